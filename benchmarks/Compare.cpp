@@ -0,0 +1,114 @@
+#include <map>
+#include <string>
+
+#include <yaml-cpp/yaml.h>
+#include <noa/core/Error.hpp>
+
+#include "Helpers.h"
+
+namespace {
+    using namespace ::noa::types;
+
+    struct Entry {
+        f64 real_time_ns{};
+        f64 bytes_per_second{};
+    };
+
+    auto to_nanoseconds(const std::string& time_unit) -> f64 {
+        if (time_unit == "ns")
+            return 1;
+        if (time_unit == "us")
+            return 1e3;
+        if (time_unit == "ms")
+            return 1e6;
+        if (time_unit == "s")
+            return 1e9;
+        noa::panic("Unknown time unit: {}", time_unit);
+    }
+
+    auto format_time(f64 nanoseconds) -> std::string {
+        if (nanoseconds < 1e3)
+            return fmt::format("{:.1f} ns", nanoseconds);
+        if (nanoseconds < 1e6)
+            return fmt::format("{:.2f} us", nanoseconds * 1e-3);
+        if (nanoseconds < 1e9)
+            return fmt::format("{:.2f} ms", nanoseconds * 1e-6);
+        return fmt::format("{:.3f} s", nanoseconds * 1e-9);
+    }
+
+    // Loads the benchmarks of a JSON output of google-benchmark (JSON is valid YAML).
+    // If the runs were repeated, the median is used, otherwise the (first) iteration run.
+    auto load(const Path& path) -> std::map<std::string, Entry> {
+        const YAML::Node root = YAML::LoadFile(path.string());
+        const YAML::Node benchmarks = root["benchmarks"];
+        noa::check(benchmarks.IsSequence(), "{} is not a JSON output of google-benchmark", path);
+
+        std::map<std::string, Entry> iterations;
+        std::map<std::string, Entry> medians;
+        for (const YAML::Node& node: benchmarks) {
+            if (node["error_occurred"] and node["error_occurred"].as<bool>())
+                continue;
+
+            const auto name = node["run_name"] ? node["run_name"].as<std::string>() : node["name"].as<std::string>();
+            const auto entry = Entry{
+                .real_time_ns = node["real_time"].as<f64>() * to_nanoseconds(node["time_unit"].as<std::string>()),
+                .bytes_per_second = node["bytes_per_second"] ? node["bytes_per_second"].as<f64>() : 0.,
+            };
+            if (node["run_type"] and node["run_type"].as<std::string>() == "aggregate") {
+                if (node["aggregate_name"].as<std::string>() == "median")
+                    medians[name] = entry;
+            } else {
+                iterations.emplace(name, entry);
+            }
+        }
+        for (const auto& [name, entry]: medians)
+            iterations[name] = entry;
+        return iterations;
+    }
+}
+
+namespace bench {
+    auto compare(const CompareOptions& options) -> bool {
+        const auto baseline = load(options.baseline);
+        const auto results = load(options.results);
+
+        fmt::print("Comparing {} against the baseline {} (threshold={:.1f}%)\n",
+                   options.results, options.baseline, options.threshold * 100);
+        fmt::print("{:<70} {:>12} {:>12} {:>9} {:>16}\n", "Benchmark", "Baseline", "Current", "Change", "GB/s");
+
+        i64 n_compared{};
+        i64 n_regressions{};
+        i64 n_improvements{};
+        for (const auto& [name, current]: results) {
+            const auto it = baseline.find(name);
+            if (it == baseline.end()) {
+                fmt::print("{:<70} {:>12} {:>12}\n", name, "-", format_time(current.real_time_ns));
+                continue;
+            }
+            const Entry& reference = it->second;
+            const f64 change = current.real_time_ns / reference.real_time_ns - 1;
+            const bool is_regression = change > options.threshold;
+            const bool is_improvement = change < -options.threshold;
+            n_compared += 1;
+            n_regressions += is_regression;
+            n_improvements += is_improvement;
+
+            const auto bandwidth = current.bytes_per_second > 0 ?
+                fmt::format("{:.2f}->{:.2f}", reference.bytes_per_second * 1e-9, current.bytes_per_second * 1e-9) :
+                std::string{};
+            fmt::print("{:<70} {:>12} {:>12} {:>+8.1f}% {:>16}{}\n",
+                       name, format_time(reference.real_time_ns), format_time(current.real_time_ns),
+                       change * 100, bandwidth,
+                       is_regression ? "  REGRESSION" : is_improvement ? "  improved" : "");
+        }
+
+        i64 n_missing{};
+        for (const auto& [name, _]: baseline)
+            n_missing += not results.contains(name);
+
+        fmt::print("\n{} compared, {} regression(s), {} improvement(s), {} new, {} missing from the results\n",
+                   n_compared, n_regressions, n_improvements,
+                   std::ssize(results) - n_compared, n_missing);
+        return n_regressions == 0;
+    }
+}
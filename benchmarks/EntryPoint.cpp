@@ -1,15 +1,55 @@
 // This is the entry point to ALL benchmarks.
 // Use --benchmark_filter=<regex> to run specific benchmarks.
+//
+// Comparing against a baseline:
+//  1. Save a baseline: --benchmark_out=baseline.json --benchmark_out_format=json
+//  2. Run and compare: --benchmark_out=results.json --benchmark_out_format=json --compare_baseline=baseline.json
+//     or compare existing results: --compare_baseline=baseline.json --compare_results=results.json
+// Benchmarks slower than the baseline by more than --compare_threshold (default=0.1, i.e. 10%) are reported
+// as regressions, in which case the program returns a non-zero exit code.
+// Use --benchmark_repetitions=<n> to compare the medians of repeated runs.
+// Baselines are machine specific, so save the baseline locally, with the same build type, before a change.
 
 // #include <iostream>
 
 // #include <noa/Session.hpp>
+#include <string_view>
 #include <benchmark/benchmark.h>
 
+#include "Helpers.h"
+
 // namespace benchmark {
     // std::filesystem::path NOA_DATA_PATH;
 // }
 
+namespace {
+    // Returns the value of the flag, if any.
+    auto find_flag(int argc, char** argv, std::string_view flag) -> std::string {
+        for (int i{1}; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            if (argument.starts_with(flag) and argument.size() > flag.size() and argument[flag.size()] == '=')
+                return std::string(argument.substr(flag.size() + 1));
+        }
+        return {};
+    }
+
+    // Removes the flag from the command line and returns its value, if any.
+    auto extract_flag(int& argc, char** argv, std::string_view flag) -> std::string {
+        std::string value;
+        for (int i{1}; i < argc; ++i) {
+            const std::string_view argument = argv[i];
+            if (argument.starts_with(flag) and argument.size() > flag.size() and argument[flag.size()] == '=') {
+                value = argument.substr(flag.size() + 1);
+                for (int j{i}; j < argc - 1; ++j)
+                    argv[j] = argv[j + 1];
+                --argc;
+                --i;
+            }
+        }
+        return value;
+    }
+}
+
 int main(int argc, char** argv) {
     // const char* path = std::getenv("NOA_DATA_PATH");
     // if (path == nullptr) {
@@ -20,10 +60,34 @@ int main(int argc, char** argv) {
     // ::benchmark::NOA_DATA_PATH = path;
     // ::benchmark::NOA_DATA_PATH /= "assets";
 
+    auto compare_options = bench::CompareOptions{
+        .baseline = extract_flag(argc, argv, "--compare_baseline"),
+        .results = extract_flag(argc, argv, "--compare_results"),
+    };
+    if (const auto threshold = extract_flag(argc, argv, "--compare_threshold"); not threshold.empty())
+        compare_options.threshold = std::stod(threshold);
+
+    // Compare existing results, without running the benchmarks.
+    if (not compare_options.baseline.empty() and not compare_options.results.empty())
+        return bench::compare(compare_options) ? 0 : 1;
+
+    // Compare the results of this run, which should be saved in JSON (the default format of --benchmark_out).
+    if (not compare_options.baseline.empty()) {
+        compare_options.results = find_flag(argc, argv, "--benchmark_out");
+        const auto format = find_flag(argc, argv, "--benchmark_out_format");
+        if (compare_options.results.empty() or (not format.empty() and format != "json")) {
+            fmt::print(stderr, "--compare_baseline requires --compare_results or --benchmark_out with the JSON format\n");
+            return 1;
+        }
+    }
+
     ::benchmark::Initialize(&argc, argv);
     if (::benchmark::ReportUnrecognizedArguments(argc, argv))
         return 1;
     ::benchmark::RunSpecifiedBenchmarks();
     ::benchmark::Shutdown();
+
+    if (not compare_options.baseline.empty())
+        return bench::compare(compare_options) ? 0 : 1;
     return 0;
 }
@@ -1,7 +1,84 @@
 #pragma once
-#include "../tests/Helpers.h"
-#include "../tests/Assets.h"
 
-namespace benchmark {
-    extern noa::path_t NOA_DATA_PATH;
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <noa/core/io/IO.hpp>
+
+namespace bench {
+    using namespace ::noa::types;
+
+    // Thread counts used to measure the scaling of the multithreaded benchmarks:
+    // the powers of two up to the number of hardware threads (which is always included).
+    inline auto thread_counts() -> std::vector<i64> {
+        const auto n_max = std::max(i64{1}, static_cast<i64>(std::thread::hardware_concurrency()));
+        std::vector<i64> counts;
+        for (i64 i{1}; i < n_max; i *= 2)
+            counts.push_back(i);
+        counts.push_back(n_max);
+        return counts;
+    }
+
+    // Single-threaded memcpy bandwidth, in bytes (read and written) per second.
+    // This is the reference of the "of_memcpy" counter. It is measured once, on a buffer much larger than
+    // the last level cache, and is the best of a few repeats to filter out the noise of the first touch.
+    inline auto memcpy_bandwidth() -> f64 {
+        static const f64 bandwidth = [] {
+            constexpr size_t N_BYTES = size_t{256} << 20;
+            const auto src = std::make_unique<std::byte[]>(N_BYTES);
+            const auto dst = std::make_unique<std::byte[]>(N_BYTES);
+            std::memset(src.get(), 1, N_BYTES);
+            std::memset(dst.get(), 0, N_BYTES);
+
+            f64 best{};
+            for (i32 i{}; i < 5; ++i) {
+                const auto start = std::chrono::steady_clock::now();
+                std::memcpy(dst.get(), src.get(), N_BYTES);
+                ::benchmark::ClobberMemory();
+                const std::chrono::duration<f64> elapsed = std::chrono::steady_clock::now() - start;
+                best = std::max(best, 2 * static_cast<f64>(N_BYTES) / elapsed.count());
+            }
+            return best;
+        }();
+        return bandwidth;
+    }
+
+    // Total number of bytes of the arrays.
+    template<typename... T>
+    auto n_bytes(const T&... arrays) -> i64 {
+        return ((arrays.ssize() * static_cast<i64>(sizeof(typename T::value_type))) + ...);
+    }
+
+    // Reports the throughput of the benchmark, given the number of bytes read and written and the number of
+    // elements processed per iteration. This sets the "bytes_per_second" (GB/s) and "items_per_second"
+    // (elements/s) counters, as well as the "of_memcpy" counter, i.e. the bandwidth relative to memcpy.
+    // Since the latter is a rate, the console reporter appends "/s" to it, but it is a ratio.
+    inline void set_throughput(::benchmark::State& state, i64 n_bytes, i64 n_elements) {
+        const auto n_iterations = static_cast<i64>(state.iterations());
+        state.SetBytesProcessed(n_iterations * n_bytes);
+        state.SetItemsProcessed(n_iterations * n_elements);
+        state.counters["of_memcpy"] = ::benchmark::Counter(
+            static_cast<f64>(n_iterations * n_bytes) / memcpy_bandwidth(),
+            ::benchmark::Counter::kIsRate);
+    }
+
+    struct CompareOptions {
+        // JSON output of a previous run (--benchmark_out=<file> --benchmark_out_format=json).
+        Path baseline;
+
+        // JSON output of the run to compare against the baseline.
+        Path results;
+
+        // Relative slowdown above which a benchmark is reported as a regression.
+        f64 threshold{0.1};
+    };
+
+    // Compares the real time of the benchmarks present in both files, prints a report to stdout,
+    // and returns whether no regression was detected. If the runs were repeated, the medians are compared.
+    auto compare(const CompareOptions& options) -> bool;
 }
@@ -0,0 +1,137 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/Signal.hpp>
+#include <noa/unified/Random.hpp>
+
+using namespace ::noa::types;
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 1024, 1024},
+        {1, 128, 128, 128},
+    };
+
+    // Compares the direct and FFT convolutions, which is used to calibrate the cost model
+    // in noa/cpu/signal/ConvolveFFT.hpp.
+    template<typename T>
+    void bench000_convolve_direct(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto filter_size = state.range(1);
+        const auto filter_shape = shape[1] == 1 ?
+                                  Shape3<i64>{1, filter_size, filter_size} :
+                                  Shape3<i64>::from_value(filter_size);
+
+        Array input = noa::random<T>(noa::Uniform<T>{-1, 1}, shape);
+        Array filter = noa::random<T>(noa::Uniform<T>{-1, 1}, filter_shape.push_front(1));
+        Array output = noa::like(input);
+
+        using input_accessor_t = AccessorRestrict<const T, 4, i64>;
+        using output_accessor_t = AccessorRestrict<T, 4, i64>;
+        using filter_accessor_t = AccessorRestrictContiguous<const T, 1, i64>;
+        const auto input_accessor = input_accessor_t(input.get(), input.strides());
+        const auto output_accessor = output_accessor_t(output.get(), output.strides());
+        const auto filter_accessor = filter_accessor_t(filter.get());
+
+        for (auto _: state) {
+            if (shape[1] == 1) {
+                auto op = noa::cpu::signal::guts::Convolution(
+                    input_accessor, output_accessor, filter_accessor, shape.filter(2, 3), filter_shape.pop_front());
+                noa::cpu::iwise(shape, op, 1);
+            } else {
+                auto op = noa::cpu::signal::guts::Convolution(
+                    input_accessor, output_accessor, filter_accessor, shape.filter(1, 2, 3), filter_shape);
+                noa::cpu::iwise(shape, op, 1);
+            }
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        state.counters["taps"] = static_cast<f64>(filter_shape.n_elements());
+    }
+
+    template<typename T>
+    void bench000_convolve_fft(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto filter_size = state.range(1);
+        const auto filter_shape = shape[1] == 1 ?
+                                  Shape3<i64>{1, filter_size, filter_size} :
+                                  Shape3<i64>::from_value(filter_size);
+
+        Array input = noa::random<T>(noa::Uniform<T>{-1, 1}, shape);
+        Array filter = noa::random<T>(noa::Uniform<T>{-1, 1}, filter_shape.push_front(1));
+        Array output = noa::like(input);
+
+        for (auto _: state) {
+            noa::cpu::signal::guts::convolve_fft(
+                input.get(), input.strides(), output.get(), output.strides(), shape,
+                filter.get(), filter_shape, 1);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        state.counters["fft_faster"] = noa::cpu::signal::guts::is_convolve_fft_faster(shape, filter_shape);
+    }
+
+    template<typename T>
+    void bench001_convolve(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto filter_size = state.range(1);
+        const auto filter_shape = shape[1] == 1 ?
+                                  Shape4<i64>{1, 1, filter_size, filter_size} :
+                                  Shape4<i64>{1, filter_size, filter_size, filter_size};
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(2));
+
+        Array input = noa::random<T>(noa::Uniform<T>{-1, 1}, shape);
+        Array filter = noa::random<T>(noa::Uniform<T>{-1, 1}, filter_shape);
+        Array output = noa::like(input);
+
+        for (auto _: state) {
+            noa::signal::convolve(input, output, filter);
+            output.eval();
+        }
+    }
+
+    constexpr Shape4<i64> separable_shapes[]{
+        {1, 1, 4096, 4096},
+        {1, 256, 256, 256},
+        {1, 512, 512, 512},
+    };
+
+    // Gaussian smoothing, i.e. symmetric filters along every dimension.
+    template<typename T>
+    void bench002_convolve_separable(benchmark::State& state) {
+        const auto shape = separable_shapes[state.range(0)];
+        const auto filter_size = state.range(1);
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(2));
+
+        Array input = noa::random<T>(noa::Uniform<T>{-1, 1}, shape);
+        Array filter = noa::empty<T>({1, 1, 1, filter_size});
+        for (i64 i{}; i < filter_size; ++i) {
+            const auto x = static_cast<f64>(i - filter_size / 2) / static_cast<f64>(filter_size / 2 + 1);
+            filter(0, 0, 0, i) = static_cast<T>(std::exp(-2 * x * x));
+        }
+        Array output = noa::like(input);
+        const auto filter_depth = shape[1] == 1 ? View<T>{} : filter.view();
+
+        for (auto _: state) {
+            noa::signal::convolve_separable(input, output, filter_depth, filter, filter);
+            output.eval();
+        }
+        state.SetBytesProcessed(state.iterations() * 2 * shape.n_elements() * static_cast<i64>(sizeof(T)));
+    }
+}
+
+BENCHMARK_TEMPLATE(bench000_convolve_direct, f32)
+    ->ArgsProduct({{0}, {3, 7, 15, 31, 63}})
+    ->ArgsProduct({{1}, {3, 5, 9, 17}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_convolve_fft, f32)
+    ->ArgsProduct({{0}, {3, 7, 15, 31, 63, 127}})
+    ->ArgsProduct({{1}, {3, 5, 9, 17, 33}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_convolve, f32)
+    ->ArgsProduct({{0}, {3, 15, 63}, {1, 4}})
+    ->ArgsProduct({{1}, {3, 9, 17}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench002_convolve_separable, f32)
+    ->ArgsProduct({{0, 1, 2}, {5, 9, 31}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/FFT.hpp>
+#include <noa/unified/Random.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 4096, 4096}, // micrograph
+        {64, 1, 512, 512},  // stack of particles
+        {1, 256, 256, 256}, // subtomogram average
+        {1, 512, 512, 512}, // tomogram
+    };
+
+    // Conventional estimate of the number of floating-point operations of a complex transform.
+    // Real transforms are counted as half a complex transform.
+    auto fft_flops(const Shape4<i64>& shape, bool is_real) -> f64 {
+        const auto n = static_cast<f64>(shape.pop_front().n_elements());
+        const f64 flops = 5 * n * std::log2(n) * static_cast<f64>(shape[0]);
+        return is_real ? flops / 2 : flops;
+    }
+
+    template<typename T>
+    void bench000_r2c(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::empty<Complex<T>>(shape.rfft());
+        noa::fft::r2c(src, dst); // plan
+
+        for (auto _: state) {
+            noa::fft::r2c(src, dst, {.norm = noa::fft::Norm::NONE});
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, dst), shape.n_elements());
+        state.counters["flops"] = ::benchmark::Counter(
+            fft_flops(shape, true), ::benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    template<typename T>
+    void bench000_c2r(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<Complex<T>>(noa::Uniform<T>{-5, 5}, shape.rfft());
+        Array dst = noa::empty<T>(shape);
+        Array tmp = noa::like(src);
+        noa::copy(src, tmp);
+        noa::fft::c2r(tmp, dst); // plan
+
+        for (auto _: state) {
+            // The multidimensional c2r transforms overwrite their input.
+            state.PauseTiming();
+            noa::copy(src, tmp);
+            state.ResumeTiming();
+            noa::fft::c2r(tmp, dst, {.norm = noa::fft::Norm::NONE});
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, dst), shape.n_elements());
+        state.counters["flops"] = ::benchmark::Counter(
+            fft_flops(shape, true), ::benchmark::Counter::kIsIterationInvariantRate);
+    }
+
+    template<typename T>
+    void bench000_c2c(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<Complex<T>>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::like(src);
+        noa::fft::c2c(src, dst, noa::fft::Sign::FORWARD); // plan
+
+        for (auto _: state) {
+            noa::fft::c2c(src, dst, noa::fft::Sign::FORWARD, {.norm = noa::fft::Norm::NONE});
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, dst), shape.n_elements());
+        state.counters["flops"] = ::benchmark::Counter(
+            fft_flops(shape, false), ::benchmark::Counter::kIsIterationInvariantRate);
+    }
+}
+
+BENCHMARK_TEMPLATE(bench000_r2c, f32)
+    ->ArgsProduct({{0, 1, 2, 3}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_c2r, f32)
+    ->ArgsProduct({{0, 1, 2, 3}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_c2c, f32)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_r2c, f64)
+    ->ArgsProduct({{0, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/unified/Random.hpp>
+#include <noa/unified/geometry/FourierProject.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+namespace ng = ::noa::geometry;
+using Remap = noa::Remap;
+
+namespace {
+    constexpr i64 sizes[]{128, 256};
+    constexpr i64 n_slices = 64;
+
+    auto rotation_matrices(i64 n, bool inverse) -> Array<Mat33<f32>> {
+        auto matrices = noa::empty<Mat33<f32>>(n);
+        for (i64 i{}; auto& matrix: matrices.span_1d_contiguous()) {
+            const auto angles = noa::deg2rad(Vec{static_cast<f32>(i) * 5.f, static_cast<f32>(i) * 2.f, 0.f});
+            matrix = ng::euler2matrix(angles, {.axes = "zyz"});
+            if (inverse)
+                matrix = matrix.transpose();
+            ++i;
+        }
+        return matrices;
+    }
+
+    // Backward projection: insertion of central slices into a volume, with the windowed-sinc interpolation.
+    void bench000_fourier_insert_interpolate_3d(benchmark::State& state) {
+        const i64 size = sizes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        const auto slice_shape = Shape4<i64>{n_slices, 1, size, size};
+        const auto volume_shape = Shape4<i64>{1, size, size, size};
+        Array slices = noa::random<c32>(noa::Uniform<f32>{-5, 5}, slice_shape.rfft());
+        Array volume = noa::zeros<c32>(volume_shape.rfft());
+        Array inv_rotations = rotation_matrices(n_slices, true);
+
+        for (auto _: state) {
+            ng::fourier_insert_interpolate_3d<Remap::HC2HC>(
+                slices, {}, slice_shape, volume, {}, volume_shape,
+                {}, inv_rotations, {.windowed_sinc = {0.02, 0.06}, .fftfreq_cutoff = 0.5});
+            ::benchmark::DoNotOptimize(volume.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(slices, volume), volume.ssize());
+    }
+
+    // Forward projection: extraction of central slices from a volume.
+    void bench000_fourier_extract_3d(benchmark::State& state) {
+        const i64 size = sizes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        const auto slice_shape = Shape4<i64>{n_slices, 1, size, size};
+        const auto volume_shape = Shape4<i64>{1, size, size, size};
+        Array volume = noa::random<c32>(noa::Uniform<f32>{-5, 5}, volume_shape.rfft());
+        Array slices = noa::empty<c32>(slice_shape.rfft());
+        Array fwd_rotations = rotation_matrices(n_slices, false);
+
+        for (auto _: state) {
+            ng::fourier_extract_3d<Remap::HC2HC>(
+                volume, {}, volume_shape, slices, {}, slice_shape,
+                {}, fwd_rotations, {.fftfreq_cutoff = 0.5});
+            ::benchmark::DoNotOptimize(slices.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(volume, slices), slices.ssize());
+    }
+
+    // Slice-to-slice projection, without the intermediate volume.
+    void bench000_fourier_insert_interpolate_and_extract_3d(benchmark::State& state) {
+        const i64 size = sizes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        const auto input_shape = Shape4<i64>{n_slices, 1, size, size};
+        const auto output_shape = Shape4<i64>{4, 1, size, size};
+        Array input_slices = noa::random<c32>(noa::Uniform<f32>{-5, 5}, input_shape.rfft());
+        Array output_slices = noa::zeros<c32>(output_shape.rfft());
+        Array inv_rotations = rotation_matrices(n_slices, true);
+        Array fwd_rotations = rotation_matrices(output_shape[0], false);
+
+        for (auto _: state) {
+            ng::fourier_insert_interpolate_and_extract_3d<Remap::HC2HC>(
+                input_slices, {}, input_shape, output_slices, {}, output_shape,
+                {}, inv_rotations, {}, fwd_rotations,
+                {.input_windowed_sinc = {0.02, 0.06}, .add_to_output = true});
+            ::benchmark::DoNotOptimize(output_slices.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input_slices, output_slices), output_slices.ssize());
+    }
+}
+
+BENCHMARK(bench000_fourier_insert_interpolate_3d)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_fourier_extract_3d)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_fourier_insert_interpolate_and_extract_3d)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
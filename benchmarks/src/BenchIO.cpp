@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/IO.hpp>
+#include <noa/unified/Random.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 4096, 4096},  // micrograph
+        {1, 256, 1024, 1024}, // tomogram
+    };
+
+    constexpr noa::io::Encoding::Type dtypes[]{
+        noa::io::Encoding::F32,
+        noa::io::Encoding::F16,
+    };
+
+    auto filename(std::string_view name) -> Path {
+        return fs::temp_directory_path() / fmt::format("noa_benchmarks_{}.mrc", name);
+    }
+
+    // The file is written to the temporary directory, so this mostly measures the encoding and the page cache.
+    void bench000_write_mrc(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto dtype = dtypes[state.range(1)];
+        const auto n_threads = static_cast<i32>(state.range(2));
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+
+        Array data = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        const auto path = filename("write");
+
+        for (auto _: state)
+            noa::write(data, path, {.dtype = dtype, .n_threads = n_threads});
+        fs::remove(path);
+
+        const i64 n_encoded_bytes = noa::io::Encoding::encoded_size(dtype, shape.n_elements());
+        bench::set_throughput(state, bench::n_bytes(data) + n_encoded_bytes, shape.n_elements());
+        state.SetLabel(fmt::format("{}", dtype));
+    }
+
+    void bench000_read_mrc(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto dtype = dtypes[state.range(1)];
+        const auto n_threads = static_cast<i32>(state.range(2));
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+
+        const auto path = filename("read");
+        noa::write(noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape), path, {.dtype = dtype});
+
+        for (auto _: state) {
+            Array data = noa::read_data<f32>(path, {.n_threads = n_threads});
+            ::benchmark::DoNotOptimize(data.get());
+        }
+        fs::remove(path);
+
+        const i64 n_encoded_bytes = noa::io::Encoding::encoded_size(dtype, shape.n_elements());
+        bench::set_throughput(state, shape.n_elements() * static_cast<i64>(sizeof(f32)) + n_encoded_bytes,
+                              shape.n_elements());
+        state.SetLabel(fmt::format("{}", dtype));
+    }
+}
+
+BENCHMARK(bench000_write_mrc)
+    ->ArgsProduct({{0, 1}, {0, 1}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_read_mrc)
+    ->ArgsProduct({{0, 1}, {0, 1}, {1, 4}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/unified/Random.hpp>
+
+using namespace ::noa::types;
+
+namespace {
+    constexpr Shape<i64, 4> shapes[]{
+        {1, 1, 4096, 4096},
+        {1, 256, 256, 256},
+        {1, 512, 512, 512},
+    };
+
+    constexpr Vec4<i64> permutations[]{
+        {0, 1, 3, 2},
+        {0, 2, 1, 3},
+        {0, 3, 1, 2},
+        {0, 2, 3, 1},
+        {0, 3, 2, 1},
+    };
+
+    // Bytes read and written, per iteration.
+    template<typename T>
+    auto bytes_moved(const Shape4<i64>& shape) -> i64 {
+        return 2 * shape.n_elements() * static_cast<i64>(sizeof(T));
+    }
+
+    template<typename T>
+    void bench000_memcpy(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::like(src);
+
+        for (auto _: state) {
+            std::copy_n(src.get(), shape.n_elements(), dst.get());
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        state.SetBytesProcessed(state.iterations() * bytes_moved<T>(shape));
+    }
+
+    template<typename T>
+    void bench000_copy(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::like(src);
+
+        for (auto _: state) {
+            noa::copy(src, dst);
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        state.SetBytesProcessed(state.iterations() * bytes_moved<T>(shape));
+    }
+
+    template<typename T>
+    void bench001_permute_copy(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        const auto permutation = permutations[state.range(1)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(2));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::empty<T>(shape.reorder(permutation));
+
+        for (auto _: state) {
+            noa::permute_copy(src, dst, permutation);
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        state.SetBytesProcessed(state.iterations() * bytes_moved<T>(shape));
+        state.SetLabel(fmt::format("{}", permutation));
+    }
+}
+
+BENCHMARK_TEMPLATE(bench000_memcpy, f32)->DenseRange(0, 2)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_copy, f32)
+    ->ArgsProduct({{0, 1, 2}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_permute_copy, f32)
+    ->ArgsProduct({{0, 1, 2}, {0, 1, 2, 3, 4}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_permute_copy, f64)
+    ->ArgsProduct({{0, 1, 2}, {0, 1, 2, 3, 4}, {1, 4, 16}})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
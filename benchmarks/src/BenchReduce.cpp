@@ -0,0 +1,146 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/unified/Random.hpp>
+#include <noa/unified/Reduce.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 4096, 4096},
+        {64, 1, 512, 512},
+        {1, 512, 512, 512},
+    };
+
+    template<typename T>
+    void bench000_sum(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+
+        for (auto _: state)
+            ::benchmark::DoNotOptimize(noa::sum(src));
+        bench::set_throughput(state, bench::n_bytes(src), shape.n_elements());
+    }
+
+    template<typename T>
+    void bench000_min_max(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+
+        for (auto _: state)
+            ::benchmark::DoNotOptimize(noa::min_max(src));
+        bench::set_throughput(state, bench::n_bytes(src), shape.n_elements());
+    }
+
+    template<typename T>
+    void bench000_mean_variance(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+
+        for (auto _: state)
+            ::benchmark::DoNotOptimize(noa::mean_variance(src));
+        bench::set_throughput(state, bench::n_bytes(src), shape.n_elements());
+    }
+
+    template<typename T>
+    void bench000_argmax(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+
+        for (auto _: state)
+            ::benchmark::DoNotOptimize(noa::argmax(src));
+        bench::set_throughput(state, bench::n_bytes(src), shape.n_elements());
+    }
+
+    // Per-batch reductions, e.g. the normalization of particle stacks.
+    template<typename T>
+    void bench001_mean_variance_per_batch(benchmark::State& state) {
+        const auto shape = shapes[1];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array means = noa::empty<T>({shape[0], 1, 1, 1});
+        Array variances = noa::like(means);
+
+        for (auto _: state) {
+            noa::mean_variance(src, means, variances);
+            ::benchmark::DoNotOptimize(variances.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, means, variances), shape.n_elements());
+    }
+
+    // Reduction of the innermost dimension, e.g. the sum of the rows of a stack.
+    template<typename T>
+    void bench001_sum_width(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::empty<T>({shape[0], shape[1], shape[2], 1});
+
+        for (auto _: state) {
+            noa::sum(src, dst);
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, dst), shape.n_elements());
+    }
+
+    // Reduction of an outer dimension, e.g. the sum of the images of a stack.
+    template<typename T>
+    void bench001_sum_depth(benchmark::State& state) {
+        const auto shape = shapes[2];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array src = noa::random<T>(noa::Uniform<T>{-5, 5}, shape);
+        Array dst = noa::empty<T>({shape[0], 1, shape[2], shape[3]});
+
+        for (auto _: state) {
+            noa::sum(src, dst);
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(src, dst), shape.n_elements());
+    }
+}
+
+BENCHMARK_TEMPLATE(bench000_sum, f32)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_sum, f64)
+    ->ArgsProduct({{2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_min_max, f32)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_mean_variance, f32)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench000_argmax, f32)
+    ->ArgsProduct({{0, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_mean_variance_per_batch, f32)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_sum_width, f32)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK_TEMPLATE(bench001_sum_depth, f32)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,217 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/FFT.hpp>
+#include <noa/Signal.hpp>
+#include <noa/unified/Random.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+namespace ns = ::noa::signal;
+using Remap = noa::Remap;
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 4096, 4096}, // micrograph
+        {64, 1, 512, 512},  // stack of particles
+        {1, 256, 256, 256}, // subtomogram
+    };
+
+    void bench000_ctf_isotropic(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array output = noa::empty<f32>(shape.rfft());
+        const auto ctf = ns::CTFIsotropic<f64>(1.2, 2.5, 300, 0.07, 2.7, 0, -50, 1);
+
+        for (auto _: state) {
+            ns::ctf_isotropic<Remap::H2H>({}, output, shape, ctf);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(output), output.ssize());
+    }
+
+    // Multiplies the spectra by the CTF.
+    void bench000_ctf_isotropic_apply(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array input = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array output = noa::like(input);
+        const auto ctf = ns::CTFIsotropic<f64>(1.2, 2.5, 300, 0.07, 2.7, 0, -50, 1);
+
+        for (auto _: state) {
+            ns::ctf_isotropic<Remap::H2H>(input, output, shape, ctf);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+
+    // Per-particle CTFs, e.g. to compute the Wiener-filtered average of a stack of particles.
+    auto particle_ctfs(i64 n) -> Array<ns::CTFAnisotropic<f64>> {
+        auto ctfs = noa::empty<ns::CTFAnisotropic<f64>>(n);
+        for (i64 i{}; auto& ctf: ctfs.span_1d_contiguous()) {
+            const auto defocus = 1.5 + static_cast<f64>(i % 100) * 0.01;
+            ctf = ns::CTFAnisotropic<f64>({1.2, 1.2}, {defocus, 0.1, 0.5}, 300, 0.07, 2.7, 0, -50, 1);
+            ++i;
+        }
+        return ctfs;
+    }
+
+    void bench000_ctf_anisotropic_per_particle(benchmark::State& state) {
+        const auto shape = Shape4<i64>{1024, 1, 256, 256};
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array input = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array output = noa::like(input);
+        Array ctfs = particle_ctfs(shape[0]);
+
+        for (auto _: state) {
+            ns::ctf_anisotropic<Remap::H2H>(input, output, shape, ctfs);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+
+    // Same as above, but with the shared frequency tables, and the sum of the squared CTFs.
+    void bench000_ctf_batched_per_particle(benchmark::State& state) {
+        const auto shape = Shape4<i64>{1024, 1, 256, 256};
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array input = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array output = noa::like(input);
+        Array ctf_squared = noa::zeros<f32>(shape.rfft().set<0>(1));
+        Array ctfs = particle_ctfs(shape[0]);
+
+        for (auto _: state) {
+            ns::ctf_batched_2d<Remap::H2H>(input, output, ctf_squared, shape, ctfs);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+
+    // Cross-correlation map, from the rFFTs to the real-space map (which includes the c2r transform).
+    void bench001_cross_correlation_map(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array lhs = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array rhs = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array buffer = noa::like(rhs);
+        Array xmap = noa::empty<f32>(shape);
+        ns::cross_correlation_map<Remap::H2FC>(lhs, rhs, xmap, {}, buffer); // plan
+
+        for (auto _: state) {
+            ns::cross_correlation_map<Remap::H2FC>(lhs, rhs, xmap, {}, buffer);
+            ::benchmark::DoNotOptimize(xmap.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(lhs, rhs, xmap), xmap.ssize());
+    }
+
+    // Translational search: one spectrum shifted by many candidate shifts.
+    void bench001_phase_shift_2d(benchmark::State& state) {
+        const auto shape = Shape4<i64>{1, 1, 512, 512};
+        const i64 n_shifts = 64;
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array input = noa::random<c32>(noa::Uniform<f32>{-5, 5}, shape.rfft());
+        Array output = noa::empty<c32>(shape.rfft().set<0>(n_shifts));
+        Array shifts = noa::empty<Vec2<f32>>(n_shifts);
+        for (i64 i{}; auto& shift: shifts.span_1d_contiguous()) {
+            shift = Vec{static_cast<f32>(i % 8), static_cast<f32>(i / 8)} * 1.5f - 6;
+            ++i;
+        }
+
+        for (auto _: state) {
+            ns::phase_shift_2d<Remap::H2H>(input, output, shape.set<0>(n_shifts), shifts);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+
+    // Local resolution of a 256^3 map, with windows every 8 voxels.
+    void bench001_local_resolution(benchmark::State& state) {
+        const auto shape = shapes[2];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(0));
+
+        Array lhs = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array rhs = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array resolution = noa::empty<f32>(ns::local_resolution_shape(shape, 8));
+        const auto options = ns::LocalResolutionOptions{.window_size = 24, .step = 8};
+        ns::local_resolution(lhs, rhs, resolution, options); // plan
+
+        for (auto _: state) {
+            ns::local_resolution(lhs, rhs, resolution, options);
+            ::benchmark::DoNotOptimize(resolution.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(lhs, rhs, resolution), resolution.ssize());
+    }
+
+    void bench002_median_filter_2d(benchmark::State& state) {
+        const auto shape = shapes[0];
+        const i64 window_size = state.range(0);
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array input = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array output = noa::like(input);
+
+        for (auto _: state) {
+            ns::median_filter_2d(input, output, {.window_size = window_size});
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+
+    void bench002_median_filter_3d(benchmark::State& state) {
+        const auto shape = shapes[2];
+        const i64 window_size = state.range(0);
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array input = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array output = noa::like(input);
+
+        for (auto _: state) {
+            ns::median_filter_3d(input, output, {.window_size = window_size});
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(input, output), output.ssize());
+    }
+}
+
+BENCHMARK(bench000_ctf_isotropic)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_ctf_isotropic_apply)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_ctf_anisotropic_per_particle)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_ctf_batched_per_particle)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_cross_correlation_map)
+    ->ArgsProduct({{0, 1, 2}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_phase_shift_2d)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_local_resolution)
+    ->ArgsProduct({bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench002_median_filter_2d)
+    ->ArgsProduct({{3, 5, 11}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench002_median_filter_3d)
+    ->ArgsProduct({{3, 5}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/unified/Random.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+
+// STREAM kernels (copy, scale, add, triad), i.e. the memory bandwidth the element-wise operations should reach.
+// The single-threaded loops are the baselines of the library's multithreaded element-wise operations.
+
+namespace {
+    constexpr Shape4<i64> shapes[]{
+        {1, 1, 4096, 4096},
+        {1, 512, 512, 512},
+    };
+
+    constexpr f32 SCALAR = 3;
+
+    void bench000_memcpy(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+
+        Array src = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array dst = noa::like(src);
+
+        const auto n_bytes = shape.n_elements() * static_cast<i64>(sizeof(f32));
+        for (auto _: state) {
+            std::memcpy(dst.get(), src.get(), static_cast<size_t>(n_bytes));
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, 2 * n_bytes, shape.n_elements());
+    }
+
+    void bench000_triad_loop(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+
+        Array b = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array c = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array a = noa::like(b);
+
+        const i64 n_elements = shape.n_elements();
+        f32* NOA_RESTRICT_ATTRIBUTE a_ptr = a.get();
+        const f32* NOA_RESTRICT_ATTRIBUTE b_ptr = b.get();
+        const f32* NOA_RESTRICT_ATTRIBUTE c_ptr = c.get();
+        for (auto _: state) {
+            for (i64 i{}; i < n_elements; ++i)
+                a_ptr[i] = c_ptr[i] * SCALAR + b_ptr[i];
+            ::benchmark::DoNotOptimize(a.get());
+        }
+        bench::set_throughput(state, 3 * n_elements * static_cast<i64>(sizeof(f32)), n_elements);
+    }
+
+    void bench001_copy(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array dst = noa::like(src);
+
+        for (auto _: state) {
+            noa::copy(src, dst);
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, 2 * shape.n_elements() * static_cast<i64>(sizeof(f32)), shape.n_elements());
+    }
+
+    void bench001_scale(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array src = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array dst = noa::like(src);
+
+        for (auto _: state) {
+            noa::ewise(noa::wrap(src, SCALAR), dst, noa::Multiply{});
+            ::benchmark::DoNotOptimize(dst.get());
+        }
+        bench::set_throughput(state, 2 * shape.n_elements() * static_cast<i64>(sizeof(f32)), shape.n_elements());
+    }
+
+    void bench001_add(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array a = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array b = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array c = noa::like(a);
+
+        for (auto _: state) {
+            noa::ewise(noa::wrap(a, b), c, noa::Plus{});
+            ::benchmark::DoNotOptimize(c.get());
+        }
+        bench::set_throughput(state, 3 * shape.n_elements() * static_cast<i64>(sizeof(f32)), shape.n_elements());
+    }
+
+    void bench001_triad(benchmark::State& state) {
+        const auto shape = shapes[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array b = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array c = noa::random<f32>(noa::Uniform<f32>{-5, 5}, shape);
+        Array a = noa::like(b);
+
+        for (auto _: state) {
+            noa::ewise(noa::wrap(c, SCALAR, b), a, noa::MultiplyPlus{});
+            ::benchmark::DoNotOptimize(a.get());
+        }
+        bench::set_throughput(state, 3 * shape.n_elements() * static_cast<i64>(sizeof(f32)), shape.n_elements());
+    }
+}
+
+BENCHMARK(bench000_memcpy)->DenseRange(0, 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_triad_loop)->DenseRange(0, 1)->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_copy)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_scale)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_add)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench001_triad)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
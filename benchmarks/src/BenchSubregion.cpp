@@ -0,0 +1,107 @@
+#include <filesystem>
+#include <random>
+#include <benchmark/benchmark.h>
+
+#include <noa/Array.hpp>
+#include <noa/IO.hpp>
+#include <noa/unified/Random.hpp>
+#include <noa/unified/Subregion.hpp>
+
+#include "Helpers.h"
+
+using namespace ::noa::types;
+
+namespace {
+    struct Setup {
+        Shape4<i64> input_shape;
+        Shape4<i64> subregion_shape;
+    };
+
+    constexpr Setup setups[]{
+        {{1, 1, 4096, 4096}, {512, 1, 256, 256}}, // particle picking
+        {{1, 256, 1024, 1024}, {128, 64, 64, 64}}, // subtomogram picking
+    };
+
+    // Random (but reproducible) origins, with some subregions partially out of bounds.
+    auto random_origins(const Setup& setup) -> Array<Vec4<i64>> {
+        const i64 n_subregions = setup.subregion_shape[0];
+        auto origins = noa::empty<Vec4<i64>>(n_subregions);
+        auto randomizer = std::mt19937_64(42);
+        for (auto& origin: origins.span_1d_contiguous()) {
+            origin[0] = 0;
+            for (size_t i = 1; i < 4; ++i) {
+                const auto low = -setup.subregion_shape[i] / 2;
+                const auto high = setup.input_shape[i] - setup.subregion_shape[i] / 2;
+                origin[i] = std::uniform_int_distribution<i64>(low, high)(randomizer);
+            }
+        }
+        return origins;
+    }
+
+    void bench000_extract_subregions(benchmark::State& state) {
+        const auto setup = setups[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array input = noa::random<f32>(noa::Uniform<f32>{-5, 5}, setup.input_shape);
+        Array subregions = noa::empty<f32>(setup.subregion_shape);
+        Array origins = random_origins(setup);
+
+        for (auto _: state) {
+            noa::extract_subregions(input, subregions, origins);
+            ::benchmark::DoNotOptimize(subregions.get());
+        }
+        bench::set_throughput(state, 2 * bench::n_bytes(subregions), subregions.ssize());
+    }
+
+    // Particle picking from a micrograph on disk: only reading the rows of the particles (0),
+    // or reading the whole micrograph and extracting from memory (1).
+    void bench000_extract_subregions_from_file(benchmark::State& state) {
+        const auto setup = Setup{{1, 1, 4096, 4096}, {32, 1, 256, 256}};
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        const auto filename = std::filesystem::temp_directory_path() / "noa_bench_micrograph.mrc";
+        noa::write(noa::random<f32>(noa::Uniform<f32>{-5, 5}, setup.input_shape), filename);
+        Array subregions = noa::empty<f32>(setup.subregion_shape);
+        Array origins = random_origins(setup);
+
+        for (auto _: state) {
+            if (state.range(0) == 0) {
+                noa::extract_subregions(filename, subregions, origins);
+            } else {
+                Array input = noa::read_data<f32>(filename);
+                noa::extract_subregions(input, subregions, origins);
+            }
+            ::benchmark::DoNotOptimize(subregions.get());
+        }
+        bench::set_throughput(state, bench::n_bytes(subregions), subregions.ssize());
+        std::filesystem::remove(filename);
+    }
+
+    void bench000_insert_subregions(benchmark::State& state) {
+        const auto setup = setups[state.range(0)];
+        StreamGuard stream{Device{}, Stream::DEFAULT};
+        stream.set_thread_limit(state.range(1));
+
+        Array subregions = noa::random<f32>(noa::Uniform<f32>{-5, 5}, setup.subregion_shape);
+        Array output = noa::zeros<f32>(setup.input_shape);
+        Array origins = random_origins(setup);
+
+        for (auto _: state) {
+            noa::insert_subregions(subregions, output, origins);
+            ::benchmark::DoNotOptimize(output.get());
+        }
+        bench::set_throughput(state, 2 * bench::n_bytes(subregions), subregions.ssize());
+    }
+}
+
+BENCHMARK(bench000_extract_subregions)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_extract_subregions_from_file)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
+BENCHMARK(bench000_insert_subregions)
+    ->ArgsProduct({{0, 1}, bench::thread_counts()})
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -19,6 +19,8 @@ macro(noa_set_options)
     set(NOA_ERROR_POLICY 2 CACHE STRING "Abort=0, Terminate=1, Exceptions=2")
     option(NOA_ENABLE_WARNINGS "Enable compiler warnings (these only affect the library's source files)" ON)
     option(NOA_ENABLE_WARNINGS_AS_ERRORS "Treat compiler warnings as errors" OFF)
+    option(NOA_ENABLE_TRACING "Enable the tracing of the library operations (see Session::set_tracing)" OFF)
+    option(NOA_ENABLE_F16C "Use the F16C instructions for the scalar conversions between f16 and f32 (GCC/Clang, x86-64)" OFF)
 
     # TIFF:
     option(NOA_ENABLE_TIFF "Enable support for the TIFF file format. Requires static libtiff" OFF) # TODO not tested
@@ -19,6 +19,19 @@ target_link_libraries(noa_public_libraries
     half::half
     )
 
+# F16C is used by Half.hpp, which is included by the user, so the flag should be public.
+if (NOA_ENABLE_F16C)
+    if (CMAKE_CXX_COMPILER_ID MATCHES ".*Clang" OR CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+        target_compile_options(noa_public_libraries
+            INTERFACE
+            $<$<COMPILE_LANGUAGE:CXX>: -mf16c>
+            $<$<COMPILE_LANGUAGE:CUDA>: -Xcompiler=-mf16c>
+            )
+    else ()
+        message(WARNING "NOA_ENABLE_F16C is not supported for the '${CMAKE_CXX_COMPILER_ID}' compiler and is ignored")
+    endif ()
+endif ()
+
 if (NOA_ENABLE_TIFF)
     include(${PROJECT_SOURCE_DIR}/cmake/ext/tiff.cmake)
     target_link_libraries(noa_private_libraries INTERFACE TIFF::TIFF)
@@ -106,6 +119,7 @@ target_compile_definitions(noa
     "$<$<BOOL:${NOA_ENABLE_CPU}>:NOA_ENABLE_CPU>"
     "$<$<BOOL:${NOA_ENABLE_CUDA}>:NOA_ENABLE_CUDA>"
     "$<$<BOOL:${NOA_ENABLE_TIFF}>:NOA_ENABLE_TIFF>"
+    "$<$<BOOL:${NOA_ENABLE_TRACING}>:NOA_ENABLE_TRACING>"
     "$<$<BOOL:${NOA_CPU_OPENMP}>:NOA_ENABLE_OPENMP>"
     "$<$<BOOL:${NOA_CPU_FFTW3_MULTITHREADED}>:NOA_CPU_FFTW3_MULTITHREADED>"
     )
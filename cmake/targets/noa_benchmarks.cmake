@@ -2,6 +2,7 @@ message(STATUS "--------------------------------------")
 message(STATUS "-> noa::noa_benchmarks: configuring public target...")
 
 include(${PROJECT_SOURCE_DIR}/cmake/ext/google-benchmark.cmake)
+include(${PROJECT_SOURCE_DIR}/cmake/ext/yaml-cpp.cmake)
 
 # Treat the unified source as CUDA sources if CUDA is enabled
 if (NOA_ENABLE_CUDA)
@@ -18,6 +19,7 @@ target_link_libraries(noa_benchmarks
     prj_compiler_warnings
     noa::noa
     benchmark::benchmark
+    yaml-cpp::yaml-cpp
     )
 
 target_include_directories(noa_benchmarks
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "noa/unified/fft/Factory.hpp"
+#include "noa/unified/fft/Pyramid.hpp"
 #include "noa/unified/fft/Remap.hpp"
 #include "noa/unified/fft/Resize.hpp"
 #include "noa/unified/fft/Transform.hpp"
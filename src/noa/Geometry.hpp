@@ -14,6 +14,7 @@
 #include "noa/unified/geometry/PolarTransform.hpp"
 #include "noa/unified/geometry/PolarTransformSpectrum.hpp"
 #include "noa/unified/geometry/Project.hpp"
+#include "noa/unified/geometry/ResamplingPlan.hpp"
 #include "noa/unified/geometry/RotationalAverage.hpp"
 #include "noa/unified/geometry/Transform.hpp"
 #include "noa/unified/geometry/TransformSpectrum.hpp"
@@ -72,4 +72,5 @@ set(NOA_CORE_SOURCES
     core/io/BinaryFile.cpp
     core/io/Encoders.cpp
     core/io/Encoding.cpp
+    core/types/Half.cpp
     )
@@ -475,6 +475,8 @@ namespace noa {
             // so keep a compile-time branch for this case so that only one value is read from the accessor.
             value_t interpolant{};
             update_at(static_cast<indices_t>(round(frequency)), real_t{1}, interpolant);
+            if constexpr (FLIP_EARLY and nt::complex<value_t>)
+                interpolant.imag *= conjugate;
             return interpolant;
         } else {
             // N=2:           0, 1
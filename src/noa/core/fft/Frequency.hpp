@@ -261,8 +261,8 @@ namespace noa::fft {
             bounds.first[N - 1] = 0;
             bounds.second[N - 1] = shape[N - 1] / 2;
         } else {
-            bounds.first = -shape / 2;
-            bounds.second = (shape - 1) / 2;
+            bounds.first = (-shape / 2).vec;
+            bounds.second = ((shape - 1) / 2).vec;
         }
         return bounds;
     }
@@ -516,4 +516,170 @@ namespace noa::geometry::guts {
         NOA_NO_UNIQUE_ADDRESS value_or_empty_type m_smoothness{};
         bool m_is_inverted{};
     };
+
+    /// Restricts a drawing operator to a (D)HW bounding box.
+    /// The coordinates are first shifted by the offset. The coordinates outside the [start, end) box are not
+    /// evaluated and return the value of the shape outside its (smooth) edges.
+    template<size_t N, typename DrawOp>
+    class DrawBoundingBox {
+    public:
+        using draw_op_type = DrawOp;
+        using value_type = nt::value_type_t<draw_op_type>;
+        using vector_type = Vec<value_type, N>;
+
+    public:
+        constexpr DrawBoundingBox() = default;
+
+        constexpr DrawBoundingBox(
+            const draw_op_type& draw_op,
+            const vector_type& offset,
+            const vector_type& start,
+            const vector_type& end,
+            value_type outside_value
+        ) :
+            m_draw_op(draw_op),
+            m_offset(offset),
+            m_start(start),
+            m_end(end),
+            m_outside_value(outside_value) {}
+
+        template<typename T = Empty>
+        [[nodiscard]] constexpr auto operator()(
+            vector_type coordinates,
+            const T& inverse_transform = T{}
+        ) const -> value_type {
+            coordinates += m_offset;
+            for (size_t i{}; i < N; ++i)
+                if (coordinates[i] < m_start[i] or coordinates[i] >= m_end[i])
+                    return m_outside_value;
+            return m_draw_op(coordinates, inverse_transform);
+        }
+
+    private:
+        draw_op_type m_draw_op;
+        vector_type m_offset;
+        vector_type m_start;
+        vector_type m_end;
+        value_type m_outside_value;
+    };
+
+    /// 3d iwise operator applying a compiled mask to 2d or 3d array(s), within the spans of the mask.
+    /// The mask is stored as one [begin, end) span per (D)H row, with the values of the mask within these spans
+    /// stored contiguously (row = {begin, end, offset of the first value}). The rows with a non-empty span are listed
+    /// in "spans". The operator is called on the (batch, span, index) grid, where the index goes up to the size of
+    /// the largest span. Outside the spans, the mask is constant and the output is left untouched.
+    template<size_t N,
+             nt::sinteger Index,
+             nt::readable_nd<1> Rows,
+             nt::readable_nd<1> Spans,
+             nt::readable_nd<1> Values,
+             nt::readable_nd<N + 1> Input,
+             nt::writable_nd<N + 1> Output>
+    requires (N == 2 or N == 3)
+    class ApplyCompiledMask {
+    public:
+        using index_type = Index;
+        using rows_type = Rows;
+        using spans_type = Spans;
+        using values_type = Values;
+        using input_type = Input;
+        using output_type = Output;
+        using output_value_type = nt::value_type_t<output_type>;
+
+    public:
+        constexpr ApplyCompiledMask(
+            const input_type& input,
+            const output_type& output,
+            const rows_type& rows,
+            const spans_type& spans,
+            const values_type& values,
+            index_type height
+        ) :
+            m_input(input),
+            m_output(output),
+            m_rows(rows),
+            m_spans(spans),
+            m_values(values),
+            m_height(height) {}
+
+        NOA_HD constexpr void operator()(index_type batch, index_type span, index_type index) const {
+            const auto row_index = static_cast<index_type>(m_spans[span]);
+            const auto& row = m_rows[row_index];
+            const auto begin = static_cast<index_type>(row[0]);
+            if (index >= static_cast<index_type>(row[1]) - begin)
+                return;
+
+            const auto mask = m_values[static_cast<index_type>(row[2]) + index];
+            const auto w = begin + index;
+            if constexpr (N == 3) {
+                const auto d = row_index / m_height;
+                const auto h = row_index - d * m_height;
+                m_output(batch, d, h, w) = static_cast<output_value_type>(m_input(batch, d, h, w) * mask);
+            } else {
+                m_output(batch, row_index, w) = static_cast<output_value_type>(m_input(batch, row_index, w) * mask);
+            }
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        rows_type m_rows;
+        spans_type m_spans;
+        values_type m_values;
+        index_type m_height;
+    };
+
+    /// 3d or 4d iwise operator applying the constant value of a compiled mask (see ApplyCompiledMask) to 2d or 3d
+    /// array(s), outside the spans of the mask. Elements within the spans are left untouched.
+    template<size_t N,
+             nt::sinteger Index,
+             nt::readable_nd<1> Rows,
+             nt::readable_nd<N + 1> Input,
+             nt::writable_nd<N + 1> Output>
+    requires (N == 2 or N == 3)
+    class ApplyCompiledMaskOutside {
+    public:
+        using index_type = Index;
+        using rows_type = Rows;
+        using input_type = Input;
+        using output_type = Output;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        using scalar_type = nt::value_type_t<input_value_type>;
+
+    public:
+        constexpr ApplyCompiledMaskOutside(
+            const input_type& input,
+            const output_type& output,
+            const rows_type& rows,
+            index_type height,
+            scalar_type outside_value
+        ) :
+            m_input(input),
+            m_output(output),
+            m_rows(rows),
+            m_height(height),
+            m_outside_value(outside_value) {}
+
+        template<nt::same_as<index_type>... I> requires (N == sizeof...(I))
+        NOA_HD constexpr void operator()(index_type batch, I... indices) const {
+            const auto indices_nd = Vec<index_type, N>::from_values(indices...);
+            index_type row_index = indices_nd[N - 2];
+            if constexpr (N == 3)
+                row_index += indices_nd[0] * m_height;
+
+            const auto& row = m_rows[row_index];
+            const auto w = static_cast<i64>(indices_nd[N - 1]);
+            if (w >= row[0] and w < row[1])
+                return;
+            m_output(batch, indices...) = static_cast<output_value_type>(m_input(batch, indices...) * m_outside_value);
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        rows_type m_rows;
+        index_type m_height;
+        scalar_type m_outside_value;
+    };
 }
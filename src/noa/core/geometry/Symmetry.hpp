@@ -1,9 +1,12 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include "noa/core/Config.hpp"
+#include "noa/core/Error.hpp"
 #include "noa/core/Traits.hpp"
+#include "noa/core/types/Pair.hpp"
 #include "noa/core/utils/Strings.hpp"
 #include "noa/core/geometry/Transform.hpp"
 #include "noa/core/types/Mat.hpp"
@@ -59,3 +62,188 @@ namespace noa::geometry::guts {
         }
     }
 }
+
+namespace noa::geometry::guts {
+    /// Returns the number of symmetry operators, including the identity, or 0 if the symmetry is not supported.
+    template<size_t N> requires (N == 2 or N == 3)
+    constexpr auto symmetry_count(const SymmetryCode& code) noexcept -> i64 {
+        switch (code.type) {
+            case 'C': return code.order > 0 ? code.order : 0;
+            case 'D': return N == 3 and code.order > 0 ? code.order * 2 : 0;
+            case 'T': return N == 3 and code.order == 0 ? 12 : 0;
+            case 'O': return N == 3 and code.order == 0 ? 24 : 0;
+            case 'I': return N == 3 and code.order == 0 ? 60 : 0;
+            default: return 0;
+        }
+    }
+
+    /// Sets the 3d rotation matrices of a point group, by generating the group from its generators.
+    /// \param[out] matrices   Rotation matrices, excluding the identity. The group order is matrices.size() + 1.
+    /// \param generators      Rotation matrices generating the group.
+    template<typename T, typename I, StridesTraits S> requires nt::mat33<T>
+    void set_point_group_matrices(Span<T, 1, I, S> matrices, const std::vector<Mat33<f64>>& generators) {
+        using value_t = nt::value_type_t<T>;
+        const auto order = static_cast<size_t>(matrices.ssize() + 1);
+
+        // Breadth-first closure, starting from the identity.
+        std::vector<Mat33<f64>> group{Mat33<f64>::eye(1)};
+        for (size_t i{}; i < group.size(); ++i) {
+            for (const auto& generator: generators) {
+                auto element = generator * group[i];
+                for (size_t r{}; r < 3; ++r) // snap to the exact value, e.g. for 90deg rotations
+                    for (auto& e: element[r])
+                        if (abs(e - round(e)) < 1e-9)
+                            e = round(e);
+
+                bool is_new{true};
+                for (const auto& g: group) {
+                    if (allclose(g, element, 1e-6)) {
+                        is_new = false;
+                        break;
+                    }
+                }
+                if (is_new) {
+                    check(group.size() < order, "The point group has more than {} elements", order);
+                    group.push_back(element);
+                }
+            }
+        }
+        check(group.size() == order, "The point group has {} elements, but expected {}", group.size(), order);
+        for (size_t i = 1; i < order; ++i) // skip the identity
+            matrices[static_cast<I>(i - 1)] = group[i].as<value_t>();
+    }
+
+    /// Sets the 3d rotation matrices for the DX symmetry: CX around Z, and 2-fold axes perpendicular to Z,
+    /// with the first one along X.
+    template<typename T, typename I, StridesTraits S> requires nt::mat33<T>
+    void set_dx_symmetry_matrices(Span<T, 1, I, S> matrices) {
+        const auto order = static_cast<f64>((matrices.ssize() + 1) / 2);
+        set_point_group_matrices(matrices, {rotate_z(Constant<f64>::PI * 2 / order), rotate_x(Constant<f64>::PI)});
+    }
+
+    /// Sets the 3d rotation matrices for the T (tetrahedral) symmetry: 2-fold axes along X, Y and Z,
+    /// and 3-fold axes along the diagonals, e.g. (1,1,1).
+    template<typename T, typename I, StridesTraits S> requires nt::mat33<T>
+    void set_t_symmetry_matrices(Span<T, 1, I, S> matrices) {
+        const auto diagonal = Vec3<f64>::from_value(1 / std::sqrt(3.));
+        set_point_group_matrices(matrices, {
+            rotate_z(Constant<f64>::PI),
+            rotate_x(Constant<f64>::PI),
+            rotate(diagonal, Constant<f64>::PI * 2 / 3),
+        });
+    }
+
+    /// Sets the 3d rotation matrices for the O (octahedral) symmetry: 4-fold axes along X, Y and Z.
+    template<typename T, typename I, StridesTraits S> requires nt::mat33<T>
+    void set_o_symmetry_matrices(Span<T, 1, I, S> matrices) {
+        set_point_group_matrices(matrices, {rotate_z(Constant<f64>::PI / 2), rotate_x(Constant<f64>::PI / 2)});
+    }
+
+    /// Sets the 3d rotation matrices for the I (icosahedral) symmetry: 2-fold axes along X, Y and Z,
+    /// and 5-fold axes in the YZ plane, e.g. along (z=phi,y=1,x=0), i.e. the T symmetry is a subgroup.
+    template<typename T, typename I, StridesTraits S> requires nt::mat33<T>
+    void set_i_symmetry_matrices(Span<T, 1, I, S> matrices) {
+        const f64 phi = (1 + std::sqrt(5.)) / 2;
+        const auto diagonal = Vec3<f64>::from_value(1 / std::sqrt(3.));
+        const auto vertex = Vec3<f64>{phi, 1, 0} / std::sqrt(phi * phi + 1);
+        set_point_group_matrices(matrices, {
+            rotate_z(Constant<f64>::PI),
+            rotate_x(Constant<f64>::PI),
+            rotate(diagonal, Constant<f64>::PI * 2 / 3),
+            rotate(vertex, Constant<f64>::PI * 2 / 5),
+        });
+    }
+
+    /// Sets the {2|3}d rotation matrices of a given symmetry.
+    /// \param[out] matrices Rotation matrices, excluding the identity.
+    ///                      Should have symmetry_count(code) - 1 elements.
+    template<typename T, typename I, StridesTraits S> requires (nt::mat22<T> or nt::mat33<T>)
+    void set_symmetry_matrices(const SymmetryCode& code, Span<T, 1, I, S> matrices) {
+        constexpr size_t N = nt::mat22<T> ? 2 : 3;
+        check(symmetry_count<N>(code) == matrices.ssize() + 1,
+              "{} symmetry is not supported or the number of matrices is invalid", code.to_string());
+        if (code.type == 'C') {
+            set_cx_symmetry_matrices(matrices);
+        } else if constexpr (N == 3) {
+            switch (code.type) {
+                case 'D': return set_dx_symmetry_matrices(matrices);
+                case 'T': return set_t_symmetry_matrices(matrices);
+                case 'O': return set_o_symmetry_matrices(matrices);
+                case 'I': return set_i_symmetry_matrices(matrices);
+                default: panic("{} symmetry is not supported", code.to_string());
+            }
+        }
+    }
+
+    /// Whether the rotation matrix maps the sampling grid onto itself, i.e. it is a signed permutation matrix.
+    template<typename T, size_t N>
+    constexpr bool is_grid_aligned_rotation(const Mat<T, N, N>& matrix) noexcept {
+        for (size_t r{}; r < N; ++r) {
+            i32 count{};
+            for (size_t c{}; c < N; ++c) {
+                const auto value = static_cast<f64>(matrix[r][c]);
+                if (abs(abs(value) - 1) < 1e-5)
+                    ++count;
+                else if (abs(value) > 1e-5)
+                    return false;
+            }
+            if (count != 1)
+                return false;
+        }
+        return true;
+    }
+
+    /// Splits a symmetry group into its grid-aligned subgroup H, i.e. the rotations mapping the sampling grid
+    /// onto itself, and the representatives g of the left cosets gH, such that every rotation of the group
+    /// is a unique product g*h. The identity is implicit and is excluded from the inputs and the outputs.
+    /// \param matrices    Rotation matrices of the symmetry, excluding the identity.
+    /// \return            The matrices of the subgroup, snapped to -1, 0 or 1, and the coset representatives.
+    template<typename T, size_t N>
+    auto split_grid_aligned_symmetry(
+        Span<const Mat<T, N, N>> matrices
+    ) -> Pair<std::vector<Mat<T, N, N>>, std::vector<Mat<T, N, N>>> {
+        using matrix_t = Mat<f64, N, N>;
+        std::vector<matrix_t> group{matrix_t::eye(1)};
+        for (const auto& matrix: matrices)
+            group.push_back(matrix.template as<f64>());
+
+        std::vector<matrix_t> subgroup{matrix_t::eye(1)};
+        for (size_t i = 1; i < group.size(); ++i) {
+            if (is_grid_aligned_rotation(group[i])) {
+                auto snapped = group[i];
+                for (size_t r{}; r < N; ++r)
+                    for (auto& e: snapped[r])
+                        e = round(e);
+                subgroup.push_back(snapped);
+            }
+        }
+
+        const auto find = [&](const matrix_t& matrix) -> size_t {
+            for (size_t i{}; i < group.size(); ++i)
+                if (allclose(group[i], matrix, 1e-4))
+                    return i;
+            return group.size();
+        };
+
+        // Partition the group in left cosets.
+        std::vector<bool> is_covered(group.size(), false);
+        std::vector<Mat<T, N, N>> cosets;
+        for (size_t i{}; i < group.size(); ++i) {
+            if (is_covered[i])
+                continue;
+            if (i > 0)
+                cosets.push_back(group[i].template as<T>());
+            for (const auto& h: subgroup) {
+                const size_t index = find(group[i] * h);
+                check(index < group.size() and not is_covered[index],
+                      "The symmetry matrices do not form a group");
+                is_covered[index] = true;
+            }
+        }
+
+        std::vector<Mat<T, N, N>> subgroup_out;
+        for (size_t i = 1; i < subgroup.size(); ++i)
+            subgroup_out.push_back(subgroup[i].template as<T>());
+        return {std::move(subgroup_out), std::move(cosets)};
+    }
+}
@@ -15,6 +15,7 @@ namespace noa::traits {
         const Vec<f64, 3>& spacing,
         noa::io::Encoding::Type dtype,
         Vec<i64, 2>& offset,
+        Vec<i64, 3>& row_offset,
         bool clamp,
         i32 n_threads,
         std::string_view extension
@@ -22,7 +23,7 @@ namespace noa::traits {
         { t.read_header(file) } -> std::same_as<Tuple<Shape<i64, 4>, Vec<f64, 3>, noa::io::Encoding::Type>>;
         { t.write_header(file, shape, spacing, dtype) } -> std::same_as<void>;
         { t.close() } -> std::same_as<void>;
-        { t.decode(file, span, offset, clamp, n_threads) } -> std::same_as<void>;
+        { t.decode(file, span, row_offset, clamp, n_threads) } -> std::same_as<void>;
         { t.encode(file, span.as_const(), offset, clamp, n_threads) } -> std::same_as<void>;
         { T::is_supported_extension(extension) } noexcept -> std::same_as<bool>;
         { T::required_file_size(shape, dtype) } noexcept -> std::same_as<i64>;
@@ -62,11 +63,13 @@ namespace noa::io {
             // We write the header directly when opening the file, so we have nothing to do here.
         }
 
+        /// The data is read from the bdh_offset, i.e. from a given row of a given slice,
+        /// which allows to read a band of consecutive rows instead of whole slices.
         template<typename T>
         void decode(
             std::FILE* file,
             const Span<T, 4>& output,
-            const Vec<i64, 2>& bd_offset,
+            const Vec<i64, 3>& bdh_offset,
             bool clamp,
             i32 n_threads
         ) {
@@ -77,11 +80,11 @@ namespace noa::io {
             };
             const i64 byte_offset =
                 HEADER_SIZE + m_extended_bytes_nb +
-                encoding.encoded_size(ni::offset_at(m_shape.strides(), bd_offset));
+                encoding.encoded_size(ni::offset_at(m_shape.strides(), bdh_offset));
 
             check(std::fseek(file, byte_offset, SEEK_SET) == 0,
-                  "Failed to seek at bd_offset={} (bytes={}). {}",
-                  bd_offset, byte_offset, std::strerror(errno));
+                  "Failed to seek at bdh_offset={} (bytes={}). {}",
+                  bdh_offset, byte_offset, std::strerror(errno));
             noa::io::decode(file, encoding, output, n_threads);
         }
 
@@ -46,6 +46,41 @@ namespace {
         }
     };
 
+    // Conversions between f16 and f32 of contiguous arrays use the vectorized conversions.
+    // These cannot swap the bytes, nor clamp to the f16 range.
+    template<typename Input, typename Output>
+    constexpr bool is_f16_f32_conversion_ =
+        (std::same_as<Input, f16> and std::same_as<Output, f32>) or
+        (std::same_as<Input, f32> and std::same_as<Output, f16>);
+
+    template<typename Input, typename Output>
+    constexpr bool is_bulk_conversion_(bool clamp, bool swap_endian) {
+        if constexpr (is_f16_f32_conversion_<Input, Output>)
+            return not swap_endian and (not clamp or std::same_as<Output, f32>);
+        return false;
+    }
+
+    template<typename Input, typename Output>
+    void bulk_convert_(const Input* input, Output* output, i64 n_elements) {
+        if constexpr (std::same_as<Input, f16>)
+            half2float(input, output, n_elements);
+        else
+            float2half(input, output, n_elements);
+    }
+
+    template<typename Input, typename Output>
+    void bulk_convert_(const Input* input, Output* output, i64 n_elements, i32 n_threads) {
+        const i64 n_elements_per_thread = divide_up(n_elements, static_cast<i64>(n_threads));
+
+        #pragma omp parallel for num_threads(n_threads)
+        for (i32 i = 0; i < n_threads; ++i) {
+            const i64 offset = i * n_elements_per_thread;
+            const i64 n_elements_to_convert = std::min(n_elements_per_thread, n_elements - offset);
+            if (n_elements_to_convert > 0)
+                bulk_convert_(input + offset, output + offset, n_elements_to_convert);
+        }
+    }
+
     template<typename Output, typename Input>
     void encode_1d_(
         SpanContiguous<const Input, 1> input,
@@ -53,6 +88,10 @@ namespace {
         bool clamp, bool swap_endian, i32 n_threads
     ) {
         auto* ptr = reinterpret_cast<Output*>(output.get());
+        if constexpr (is_f16_f32_conversion_<Input, Output>) {
+            if (is_bulk_conversion_<Input, Output>(clamp, swap_endian))
+                return bulk_convert_(input.get(), ptr, input.ssize(), n_threads);
+        }
         auto encoder = Encoder<Input, Output>{clamp, swap_endian};
 
         #pragma omp parallel for num_threads(n_threads) default(none) shared(input, ptr, encoder)
@@ -106,6 +145,10 @@ namespace {
         bool clamp, bool swap_endian, i32 n_threads
     ) {
         auto* ptr = reinterpret_cast<const Input*>(input.get());
+        if constexpr (is_f16_f32_conversion_<Input, Output>) {
+            if (is_bulk_conversion_<Input, Output>(clamp, swap_endian))
+                return bulk_convert_(ptr, output.get(), output.ssize(), n_threads);
+        }
         auto decoder = Decoder<Input, Output>{clamp, swap_endian};
 
         #pragma omp parallel for num_threads(n_threads) default(none) shared(output, ptr, decoder)
@@ -199,6 +242,7 @@ namespace {
         check(start_offset != -1, "Could not get the current position of the stream, {}", std::strerror(errno));
 
         const bool input_is_contiguous = input.are_contiguous();
+        const bool is_bulk_conversion = input_is_contiguous and is_bulk_conversion_<Input, Output>(clamp, swap_endian);
 
         #pragma omp parallel for num_threads(n_threads)
         for (i64 n_block = 0; n_block < n_blocks; ++n_block) {
@@ -213,7 +257,11 @@ namespace {
             const i64 n_elements_offset = offset / N_BYTES_PER_ELEMENT;
 
             const Input* input_ptr = input.get() + n_elements_offset;
-            for (i64 i = 0; i < n_elements_to_write; ++i) {
+            if constexpr (is_f16_f32_conversion_<Input, Output>) {
+                if (is_bulk_conversion)
+                    bulk_convert_(input_ptr, reinterpret_cast<Output*>(per_thread_buffer), n_elements_to_write);
+            }
+            for (i64 i = 0; i < n_elements_to_write and not is_bulk_conversion; ++i) {
                 if constexpr (std::same_as<Output, u4_encoding>) {
                     u32 l_val = clamp_cast<u32>(noa::round(input_ptr[2 * i]));
                     u32 h_val = clamp_cast<u32>(noa::round(input_ptr[2 * i + 1]));
@@ -270,6 +318,7 @@ namespace {
         check(start_offset != -1, "Could not get the current position of the stream, {}", std::strerror(errno));
 
         const bool output_is_contiguous = output.are_contiguous();
+        const bool is_bulk_conversion = output_is_contiguous and is_bulk_conversion_<Input, Output>(clamp, swap_endian);
 
         #pragma omp parallel for num_threads(n_threads)
         for (i64 n_block = 0; n_block < n_blocks; ++n_block) {
@@ -297,7 +346,11 @@ namespace {
             }
 
             Output* output_ptr = output.get() + n_elements_offset;
-            for (i64 i = 0; i < n_elements_to_read; ++i) {
+            if constexpr (is_f16_f32_conversion_<Input, Output>) {
+                if (is_bulk_conversion)
+                    bulk_convert_(reinterpret_cast<const Input*>(per_thread_buffer), output_ptr, n_elements_to_read);
+            }
+            for (i64 i = 0; i < n_elements_to_read and not is_bulk_conversion; ++i) {
                 if constexpr (std::same_as<Input, u4_encoding>) {
                     constexpr char MASK_4LSB{0b00001111};
                     output_ptr[i * 2] = static_cast<Output>(per_thread_buffer[i] & MASK_4LSB);
@@ -172,7 +172,35 @@ namespace noa::io {
             // Read and decode.
             std::visit([&, this](auto& f) {
                 f.decode(m_file.stream(), output.as_strided(),
-                         parameters.bd_offset, parameters.clamp, parameters.n_threads);
+                         parameters.bd_offset.push_back(0), parameters.clamp, parameters.n_threads);
+            }, m_encoders);
+        }
+
+        /// Reads a band of consecutive rows from a 2d slice of the file.
+        /// \details The output should be a (1,1,n_rows,width) array, where the width matches the file's, and
+        ///          receives the rows [row_offset, row_offset + n_rows) of the slice at parameters.bd_offset.
+        ///          This is useful to only read the part of a (large) image that is needed.
+        template<typename T, StridesTraits S>
+        void read_rows(const Span<T, 4, i64, S>& output, i64 row_offset, Parameters parameters) {
+            check(is_open(), "The file should be open");
+
+            check(noa::all(parameters.bd_offset >= 0) and row_offset >= 0,
+                  "Offsets should be positive, but got bd_offset={} and row_offset={}",
+                  parameters.bd_offset, row_offset);
+
+            check(output.shape()[0] == 1 and output.shape()[1] == 1 and
+                  shape()[0] > parameters.bd_offset[0] and shape()[1] > parameters.bd_offset[1],
+                  "File: {}. Only one 2d slice can be read, got bd_offset={}, output:shape={} and file:shape={}",
+                  path(), parameters.bd_offset, output.shape().filter(0, 1), shape().filter(0, 1));
+
+            check(shape()[2] >= row_offset + output.shape()[2] and shape()[3] == output.shape()[3],
+                  "File: {}. Rows are out of bounds, got row_offset={}, output:shape={} and file:shape={}",
+                  path(), row_offset, output.shape().filter(2, 3), shape().filter(2, 3));
+
+            // Read and decode.
+            std::visit([&, this](auto& f) {
+                f.decode(m_file.stream(), output.as_strided(),
+                         parameters.bd_offset.push_back(row_offset), parameters.clamp, parameters.n_threads);
             }, m_encoders);
         }
 
@@ -190,7 +218,7 @@ namespace noa::io {
             // Read and decode.
             std::visit([&, this](auto& f) {
                 f.decode(m_file.stream(), output.as_strided(),
-                         parameters.bd_offset, parameters.clamp, parameters.n_threads);
+                         parameters.bd_offset.push_back(0), parameters.clamp, parameters.n_threads);
             }, m_encoders);
         }
 
@@ -115,28 +115,62 @@ namespace noa {
     };
 
     /// Poisson distribution.
+    /// \note Small means use the multiplication method (Knuth), which draws mean+1 values on average.
+    ///       Larger means use the transformed rejection method with squeeze (PTRS, Hörmann 1993),
+    ///       which draws about two values per sample, regardless of the mean.
     template<nt::integer T>
     class Poisson {
     public:
         using value_type = T;
         using compute_type = f64;
 
-        constexpr explicit Poisson(T mean) noexcept :
-            m_mean(static_cast<compute_type>(mean)), m_threshold(std::exp(-m_mean)) {}
-
-        constexpr auto next(auto& generator) noexcept -> compute_type {
-            T x = 0;
-            compute_type prod = 1.0;
-            do {
-                prod *= generator.template next<compute_type>();
-                x += 1;
-            } while (prod > m_threshold);
-            return static_cast<value_type>(x - 1);
+        constexpr explicit Poisson(compute_type mean) noexcept : m_mean(mean) {
+            if (m_mean < PTRS_THRESHOLD) {
+                m_threshold = std::exp(-m_mean);
+            } else {
+                m_log_mean = std::log(m_mean);
+                m_b = 0.931 + 2.53 * std::sqrt(m_mean);
+                m_a = -0.059 + 0.02483 * m_b;
+                m_inv_alpha = 1.1239 + 1.1328 / (m_b - 3.4);
+                m_vr = 0.9277 - 3.6224 / (m_b - 2);
+            }
+        }
+
+        constexpr auto operator()(auto& generator) const noexcept -> value_type {
+            if (m_mean < PTRS_THRESHOLD) {
+                compute_type x{};
+                compute_type prod{1};
+                do {
+                    prod *= generator.template next<compute_type>();
+                    x += 1;
+                } while (prod > m_threshold);
+                return static_cast<value_type>(x - 1);
+            }
+
+            while (true) {
+                const compute_type u = generator.template next<compute_type>() - 0.5;
+                const compute_type v = generator.template next<compute_type>();
+                const compute_type us = 0.5 - abs(u);
+                const compute_type k = floor((2 * m_a / us + m_b) * u + m_mean + 0.43);
+                if (us >= 0.07 and v <= m_vr)
+                    return static_cast<value_type>(k);
+                if (k < 0 or (us < 0.013 and v > us))
+                    continue;
+                if (log(v) + log(m_inv_alpha) - log(m_a / (us * us) + m_b) <=
+                    -m_mean + k * m_log_mean - lgamma(k + 1))
+                    return static_cast<value_type>(k);
+            }
         }
 
     private:
+        static constexpr compute_type PTRS_THRESHOLD = 10;
         compute_type m_mean;
-        compute_type m_threshold;
+        compute_type m_threshold{};
+        compute_type m_log_mean{};
+        compute_type m_a{};
+        compute_type m_b{};
+        compute_type m_inv_alpha{};
+        compute_type m_vr{};
     };
 }
 
@@ -265,6 +299,117 @@ namespace noa {
         u64 random_seed{};
     };
 
+    /// Philox4x32-10 counter-based pseudorandom number generator.
+    /// \details The bits are a function of the key (the seed) and the counter (e.g. the index of an element),
+    ///          so that each element can have its own independent stream of values, without any state shared
+    ///          between threads. Each round of the generator outputs 128 bits, i.e. four 32-bit or two 64-bit values,
+    ///          which are consumed before incrementing the sub-stream counter.
+    /// \note See Salmon et al., 2011, "Parallel random numbers: as easy as 1, 2, 3".
+    class CounterBasedRandomBitsGenerator {
+    public:
+        constexpr CounterBasedRandomBitsGenerator() = default;
+
+        NOA_HD constexpr explicit CounterBasedRandomBitsGenerator(u64 seed, u64 counter = 0) noexcept :
+            m_key{static_cast<u32>(seed), static_cast<u32>(seed >> 32)},
+            m_counter{static_cast<u32>(counter), static_cast<u32>(counter >> 32), 0, 0} {}
+
+        constexpr auto operator()() -> u64 {
+            return next_u64_();
+        }
+
+        template<typename T>
+        NOA_HD constexpr auto next() noexcept {
+            if constexpr (std::is_same_v<T, u16>) {
+                return static_cast<u16>(next_u32_() >> 16);
+            } else if constexpr (std::is_same_v<T, u32>) {
+                return next_u32_();
+            } else if constexpr (std::is_same_v<T, u64>) {
+                return next_u64_();
+            } else if constexpr (std::is_same_v<T, f32>) {
+                // Fill the mantissa with random bits and normalise in range [0,1)
+                return static_cast<f32>(next_u32_() >> 8) / static_cast<f32>(1ul << 24);
+            } else if constexpr (std::is_same_v<T, f64>) {
+                // Fill the mantissa with random bits and normalise in range [0,1)
+                return static_cast<f64>(next_u64_() >> 11) / static_cast<f64>(1ul << 53);
+            } else {
+                static_assert(nt::always_false<T>);
+            }
+        }
+
+        /// Computes the 128 bits of a given key and counter.
+        NOA_HD static constexpr void philox(const u32 (&key)[2], const u32 (&counter)[4], u32 (&output)[4]) noexcept {
+            constexpr u32 M0 = 0xD2511F53;
+            constexpr u32 M1 = 0xCD9E8D57;
+            constexpr u32 W0 = 0x9E3779B9;
+            constexpr u32 W1 = 0xBB67AE85;
+
+            u32 k0 = key[0], k1 = key[1];
+            u32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+            for (i32 i{}; i < 10; ++i) {
+                const u64 p0 = static_cast<u64>(M0) * c0;
+                const u64 p1 = static_cast<u64>(M1) * c2;
+                const u32 r0 = static_cast<u32>(p1 >> 32) ^ c1 ^ k0;
+                const u32 r2 = static_cast<u32>(p0 >> 32) ^ c3 ^ k1;
+                c0 = r0;
+                c1 = static_cast<u32>(p1);
+                c2 = r2;
+                c3 = static_cast<u32>(p0);
+                k0 += W0;
+                k1 += W1;
+            }
+            output[0] = c0;
+            output[1] = c1;
+            output[2] = c2;
+            output[3] = c3;
+        }
+
+        NOA_HD static constexpr auto min() noexcept -> u64 { return 0; }
+        NOA_HD static constexpr auto max() noexcept -> u64 { return u64(-1); }
+
+    private:
+        NOA_HD constexpr auto next_u32_() noexcept -> u32 {
+            if (m_index == 4) {
+                philox(m_key, m_counter, m_bits);
+                if (++m_counter[2] == 0)
+                    ++m_counter[3];
+                m_index = 0;
+            }
+            return m_bits[m_index++];
+        }
+
+        NOA_HD constexpr auto next_u64_() noexcept -> u64 {
+            const u64 low = next_u32_();
+            const u64 high = next_u32_();
+            return (high << 32) | low;
+        }
+
+    private:
+        u32 m_key[2]{};
+        u32 m_counter[4]{};
+        u32 m_bits[4]{};
+        u32 m_index{4};
+    };
+
+    /// Counter-based randomizer.
+    /// Returns the random value of a given element index. The values only depend on the seed and the index,
+    /// not on the order in which the elements are generated.
+    template<typename Distribution, typename T>
+    struct CounterBasedRandomizer {
+        Distribution distribution;
+        u64 seed{};
+
+        NOA_HD constexpr auto operator()(nt::integer auto index) const noexcept -> T {
+            // Each element starts from a copy of the distribution, in case it holds a state (e.g. Normal).
+            auto generator = CounterBasedRandomBitsGenerator(seed, static_cast<u64>(index));
+            auto element_distribution = distribution;
+            if constexpr (nt::complex<T> and not nt::complex<nt::value_type_t<Distribution>>) {
+                return T{static_cast<T::value_type>(element_distribution(generator))};
+            } else {
+                return static_cast<T>(element_distribution(generator));
+            }
+        }
+    };
+
     /// Returns a random value generator.
     /// Use the call operator to get a value.
     template<nt::distribution T>
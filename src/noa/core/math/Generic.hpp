@@ -86,6 +86,9 @@ namespace noa {
     [[nodiscard]] NOA_FHD auto log1p(double x) noexcept -> double { return std::log1p(x); }
     [[nodiscard]] NOA_FHD auto log1p(float x) noexcept -> float { return std::log1p(x); }
 
+    [[nodiscard]] NOA_FHD auto lgamma(double x) noexcept -> double { return std::lgamma(x); }
+    [[nodiscard]] NOA_FHD auto lgamma(float x) noexcept -> float { return std::lgamma(x); }
+
     [[nodiscard]] NOA_FHD auto hypot(double x, double y) noexcept -> double { return std::hypot(x, y); }
     [[nodiscard]] NOA_FHD auto hypot(float x, float y) noexcept -> float { return std::hypot(x, y); }
 
@@ -0,0 +1,109 @@
+#include "noa/core/types/Half.hpp"
+
+// The vectorized conversions are compiled for their instruction set, regardless of the target of the library,
+// and the version to use is selected at runtime, the first time the conversion is called.
+#if defined(__x86_64__) && (defined(NOA_COMPILER_GCC) || defined(NOA_COMPILER_CLANG))
+#define NOA_HALF_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+namespace {
+    using namespace ::noa::types;
+
+    void half2float_scalar_(const f16* input, f32* output, i64 n_elements) noexcept {
+        for (i64 i{}; i < n_elements; ++i)
+            output[i] = static_cast<f32>(input[i]);
+    }
+
+    void float2half_scalar_(const f32* input, f16* output, i64 n_elements) noexcept {
+        for (i64 i{}; i < n_elements; ++i)
+            output[i] = static_cast<f16>(input[i]);
+    }
+
+    #ifdef NOA_HALF_X86_DISPATCH
+    __attribute__((target("avx,f16c")))
+    void half2float_f16c_(const f16* input, f32* output, i64 n_elements) noexcept {
+        i64 i{};
+        for (; i + 8 <= n_elements; i += 8) {
+            const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+            _mm256_storeu_ps(output + i, _mm256_cvtph_ps(h));
+        }
+        half2float_scalar_(input + i, output + i, n_elements - i);
+    }
+
+    __attribute__((target("avx,f16c")))
+    void float2half_f16c_(const f32* input, f16* output, i64 n_elements) noexcept {
+        i64 i{};
+        for (; i + 8 <= n_elements; i += 8) {
+            const __m256 f = _mm256_loadu_ps(input + i);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm256_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT));
+        }
+        float2half_scalar_(input + i, output + i, n_elements - i);
+    }
+
+    __attribute__((target("avx512f")))
+    void half2float_avx512_(const f16* input, f32* output, i64 n_elements) noexcept {
+        i64 i{};
+        for (; i + 16 <= n_elements; i += 16) {
+            const __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+            _mm512_storeu_ps(output + i, _mm512_cvtph_ps(h));
+        }
+        half2float_f16c_(input + i, output + i, n_elements - i);
+    }
+
+    __attribute__((target("avx512f")))
+    void float2half_avx512_(const f32* input, f16* output, i64 n_elements) noexcept {
+        i64 i{};
+        for (; i + 16 <= n_elements; i += 16) {
+            const __m512 f = _mm512_loadu_ps(input + i);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                                _mm512_cvtps_ph(f, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));
+        }
+        float2half_f16c_(input + i, output + i, n_elements - i);
+    }
+    #endif
+
+    enum class HalfConversionPath { SCALAR, F16C, AVX512 };
+
+    auto half_conversion_path_() noexcept -> HalfConversionPath {
+        #ifdef NOA_HALF_X86_DISPATCH
+        __builtin_cpu_init();
+        // AVX-512F implies F16C, which is used for the remaining elements.
+        if (__builtin_cpu_supports("avx512f"))
+            return HalfConversionPath::AVX512;
+        if (__builtin_cpu_supports("avx") and __builtin_cpu_supports("f16c"))
+            return HalfConversionPath::F16C;
+        #endif
+        return HalfConversionPath::SCALAR;
+    }
+}
+
+namespace noa {
+    void half2float(const Half* input, f32* output, i64 n_elements) noexcept {
+        using function_t = void(*)(const f16*, f32*, i64) noexcept;
+        static const function_t function = []() -> function_t {
+            switch (half_conversion_path_()) {
+                #ifdef NOA_HALF_X86_DISPATCH
+                case HalfConversionPath::AVX512: return half2float_avx512_;
+                case HalfConversionPath::F16C: return half2float_f16c_;
+                #endif
+                default: return half2float_scalar_;
+            }
+        }();
+        function(input, output, n_elements);
+    }
+
+    void float2half(const f32* input, Half* output, i64 n_elements) noexcept {
+        using function_t = void(*)(const f32*, f16*, i64) noexcept;
+        static const function_t function = []() -> function_t {
+            switch (half_conversion_path_()) {
+                #ifdef NOA_HALF_X86_DISPATCH
+                case HalfConversionPath::AVX512: return float2half_avx512_;
+                case HalfConversionPath::F16C: return float2half_f16c_;
+                #endif
+                default: return float2half_scalar_;
+            }
+        }();
+        function(input, output, n_elements);
+    }
+}
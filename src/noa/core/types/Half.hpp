@@ -37,6 +37,14 @@
 #include <half/half.hpp>
 #endif
 
+// When compiled for F16C (see NOA_ENABLE_F16C), the scalar conversions between float and half use the
+// hardware instructions.
+// The bulk conversions (see half2float and float2half) detect these instructions at runtime.
+#if defined(__F16C__) && !defined(__CUDA_ARCH__)
+#include <bit>
+#include <immintrin.h>
+#endif
+
 #if defined(NOA_COMPILER_GCC) || defined(NOA_COMPILER_CLANG)
 #pragma GCC diagnostic pop
 #elif defined(NOA_COMPILER_MSVC)
@@ -165,6 +173,14 @@ namespace noa::inline types {
             if constexpr (std::is_same_v<T, U>) {
                 return value;
             } else if constexpr (std::is_same_v<T, native_type> or std::is_same_v<U, native_type>) {
+                #if defined(__F16C__)
+                if (not std::is_constant_evaluated()) {
+                    if constexpr (std::is_same_v<T, float>)
+                        return _cvtsh_ss(std::bit_cast<uint16_t>(value));
+                    else if constexpr (std::is_same_v<U, float>)
+                        return half_float::reinterpret_as_half(_cvtss_sh(value, _MM_FROUND_TO_NEAREST_INT));
+                }
+                #endif
                 // half_float::half_cast has a bug in int2half for the min value so check it beforehand.
                 if constexpr (std::is_integral_v<U> and std::is_signed_v<U>) {
                     if (value == std::numeric_limits<U>::min()) {
@@ -387,6 +403,17 @@ namespace noa::inline types {
     static_assert(alignof(f16) == 2);
 }
 
+namespace noa {
+    /// Converts contiguous f16 values to f32, or f32 values to f16.
+    /// \details On x86-64, the values are converted by blocks of 16 (AVX-512F) or 8 (F16C) elements, if these
+    ///          instructions are supported by the CPU. This is detected at runtime, so the library doesn't need to be
+    ///          compiled for these instruction sets. Otherwise, the values are converted one at a time.
+    /// \note These are equivalent to static_cast, i.e. f32 values are rounded to the nearest f16 value (ties to
+    ///       even), and values outside the f16 range are converted to infinity.
+    void half2float(const Half* input, f32* output, i64 n_elements) noexcept;
+    void float2half(const f32* input, Half* output, i64 n_elements) noexcept;
+}
+
 namespace noa {
     template<>
     struct nt::proclaim_is_real<Half> : std::true_type {};
@@ -24,6 +24,8 @@ set(NOA_CPU_HEADERS
 
     # noa::cpu::signal
     cpu/signal/Convolve.hpp
+    cpu/signal/ConvolveFFT.hpp
+    cpu/signal/ConvolveSeparable.hpp
     cpu/signal/MedianFilter.hpp
     )
 
@@ -17,6 +17,95 @@
 #include "noa/core/indexing/Layout.hpp"
 #include "noa/cpu/Blas.hpp"
 
+namespace {
+    using namespace ::noa::types;
+
+    #if defined(NOA_COMPILER_GCC) || defined(NOA_COMPILER_CLANG)
+    #define NOA_BLAS_UNROLL_ _Pragma("GCC unroll 8")
+    #else
+    #define NOA_BLAS_UNROLL_
+    #endif
+
+    // Column-major matrix, optionally transposed.
+    template<typename T, bool TRANSPOSE>
+    struct ColumnMajorMatrix {
+        const T* ptr;
+        i64 ld;
+
+        [[nodiscard]] constexpr auto operator()(i64 row, i64 col) const -> const T& {
+            if constexpr (TRANSPOSE)
+                return ptr[col + row * ld];
+            else
+                return ptr[row + col * ld];
+        }
+    };
+
+    // Single-threaded product of small column-major matrices.
+    // If M, N and K are non-zero, the sizes are compile-time constants and the loops are fully unrolled.
+    template<i64 M, i64 N, i64 K, bool LHS_TRANSPOSE, bool RHS_TRANSPOSE, typename T>
+    void matmul_small(
+        const T* lhs, i64 lda, const T* rhs, i64 ldb, T* output, i64 ldc,
+        i64 m, i64 n, i64 k, T alpha, T beta
+    ) {
+        if constexpr (M > 0) {
+            m = M;
+            n = N;
+            k = K;
+        }
+        const auto a = ColumnMajorMatrix<T, LHS_TRANSPOSE>{lhs, lda};
+        const auto b = ColumnMajorMatrix<T, RHS_TRANSPOSE>{rhs, ldb};
+
+        NOA_BLAS_UNROLL_
+        for (i64 j = 0; j < n; ++j) {
+            NOA_BLAS_UNROLL_
+            for (i64 i = 0; i < m; ++i) {
+                T sum{};
+                NOA_BLAS_UNROLL_
+                for (i64 p = 0; p < k; ++p)
+                    sum += a(i, p) * b(p, j);
+                T& c = output[i + j * ldc];
+                c = beta == T{} ? alpha * sum : alpha * sum + beta * c; // don't read the output if beta=0
+            }
+        }
+    }
+
+    template<typename T>
+    using matmul_small_t = void(*)(const T*, i64, const T*, i64, T*, i64, i64, i64, i64, T, T);
+
+    // Selects the kernel for the given sizes. The square matrix-matrix and matrix-vector products,
+    // e.g. the chains of affine transforms, have a dedicated kernel.
+    template<bool LHS_TRANSPOSE, bool RHS_TRANSPOSE, typename T>
+    auto matmul_small_kernel(i64 m, i64 n, i64 k) -> matmul_small_t<T> {
+        matmul_small_t<T> kernel = matmul_small<0, 0, 0, LHS_TRANSPOSE, RHS_TRANSPOSE, T>;
+        if (m != k)
+            return kernel;
+
+        [&]<i64... S>(std::integer_sequence<i64, S...>) {
+            auto select = [&]<i64 SIZE>() {
+                if (m != SIZE)
+                    return;
+                if (n == SIZE)
+                    kernel = matmul_small<SIZE, SIZE, SIZE, LHS_TRANSPOSE, RHS_TRANSPOSE, T>;
+                else if (n == 1)
+                    kernel = matmul_small<SIZE, 1, SIZE, LHS_TRANSPOSE, RHS_TRANSPOSE, T>;
+            };
+            (select.template operator()<S + 2>(), ...);
+        }(std::make_integer_sequence<i64, 7>{}); // 2 to 8
+        return kernel;
+    }
+
+    template<typename T>
+    auto matmul_small_kernel(bool lhs_transpose, bool rhs_transpose, i64 m, i64 n, i64 k) -> matmul_small_t<T> {
+        if (lhs_transpose and rhs_transpose)
+            return matmul_small_kernel<true, true, T>(m, n, k);
+        if (lhs_transpose)
+            return matmul_small_kernel<true, false, T>(m, n, k);
+        if (rhs_transpose)
+            return matmul_small_kernel<false, true, T>(m, n, k);
+        return matmul_small_kernel<false, false, T>(m, n, k);
+    }
+}
+
 namespace noa::cpu {
     template<typename T>
     void matmul(
@@ -40,6 +129,25 @@ namespace noa::cpu {
             std::swap(sabc[0], sabc[1]);
         }
 
+        // Batches of small matrices are dominated by the per-matrix overhead, so they are distributed
+        // across threads, and each matrix is computed by one thread. Large matrices are threaded by Eigen.
+        const i64 n_batches = output_shape[0];
+        const i64 max_size = max(mnk.vec);
+        const bool is_batched = max_size <= MATMUL_BATCHED_MAX_SIZE and n_batches > 1;
+        const i64 n_threads_batched = min(n_threads, n_batches);
+
+        if (max_size <= MATMUL_SMALL_MAX_SIZE) {
+            const auto kernel = matmul_small_kernel<T>(lhs_transpose, rhs_transpose, mnk[0], mnk[1], mnk[2]);
+            #pragma omp parallel for num_threads(n_threads_batched) if(n_batches * max_size > 1024)
+            for (i64 batch = 0; batch < n_batches; ++batch) {
+                kernel(lhs + sabc[0] * batch, labc[0],
+                       rhs + sabc[1] * batch, labc[1],
+                       output + sabc[2] * batch, labc[2],
+                       mnk[0], mnk[1], mnk[2], alpha, beta);
+            }
+            return;
+        }
+
         // Eigen doesn't support our complex types, but they have the same layout and alignment so reinterpret.
         using std_complex_t = std::complex<nt::value_type_t<T>>;
         using value_t = std::conditional_t<nt::complex<T>, std_complex_t, T>;
@@ -63,11 +171,16 @@ namespace noa::cpu {
         using imap_t = Eigen::Map<const matrix_t, Eigen::Unaligned, strides_t>;
         using omap_t = Eigen::Map<matrix_t, Eigen::Unaligned, strides_t>;
 
-        Eigen::setNbThreads(static_cast<int>(n_threads));
-
-        for (i64 batch = 0; batch < output_shape[0]; ++batch) {
-            imap_t lhs_matrix(lhs_ + sabc[0] * batch, mnk[0], mnk[2], strides_t(labc[0], 1));
-            imap_t rhs_matrix(rhs_ + sabc[1] * batch, mnk[2], mnk[1], strides_t(labc[1], 1));
+        auto matmul_batch = [&](i64 batch) {
+            // The transposed matrices are mapped as stored, i.e. KxM and NxK.
+            imap_t lhs_matrix(lhs_ + sabc[0] * batch,
+                              lhs_transpose ? mnk[2] : mnk[0],
+                              lhs_transpose ? mnk[0] : mnk[2],
+                              strides_t(labc[0], 1));
+            imap_t rhs_matrix(rhs_ + sabc[1] * batch,
+                              rhs_transpose ? mnk[1] : mnk[2],
+                              rhs_transpose ? mnk[2] : mnk[1],
+                              strides_t(labc[1], 1));
             omap_t out_matrix(out_ + sabc[2] * batch, mnk[0], mnk[1], strides_t(labc[2], 1));
 
             // FIXME Is there a better way to do this?
@@ -91,6 +204,17 @@ namespace noa::cpu {
                 else
                     out_matrix.noalias() += (lhs_matrix * rhs_matrix) * alpha_;
             }
+        };
+
+        if (is_batched) {
+            Eigen::setNbThreads(1);
+            #pragma omp parallel for num_threads(n_threads_batched)
+            for (i64 batch = 0; batch < n_batches; ++batch)
+                matmul_batch(batch);
+        } else {
+            Eigen::setNbThreads(static_cast<int>(n_threads));
+            for (i64 batch = 0; batch < n_batches; ++batch)
+                matmul_batch(batch);
         }
     }
 
@@ -108,6 +232,8 @@ namespace noa::cpu {
     INSTANTIATE_GEMM_(c64);
 }
 
+#undef NOA_BLAS_UNROLL_
+
 #if defined(NOA_COMPILER_GCC) || defined(NOA_COMPILER_CLANG)
     #pragma GCC diagnostic pop
 #elif defined(NOA_COMPILER_MSVC)
@@ -3,6 +3,14 @@
 #include "noa/core/types/Shape.hpp"
 
 namespace noa::cpu {
+    // Matrices with all their dimensions up to this size are computed with a scalar kernel,
+    // whose loops are unrolled at compile time for square matrices and matrix-vector products.
+    inline constexpr i64 MATMUL_SMALL_MAX_SIZE = 8;
+
+    // Batches of matrices with all their dimensions up to this size are distributed across threads,
+    // one matrix per thread. Larger matrices are computed one after the other, each using every thread.
+    inline constexpr i64 MATMUL_BATCHED_MAX_SIZE = 128;
+
     // Computes a scalar-matrix-matrix product and add the result to a scalar-matrix product, with general matrices.
     template<typename T>// requires nt::is_any_v<T, f32, f64, c32, c64>
     void matmul(const T* lhs, const Strides4<i64>& lhs_strides, const Shape4<i64>& lhs_shape,
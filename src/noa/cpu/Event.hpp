@@ -1,43 +1,88 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
 #include "noa/core/Error.hpp"
 #include "noa/cpu/Stream.hpp"
 
+namespace noa::cpu::guts {
+    // State of an event, shared with the tasks completing it and waiting on it.
+    struct EventState {
+        // Index of the last record and of the last completed record. Records are numbered from 1.
+        std::atomic<u64> n_recorded{0};
+        std::atomic<u64> n_completed{0};
+        std::chrono::time_point<std::chrono::steady_clock> time;
+        std::mutex mutex;
+
+        // Blocks until the given record is completed.
+        void wait(u64 record) const {
+            u64 completed = n_completed.load(std::memory_order_acquire);
+            while (completed < record) {
+                n_completed.wait(completed, std::memory_order_acquire);
+                completed = n_completed.load(std::memory_order_acquire);
+            }
+        }
+
+        // Records can complete out of order, e.g. when the event is recorded in another stream that finishes
+        // first, so the completed record can only move forward.
+        void complete(u64 record) noexcept {
+            {
+                const std::scoped_lock lock(mutex);
+                if (record <= n_completed.load(std::memory_order_relaxed))
+                    return;
+                time = std::chrono::steady_clock::now();
+                n_completed.store(record, std::memory_order_release);
+            }
+            n_completed.notify_all();
+        }
+    };
+}
+
 namespace noa::cpu {
     // Simple event that can be enqueued in streams.
-    // Elapsed time can be measured between events.
+    // Streams can wait on events recorded in other streams, and elapsed time can be measured between events.
     class Event {
     public:
-        Event() = default;
+        Event() : m_state(std::make_shared<guts::EventState>()) {}
 
-        // Waits ("busy sleep") until the completion of the event.
+        // Waits until the completion of the event. The current thread sleeps until the event is completed.
         void synchronize() const {
-            while (m_event.load(std::memory_order_acquire) != Status::COMPLETED)
-                std::this_thread::yield();
+            m_state->wait(n_recorded_());
         }
 
         // Whether the event is completed.
         [[nodiscard]] auto is_busy() const -> bool {
-            return m_event.load(std::memory_order_acquire) == Status::COMPLETED;
+            const u64 n_recorded = n_recorded_();
+            return n_recorded > 0 and m_state->n_completed.load(std::memory_order_acquire) >= n_recorded;
         }
 
         // Records (enqueue) the event into a stream.
-        void record(Stream& stream) {
-            m_event.store(QUEUED, std::memory_order_release);
-            stream.enqueue(
-                [this]() noexcept {
-                    this->m_event.store(COMPLETED);
-                    this->m_time = std::chrono::steady_clock::now();
+        // The event is completed once the tasks enqueued before this call are completed, even if they failed.
+        // If the stream is capturing, the record is only made when the captured marker runs, i.e. each time
+        // the graph is launched, so the capture doesn't leave the event waiting on a graph that may never run.
+        void record(const Stream& stream) {
+            if (stream.is_capturing()) {
+                stream.enqueue_marker([state = m_state]() noexcept {
+                    state->complete(state->n_recorded.fetch_add(1, std::memory_order_acq_rel) + 1);
                 });
+            } else {
+                const u64 record = m_state->n_recorded.fetch_add(1, std::memory_order_acq_rel) + 1;
+                stream.enqueue_marker([state = m_state, record]() noexcept {
+                    state->complete(record);
+                });
+            }
         }
 
         // Computes the elapsed time between completed events.
         static auto elapsed(const Event& start, const Event& end) {
-            const Status status_start = start.m_event.load(std::memory_order_acquire);
-            const Status status_end = end.m_event.load(std::memory_order_acquire);
+            const Status status_start = start.status_();
+            const Status status_end = end.status_();
 
             if (status_start == COMPLETED and status_end == COMPLETED) {
-                std::chrono::duration<f64, std::milli> diff = end.m_time - start.m_time;
+                std::chrono::duration<f64, std::milli> diff = end.m_state->time - start.m_state->time;
                 return diff;
             } else if (status_start == QUEUED or status_end == QUEUED) {
                 panic("At least one event has not been completed");
@@ -53,12 +98,32 @@ namespace noa::cpu {
         Event& operator=(Event&&) = delete;
 
     private:
+        friend class Stream;
+
         enum class Status : i32 {
             CREATED, QUEUED, COMPLETED
         };
         using enum Status;
 
-        std::atomic<Status> m_event{CREATED};
-        std::chrono::time_point<std::chrono::steady_clock> m_time;
+        [[nodiscard]] auto n_recorded_() const -> u64 {
+            return m_state->n_recorded.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] auto status_() const -> Status {
+            const u64 n_recorded = n_recorded_();
+            if (n_recorded == 0)
+                return CREATED;
+            return m_state->n_completed.load(std::memory_order_acquire) >= n_recorded ? COMPLETED : QUEUED;
+        }
+
+        std::shared_ptr<guts::EventState> m_state;
     };
+
+    inline void Stream::wait(const Event& event) const {
+        if (event.status_() != Event::QUEUED)
+            return; // nothing to wait for
+        m_core->worker.enqueue([state = event.m_state, record = event.n_recorded_()] {
+            state->wait(record);
+        });
+    }
 }
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <omp.h>
+#include "noa/core/Ewise.hpp"
 #include "noa/core/Interfaces.hpp"
+#include "noa/core/types/Half.hpp"
 #include "noa/core/types/Shape.hpp"
 #include "noa/core/indexing/Layout.hpp"
 #include "noa/core/types/Accessor.hpp"
@@ -65,6 +67,47 @@ namespace noa::cpu::guts {
     };
 }
 
+namespace noa::cpu::guts {
+    /// Whether the operator casts f16 to f32, or f32 to f16.
+    /// For contiguous arrays, these casts use the vectorized conversions (see noa::half2float).
+    template<typename Op, typename Input, typename Output>
+    consteval bool is_f16_f32_cast() {
+        using input_t = std::decay_t<Input>;
+        using output_t = std::decay_t<Output>;
+        if constexpr (std::same_as<std::decay_t<Op>, Cast> and requires {
+            requires std::tuple_size<input_t>::value == 1 and std::tuple_size<output_t>::value == 1;
+        }) {
+            using input_value_t = nt::mutable_value_type_t<std::tuple_element_t<0, input_t>>;
+            using output_value_t = nt::value_type_t<std::tuple_element_t<0, output_t>>;
+            return (std::same_as<input_value_t, f16> and std::same_as<output_value_t, f32>) or
+                   (std::same_as<input_value_t, f32> and std::same_as<output_value_t, f16>);
+        }
+        return false;
+    }
+
+    template<typename T, typename U>
+    void cast_f16_f32(const T* input, U* output, i64 n_elements, i64 n_threads) {
+        auto convert = [](const T* src, U* dst, i64 n) {
+            if constexpr (std::same_as<T, f16>)
+                half2float(src, dst, n);
+            else
+                float2half(src, dst, n);
+        };
+        if (n_threads <= 1)
+            return convert(input, output, n_elements);
+
+        const i64 n_elements_per_thread = divide_up(n_elements, n_threads);
+        #pragma omp parallel for num_threads(n_threads) default(none) \
+            shared(input, output, n_elements, n_elements_per_thread, n_threads, convert)
+        for (i64 i = 0; i < n_threads; ++i) {
+            const i64 offset = i * n_elements_per_thread;
+            const i64 n_elements_to_convert = min(n_elements_per_thread, n_elements - offset);
+            if (n_elements_to_convert > 0)
+                convert(input + offset, output + offset, n_elements_to_convert);
+        }
+    }
+}
+
 namespace noa::cpu {
     template<bool ZipInput = false, bool ZipOutput = false, i64 ElementsPerThread = 1'048'576>
     struct EwiseConfig {
@@ -97,6 +140,15 @@ namespace noa::cpu {
 
         using ewise_t = guts::Ewise<Config::zip_input, Config::zip_output>;
 
+        if constexpr (guts::is_f16_f32_cast<Op, Input, Output>()) {
+            // The vectorized conversions don't clamp to the f16 range.
+            using output_value_t = nt::value_type_t<std::tuple_element_t<0, std::decay_t<Output>>>;
+            if (are_all_contiguous and (not op.clamp or std::same_as<output_value_t, f32>)) {
+                return guts::cast_f16_f32(
+                    input[Tag<0>{}].get(), output[Tag<0>{}].get(), elements, actual_n_threads);
+            }
+        }
+
         if (are_all_contiguous) {
             auto shape_1d = Shape1<Index>{shape.n_elements()};
             if (not nt::enable_vectorization_v<Op> and ng::are_accessors_aliased(input, output)) {
@@ -1,38 +1,223 @@
 #pragma once
 
+#include <omp.h>
 #include <algorithm>
 #include "noa/core/indexing/Layout.hpp"
+#include "noa/core/indexing/Offset.hpp"
 #include "noa/core/math/Generic.hpp"
+#include "noa/core/types/Pair.hpp"
 #include "noa/core/types/Shape.hpp"
 #include "noa/cpu/AllocatorHeap.hpp"
+#include "noa/cpu/Copy.hpp"
+#include "noa/cpu/Sort.hpp"
+
+// Quantiles use the linear interpolation of numpy (method="linear"): the quantile q of n values is the value at
+// the (fractional) rank q * (n - 1) of the sorted values. The median is the 0.5 quantile.
+//
+// Integers are selected with a radix select: the values are compared using their radix representation (see
+// guts::sort::to_radix), 8 bits at a time, starting from the most significant bits. Each pass only counts the
+// values matching the bits selected so far, so the input is read as is, without being copied or modified.
+// Other types are partially sorted (std::nth_element), either in-place or in a buffer.
+
+namespace noa::cpu::guts {
+    struct QuantileConfig {
+        static constexpr i64 n_elements_per_thread = 1'048'576;
+    };
+
+    /// Returns the rank of the quantile in n sorted values, and the interpolation weight with the next rank.
+    inline auto quantile_rank(i64 n, f64 quantile) -> Pair<i64, f64> {
+        const f64 position = clamp(quantile, 0., 1.) * static_cast<f64>(n - 1);
+        const f64 rank = floor(position);
+        return {static_cast<i64>(rank), position - rank};
+    }
+
+    /// Returns the k-th smallest value of a strided range.
+    template<nt::integer T> requires (not nt::boolean<T>)
+    auto radix_select(const T* input, i64 stride, i64 n, i64 k) -> T {
+        using radix_t = sort::radix_t<T>;
+        constexpr i64 N_BUCKETS = sort::SortConfig::n_buckets;
+        constexpr i64 N_BITS = sort::SortConfig::n_bits_per_pass;
+
+        radix_t prefix{};
+        radix_t mask{};
+        i64 histogram[N_BUCKETS];
+        for (i64 shift = static_cast<i64>(sizeof(T)) * 8 - N_BITS; shift >= 0; shift -= N_BITS) {
+            std::fill_n(histogram, N_BUCKETS, i64{});
+            for (i64 i{}; i < n; ++i) {
+                const radix_t bits = sort::to_radix(input[i * stride], true);
+                if ((bits & mask) == prefix)
+                    ++histogram[(bits >> shift) & (N_BUCKETS - 1)];
+            }
+
+            // Find the bucket containing the k-th value.
+            i64 bucket{};
+            for (; bucket < N_BUCKETS - 1 and k >= histogram[bucket]; ++bucket)
+                k -= histogram[bucket];
+
+            prefix = static_cast<radix_t>(prefix | (static_cast<radix_t>(bucket) << shift));
+            mask = static_cast<radix_t>(mask | (static_cast<radix_t>(N_BUCKETS - 1) << shift));
+        }
+        return sort::from_radix<T>(prefix, true);
+    }
+
+    template<typename T, typename U>
+    auto interpolate_quantile(const T& lhs, const T& rhs, f64 weight) -> U {
+        if (weight == 0)
+            return static_cast<U>(lhs);
+        const auto lhs_f64 = static_cast<f64>(lhs);
+        return static_cast<U>(lhs_f64 + (static_cast<f64>(rhs) - lhs_f64) * weight);
+    }
+
+    /// Computes the quantile of a strided range.
+    /// \param[in,out] input    Range of n elements. Integers are never modified. Other types are only modified
+    ///                         if buffer is nullptr, in which case the range should be contiguous.
+    /// \param buffer           Buffer of at least n elements, or nullptr. Ignored for integers.
+    template<typename U, typename T>
+    auto quantile_line(T* input, i64 stride, i64 n, f64 quantile, T* buffer) -> U {
+        const auto [rank, weight] = quantile_rank(n, quantile);
+
+        if constexpr (nt::integer<T> and not nt::boolean<T>) {
+            const T lhs = radix_select(input, stride, n, rank);
+            const T rhs = weight == 0 ? lhs : radix_select(input, stride, n, rank + 1);
+            return interpolate_quantile<T, U>(lhs, rhs, weight);
+        } else {
+            T* data = input;
+            if (buffer) {
+                for (i64 i{}; i < n; ++i)
+                    buffer[i] = input[i * stride];
+                data = buffer;
+            }
+            std::nth_element(data, data + rank, data + n);
+            const T lhs = data[rank];
+            // Everything after the rank is greater or equal, so the next rank is the minimum of that range.
+            const T rhs = weight == 0 ? lhs : *std::min_element(data + rank + 1, data + n);
+            return interpolate_quantile<T, U>(lhs, rhs, weight);
+        }
+    }
+}
 
 namespace noa::cpu {
+    /// If the input is const, the overwrite parameter is ignored and the input is copied into a buffer
+    /// (except for integers, which are never modified).
     template<typename Value>
-    Value median(Value* input, Strides4<i64> strides, Shape4<i64> shape, bool overwrite) {
+    auto quantile(
+        Value* input, Strides4<i64> strides, Shape4<i64> shape, f64 quantile, bool overwrite
+    ) -> std::remove_const_t<Value> {
+        using value_t = std::remove_const_t<Value>;
+
         // Make it in rightmost order.
         const auto order = ni::order(strides, shape);
         strides = ni::reorder(strides, order);
         shape = ni::reorder(shape, order);
 
-        // Allocate buffer only if necessary.
         const auto n_elements = shape.n_elements();
-        Value* to_sort;
-        typename AllocatorHeap<Value>::alloc_unique_type buffer;
-        if (overwrite and ni::are_contiguous(strides, shape)) {
-            to_sort = input;
-        } else {
-            buffer = AllocatorHeap<Value>::allocate(n_elements);
-            copy(input, strides, buffer.get(), shape.strides(), shape, 1);
-            to_sort = buffer.get();
+        if (ni::are_contiguous(strides, shape)) {
+            // Integers are never modified, so there's no need for a buffer.
+            if constexpr (nt::integer<value_t> and not nt::boolean<value_t>) {
+                return guts::quantile_line<value_t>(input, 1, n_elements, quantile, static_cast<Value*>(nullptr));
+            } else if constexpr (not std::is_const_v<Value>) {
+                typename AllocatorHeap<value_t>::alloc_unique_type buffer;
+                if (not overwrite)
+                    buffer = AllocatorHeap<value_t>::allocate(n_elements);
+                return guts::quantile_line<value_t>(input, 1, n_elements, quantile, buffer.get());
+            }
         }
 
-        std::nth_element(to_sort, to_sort + n_elements / 2, to_sort + n_elements);
-        Value half = to_sort[n_elements / 2];
-        if (is_odd(n_elements)) {
-            return half;
+        auto buffer = AllocatorHeap<value_t>::allocate(n_elements);
+        copy(input, strides, buffer.get(), shape.strides(), shape, 1);
+        return guts::quantile_line<value_t>(buffer.get(), 1, n_elements, quantile, static_cast<value_t*>(nullptr));
+    }
+
+    template<typename Value>
+    auto median(Value* input, Strides4<i64> strides, Shape4<i64> shape, bool overwrite) -> std::remove_const_t<Value> {
+        return quantile(input, strides, shape, 0.5, overwrite);
+    }
+
+    /// Reduces the dimensions of the input to compute the quantile of each reduced subregion.
+    /// The reduced dimensions are the ones with a size of 1 in the output, and can be any combination of
+    /// dimensions. Quantiles are computed in parallel across the output elements, each thread using a buffer
+    /// the size of one reduced subregion (integers only need it if the reduced dimensions cannot be collapsed
+    /// into a single strided dimension).
+    template<typename Input, typename Output>
+    void quantile_axes(
+        const Input* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        Output* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        f64 quantile, i64 n_threads
+    ) {
+        // Split the input into the kept and the reduced dimensions.
+        auto reduced_shape = Shape4<i64>::from_value(1);
+        auto reduced_strides = Strides4<i64>{};
+        for (size_t i{}; i < 4; ++i) {
+            if (output_shape[i] == 1 and input_shape[i] > 1) {
+                reduced_shape[i] = input_shape[i];
+                reduced_strides[i] = input_strides[i];
+            }
+        }
+        const i64 n_outputs = output_shape.n_elements();
+        const i64 n_reduced = reduced_shape.n_elements();
+
+        // Collapse the reduced dimensions if possible, so that the subregions can be accessed as a strided line.
+        const auto order = ni::order(reduced_strides, reduced_shape);
+        const auto reduced_shape_ordered = ni::reorder(reduced_shape, order);
+        const auto reduced_strides_ordered = ni::reorder(reduced_strides, order);
+        i64 line_stride{1};
+        bool is_line{true};
+        i64 expected_stride{-1};
+        for (size_t i = 4; i-- > 0;) {
+            if (reduced_shape_ordered[i] == 1)
+                continue;
+            if (expected_stride == -1)
+                line_stride = reduced_strides_ordered[i];
+            else if (reduced_strides_ordered[i] != expected_stride)
+                is_line = false;
+            expected_stride = reduced_strides_ordered[i] * reduced_shape_ordered[i];
+        }
+        const bool use_buffer = not is_line or not (nt::integer<Input> and not nt::boolean<Input>);
+
+        const auto reduce_one = [&](i64 i, i64 j, i64 k, i64 l, Input* buffer) {
+            const Input* subregion = input + ni::offset_at(input_strides, i, j, k, l);
+            if (not is_line) {
+                i64 count{};
+                for (i64 m{}; m < reduced_shape[0]; ++m)
+                    for (i64 n{}; n < reduced_shape[1]; ++n)
+                        for (i64 o{}; o < reduced_shape[2]; ++o)
+                            for (i64 p{}; p < reduced_shape[3]; ++p)
+                                buffer[count++] = subregion[ni::offset_at(reduced_strides, m, n, o, p)];
+                output[ni::offset_at(output_strides, i, j, k, l)] =
+                    guts::quantile_line<Output>(buffer, 1, n_reduced, quantile, static_cast<Input*>(nullptr));
+            } else {
+                // The input is never modified since integers don't use the buffer.
+                output[ni::offset_at(output_strides, i, j, k, l)] = guts::quantile_line<Output>(
+                    const_cast<Input*>(subregion), line_stride, n_reduced, quantile, buffer);
+            }
+        };
+
+        const i64 actual_n_threads = min({n_threads, n_outputs, divide_up(
+            input_shape.n_elements(), guts::QuantileConfig::n_elements_per_thread)});
+        if (actual_n_threads > 1) {
+            #pragma omp parallel num_threads(actual_n_threads) default(none) \
+                shared(output_shape, n_reduced, use_buffer, reduce_one)
+            {
+                typename AllocatorHeap<Input>::alloc_unique_type buffer;
+                if (use_buffer)
+                    buffer = AllocatorHeap<Input>::allocate(n_reduced);
+
+                #pragma omp for collapse(4)
+                for (i64 i = 0; i < output_shape[0]; ++i)
+                    for (i64 j = 0; j < output_shape[1]; ++j)
+                        for (i64 k = 0; k < output_shape[2]; ++k)
+                            for (i64 l = 0; l < output_shape[3]; ++l)
+                                reduce_one(i, j, k, l, buffer.get());
+            }
         } else {
-            std::nth_element(to_sort, to_sort + (n_elements - 1) / 2, to_sort + n_elements);
-            return static_cast<Value>(to_sort[(n_elements - 1) / 2] + half) / Value{2}; // cast to silence integer promotion
+            typename AllocatorHeap<Input>::alloc_unique_type buffer;
+            if (use_buffer)
+                buffer = AllocatorHeap<Input>::allocate(n_reduced);
+            for (i64 i = 0; i < output_shape[0]; ++i)
+                for (i64 j = 0; j < output_shape[1]; ++j)
+                    for (i64 k = 0; k < output_shape[2]; ++k)
+                        for (i64 l = 0; l < output_shape[3]; ++l)
+                            reduce_one(i, j, k, l, buffer.get());
         }
     }
 }
@@ -6,21 +6,232 @@
 #include "noa/core/types/Shape.hpp"
 #include "noa/cpu/Copy.hpp"
 
-// TODO Use BLAS-like copy for out-of-place permute
-// TODO Try https://stackoverflow.com/a/16743203
+#if defined(__SSE2__) || defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Out-of-place permutations that swap the innermost dimension are transposes between two axes: the input is
+// contiguous along one axis, and the output is contiguous along another one. We walk through these two axes
+// by tiles that fit in L1, and each tile is transposed by small blocks held in SIMD registers, so that both
+// the reads and the writes are done on full cache lines.
+// Logic from:
+// https://stackoverflow.com/a/16743203
+// https://stackoverflow.com/a/25627536
 
 namespace noa::cpu::guts {
+    struct PermuteConfig {
+        // Number of elements per side of a tile. Both the input and output tiles should fit in L1.
+        template<typename T>
+        static constexpr i64 tile_size = sizeof(T) <= 4 ? 64 : sizeof(T) <= 8 ? 32 : 16;
+
+        // Same as ewise.
+        static constexpr i64 n_elements_per_thread = 1'048'576;
+    };
+
+    /// Size of the square block transposed in registers.
+    template<typename T>
+    consteval i64 transpose_block_size() {
+        #if defined(__AVX__)
+        if constexpr (sizeof(T) == 4)
+            return 8;
+        else if constexpr (sizeof(T) == 8)
+            return 4;
+        #elif defined(__SSE2__)
+        if constexpr (sizeof(T) == 4)
+            return 4;
+        else if constexpr (sizeof(T) == 8)
+            return 2;
+        #endif
+        return 8;
+    }
+
+    /// Transposes a square block, i.e. output[i * output_stride + j] = input[j * input_stride + i].
+    /// The rows of the input and output blocks are contiguous. 4 and 8 bytes types are moved as floats and
+    /// doubles, respectively, since we only need to move the bits around.
+    template<typename T>
+    NOA_FH void transpose_block(
+        const T* NOA_RESTRICT_ATTRIBUTE input, i64 input_stride,
+        T* NOA_RESTRICT_ATTRIBUTE output, i64 output_stride
+    ) {
+        constexpr i64 BLOCK = transpose_block_size<T>();
+
+        #if defined(__AVX__)
+        if constexpr (sizeof(T) == 4) {
+            const auto* src = reinterpret_cast<const float*>(input);
+            auto* dst = reinterpret_cast<float*>(output);
+            __m256 r[8], t[8];
+            for (i64 i{}; i < 8; ++i)
+                r[i] = _mm256_loadu_ps(src + i * input_stride);
+            for (i64 i{}; i < 8; i += 2) {
+                t[i + 0] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+                t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+            }
+            for (i64 i{}; i < 8; i += 4) {
+                r[i + 0] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(1, 0, 1, 0));
+                r[i + 1] = _mm256_shuffle_ps(t[i + 0], t[i + 2], _MM_SHUFFLE(3, 2, 3, 2));
+                r[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(1, 0, 1, 0));
+                r[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], _MM_SHUFFLE(3, 2, 3, 2));
+            }
+            for (i64 i{}; i < 4; ++i) {
+                _mm256_storeu_ps(dst + (i + 0) * output_stride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x20));
+                _mm256_storeu_ps(dst + (i + 4) * output_stride, _mm256_permute2f128_ps(r[i], r[i + 4], 0x31));
+            }
+            return;
+        } else if constexpr (sizeof(T) == 8) {
+            const auto* src = reinterpret_cast<const double*>(input);
+            auto* dst = reinterpret_cast<double*>(output);
+            __m256d r[4], t[4];
+            for (i64 i{}; i < 4; ++i)
+                r[i] = _mm256_loadu_pd(src + i * input_stride);
+            t[0] = _mm256_unpacklo_pd(r[0], r[1]);
+            t[1] = _mm256_unpackhi_pd(r[0], r[1]);
+            t[2] = _mm256_unpacklo_pd(r[2], r[3]);
+            t[3] = _mm256_unpackhi_pd(r[2], r[3]);
+            _mm256_storeu_pd(dst + 0 * output_stride, _mm256_permute2f128_pd(t[0], t[2], 0x20));
+            _mm256_storeu_pd(dst + 1 * output_stride, _mm256_permute2f128_pd(t[1], t[3], 0x20));
+            _mm256_storeu_pd(dst + 2 * output_stride, _mm256_permute2f128_pd(t[0], t[2], 0x31));
+            _mm256_storeu_pd(dst + 3 * output_stride, _mm256_permute2f128_pd(t[1], t[3], 0x31));
+            return;
+        }
+        #elif defined(__SSE2__)
+        if constexpr (sizeof(T) == 4) {
+            const auto* src = reinterpret_cast<const float*>(input);
+            auto* dst = reinterpret_cast<float*>(output);
+            __m128 r0 = _mm_loadu_ps(src + 0 * input_stride);
+            __m128 r1 = _mm_loadu_ps(src + 1 * input_stride);
+            __m128 r2 = _mm_loadu_ps(src + 2 * input_stride);
+            __m128 r3 = _mm_loadu_ps(src + 3 * input_stride);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(dst + 0 * output_stride, r0);
+            _mm_storeu_ps(dst + 1 * output_stride, r1);
+            _mm_storeu_ps(dst + 2 * output_stride, r2);
+            _mm_storeu_ps(dst + 3 * output_stride, r3);
+            return;
+        } else if constexpr (sizeof(T) == 8) {
+            const auto* src = reinterpret_cast<const double*>(input);
+            auto* dst = reinterpret_cast<double*>(output);
+            const __m128d r0 = _mm_loadu_pd(src + 0 * input_stride);
+            const __m128d r1 = _mm_loadu_pd(src + 1 * input_stride);
+            _mm_storeu_pd(dst + 0 * output_stride, _mm_unpacklo_pd(r0, r1));
+            _mm_storeu_pd(dst + 1 * output_stride, _mm_unpackhi_pd(r0, r1));
+            return;
+        }
+        #endif
+
+        // Generic fallback. The block size is known at compile time, so let the compiler unroll it.
+        for (i64 i{}; i < BLOCK; ++i)
+            for (i64 j{}; j < BLOCK; ++j)
+                output[i * output_stride + j] = input[j * input_stride + i];
+    }
+
+    /// Transposes a tile of shape (a, b), where the input is contiguous along a and the output is contiguous along b.
+    template<typename T>
+    NOA_FH void transpose_tile(
+        const T* NOA_RESTRICT_ATTRIBUTE input, i64 input_stride_b,
+        T* NOA_RESTRICT_ATTRIBUTE output, i64 output_stride_a,
+        i64 size_a, i64 size_b
+    ) {
+        constexpr i64 BLOCK = transpose_block_size<T>();
+        const i64 size_a_blocked = size_a - size_a % BLOCK;
+        const i64 size_b_blocked = size_b - size_b % BLOCK;
+
+        for (i64 a{}; a < size_a_blocked; a += BLOCK) {
+            for (i64 b{}; b < size_b_blocked; b += BLOCK)
+                transpose_block(input + b * input_stride_b + a, input_stride_b,
+                                output + a * output_stride_a + b, output_stride_a);
+            for (i64 i{}; i < BLOCK; ++i)
+                for (i64 b{size_b_blocked}; b < size_b; ++b)
+                    output[(a + i) * output_stride_a + b] = input[b * input_stride_b + a + i];
+        }
+        for (i64 a{size_a_blocked}; a < size_a; ++a)
+            for (i64 b{}; b < size_b; ++b)
+                output[a * output_stride_a + b] = input[b * input_stride_b + a];
+    }
+
+    /// Out-of-place transpose between the axes a and b, with every other axis being a batch.
+    /// The input should be contiguous along a and the output should be contiguous along b.
+    template<typename T>
+    void permute_copy_tiled(
+        const T* input, const Strides4<i64>& input_strides,
+        T* output, const Strides4<i64>& output_strides,
+        const Shape4<i64>& shape, i64 a, i64 b, i64 n_threads
+    ) {
+        // Batch dimensions, in the rightmost order of the output.
+        Vec2<i64> batch{};
+        for (i64 i{}, j{}; i < 4; ++i)
+            if (i != a and i != b)
+                batch[j++] = i;
+        if (output_strides[batch[0]] < output_strides[batch[1]])
+            std::swap(batch[0], batch[1]);
+
+        const i64 size_a = shape[a];
+        const i64 size_b = shape[b];
+        const i64 size_0 = shape[batch[0]];
+        const i64 size_1 = shape[batch[1]];
+        const i64 input_stride_b = input_strides[b];
+        const i64 output_stride_a = output_strides[a];
+        const Vec2<i64> input_strides_batch{input_strides[batch[0]], input_strides[batch[1]]};
+        const Vec2<i64> output_strides_batch{output_strides[batch[0]], output_strides[batch[1]]};
+
+        constexpr i64 TILE = PermuteConfig::tile_size<T>;
+        const i64 n_tiles_a = divide_up(size_a, TILE);
+        const i64 n_tiles_b = divide_up(size_b, TILE);
+
+        #pragma omp parallel for collapse(4) num_threads(n_threads) if(n_threads > 1) default(none) \
+        shared(input, output, size_0, size_1, size_a, size_b, n_tiles_a, n_tiles_b, \
+               input_stride_b, output_stride_a, input_strides_batch, output_strides_batch)
+        for (i64 i = 0; i < size_0; ++i) {
+            for (i64 j = 0; j < size_1; ++j) {
+                for (i64 ta = 0; ta < n_tiles_a; ++ta) {
+                    for (i64 tb = 0; tb < n_tiles_b; ++tb) {
+                        const i64 ia = ta * TILE;
+                        const i64 ib = tb * TILE;
+                        const T* input_tile =
+                            input + i * input_strides_batch[0] + j * input_strides_batch[1] +
+                            ib * input_stride_b + ia;
+                        T* output_tile =
+                            output + i * output_strides_batch[0] + j * output_strides_batch[1] +
+                            ia * output_stride_a + ib;
+                        transpose_tile(input_tile, input_stride_b, output_tile, output_stride_a,
+                                       min(TILE, size_a - ia), min(TILE, size_b - ib));
+                    }
+                }
+            }
+        }
+    }
+
     template<typename T>
     void permute_copy(
         const T* input, const Strides4<i64>& input_strides,
         const Shape4<i64>& input_shape,
         T* output, const Strides4<i64>& output_strides,
-        const Vec4<i64>& permutation, i64 threads
+        const Vec4<i64>& permutation, i64 n_threads
     ) {
         NOA_ASSERT(input != output);
         const auto output_shape = ni::reorder(input_shape, permutation);
         const auto input_strides_permuted = ni::reorder(input_strides, permutation);
-        copy(input, input_strides_permuted, output, output_strides, output_shape, threads);
+
+        // Find the contiguous axes of the input and output, in the output order.
+        // If these are the same, the permutation doesn't affect the innermost dimension, so copy rows.
+        i64 a{-1}, b{-1};
+        for (i64 i{}; i < 4; ++i) {
+            if (output_shape[i] == 1)
+                continue;
+            if (input_strides_permuted[i] == 1)
+                a = i;
+            if (output_strides[i] == 1)
+                b = i;
+        }
+        if (a == -1 or b == -1 or a == b)
+            return copy(input, input_strides_permuted, output, output_strides, output_shape, n_threads);
+
+        const i64 n_elements = output_shape.n_elements();
+        i64 actual_n_threads = n_elements <= PermuteConfig::n_elements_per_thread ? 1 : n_threads;
+        if (actual_n_threads > 1)
+            actual_n_threads = min(n_threads, n_elements / PermuteConfig::n_elements_per_thread);
+
+        permute_copy_tiled(input, input_strides_permuted, output, output_strides,
+                           output_shape, a, b, actual_n_threads);
     }
 
     template<typename T>
@@ -1,200 +1,406 @@
 #pragma once
 
+#include <omp.h>
 #include <algorithm>
+#include <bit>
+#include "noa/core/types/Pair.hpp"
 #include "noa/core/types/Shape.hpp"
+#include "noa/core/indexing/Offset.hpp"
 #include "noa/cpu/AllocatorHeap.hpp"
 
+// Every line (the axis to sort) is gathered into a contiguous buffer, sorted, and scattered back.
+// Lines are distributed across threads, each thread having its own buffers, so the memory overhead is bounded
+// to a few lines per thread. If there are fewer lines than threads, each line is instead sorted in parallel.
+//
+// Integers and floating-points are sorted using a stable LSD radix sort. The keys are first transformed to
+// unsigned integers whose ordering matches the ordering of the original keys (this is also where the descending
+// order is handled), so that each pass is a simple counting sort on 8 bits. Any other type is sorted using a
+// (parallel) merge sort.
+
 namespace noa::cpu::guts::sort {
-    template<typename T, typename U>
-    using KeyValPair = Pair<T, U>;
-
-    // Ascending order.
-    template<bool SORT_VALUES>
-    struct IsLess {
-        template<typename T, typename U>
-        constexpr bool operator()(const KeyValPair<T, U> lhs, const KeyValPair<T, U> rhs) const noexcept {
-            if constexpr (SORT_VALUES)
-                return lhs.second < rhs.second;
-            else
-                return lhs.first < rhs.first;
-        }
+    template<typename T>
+    concept radix_sortable = (nt::integer<T> and not nt::boolean<T>) or nt::real<T>;
+
+    template<typename T>
+    using radix_t =
+        std::conditional_t<sizeof(T) == 1, u8,
+        std::conditional_t<sizeof(T) == 2, u16,
+        std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+
+    /// Transforms a key to an unsigned integer, such that the integer ordering matches the key ordering.
+    /// Descending keys have their bits flipped.
+    template<radix_sortable T>
+    constexpr auto to_radix(T key, bool ascending) noexcept -> radix_t<T> {
+        using radix_type = radix_t<T>;
+        constexpr auto SIGN = static_cast<radix_type>(radix_type{1} << (sizeof(T) * 8 - 1));
+        auto bits = std::bit_cast<radix_type>(key);
+        if constexpr (nt::real<T>) // negative floats: flip everything; positive floats: flip the sign
+            bits = (bits & SIGN) ? static_cast<radix_type>(~bits) : static_cast<radix_type>(bits | SIGN);
+        else if constexpr (nt::sinteger<T>)
+            bits = static_cast<radix_type>(bits ^ SIGN);
+        return ascending ? bits : static_cast<radix_type>(~bits);
+    }
+
+    /// Inverse of to_radix.
+    template<radix_sortable T>
+    constexpr auto from_radix(radix_t<T> bits, bool ascending) noexcept -> T {
+        using radix_type = radix_t<T>;
+        constexpr auto SIGN = static_cast<radix_type>(radix_type{1} << (sizeof(T) * 8 - 1));
+        if (not ascending)
+            bits = static_cast<radix_type>(~bits);
+        if constexpr (nt::real<T>)
+            bits = (bits & SIGN) ? static_cast<radix_type>(bits ^ SIGN) : static_cast<radix_type>(~bits);
+        else if constexpr (nt::sinteger<T>)
+            bits = static_cast<radix_type>(bits ^ SIGN);
+        return std::bit_cast<T>(bits);
+    }
+
+    struct SortConfig {
+        static constexpr i64 n_bits_per_pass = 8;
+        static constexpr i64 n_buckets = 1 << n_bits_per_pass;
+
+        // Below this size, the histograms cost more than a comparison sort.
+        static constexpr i64 radix_min_size = 512;
+
+        // Below this size, a line is never sorted in parallel.
+        static constexpr i64 parallel_min_size = 65'536;
     };
 
-    // Descending order.
-    template<bool SORT_VALUES>
-    struct IsGreater {
-        template<typename T, typename U>
-        constexpr bool operator()(const KeyValPair<T, U> lhs, const KeyValPair<T, U> rhs) const noexcept {
-            if constexpr (SORT_VALUES)
-                return lhs.second > rhs.second;
-            else
-                return lhs.first > rhs.first;
+    /// Stable LSD radix sort of a contiguous range, with optional values (V = Empty).
+    /// Returns true if the sorted range ended up in the buffers (radix_tmp and values_tmp).
+    template<typename R, typename V>
+    auto radix_sort(
+        R* radix, R* radix_tmp,
+        V* values, V* values_tmp,
+        i64 n, i64 n_threads
+    ) -> bool {
+        constexpr bool HAS_VALUES = not std::is_empty_v<V>;
+        constexpr i64 N_BUCKETS = SortConfig::n_buckets;
+        constexpr i64 N_PASSES = static_cast<i64>(sizeof(R)) * 8 / SortConfig::n_bits_per_pass;
+        bool swapped{};
+
+        if (n_threads <= 1) {
+            i64 histogram[N_BUCKETS];
+            for (i64 pass{}; pass < N_PASSES; ++pass) {
+                const i64 shift = pass * SortConfig::n_bits_per_pass;
+                std::fill_n(histogram, N_BUCKETS, i64{});
+                for (i64 i{}; i < n; ++i)
+                    ++histogram[(radix[i] >> shift) & (N_BUCKETS - 1)];
+
+                // Every key has the same digit, so skip this pass.
+                if (histogram[(radix[0] >> shift) & (N_BUCKETS - 1)] == n)
+                    continue;
+
+                i64 offset{};
+                for (i64& count: histogram)
+                    offset += std::exchange(count, offset);
+                for (i64 i{}; i < n; ++i) {
+                    const i64 index = histogram[(radix[i] >> shift) & (N_BUCKETS - 1)]++;
+                    radix_tmp[index] = radix[i];
+                    if constexpr (HAS_VALUES)
+                        values_tmp[index] = values[i];
+                }
+                std::swap(radix, radix_tmp);
+                if constexpr (HAS_VALUES)
+                    std::swap(values, values_tmp);
+                swapped = not swapped;
+            }
+            return swapped;
         }
-    };
 
-    // Maybe this could be nice in the main API? Probably too specialized.
-    template<typename T>
-    void iota_(
-        T* input, const Strides4<i64>& strides, const Shape4<i64>& shape,
-        const Shape4<i64>& tile, KeyValPair<u32, T>* output
-    ) {
-        const auto tile_strides = tile.strides();
-        for (i64 i{}; i < shape[0]; ++i) {
-            for (i64 j{}; j < shape[1]; ++j) {
-                for (i64 k{}; k < shape[2]; ++k) {
-                    for (i64 l{}; l < shape[3]; ++l, ++output) {
-                        const i64 key = ni::offset_at(
-                            tile_strides,
-                            i % tile[0], j % tile[1],
-                            k % tile[2], l % tile[3]);
-                        *output = {
-                            static_cast<u32>(key),
-                            input[ni::offset_at(strides, i, j, k, l)]
-                        };
+        // Each thread counts and scatters its own chunk. The offsets are computed such that, for a given bucket,
+        // the elements of thread i are placed before the elements of thread i+1, which keeps the sort stable.
+        const i64 chunk_size = divide_up(n, n_threads);
+        const auto histograms = AllocatorHeap<i64>::allocate(N_BUCKETS * n_threads);
+        i64* histograms_ptr = histograms.get();
+        bool skip{};
+
+        #pragma omp parallel num_threads(n_threads) default(none) \
+        shared(radix, radix_tmp, values, values_tmp, n, chunk_size, histograms_ptr, swapped, skip, n_threads)
+        {
+            const i64 tid = omp_get_thread_num();
+            const i64 begin = min(tid * chunk_size, n);
+            const i64 end = min(begin + chunk_size, n);
+            i64* histogram = histograms_ptr + tid * N_BUCKETS;
+
+            for (i64 pass{}; pass < N_PASSES; ++pass) {
+                const i64 shift = pass * SortConfig::n_bits_per_pass;
+                std::fill_n(histogram, N_BUCKETS, i64{});
+                for (i64 i = begin; i < end; ++i)
+                    ++histogram[(radix[i] >> shift) & (N_BUCKETS - 1)];
+
+                #pragma omp barrier
+                #pragma omp single
+                {
+                    i64 offset{};
+                    for (i64 bucket{}; bucket < N_BUCKETS; ++bucket) {
+                        for (i64 thread{}; thread < n_threads; ++thread)
+                            offset += std::exchange(histograms_ptr[thread * N_BUCKETS + bucket], offset);
                     }
+                    const i64 first = (radix[0] >> shift) & (N_BUCKETS - 1);
+                    const i64 last = first + 1 == N_BUCKETS ? n : histograms_ptr[first + 1];
+                    skip = histograms_ptr[first] == 0 and last == n;
+                } // implicit barrier
+
+                if (not skip) {
+                    for (i64 i = begin; i < end; ++i) {
+                        const i64 index = histogram[(radix[i] >> shift) & (N_BUCKETS - 1)]++;
+                        radix_tmp[index] = radix[i];
+                        if constexpr (HAS_VALUES)
+                            values_tmp[index] = values[i];
+                    }
+                    #pragma omp barrier
+                    #pragma omp single
+                    {
+                        std::swap(radix, radix_tmp);
+                        if constexpr (HAS_VALUES)
+                            std::swap(values, values_tmp);
+                        swapped = not swapped;
+                    } // implicit barrier
                 }
             }
         }
+        return swapped;
     }
 
-    // This is like permute(), but working with the pair as input.
-    template<typename T>
-    void permute_(
-        const Pair<uint, T>* src, const Strides4<i64>& src_strides, const Shape4<i64>& src_shape,
-        T* dst, const Strides4<i64>& dst_strides, const Vec4<i64>& permutation
-    ) {
-        const auto dst_shape = src_shape.reorder(permutation);
-        const auto src_strides_permuted = src_strides.reorder(permutation);
-
-        for (i64 i{}; i < dst_shape[0]; ++i)
-            for (i64 j{}; j < dst_shape[1]; ++j)
-                for (i64 k{}; k < dst_shape[2]; ++k)
-                    for (i64 l{}; l < dst_shape[3]; ++l)
-                        dst[ni::offset_at(dst_strides, i, j, k, l)] =
-                                src[ni::offset_at(src_strides_permuted, i, j, k, l)].second;
+    /// Stable merge sort of a contiguous range. Chunks are sorted in parallel and then merged in parallel,
+    /// pairwise, until only one chunk remains. The buffer should have the same size as the range.
+    template<typename T, typename Comp>
+    void merge_sort(T* data, T* buffer, i64 n, Comp comp, i64 n_threads) {
+        if (n_threads <= 1) {
+            std::stable_sort(data, data + n, comp);
+            return;
+        }
+
+        const i64 chunk_size = divide_up(n, n_threads);
+        #pragma omp parallel for num_threads(n_threads) default(none) shared(data, n, comp, chunk_size, n_threads)
+        for (i64 i = 0; i < n_threads; ++i) {
+            const i64 begin = min(i * chunk_size, n);
+            const i64 end = min(begin + chunk_size, n);
+            std::stable_sort(data + begin, data + end, comp);
+        }
+
+        T* src = data;
+        T* dst = buffer;
+        for (i64 width = chunk_size; width < n; width *= 2) {
+            const i64 n_merges = divide_up(n, 2 * width);
+            #pragma omp parallel for num_threads(n_threads) default(none) shared(src, dst, n, comp, width, n_merges)
+            for (i64 i = 0; i < n_merges; ++i) {
+                const i64 begin = i * 2 * width;
+                const i64 middle = min(begin + width, n);
+                const i64 end = min(begin + 2 * width, n);
+                std::merge(src + begin, src + middle, src + middle, src + end, dst + begin, comp);
+            }
+            std::swap(src, dst);
+        }
+        if (src != data)
+            std::copy_n(src, n, data);
     }
 
-    // Sorts the third dimension of "values" using std::sort.
-    // Works with non-contiguous strides. If row is non-contiguous, allocates one row.
-    // If there's a lot of rows to sort, sort_batched_ may be faster at the cost of more memory allocated.
-    template<typename T>
-    void sort_iterative_(T* values, const Strides4<i64>& strides, const Shape4<i64>& shape, i32 dim, bool ascending) {
-        NOA_ASSERT(strides[dim] > 0); // nothing to sort if dim is broadcast
+    /// Sorts the lines of keys and optionally reorders the values accordingly.
+    /// \param[in] keys         Keys to sort.
+    /// \param[out] keys_output Sorted keys. Can be equal to keys, or nullptr.
+    /// \param[in,out] values   Values to reorder. If ARGSORT is true, these are only written to, and are set to
+    ///                         the index, along the sorted axis, of the corresponding sorted key.
+    template<bool ARGSORT, typename K, typename V>
+    void sort_lines(
+        const K* keys, const Strides4<i64>& keys_strides, K* keys_output,
+        V* values, const Strides4<i64>& values_strides,
+        const Shape4<i64>& shape, i32 dim, bool ascending, i64 n_threads
+    ) {
+        constexpr bool HAS_VALUES = not std::is_empty_v<V>;
+        constexpr bool USE_RADIX = radix_sortable<K>;
+        using radix_type = std::conditional_t<USE_RADIX, radix_t<K>, K>;
+        using pair_type = std::conditional_t<HAS_VALUES, Pair<K, V>, K>;
 
-        Strides3<i64> shape_;
-        Strides3<i64> strides_;
-        i32 count{};
-        for (i32 i{}; i < 4; ++i) {
+        // Collapse the lines into a 3d iteration.
+        Shape3<i64> lines_shape;
+        Strides3<i64> lines_keys_strides;
+        Strides3<i64> lines_values_strides;
+        for (i32 i{}, count{}; i < 4; ++i) {
             if (i != dim) {
-                shape_[count] = shape[i];
-                strides_[count] = strides[i];
+                lines_shape[count] = shape[i];
+                lines_keys_strides[count] = keys_strides[i];
+                lines_values_strides[count] = values_strides[i];
                 ++count;
             }
         }
+        const i64 n_lines = lines_shape.n_elements();
+        const i64 size = shape[dim];
+        const i64 key_stride = keys_strides[dim];
+        const i64 value_stride = values_strides[dim];
 
-        const bool dim_is_contiguous = strides[dim] == 1;
-        const i64 dim_size = shape[dim];
-        const i64 dim_stride = strides[dim];
-
-        const auto buffer = AllocatorHeap<T>::allocate(dim_is_contiguous ? 0 : dim_size);
-        for (i64 i{}; i < shape_[0]; ++i) {
-            for (i64 j{}; j < shape_[1]; ++j) {
-                for (i64 k{}; k < shape_[2]; ++k) {
-
-                    const i64 offset = ni::offset_at(strides_, i, j, k);
-                    T* values_ptr = values + offset;
+        const auto sort_line = [&](
+            const K* line_keys, K* line_keys_output, V* line_values,
+            radix_type* radix, pair_type* pairs, V* values_buffer, i64 n_threads_per_line
+        ) {
+            const auto get_value = [&](i64 i) -> V {
+                if constexpr (ARGSORT)
+                    return static_cast<V>(i);
+                else
+                    return line_values[i * value_stride];
+            };
 
-                    // If row is strided, copy in buffer...
-                    if (not dim_is_contiguous) {
-                        for (i64 l = 0; l < dim_size; ++l)
-                            buffer.get()[l] = values_ptr[l * dim_stride];
-                        values_ptr = buffer.get();
+            if (USE_RADIX and size >= SortConfig::radix_min_size) {
+                if constexpr (USE_RADIX) {
+                    for (i64 i{}; i < size; ++i)
+                        radix[i] = to_radix(line_keys[i * key_stride], ascending);
+                    if constexpr (HAS_VALUES) {
+                        for (i64 i{}; i < size; ++i)
+                            values_buffer[i] = get_value(i);
                     }
+                    const bool swapped = radix_sort(
+                        radix, radix + size, values_buffer, values_buffer + size, size, n_threads_per_line);
+                    const radix_type* sorted_radix = radix + swapped * size;
+                    const V* sorted_values = values_buffer + swapped * size;
 
-                    if (ascending)
-                        std::sort(values_ptr, values_ptr + dim_size, std::less{});
+                    if (line_keys_output) {
+                        for (i64 i{}; i < size; ++i)
+                            line_keys_output[i * key_stride] = from_radix<K>(sorted_radix[i], ascending);
+                    }
+                    if constexpr (HAS_VALUES) {
+                        for (i64 i{}; i < size; ++i)
+                            line_values[i * value_stride] = sorted_values[i];
+                    }
+                }
+            } else {
+                const auto get_key = [&](const pair_type& pair) -> const K& {
+                    if constexpr (HAS_VALUES)
+                        return pair.first;
                     else
-                        std::sort(values_ptr, values_ptr + dim_size, std::greater{});
+                        return pair;
+                };
+                for (i64 i{}; i < size; ++i) {
+                    if constexpr (HAS_VALUES)
+                        pairs[i] = pair_type{line_keys[i * key_stride], get_value(i)};
+                    else
+                        pairs[i] = line_keys[i * key_stride];
+                }
+                if (ascending) {
+                    merge_sort(pairs, pairs + size, size, [&](const pair_type& lhs, const pair_type& rhs) {
+                        return get_key(lhs) < get_key(rhs);
+                    }, n_threads_per_line);
+                } else {
+                    merge_sort(pairs, pairs + size, size, [&](const pair_type& lhs, const pair_type& rhs) {
+                        return get_key(lhs) > get_key(rhs);
+                    }, n_threads_per_line);
+                }
+                for (i64 i{}; i < size; ++i) {
+                    if (line_keys_output)
+                        line_keys_output[i * key_stride] = get_key(pairs[i]);
+                    if constexpr (HAS_VALUES)
+                        line_values[i * value_stride] = pairs[i].second;
+                }
+            }
+        };
+
+        // Buffers for one line. Only one of the radix or pair buffers is used.
+        const bool use_radix = USE_RADIX and size >= SortConfig::radix_min_size;
+        const auto allocate_buffers = [&] {
+            return Tuple{
+                AllocatorHeap<radix_type>::allocate(use_radix ? 2 * size : 0),
+                AllocatorHeap<pair_type>::allocate(use_radix ? 0 : 2 * size),
+                AllocatorHeap<V>::allocate(use_radix and HAS_VALUES ? 2 * size : 0),
+            };
+        };
 
-                    // ... and copy the sorted row back to the original array.
-                    if (not dim_is_contiguous) {
-                        for (i64 l{}; l < dim_size; ++l, ++values_ptr)
-                            values[offset + l * dim_stride] = values_ptr[l];
+        const auto offset_at = [&](i64 i, i64 j, i64 k) {
+            const auto key_offset = ni::offset_at(lines_keys_strides, i, j, k);
+            const auto value_offset = ni::offset_at(lines_values_strides, i, j, k);
+            return Pair{key_offset, value_offset};
+        };
+
+        if (n_lines >= n_threads or size < SortConfig::parallel_min_size) {
+            // Batch the lines across threads.
+            const i64 actual_n_threads = min(n_threads, n_lines);
+            #pragma omp parallel num_threads(actual_n_threads) if(actual_n_threads > 1) default(none) \
+            shared(keys, keys_output, values, lines_shape, sort_line, allocate_buffers, offset_at)
+            {
+                auto [radix, pairs, values_buffer] = allocate_buffers();
+
+                #pragma omp for collapse(3)
+                for (i64 i = 0; i < lines_shape[0]; ++i) {
+                    for (i64 j = 0; j < lines_shape[1]; ++j) {
+                        for (i64 k = 0; k < lines_shape[2]; ++k) {
+                            const auto [key_offset, value_offset] = offset_at(i, j, k);
+                            sort_line(keys + key_offset,
+                                      keys_output ? keys_output + key_offset : nullptr,
+                                      values + value_offset,
+                                      radix.get(), pairs.get(), values_buffer.get(), 1);
+                        }
+                    }
+                }
+            }
+        } else {
+            // Few but large lines. Sort each line in parallel.
+            auto [radix, pairs, values_buffer] = allocate_buffers();
+            for (i64 i{}; i < lines_shape[0]; ++i) {
+                for (i64 j{}; j < lines_shape[1]; ++j) {
+                    for (i64 k{}; k < lines_shape[2]; ++k) {
+                        const auto [key_offset, value_offset] = offset_at(i, j, k);
+                        sort_line(keys + key_offset,
+                                  keys_output ? keys_output + key_offset : nullptr,
+                                  values + value_offset,
+                                  radix.get(), pairs.get(), values_buffer.get(), n_threads);
                     }
                 }
             }
         }
     }
 
-    // Sort any dimension [0..3] of the input array, in-place.
-    // The array can have non-contiguous strides in any dimension.
-    // Basically allocates x2 the shape...
-    template<typename T>
-    void sort_batched_(T* values, const Strides4<i64>& strides, const Shape4<i64>& shape, i32 dim, bool ascending) {
-        using keypair_t = KeyValPair<u32, T>;
-        auto tile = shape;
-        tile[dim] = 1; // mark elements with their original axis.
-        std::vector<keypair_t> key_val(static_cast<size_t>(shape.n_elements()));
-        iota_(values, strides, shape, tile, key_val.data());
-
-        // Sort the entire array based on the values, but update the original indexes.
-        if (ascending)
-            std::sort(key_val.begin(), key_val.end(), IsLess<true>{});
-        else
-            std::sort(key_val.begin(), key_val.end(), IsGreater<true>{});
-
-        // Sort the entire array based on the original indexes.
-        // The key here is the iota and the stable_sort. Let say the dim to sort is the rows.
-        //  1) the iota has a tile of 1 in row dimension, so the elements in the same row have the same index.
-        //  2) by sorting the indexes, we replace the elements in their original row, but because we use a stable
-        //     sort, we also keep their relative position, thus preserving the order from the first sort.
-        std::stable_sort(key_val.begin(), key_val.end(), IsLess<false>{});
-
-        // Now the problem is that key_val is permuted, with the "dim" being the innermost dimension.
-        // The relative order of the other dimensions are preserved. In any case, we need to permute
-        // it back, so do this while transferring the values back to the original array.
-
-        // Find the permutation from "key_val" to "values":
-        // dim=3 -> {0,1,2,3} {0,1,2,3}
-        // dim=2 -> {0,1,3,2} {1,2,3,0}
-        // dim=1 -> {0,2,3,1} {2,3,0,1}
-        // dim=0 -> {1,2,3,0} {3,0,1,2}
-        auto input_shape = Shape4<i64>::filled_with(shape[dim]);
-        auto permutation = Vec4<i64>::filled_with(3);
-        i64 count{};
-        for (i32 i{}; i < 4; ++i) {
-            if (i != dim) {
-                input_shape[count] = shape[i];
-                permutation[i] = count;
-                ++count;
-            }
-        }
-        permute_(key_val.data(), input_shape.strides(), input_shape, values, strides, permutation);
+    // Allow dim = -1 to specify the first non-empty dimension in the rightmost order.
+    inline auto actual_dim(const Shape4<i64>& shape, i32 dim) -> i32 {
+        if (dim == -1)
+            dim = shape[3] > 1 ? 3 : shape[2] > 1 ? 2 : shape[1] > 1 ? 1 : 0;
+        NOA_ASSERT(dim >= 0 and dim <= 3);
+        return dim;
     }
 }
 
 namespace noa::cpu {
+    /// Sorts the array along an axis, in-place.
     template<typename T>
-    void sort(T* array, const Strides4<i64>& strides, const Shape4<i64>& shape, bool ascending, i32 dim) {
+    void sort(
+        T* array, const Strides4<i64>& strides, const Shape4<i64>& shape,
+        bool ascending, i32 dim, i64 n_threads = 1
+    ) {
         NOA_ASSERT(array and all(shape > 0));
-
-        // Allow dim = -1 to specify the first non-empty dimension in the rightmost order.
-        if (dim == -1)
-            dim = shape[3] > 1 ? 3 : shape[2] > 1 ? 2 : shape[1] > 1 ? 1 : 0;
-        NOA_ASSERT(dim >= 0 and dim <= 3);
-
+        dim = guts::sort::actual_dim(shape, dim);
         if (strides[dim] == 0)
             return; // there's only one value in the dimension to sort...
 
-        // If there's not a lot of axes to sort, use the iterative version which uses less memory
-        // and does a single sort per axis. Otherwise, use the batched version which uses more memory
-        // but uses 2 sorts (1 being a stable sort), and a permutation/copy, for the entire array.
-        auto shape_4d = shape;
-        shape_4d[dim] = 1;
-        const auto iterations = shape_4d.n_elements();
-        if (iterations < 100)
-            guts::sort::sort_iterative_(array, strides, shape, dim, ascending);
-        else
-            guts::sort::sort_batched_(array, strides, shape, dim, ascending);
+        Empty* values{};
+        guts::sort::sort_lines<false>(array, strides, array, values, Strides4<i64>{}, shape, dim, ascending, n_threads);
+    }
+
+    /// Sorts the keys along an axis and reorders the values accordingly, in-place.
+    template<typename K, typename V>
+    void sort_by_key(
+        K* keys, const Strides4<i64>& keys_strides,
+        V* values, const Strides4<i64>& values_strides,
+        const Shape4<i64>& shape, bool ascending, i32 dim, i64 n_threads = 1
+    ) {
+        NOA_ASSERT(keys and values and all(shape > 0));
+        dim = guts::sort::actual_dim(shape, dim);
+        if (keys_strides[dim] == 0)
+            return;
+
+        guts::sort::sort_lines<false>(
+            keys, keys_strides, keys, values, values_strides, shape, dim, ascending, n_threads);
+    }
+
+    /// Computes the indices, along an axis, that would sort the input.
+    template<typename T, typename I>
+    void argsort(
+        const T* input, const Strides4<i64>& input_strides,
+        I* indices, const Strides4<i64>& indices_strides,
+        const Shape4<i64>& shape, bool ascending, i32 dim, i64 n_threads = 1
+    ) {
+        NOA_ASSERT(input and indices and all(shape > 0));
+        dim = guts::sort::actual_dim(shape, dim);
+
+        T* keys_output{};
+        guts::sort::sort_lines<true>(
+            input, input_strides, keys_output, indices, indices_strides, shape, dim, ascending, n_threads);
     }
 }
@@ -7,6 +7,7 @@
 #include <queue>
 #include <tuple>
 #include <functional>
+#include <vector>
 
 #include "noa/core/Error.hpp"
 #include "noa/core/Traits.hpp"
@@ -38,6 +39,15 @@ namespace noa::cpu::guts {
 
         template<typename F, typename... Args>
         void enqueue(F&& func, Args&&... args) {
+            if (m_is_capturing) {
+                // The task may be launched multiple times, so the function and its arguments
+                // are stored in the task and are never moved from.
+                m_captured_tasks.emplace_back([f = std::forward<F>(func), ...a = std::forward<Args>(args)]() mutable {
+                    f(forward_to_replay_<Args>(a)...);
+                });
+                return;
+            }
+
             if (is_sync()) {
                 std::forward<F>(func)(std::forward<Args>(args)...);
                 return;
@@ -51,11 +61,27 @@ namespace noa::cpu::guts {
 
             const std::scoped_lock lock(m_mutex);
             if (m_exception) {
-                while (not m_queue.empty())
-                    m_queue.pop();
+                flush_();
                 std::rethrow_exception(std::exchange(m_exception, nullptr));
             }
-            m_queue.emplace(std::move(no_args_func));
+            m_queue.push(Task{std::move(no_args_func), false});
+            m_condition_work.notify_one();
+        }
+
+        // Enqueues a marker, i.e. a task that cannot fail and that is executed even if a previous task failed.
+        // This is used to complete events, which would otherwise never complete if the queue is flushed.
+        template<typename F> requires std::is_nothrow_invocable_v<F&>
+        void enqueue_marker(F&& marker) {
+            if (m_is_capturing) {
+                m_captured_tasks.emplace_back(std::forward<F>(marker));
+                return;
+            }
+            if (is_sync()) {
+                marker();
+                return;
+            }
+            const std::scoped_lock lock(m_mutex);
+            m_queue.push(Task{std::forward<F>(marker), true});
             m_condition_work.notify_one();
         }
 
@@ -65,8 +91,7 @@ namespace noa::cpu::guts {
 
             const std::scoped_lock lock_worker(m_mutex);
             if (m_exception) {
-                while (not m_queue.empty())
-                    m_queue.pop();
+                flush_();
                 std::rethrow_exception(std::exchange(m_exception, nullptr));
             }
             return not m_queue.empty() or m_is_busy;
@@ -82,6 +107,22 @@ namespace noa::cpu::guts {
                 std::rethrow_exception(std::exchange(m_exception, nullptr));
         }
 
+        void begin_capture() {
+            check(not m_is_capturing, "The stream is already capturing");
+            m_captured_tasks.clear();
+            m_is_capturing = true;
+        }
+
+        auto end_capture() -> std::vector<std::function<void()>> {
+            check(m_is_capturing, "The stream is not capturing");
+            m_is_capturing = false;
+            return std::exchange(m_captured_tasks, {});
+        }
+
+        [[nodiscard]] bool is_capturing() const noexcept {
+            return m_is_capturing;
+        }
+
         [[nodiscard]] std::thread::id thread_id() const noexcept {
             return m_thread.get_id();
         }
@@ -96,7 +137,7 @@ namespace noa::cpu::guts {
         // receives the notification, it extracts it from the queue and launches the task.
         void waiting_room_() {
             while (true) {
-                std::function<void()> task;
+                Task task;
                 {
                     std::unique_lock lock(m_mutex);
                     if (m_queue.empty()) {
@@ -123,7 +164,8 @@ namespace noa::cpu::guts {
 
                         // If there's an exception that was thrown by the previous task,
                         // ignore the remaining tasks, which is effectively emptying the queue.
-                        if (m_exception) {
+                        // Markers are still executed.
+                        if (m_exception and not task.is_marker) {
                             continue;
                         }
                     }
@@ -132,8 +174,8 @@ namespace noa::cpu::guts {
                 // At this point, the lock is released and new enquires can be made to the stream.
                 // Meanwhile, the working thread will execute the task.
                 try {
-                    if (task)
-                        task();
+                    if (task.function)
+                        task.function();
                 } catch (...) {
                     const std::scoped_lock lock(m_mutex);
                     m_exception = std::current_exception();
@@ -141,9 +183,32 @@ namespace noa::cpu::guts {
             }
         }
 
+        // Empties the queue, but executes the markers. The lock should be acquired.
+        void flush_() noexcept {
+            while (not m_queue.empty()) {
+                if (m_queue.front().is_marker)
+                    m_queue.front().function();
+                m_queue.pop();
+            }
+        }
+
+        // Arguments passed as lvalues are forwarded as lvalues. Otherwise, a copy is forwarded as an rvalue.
+        template<typename Arg, typename T>
+        static constexpr auto forward_to_replay_(T& arg) -> decltype(auto) {
+            if constexpr (std::is_lvalue_reference_v<Arg>)
+                return arg;
+            else
+                return std::decay_t<Arg>(arg);
+        }
+
     private:
+        struct Task {
+            std::function<void()> function;
+            bool is_marker{};
+        };
+
         // TODO Switch to `std::move_only_function` to allow move-only objects?
-        std::queue<std::function<void()>> m_queue;
+        std::queue<Task> m_queue;
         std::thread m_thread;
         std::exception_ptr m_exception;
 
@@ -158,10 +223,43 @@ namespace noa::cpu::guts {
         std::mutex m_mutex;
         bool m_is_busy{false};
         bool m_stop{false};
+
+        // Graph capture. Only accessed by the enqueuing thread.
+        std::vector<std::function<void()>> m_captured_tasks;
+        bool m_is_capturing{false};
     };
 }
 
 namespace noa::cpu {
+    // Sequence of tasks captured from a stream, which can be launched any number of times.
+    // Graphs are reference counted, and the captured tasks hold the resources they need (e.g. the arrays
+    // and the temporary buffers created during the capture), so launching a graph doesn't allocate.
+    class Graph {
+    public:
+        using task_type = std::function<void()>;
+
+        Graph() = default;
+        explicit Graph(std::vector<task_type>&& tasks) :
+            m_tasks(std::make_shared<const std::vector<task_type>>(std::move(tasks))) {}
+
+        // Executes the tasks, in order, on the current thread.
+        void operator()() const {
+            if (m_tasks)
+                for (const auto& task: *m_tasks)
+                    task();
+        }
+
+        [[nodiscard]] auto n_tasks() const noexcept -> i64 { return m_tasks ? std::ssize(*m_tasks) : 0; }
+        [[nodiscard]] auto is_empty() const noexcept -> bool { return n_tasks() == 0; }
+
+    private:
+        std::shared_ptr<const std::vector<task_type>> m_tasks;
+    };
+}
+
+namespace noa::cpu {
+    class Event;
+
     // Shared (a)synchronous dispatch queue.
     class Stream {
     public:
@@ -211,7 +309,24 @@ namespace noa::cpu {
             m_core->worker.enqueue(std::forward<F>(func), std::forward<Args>(args)...);
         }
 
-        [[nodiscard]] auto is_sync() const -> bool { return m_core->worker.is_sync(); }
+        // Enqueues a marker, i.e. a noexcept task that is executed even if a previous task failed.
+        template<typename F>
+        void enqueue_marker(F&& marker) const {
+            m_core->worker.enqueue_marker(std::forward<F>(marker));
+        }
+
+        // Makes the stream wait on an event, i.e. the tasks enqueued after this call are executed once the
+        // work captured by the most recent Event::record() call is completed. This call doesn't block the
+        // calling thread, unless the stream is synchronous, in which case the current thread waits on the event.
+        // The worker thread of an asynchronous stream sleeps until the event is completed (no busy-wait).
+        // Defined in noa/cpu/Event.hpp.
+        void wait(const Event& event) const;
+
+        // Whether the enqueued tasks are executed immediately by the current thread.
+        // While capturing, the tasks are deferred, so the stream is not considered synchronous.
+        [[nodiscard]] auto is_sync() const -> bool {
+            return m_core->worker.is_sync() and not m_core->worker.is_capturing();
+        }
         [[nodiscard]] auto is_async() const -> bool { return not is_sync(); }
 
         // Whether the stream is busy running tasks.
@@ -223,9 +338,37 @@ namespace noa::cpu {
         // Blocks until the stream has completed all operations.
         // This function may also throw an exception from previous asynchronous tasks.
         void synchronize() const {
+            check(not is_capturing(), "A stream cannot be synchronized while capturing a graph");
             m_core->worker.synchronize();
         }
 
+        // Starts capturing the enqueued tasks into a graph, similar to CUDA graphs.
+        // While capturing, enqueued tasks are recorded instead of being executed, and the stream cannot be
+        // synchronized. Since the tasks are recorded with their arguments, the arguments are validated, and the
+        // temporary buffers are allocated, only once, during the capture. The captured tasks always use the
+        // same memory regions and the same number of internal threads.
+        void begin_capture() const {
+            m_core->worker.begin_capture();
+        }
+
+        // Stops capturing and returns the captured graph.
+        [[nodiscard]] auto end_capture() const -> Graph {
+            return Graph(m_core->worker.end_capture());
+        }
+
+        // Whether the stream is capturing.
+        [[nodiscard]] auto is_capturing() const -> bool {
+            return m_core->worker.is_capturing();
+        }
+
+        // Enqueues a graph. The tasks are executed in order, as a single task.
+        // If the stream is capturing, the graph is captured as a task of the new graph.
+        void launch(const Graph& graph) const {
+            if (graph.is_empty())
+                return;
+            m_core->worker.enqueue([graph] { graph(); });
+        }
+
         // Sets the number of internal threads that enqueued functions are allowed to use.
         void set_thread_limit(i64 n_threads) const noexcept {
             m_core->omp_thread_limit = n_threads ? n_threads : 1;
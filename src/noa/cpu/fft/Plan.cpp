@@ -1,10 +1,25 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <vector>
+#include <omp.h>
 #include <fftw3/fftw3.h>
 
 #include "noa/core/Error.hpp"
 #include "noa/core/indexing/Layout.hpp"
+#include "noa/core/math/Generic.hpp"
+#include "noa/core/indexing/Offset.hpp"
 #include "noa/core/utils/Irange.hpp"
 #include "noa/core/utils/Misc.hpp"
+#include "noa/cpu/AllocatorHeap.hpp"
 #include "noa/cpu/fft/Plan.hpp"
 
 namespace {
@@ -253,6 +268,70 @@ namespace {
             return plan;
         }
 
+        // Batched 1d transforms, using the guru interface. Sizes and strides are in number of elements.
+        // These plans are single-threaded.
+        static plan_t create_guru_r2c(
+            real_t* input, complex_t* output,
+            i64 size, i64 input_stride, i64 output_stride,
+            i64 batch, i64 input_batch_stride, i64 output_batch_stride, u32 flags
+        ) {
+            const std::scoped_lock lock(mutex);
+            set_planner_(1, Shape3<i32>::from_value(1), 1);
+            const fftw_iodim64 dims{size, input_stride, output_stride};
+            const fftw_iodim64 batch_dims{batch, input_batch_stride, output_batch_stride};
+            auto optr = reinterpret_cast<fftw_complex_t*>(output);
+            plan_t plan;
+            if constexpr (is_single_precision)
+                plan = fftwf_plan_guru64_dft_r2c(1, &dims, 1, &batch_dims, input, optr, flags);
+            else
+                plan = fftw_plan_guru64_dft_r2c(1, &dims, 1, &batch_dims, input, optr, flags);
+            noa::check(plan != nullptr, "Failed to create the r2c plan with size={}, batch={}", size, batch);
+            return plan;
+        }
+
+        static plan_t create_guru_c2r(
+            complex_t* input, real_t* output,
+            i64 size, i64 input_stride, i64 output_stride,
+            i64 batch, i64 input_batch_stride, i64 output_batch_stride, u32 flags
+        ) {
+            const std::scoped_lock lock(mutex);
+            set_planner_(1, Shape3<i32>::from_value(1), 1);
+            const fftw_iodim64 dims{size, input_stride, output_stride};
+            const fftw_iodim64 batch_dims{batch, input_batch_stride, output_batch_stride};
+            auto iptr = reinterpret_cast<fftw_complex_t*>(input);
+            plan_t plan;
+            if constexpr (is_single_precision)
+                plan = fftwf_plan_guru64_dft_c2r(1, &dims, 1, &batch_dims, iptr, output, flags);
+            else
+                plan = fftw_plan_guru64_dft_c2r(1, &dims, 1, &batch_dims, iptr, output, flags);
+            noa::check(plan != nullptr, "Failed to create the c2r plan with size={}, batch={}", size, batch);
+            return plan;
+        }
+
+        static plan_t create_guru_c2c(
+            complex_t* input, complex_t* output,
+            i64 size, i64 input_stride, i64 output_stride,
+            i64 batch, i64 input_batch_stride, i64 output_batch_stride,
+            noa::fft::Sign sign, u32 flags
+        ) {
+            const std::scoped_lock lock(mutex);
+            set_planner_(1, Shape3<i32>::from_value(1), 1);
+            const fftw_iodim64 dims{size, input_stride, output_stride};
+            const fftw_iodim64 batch_dims{batch, input_batch_stride, output_batch_stride};
+            auto iptr = reinterpret_cast<fftw_complex_t*>(input);
+            auto optr = reinterpret_cast<fftw_complex_t*>(output);
+            plan_t plan;
+            if constexpr (is_single_precision) {
+                plan = fftwf_plan_guru64_dft(
+                    1, &dims, 1, &batch_dims, iptr, optr, noa::to_underlying(sign), flags);
+            } else {
+                plan = fftw_plan_guru64_dft(
+                    1, &dims, 1, &batch_dims, iptr, optr, noa::to_underlying(sign), flags);
+            }
+            noa::check(plan != nullptr, "Failed to create the c2c plan with size={}, batch={}", size, batch);
+            return plan;
+        }
+
         static i32 destroy(void* plan, bool clear_cache_first = false) noexcept {
             // FFTW accumulates a "wisdom" automatically. This circular buffer is here
             // in case fftw_destroy_plan destructs that wisdom.
@@ -321,6 +400,49 @@ namespace {
                 fftw_execute(p);
         }
 
+        // Executes the plan on new arrays. This is thread-safe.
+        static void execute(void* plan, real_t* input, complex_t* output) noexcept {
+            auto p = static_cast<plan_t>(plan);
+            auto optr = reinterpret_cast<fftw_complex_t*>(output);
+            if constexpr (is_single_precision)
+                fftwf_execute_dft_r2c(p, input, optr);
+            else
+                fftw_execute_dft_r2c(p, input, optr);
+        }
+
+        static void execute(void* plan, complex_t* input, real_t* output) noexcept {
+            auto p = static_cast<plan_t>(plan);
+            auto iptr = reinterpret_cast<fftw_complex_t*>(input);
+            if constexpr (is_single_precision)
+                fftwf_execute_dft_c2r(p, iptr, output);
+            else
+                fftw_execute_dft_c2r(p, iptr, output);
+        }
+
+        static void execute(void* plan, complex_t* input, complex_t* output) noexcept {
+            auto p = static_cast<plan_t>(plan);
+            auto iptr = reinterpret_cast<fftw_complex_t*>(input);
+            auto optr = reinterpret_cast<fftw_complex_t*>(output);
+            if constexpr (is_single_precision)
+                fftwf_execute_dft(p, iptr, optr);
+            else
+                fftw_execute_dft(p, iptr, optr);
+        }
+
+        // Gets the number of threads to use for batch-level parallelism, where each thread computes a slice of
+        // the batch with a single-threaded plan. With small transforms, FFTW cannot use many threads without
+        // synchronizing for every transform, so it is better to split the batch instead. Returns 1 if the threads
+        // should rather be used within the transforms (transform-level parallelism).
+        static i64 batch_n_threads(const Shape4<i64>& shape, i64 max_n_threads) noexcept {
+            const i64 batch = shape[0];
+            if (max_n_threads <= 1 or batch <= 1)
+                return 1;
+            const auto shape_3d = shape.pop_front().as<i32>();
+            const i64 n_threads_per_transform = suggest_n_threads_(1, shape_3d, shape_3d.ndim());
+            const i64 n_threads = std::min(batch, max_n_threads);
+            return n_threads > n_threads_per_transform ? n_threads : 1;
+        }
+
     private:
         // The only thread-safe routine in FFTW is fftw_execute (and the new-array variants). All other routines
         // (e.g. the planners) should only be called from one thread at a time. Thus, to make our API thread-safe,
@@ -386,6 +508,394 @@ namespace {
     bool is_inplace_(const void* input, const void* output) {
         return input == output;
     }
+
+    // Plans can only be executed on arrays with the same alignment as the arrays they were created with.
+    // FFTW only needs the SIMD alignment, but use the cache line to be safe.
+    constexpr i64 ALIGNMENT = 64;
+
+    i64 alignment_of_(const void* pointer) {
+        return static_cast<i64>(reinterpret_cast<std::uintptr_t>(pointer) % ALIGNMENT);
+    }
+
+    // Scratch buffer of at least n_bytes, with the given alignment (see alignment_of_).
+    class Scratch {
+    public:
+        Scratch(i64 alignment, i64 n_bytes) :
+            m_buffer(std::make_unique<std::byte[]>(static_cast<size_t>(n_bytes + ALIGNMENT))) {
+            const i64 offset = (alignment - alignment_of_(m_buffer.get()) + ALIGNMENT) % ALIGNMENT;
+            m_data = m_buffer.get() + offset;
+        }
+
+        template<typename T>
+        [[nodiscard]] auto as() const -> T* { return reinterpret_cast<T*>(m_data); }
+
+    private:
+        std::unique_ptr<std::byte[]> m_buffer;
+        std::byte* m_data;
+    };
+
+    template<typename T>
+    i64 n_bytes_(const Strides4<i64>& strides, const Shape4<i64>& shape) {
+        return (ni::offset_at(strides, shape.vec - 1) + 1) * static_cast<i64>(sizeof(T));
+    }
+
+    // Maximum number of entries in each cache of plans. See noa::cpu::fft::set_cache_limit.
+    std::atomic<size_t> g_cache_limit{64};
+
+    // Removes the least recently used entries of the cache, until it has at most limit entries.
+    // The plans still used by a transform are destroyed once the transform is done.
+    template<typename Map>
+    void evict_(Map& entries, size_t limit) {
+        while (entries.size() > limit) {
+            const auto lru = std::min_element(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+                return lhs.second.last_used < rhs.second.last_used;
+            });
+            entries.erase(lru);
+        }
+    }
+
+    // Cache of the tuned plans.
+    template<typename T>
+    class TunedPlans {
+    public:
+        using plan_type = noa::cpu::fft::Plan<T>;
+        using key_type = std::array<i64, 23>;
+
+        struct Entry {
+            std::mutex mutex; // creation of the estimated plan, or synchronous measurement
+            std::optional<plan_type> estimated;
+            std::optional<plan_type> measured;
+            std::atomic<bool> is_measured{false};
+            bool is_measuring{false};
+        };
+
+        static auto instance() -> TunedPlans& {
+            static TunedPlans plans;
+            return plans;
+        }
+
+        // Returns the entry of the key. The entry should be kept alive while its plans are used,
+        // since it can be evicted from the cache at any time.
+        auto entry(const key_type& key) -> std::shared_ptr<Entry> {
+            const std::scoped_lock lock(m_mutex);
+            const size_t limit = g_cache_limit.load(std::memory_order_relaxed);
+            if (limit == 0)
+                return std::make_shared<Entry>();
+
+            auto& slot = m_entries[key];
+            slot.last_used = ++m_tick;
+            if (not slot.entry) {
+                slot.entry = std::make_shared<Entry>();
+                auto entry = slot.entry; // slot may be evicted
+                evict_(m_entries, limit);
+                return entry;
+            }
+            return slot.entry;
+        }
+
+        void set_limit(size_t limit) {
+            const std::scoped_lock lock(m_mutex);
+            evict_(m_entries, limit);
+        }
+
+        template<typename F>
+        void launch(F&& task) {
+            const std::scoped_lock lock(m_mutex);
+            std::erase_if(m_tasks, [](const std::future<void>& future) {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            });
+            m_tasks.push_back(std::async(std::launch::async, std::forward<F>(task)));
+        }
+
+        // Waits for the measurements in progress and destroys the plans.
+        void clear() {
+            std::vector<std::future<void>> tasks;
+            {
+                const std::scoped_lock lock(m_mutex);
+                tasks = std::move(m_tasks);
+            }
+            for (auto& task: tasks)
+                task.wait();
+            const std::scoped_lock lock(m_mutex);
+            m_entries.clear();
+        }
+
+        TunedPlans(const TunedPlans&) = delete;
+        TunedPlans& operator=(const TunedPlans&) = delete;
+        ~TunedPlans() { clear(); }
+
+    private:
+        TunedPlans() {
+            // The plans are destroyed through the cache of fftw<T>::destroy, so make sure that cache
+            // is constructed first, and thus destroyed after this instance.
+            fftw<T>::destroy(nullptr);
+        }
+
+        struct Slot {
+            std::shared_ptr<Entry> entry;
+            u64 last_used{};
+        };
+
+        std::mutex m_mutex;
+        std::map<key_type, Slot> m_entries;
+        std::vector<std::future<void>> m_tasks;
+        u64 m_tick{};
+    };
+
+    enum class TransformType : i64 { R2C, C2R, C2C };
+
+    // Gets a tuned plan for the arrays. The plan is either owned by the cache entry, which is kept alive by "owner",
+    // or is created in "local". make_plan(input, output, flags) creates the plan on the given arrays.
+    template<typename T, typename I, typename O, typename F>
+    auto tuned_plan_(
+        TransformType type, noa::fft::Sign sign,
+        I* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        O* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        const noa::cpu::fft::TuneOptions& options, i64 max_n_threads, F&& make_plan,
+        std::optional<noa::cpu::fft::Plan<T>>& local,
+        std::shared_ptr<typename TunedPlans<T>::Entry>& owner
+    ) -> noa::cpu::fft::Plan<T>& {
+        using namespace noa::cpu::fft;
+        const bool is_inplace = is_inplace_(input, output);
+        const u32 algorithm_flags = options.flags & ~RIGOR_MASK;
+        u32 measure_flags = options.flags;
+        if (options.autotune and (options.flags & ESTIMATE))
+            measure_flags = algorithm_flags | MEASURE;
+
+        // Measuring the plan overwrites the arrays, so use scratch buffers with the same layout.
+        const i64 input_bytes = n_bytes_<I>(input_strides, input_shape);
+        const i64 output_bytes = n_bytes_<O>(output_strides, output_shape);
+        const i64 input_alignment = alignment_of_(input);
+        const i64 output_alignment = alignment_of_(output);
+        const auto measure = [=] {
+            if (is_inplace) {
+                const auto scratch = Scratch(input_alignment, std::max(input_bytes, output_bytes));
+                return make_plan(scratch.template as<I>(), scratch.template as<O>(), measure_flags);
+            }
+            const auto input_scratch = Scratch(input_alignment, input_bytes);
+            const auto output_scratch = Scratch(output_alignment, output_bytes);
+            return make_plan(input_scratch.template as<I>(), output_scratch.template as<O>(), measure_flags);
+        };
+
+        if (not options.autotune and not options.cache)
+            return local.emplace(measure());
+
+        // Both shapes are needed: the logical width of r2c and c2r transforms isn't given by the rfft width.
+        const auto key = typename TunedPlans<T>::key_type{
+            to_underlying(type), to_underlying(sign),
+            input_shape[0], input_shape[1], input_shape[2], input_shape[3],
+            output_shape[0], output_shape[1], output_shape[2], output_shape[3],
+            input_strides[0], input_strides[1], input_strides[2], input_strides[3],
+            output_strides[0], output_strides[1], output_strides[2], output_strides[3],
+            is_inplace, input_alignment, output_alignment,
+            static_cast<i64>(measure_flags), max_n_threads,
+        };
+        auto& plans = TunedPlans<T>::instance();
+        const std::shared_ptr entry = plans.entry(key);
+        owner = entry;
+        if (entry->is_measured.load(std::memory_order_acquire))
+            return *entry->measured;
+
+        if (not options.autotune) {
+            {
+                const std::scoped_lock lock(entry->mutex);
+                if (not entry->is_measured.load(std::memory_order_acquire)) {
+                    entry->measured.emplace(measure());
+                    entry->is_measured.store(true, std::memory_order_release);
+                }
+            }
+            return *entry->measured;
+        }
+
+        {
+            const std::scoped_lock lock(entry->mutex);
+            if (not entry->estimated) // estimating doesn't touch the arrays
+                entry->estimated.emplace(make_plan(input, output, algorithm_flags | ESTIMATE));
+            if (not entry->is_measuring) {
+                entry->is_measuring = true;
+                plans.launch([entry, measure] {
+                    try {
+                        entry->measured.emplace(measure());
+                        entry->is_measured.store(true, std::memory_order_release);
+                    } catch (...) {
+                        // Keep using the estimated plan.
+                    }
+                });
+            }
+        }
+        return *entry->estimated;
+    }
+
+    // Executes a transform with a tuned plan.
+    template<typename T, typename I, typename O, typename F>
+    void execute_tuned_(
+        TransformType type, noa::fft::Sign sign,
+        I* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        O* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        const noa::cpu::fft::TuneOptions& options, i64 max_n_threads, F&& make_plan
+    ) {
+        std::optional<noa::cpu::fft::Plan<T>> local;
+        std::shared_ptr<typename TunedPlans<T>::Entry> owner;
+        tuned_plan_<T>(type, sign,
+                       input, input_strides, input_shape,
+                       output, output_strides, output_shape,
+                       options, max_n_threads, std::forward<F>(make_plan), local, owner
+        ).execute(input, output);
+    }
+
+    // Executes a batched transform by splitting the batch across threads (batch-level parallelism).
+    // Each thread executes a single-threaded plan on its slice of the batch, using the new-array execute
+    // functions. Slices with the same number of transforms and the same alignment share the same plan.
+    // make_plan(batch) returns a function creating the plans, like in execute_tuned_, for a given batch size.
+    template<typename T, typename I, typename O, typename F>
+    void execute_batched_(
+        TransformType type, noa::fft::Sign sign,
+        I* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        O* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        const noa::cpu::fft::TuneOptions& options, i64 n_threads, F&& make_plan
+    ) {
+        using namespace noa::cpu::fft;
+        struct Slice {
+            i64 offset;
+            size_t plan;
+        };
+
+        const i64 batch = input_shape[0];
+        const i64 n_slices = n_threads;
+        const i64 slice_size = divide_up(batch, n_slices);
+        const bool is_estimate = (options.flags & ESTIMATE) and not options.autotune;
+
+        std::vector<Slice> slices;
+        std::vector<std::array<i64, 3>> keys;
+        std::vector<std::optional<Plan<T>>> locals(static_cast<size_t>(n_slices));
+        std::vector<std::shared_ptr<typename TunedPlans<T>::Entry>> owners(static_cast<size_t>(n_slices));
+        std::vector<Plan<T>*> plans;
+        for (i64 offset{}; offset < batch; offset += slice_size) {
+            const i64 n_transforms = std::min(slice_size, batch - offset);
+            I* slice_input = input + input_strides[0] * offset;
+            O* slice_output = output + output_strides[0] * offset;
+            const auto key = std::array{n_transforms, alignment_of_(slice_input), alignment_of_(slice_output)};
+
+            const auto it = std::find(keys.begin(), keys.end(), key);
+            size_t index = static_cast<size_t>(it - keys.begin());
+            if (it == keys.end()) {
+                auto& local = locals[index];
+                auto make_slice_plan = make_plan(n_transforms);
+                if (is_estimate) { // estimating doesn't touch the arrays
+                    plans.push_back(&local.emplace(make_slice_plan(slice_input, slice_output, options.flags)));
+                } else {
+                    plans.push_back(&tuned_plan_<T>(
+                        type, sign,
+                        slice_input, input_strides, input_shape.set<0>(n_transforms),
+                        slice_output, output_strides, output_shape.set<0>(n_transforms),
+                        options, 1, make_slice_plan, local, owners[index]));
+                }
+                keys.push_back(key);
+            }
+            slices.push_back({offset, index});
+        }
+
+        const i64 n_tasks = std::ssize(slices);
+        #pragma omp parallel for num_threads(n_threads) default(none) \
+            shared(n_tasks, slices, plans, input, input_strides, output, output_strides)
+        for (i64 i = 0; i < n_tasks; ++i) {
+            const Slice& slice = slices[static_cast<size_t>(i)];
+            plans[slice.plan]->execute(
+                input + input_strides[0] * slice.offset,
+                output + output_strides[0] * slice.offset);
+        }
+    }
+
+    // FFTW plans of a pruned transform, along the width, height and depth.
+    template<typename T>
+    struct PrunedPlanHandles {
+        void* plan_w{};
+        void* plan_h{};
+        void* plan_d{};
+
+        PrunedPlanHandles() = default;
+        PrunedPlanHandles(const PrunedPlanHandles&) = delete;
+        PrunedPlanHandles& operator=(const PrunedPlanHandles&) = delete;
+        ~PrunedPlanHandles() {
+            for (void* plan: {plan_w, plan_h, plan_d})
+                if (plan)
+                    fftw<T>::destroy(plan);
+        }
+    };
+
+    // Cache of the plans of the pruned transforms.
+    // The plans are created and executed on the internal buffers of the pruned transforms, which all have the same
+    // alignment, so the plans only depend on the sign, the shapes and the flags.
+    template<typename T>
+    class PrunedPlans {
+    public:
+        using plans_type = PrunedPlanHandles<T>;
+        using key_type = std::array<i64, 14>;
+
+        static auto instance() -> PrunedPlans& {
+            static PrunedPlans plans;
+            return plans;
+        }
+
+        // Returns the cached plans, or create(), which is saved in the cache.
+        template<typename F>
+        auto get(const key_type& key, F&& create) -> std::shared_ptr<const plans_type> {
+            std::shared_ptr<Entry> entry;
+            {
+                const std::scoped_lock lock(m_mutex);
+                const size_t limit = g_cache_limit.load(std::memory_order_relaxed);
+                if (limit == 0)
+                    return create();
+
+                auto& slot = m_entries[key];
+                slot.last_used = ++m_tick;
+                entry = slot.entry;
+                if (not entry) {
+                    entry = slot.entry = std::make_shared<Entry>();
+                    evict_(m_entries, limit);
+                }
+            }
+            const std::scoped_lock lock(entry->mutex);
+            if (not entry->plans)
+                entry->plans = create();
+            return entry->plans;
+        }
+
+        void set_limit(size_t limit) {
+            const std::scoped_lock lock(m_mutex);
+            evict_(m_entries, limit);
+        }
+
+        // Releases the plans. The plans still used by a transform are destroyed once the transform is done.
+        void clear() {
+            const std::scoped_lock lock(m_mutex);
+            m_entries.clear();
+        }
+
+        PrunedPlans(const PrunedPlans&) = delete;
+        PrunedPlans& operator=(const PrunedPlans&) = delete;
+        ~PrunedPlans() { clear(); }
+
+    private:
+        PrunedPlans() {
+            // See TunedPlans.
+            fftw<T>::destroy(nullptr);
+        }
+
+        struct Entry {
+            std::mutex mutex; // creation of the plans
+            std::shared_ptr<const plans_type> plans;
+        };
+
+        struct Slot {
+            std::shared_ptr<Entry> entry;
+            u64 last_used{};
+        };
+
+        std::mutex m_mutex;
+        std::map<key_type, Slot> m_entries;
+        u64 m_tick{};
+    };
 }
 
 namespace noa::cpu::fft {
@@ -515,11 +1025,427 @@ namespace noa::cpu::fft {
         fftw<T>::execute(m_plan);
     }
 
+    template<typename T>
+    void Plan<T>::execute(T* input, Complex<T>* output) noexcept {
+        fftw<T>::execute(m_plan, input, output);
+    }
+
+    template<typename T>
+    void Plan<T>::execute(Complex<T>* input, T* output) noexcept {
+        fftw<T>::execute(m_plan, input, output);
+    }
+
+    template<typename T>
+    void Plan<T>::execute(Complex<T>* input, Complex<T>* output) noexcept {
+        fftw<T>::execute(m_plan, input, output);
+    }
+
     template<typename T>
     i32 Plan<T>::cleanup() noexcept {
+        TunedPlans<T>::instance().clear();
+        PrunedPlans<T>::instance().clear();
         return fftw<T>::cleanup();
     }
 
     template class Plan<f32>;
     template class Plan<f64>;
+
+    void set_cache_limit(i32 count) noexcept {
+        NOA_ASSERT(count >= 0);
+        const auto limit = clamp_cast<size_t>(count);
+        g_cache_limit.store(limit, std::memory_order_relaxed);
+        TunedPlans<f32>::instance().set_limit(limit);
+        TunedPlans<f64>::instance().set_limit(limit);
+        PrunedPlans<f32>::instance().set_limit(limit);
+        PrunedPlans<f64>::instance().set_limit(limit);
+    }
+}
+
+namespace noa::cpu::fft {
+    template<typename T>
+    void r2c(
+        T* input, const Strides4<i64>& input_strides,
+        Complex<T>* output, const Strides4<i64>& output_strides,
+        const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads
+    ) {
+        if (const i64 n_threads = fftw<T>::batch_n_threads(shape, max_n_threads); n_threads > 1) {
+            return execute_batched_<T>(
+                TransformType::R2C, noa::fft::Sign::FORWARD,
+                input, input_strides, shape, output, output_strides, shape.rfft(), options, n_threads,
+                [=](i64 batch) {
+                    return [=](T* i, Complex<T>* o, u32 flags) {
+                        return Plan(i, input_strides, o, output_strides, shape.set<0>(batch), flags, 1);
+                    };
+                });
+        }
+        if ((options.flags & ESTIMATE) and not options.autotune)
+            return Plan(input, input_strides, output, output_strides, shape, options.flags, max_n_threads).execute();
+
+        execute_tuned_<T>(
+            TransformType::R2C, noa::fft::Sign::FORWARD,
+            input, input_strides, shape, output, output_strides, shape.rfft(), options, max_n_threads,
+            [=](T* i, Complex<T>* o, u32 flags) {
+                return Plan(i, input_strides, o, output_strides, shape, flags, max_n_threads);
+            });
+    }
+
+    template<typename T>
+    void c2r(
+        Complex<T>* input, const Strides4<i64>& input_strides,
+        T* output, const Strides4<i64>& output_strides,
+        const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads
+    ) {
+        if (const i64 n_threads = fftw<T>::batch_n_threads(shape, max_n_threads); n_threads > 1) {
+            return execute_batched_<T>(
+                TransformType::C2R, noa::fft::Sign::BACKWARD,
+                input, input_strides, shape.rfft(), output, output_strides, shape, options, n_threads,
+                [=](i64 batch) {
+                    return [=](Complex<T>* i, T* o, u32 flags) {
+                        return Plan(i, input_strides, o, output_strides, shape.set<0>(batch), flags, 1);
+                    };
+                });
+        }
+        if ((options.flags & ESTIMATE) and not options.autotune)
+            return Plan(input, input_strides, output, output_strides, shape, options.flags, max_n_threads).execute();
+
+        execute_tuned_<T>(
+            TransformType::C2R, noa::fft::Sign::BACKWARD,
+            input, input_strides, shape.rfft(), output, output_strides, shape, options, max_n_threads,
+            [=](Complex<T>* i, T* o, u32 flags) {
+                return Plan(i, input_strides, o, output_strides, shape, flags, max_n_threads);
+            });
+    }
+
+    template<typename T>
+    void c2c(
+        Complex<T>* input, const Strides4<i64>& input_strides,
+        Complex<T>* output, const Strides4<i64>& output_strides,
+        const Shape4<i64>& shape, noa::fft::Sign sign, const TuneOptions& options, i64 max_n_threads
+    ) {
+        if (const i64 n_threads = fftw<T>::batch_n_threads(shape, max_n_threads); n_threads > 1) {
+            return execute_batched_<T>(
+                TransformType::C2C, sign,
+                input, input_strides, shape, output, output_strides, shape, options, n_threads,
+                [=](i64 batch) {
+                    return [=](Complex<T>* i, Complex<T>* o, u32 flags) {
+                        return Plan(i, input_strides, o, output_strides, shape.set<0>(batch), sign, flags, 1);
+                    };
+                });
+        }
+        if ((options.flags & ESTIMATE) and not options.autotune) {
+            return Plan(input, input_strides, output, output_strides, shape, sign, options.flags, max_n_threads)
+                .execute();
+        }
+
+        execute_tuned_<T>(
+            TransformType::C2C, sign,
+            input, input_strides, shape, output, output_strides, shape, options, max_n_threads,
+            [=](Complex<T>* i, Complex<T>* o, u32 flags) {
+                return Plan(i, input_strides, o, output_strides, shape, sign, flags, max_n_threads);
+            });
+    }
+
+    #define INSTANTIATE_TUNED_FFT_(T)                           \
+    template void r2c<T>(                                       \
+        T*, const Strides4<i64>&,                               \
+        Complex<T>*, const Strides4<i64>&,                      \
+        const Shape4<i64>&, const TuneOptions&, i64);           \
+    template void c2r<T>(                                       \
+        Complex<T>*, const Strides4<i64>&,                      \
+        T*, const Strides4<i64>&,                               \
+        const Shape4<i64>&, const TuneOptions&, i64);           \
+    template void c2c<T>(                                       \
+        Complex<T>*, const Strides4<i64>&,                      \
+        Complex<T>*, const Strides4<i64>&,                      \
+        const Shape4<i64>&, noa::fft::Sign, const TuneOptions&, i64)
+
+    INSTANTIATE_TUNED_FFT_(f32);
+    INSTANTIATE_TUNED_FFT_(f64);
+}
+
+namespace noa::cpu::fft {
+    template<typename T>
+    struct PrunedPlan<T>::Impl {
+        using complex_t = Complex<T>;
+        using buffer_t = typename AllocatorHeap<complex_t>::alloc_unique_type;
+
+        // The arrays. Only the pointers of the transform direction are set.
+        const T* real_input{};
+        complex_t* complex_output{};
+        const complex_t* complex_input{};
+        T* real_output{};
+        Strides4<i64> input_strides;
+        Strides4<i64> output_strides;
+
+        Shape4<i64> shape; // logical shape
+        Shape4<i64> real_shape; // non-zero region of the r2c input, or computed region of the c2r output
+        Shape4<i64> spectrum_shape; // cropped spectrum
+
+        // Each thread has its own buffer, holding one plane of the transform (W and H passes),
+        // or the columns along the depth of one row of the spectrum (D pass).
+        // The intermediate array is used to transpose the planes into columns.
+        i64 n_threads{};
+        i64 buffer_size{};
+        buffer_t buffers;
+        buffer_t intermediate;
+
+        std::shared_ptr<const PrunedPlanHandles<T>> plans;
+        void* plan_w{};
+        void* plan_h{};
+        void* plan_d{};
+
+        Impl(const Shape4<i64>& shape_, const Shape4<i64>& real_shape_, const Shape4<i64>& spectrum_shape_,
+             noa::fft::Sign sign, const TuneOptions& options, i64 max_n_threads) :
+            shape(shape_), real_shape(real_shape_), spectrum_shape(spectrum_shape_)
+        {
+            const auto [n_batch, depth, height, width] = shape;
+            const i64 width_rfft = width / 2 + 1;
+            const i64 n_columns = spectrum_shape[3];
+
+            // Keep the buffers of every thread with the same alignment, so that they can all use the same plans.
+            constexpr i64 BUFFER_ALIGNMENT = 32;
+            buffer_size = max(height * width_rfft, depth > 1 ? depth * n_columns : 0);
+            buffer_size = divide_up(buffer_size, BUFFER_ALIGNMENT) * BUFFER_ALIGNMENT;
+
+            const i64 n_tasks = n_batch * max(real_shape[1], spectrum_shape[2]);
+            n_threads = clamp(max_n_threads, i64{1}, n_tasks);
+            buffers = AllocatorHeap<complex_t>::allocate(buffer_size * n_threads);
+            if (depth > 1)
+                intermediate = AllocatorHeap<complex_t>::allocate(n_batch * real_shape[1] * spectrum_shape[2] * n_columns);
+
+            // The rows of the planes are padded, so the transforms along the width are in-place.
+            // The plans are created on the buffers, so measuring the plans never overwrites the arrays.
+            const auto create_plans = [&, flags = options.flags] {
+                auto handles = std::make_shared<PrunedPlanHandles<T>>();
+                complex_t* buffer = buffers.get();
+                T* buffer_real = reinterpret_cast<T*>(buffer);
+                if (sign == noa::fft::Sign::FORWARD) {
+                    handles->plan_w = fftw<T>::create_guru_r2c(
+                        buffer_real, buffer, width, 1, 1, real_shape[2], width_rfft * 2, width_rfft, flags);
+                } else {
+                    handles->plan_w = fftw<T>::create_guru_c2r(
+                        buffer, buffer_real, width, 1, 1, real_shape[2], width_rfft, width_rfft * 2, flags);
+                }
+                if (height > 1) {
+                    handles->plan_h = fftw<T>::create_guru_c2c(
+                        buffer, buffer, height, width_rfft, width_rfft, n_columns, 1, 1, sign, flags);
+                }
+                if (depth > 1) {
+                    handles->plan_d = fftw<T>::create_guru_c2c(
+                        buffer, buffer, depth, n_columns, n_columns, n_columns, 1, 1, sign, flags);
+                }
+                return std::shared_ptr<const PrunedPlanHandles<T>>(std::move(handles));
+            };
+
+            // Like the other transforms, only the plans with a planning rigor other than ESTIMATE are cached.
+            if (options.cache and not (options.flags & ESTIMATE)) {
+                const auto key = typename PrunedPlans<T>::key_type{
+                    to_underlying(sign), static_cast<i64>(options.flags),
+                    shape[0], shape[1], shape[2], shape[3],
+                    real_shape[1], real_shape[2], real_shape[3],
+                    spectrum_shape[1], spectrum_shape[2], spectrum_shape[3],
+                    real_shape[0], spectrum_shape[0],
+                };
+                plans = PrunedPlans<T>::instance().get(key, create_plans);
+            } else {
+                plans = create_plans();
+            }
+            plan_w = plans->plan_w;
+            plan_h = plans->plan_h;
+            plan_d = plans->plan_d;
+        }
+
+        Impl(const Impl&) = delete;
+        Impl& operator=(const Impl&) = delete;
+
+        // Index, in the logical shape, of the index in the cropped spectrum. See noa::fft::resize.
+        static i64 spectrum_index(i64 index, i64 cropped_size, i64 size) {
+            return index < (cropped_size + 1) / 2 ? index : index + size - cropped_size;
+        }
+
+        auto intermediate_row(i64 batch, i64 plane, i64 row) const -> complex_t* {
+            return intermediate.get() + ((batch * real_shape[1] + plane) * spectrum_shape[2] + row) * spectrum_shape[3];
+        }
+
+        template<typename F>
+        void parallel_for(i64 n_tasks, F&& task) const {
+            const i64 actual_n_threads = min(n_threads, n_tasks);
+            if (actual_n_threads > 1) {
+                #pragma omp parallel num_threads(actual_n_threads) default(none) shared(n_tasks, task)
+                {
+                    complex_t* buffer = buffers.get() + omp_get_thread_num() * buffer_size;
+                    #pragma omp for
+                    for (i64 i = 0; i < n_tasks; ++i)
+                        task(i, buffer);
+                }
+            } else {
+                for (i64 i = 0; i < n_tasks; ++i)
+                    task(i, buffers.get());
+            }
+        }
+
+        void execute_r2c(T scale) {
+            const auto [n_batch, depth, height, width] = shape;
+            const i64 width_rfft = width / 2 + 1;
+            const auto [rd, rh, rw] = real_shape.pop_front();
+            const auto [sd, sh, sw] = spectrum_shape.pop_front();
+
+            // Width and height, one plane of the non-zero region at a time.
+            parallel_for(n_batch * rd, [&](i64 task, complex_t* buffer) {
+                const i64 batch = task / rd;
+                const i64 plane = task % rd;
+                T* buffer_real = reinterpret_cast<T*>(buffer);
+
+                for (i64 y{}; y < rh; ++y) {
+                    const T* input_row = real_input + ni::offset_at(input_strides, batch, plane, y);
+                    T* row = buffer_real + y * width_rfft * 2;
+                    for (i64 x{}; x < rw; ++x)
+                        row[x] = input_row[x * input_strides[3]];
+                    std::fill(row + rw, row + width, T{});
+                }
+                fftw<T>::execute(plan_w, buffer_real, buffer);
+
+                if (plan_h) {
+                    for (i64 y = rh; y < height; ++y)
+                        std::fill_n(buffer + y * width_rfft, sw, complex_t{});
+                    fftw<T>::execute(plan_h, buffer, buffer);
+                }
+
+                for (i64 yk{}; yk < sh; ++yk) {
+                    const complex_t* row = buffer + spectrum_index(yk, sh, height) * width_rfft;
+                    if (plan_d) {
+                        std::copy_n(row, sw, intermediate_row(batch, plane, yk));
+                    } else {
+                        complex_t* output_row = complex_output + ni::offset_at(output_strides, batch, 0, yk);
+                        for (i64 x{}; x < sw; ++x)
+                            output_row[x * output_strides[3]] = row[x] * scale;
+                    }
+                }
+            });
+
+            // Depth, one row of the cropped spectrum at a time.
+            if (plan_d) {
+                parallel_for(n_batch * sh, [&](i64 task, complex_t* buffer) {
+                    const i64 batch = task / sh;
+                    const i64 yk = task % sh;
+                    for (i64 z{}; z < rd; ++z)
+                        std::copy_n(intermediate_row(batch, z, yk), sw, buffer + z * sw);
+                    std::fill(buffer + rd * sw, buffer + depth * sw, complex_t{});
+                    fftw<T>::execute(plan_d, buffer, buffer);
+
+                    for (i64 zk{}; zk < sd; ++zk) {
+                        const complex_t* row = buffer + spectrum_index(zk, sd, depth) * sw;
+                        complex_t* output_row = complex_output + ni::offset_at(output_strides, batch, zk, yk);
+                        for (i64 x{}; x < sw; ++x)
+                            output_row[x * output_strides[3]] = row[x] * scale;
+                    }
+                });
+            }
+        }
+
+        void execute_c2r(T scale) {
+            const auto [n_batch, depth, height, width] = shape;
+            const i64 width_rfft = width / 2 + 1;
+            const auto [rd, rh, rw] = real_shape.pop_front();
+            const auto [sd, sh, sw] = spectrum_shape.pop_front();
+
+            // Depth, one row of the cropped spectrum at a time.
+            if (plan_d) {
+                parallel_for(n_batch * sh, [&](i64 task, complex_t* buffer) {
+                    const i64 batch = task / sh;
+                    const i64 yk = task % sh;
+                    std::fill_n(buffer, depth * sw, complex_t{});
+                    for (i64 zk{}; zk < sd; ++zk) {
+                        const complex_t* input_row = complex_input + ni::offset_at(input_strides, batch, zk, yk);
+                        complex_t* row = buffer + spectrum_index(zk, sd, depth) * sw;
+                        for (i64 x{}; x < sw; ++x)
+                            row[x] = input_row[x * input_strides[3]];
+                    }
+                    fftw<T>::execute(plan_d, buffer, buffer);
+                    for (i64 z{}; z < rd; ++z)
+                        std::copy_n(buffer + z * sw, sw, intermediate_row(batch, z, yk));
+                });
+            }
+
+            // Height and width, one plane of the computed region at a time.
+            parallel_for(n_batch * rd, [&](i64 task, complex_t* buffer) {
+                const i64 batch = task / rd;
+                const i64 plane = task % rd;
+                T* buffer_real = reinterpret_cast<T*>(buffer);
+
+                for (i64 y{}, yk{}; y < height; ++y) {
+                    complex_t* row = buffer + y * width_rfft;
+                    if (yk < sh and spectrum_index(yk, sh, height) == y) {
+                        if (plan_d) {
+                            std::copy_n(intermediate_row(batch, plane, yk), sw, row);
+                        } else {
+                            const complex_t* input_row = complex_input + ni::offset_at(input_strides, batch, 0, yk);
+                            for (i64 x{}; x < sw; ++x)
+                                row[x] = input_row[x * input_strides[3]];
+                        }
+                        ++yk;
+                    } else {
+                        std::fill_n(row, sw, complex_t{});
+                    }
+                }
+                if (plan_h)
+                    fftw<T>::execute(plan_h, buffer, buffer);
+
+                for (i64 y{}; y < rh; ++y)
+                    std::fill(buffer + y * width_rfft + sw, buffer + (y + 1) * width_rfft, complex_t{});
+                fftw<T>::execute(plan_w, buffer, buffer_real);
+
+                for (i64 y{}; y < rh; ++y) {
+                    const T* row = buffer_real + y * width_rfft * 2;
+                    T* output_row = real_output + ni::offset_at(output_strides, batch, plane, y);
+                    for (i64 x{}; x < rw; ++x)
+                        output_row[x * output_strides[3]] = row[x] * scale;
+                }
+            });
+        }
+    };
+
+    template<typename T>
+    PrunedPlan<T>::PrunedPlan(
+        const real_type* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        complex_type* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads
+    ) : m_impl(std::make_unique<Impl>(shape, input_shape, output_shape, noa::fft::Sign::FORWARD, options, max_n_threads)) {
+        m_impl->real_input = input;
+        m_impl->input_strides = input_strides;
+        m_impl->complex_output = output;
+        m_impl->output_strides = output_strides;
+    }
+
+    template<typename T>
+    PrunedPlan<T>::PrunedPlan(
+        const complex_type* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+        real_type* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+        const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads
+    ) : m_impl(std::make_unique<Impl>(shape, output_shape, input_shape, noa::fft::Sign::BACKWARD, options, max_n_threads)) {
+        m_impl->complex_input = input;
+        m_impl->input_strides = input_strides;
+        m_impl->real_output = output;
+        m_impl->output_strides = output_strides;
+    }
+
+    template<typename T>
+    PrunedPlan<T>::PrunedPlan(PrunedPlan&&) noexcept = default;
+
+    template<typename T>
+    PrunedPlan<T>& PrunedPlan<T>::operator=(PrunedPlan&&) noexcept = default;
+
+    template<typename T>
+    PrunedPlan<T>::~PrunedPlan() noexcept = default;
+
+    template<typename T>
+    void PrunedPlan<T>::execute(real_type scale) noexcept {
+        if (m_impl->real_input)
+            m_impl->execute_r2c(scale);
+        else
+            m_impl->execute_c2r(scale);
+    }
+
+    template class PrunedPlan<f32>;
+    template class PrunedPlan<f64>;
 }
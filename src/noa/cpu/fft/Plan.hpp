@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <utility>
 #include "noa/core/Enums.hpp"
 #include "noa/core/types/Shape.hpp"
 
@@ -55,6 +57,9 @@ namespace noa::cpu::fft {
         PRESERVE_INPUT = 1u << 4,
     };
 
+    /// Bitmask of the planning-rigor field.
+    inline constexpr u32 RIGOR_MASK = ESTIMATE | MEASURE | PATIENT | EXHAUSTIVE;
+
     /// Wrapper managing FFTW plans.
     /// NOTE: This object does not keep track of the associated data.
     ///       It is the user's responsibility to create, delete and keep track of the input/output arrays.
@@ -102,24 +107,124 @@ namespace noa::cpu::fft {
     public:
         Plan(const Plan&) = delete;
         Plan& operator=(const Plan&) = delete;
-        Plan(Plan&&) noexcept = default;
-        Plan& operator=(Plan&&) noexcept = default;
+        Plan(Plan&& other) noexcept : m_plan(std::exchange(other.m_plan, nullptr)) {}
+        Plan& operator=(Plan&& other) noexcept {
+            std::swap(m_plan, other.m_plan);
+            return *this;
+        }
         ~Plan() noexcept;
 
         void execute() noexcept;
 
+        /// Executes the plan on new arrays.
+        /// The arrays should have the same strides and alignment as the arrays used to create the plan,
+        /// and should be in-place only if the plan was created in-place.
+        void execute(real_type* input, complex_type* output) noexcept; // r2c
+        void execute(complex_type* input, real_type* output) noexcept; // c2r
+        void execute(complex_type* input, complex_type* output) noexcept; // c2c
+
         // The plans are cached and FFTW caches accumulated wisdom and a list of algorithms available in the current
         // configuration. If you want to deallocate all of that and reset to the pristine state it was in when you
         // started your program, then call this function.
         // This functions should only be call when all plans are destroyed. All existing plans become
         // undefined, and one should not attempt to execute them nor to destroy them. You can however
-        // create and execute/destroy new plans.
+        // create and execute/destroy new plans. The cached tuned plans are destroyed first, after waiting
+        // for the measurements in progress.
         static i32 cleanup() noexcept;
 
     private:
         void* m_plan{};
     };
 
+    /// Options of the transforms using measured plans.
+    struct TuneOptions {
+        /// FFTW flags, with the planning-rigor field (ESTIMATE, MEASURE, PATIENT or EXHAUSTIVE)
+        /// and the algorithm-restriction field.
+        u32 flags{ESTIMATE};
+
+        /// Whether the plan should be saved and reused by the next transforms with the same layout,
+        /// i.e. the same type, shape, strides, alignment, flags and number of threads.
+        /// The cache has a limited capacity (see set_cache_limit) and can be cleared with clear_caches.
+        bool cache{true};
+
+        /// Whether the plan should be measured in the background. The transforms use a plan created with ESTIMATE
+        /// until the measured plan is ready. If the planning rigor is ESTIMATE, MEASURE is used instead.
+        /// Autotuned plans are always cached.
+        bool autotune{false};
+    };
+
+    /// Tuned transforms.
+    /// Measuring plans overwrites the arrays. As such, plans are measured on scratch buffers with the same layout
+    /// and alignment as the arrays, and are then executed on the arrays. Since FFTW plans are created one at a time,
+    /// creating a plan may wait for a measurement in progress.
+    /// If the planning rigor is ESTIMATE and autotune is false, this is equivalent to creating and executing a Plan.
+    template<typename T>
+    void r2c(T* input, const Strides4<i64>& input_strides,
+             Complex<T>* output, const Strides4<i64>& output_strides,
+             const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads);
+
+    template<typename T>
+    void c2r(Complex<T>* input, const Strides4<i64>& input_strides,
+             T* output, const Strides4<i64>& output_strides,
+             const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads);
+
+    template<typename T>
+    void c2c(Complex<T>* input, const Strides4<i64>& input_strides,
+             Complex<T>* output, const Strides4<i64>& output_strides,
+             const Shape4<i64>& shape, noa::fft::Sign sign, const TuneOptions& options, i64 max_n_threads);
+
+    /// Pruned transforms of zero-padded arrays and cropped spectra.
+    /// The transforms are computed one dimension at a time (row-column decomposition), and the rows and planes
+    /// that are known to be zero, or that are not needed in the output, are skipped:
+    ///  - r2c: the input is the non-zero region of an array of logical shape \p shape, i.e. it is implicitly
+    ///    zero-padded at the end of each dimension. The output is the non-redundant non-centered spectrum,
+    ///    cropped to the lowest frequencies, as noa::fft::resize would.
+    ///  - c2r: the input is a cropped spectrum, implicitly zero-padded as noa::fft::resize would. The output is
+    ///    the region at the origin of the real array of logical shape \p shape.
+    /// \note The plans are created and executed on internal buffers, so the arrays are never overwritten during
+    ///       planning, and the input of the c2r transforms is preserved. As such, the plans only depend on the
+    ///       shapes and flags, and are cached if TuneOptions::cache is true and the planning rigor isn't ESTIMATE.
+    ///       TuneOptions::autotune is ignored.
+    /// \note 2d/3d arrays should be in the rightmost order and 1d arrays should be row vectors.
+    template<typename T>
+    class PrunedPlan {
+    public:
+        static_assert(nt::any_of<T, f32, f64>);
+        using real_type = T;
+        using complex_type = Complex<T>;
+
+    public:
+        /// r2c, where input_shape is the shape of the non-zero region, output_shape is the shape of the cropped
+        /// spectrum, and shape is the BDHW logical shape of the transform.
+        PrunedPlan(const real_type* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+                   complex_type* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+                   const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads);
+
+        /// c2r, where input_shape is the shape of the cropped spectrum, output_shape is the shape of the computed
+        /// region, and shape is the BDHW logical shape of the transform.
+        PrunedPlan(const complex_type* input, const Strides4<i64>& input_strides, const Shape4<i64>& input_shape,
+                   real_type* output, const Strides4<i64>& output_strides, const Shape4<i64>& output_shape,
+                   const Shape4<i64>& shape, const TuneOptions& options, i64 max_n_threads);
+
+        PrunedPlan(const PrunedPlan&) = delete;
+        PrunedPlan& operator=(const PrunedPlan&) = delete;
+        PrunedPlan(PrunedPlan&&) noexcept;
+        PrunedPlan& operator=(PrunedPlan&&) noexcept;
+        ~PrunedPlan() noexcept;
+
+        /// Executes the transform. The output is multiplied by the scale, e.g. the normalization factor.
+        void execute(real_type scale = 1) noexcept;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+    /// Sets the maximum number of entries in the caches of the tuned and pruned plans (64 by default).
+    /// Each precision has its own caches. When a cache is full, the least recently used plans are released.
+    /// Setting the limit to 0 turns off the caching.
+    void set_cache_limit(i32 count) noexcept;
+
     inline i32 clear_caches() noexcept {
         i32 n = Plan<f32>::cleanup();
         n += Plan<f64>::cleanup();
@@ -8,6 +8,8 @@
 #include "noa/cpu/AllocatorHeap.hpp"
 #include "noa/cpu/Iwise.hpp"
 #include "noa/cpu/Ewise.hpp"
+#include "noa/cpu/signal/ConvolveFFT.hpp"
+#include "noa/cpu/signal/ConvolveSeparable.hpp"
 
 namespace noa::cpu::signal::guts {
     template<size_t DIM, typename InputAccessor, typename OutputAccessor, typename FilterAccessor>
@@ -90,60 +92,6 @@ namespace noa::cpu::signal::guts {
         DEPTH = 1, HEIGHT = 2, WIDTH = 3
     };
 
-    template<ConvolutionSeparableDim DIM, typename InputAccessor, typename OutputAccessor, typename FilterAccessor>
-    class ConvolutionSeparable {
-    public:
-        using input_accessor_type = InputAccessor;
-        using output_accessor_type = OutputAccessor;
-        using filter_accessor_type = FilterAccessor;
-        using input_value_type = nt::mutable_value_type_t<input_accessor_type>;
-        using output_value_type = nt::value_type_t<output_accessor_type>;
-        using filter_value_type = nt::mutable_value_type_t<filter_accessor_type>;
-
-    public:
-        ConvolutionSeparable(
-            const input_accessor_type& input,
-            const output_accessor_type& output,
-            const filter_accessor_type& filter,
-            i64 dim_size, i64 filter_size
-        ) : m_input(input), m_output(output), m_filter(filter),
-            m_dim_size(dim_size), m_filter_size(filter_size),
-            m_halo(filter_size / 2) {}
-
-        constexpr void operator()(i64 i, i64 j, i64 k, i64 l) const {
-            filter_value_type conv{};
-
-            if constexpr (DIM == ConvolutionSeparableDim::WIDTH) {
-                for (i64 wl{}; wl < m_filter_size; ++wl) {
-                    const i64 il = l - m_halo + wl;
-                    if (il >= 0 and il < m_dim_size)
-                        conv += static_cast<filter_value_type>(m_input(i, j, k, il)) * m_filter[wl];
-                }
-            } else if constexpr (DIM == ConvolutionSeparableDim::HEIGHT) {
-                for (i64 wk{}; wk < m_filter_size; ++wk) {
-                    const i64 ik = k - m_halo + wk;
-                    if (ik >= 0 and ik < m_dim_size)
-                        conv += static_cast<filter_value_type>(m_input(i, j, ik, l)) * m_filter[wk];
-                }
-            } else if constexpr (DIM == ConvolutionSeparableDim::DEPTH) {
-                for (i64 wj{}; wj < m_filter_size; ++wj) {
-                    const i64 ij = j - m_halo + wj;
-                    if (ij >= 0 and ij < m_dim_size)
-                        conv += static_cast<filter_value_type>(m_input(i, ij, k, l)) * m_filter[wj];
-                }
-            }
-            m_output(i, j, k, l) = static_cast<output_value_type>(conv);
-        }
-
-    private:
-        input_accessor_type m_input;
-        output_accessor_type m_output;
-        filter_accessor_type m_filter;
-        i64 m_dim_size;
-        i64 m_filter_size;
-        i64 m_halo;
-    };
-
     // If half precision, convert filter and do the accumulation is single-precision.
     // Without this, half precision would be ~10times slower. With this preprocessing, it is only 2times slower.
     template<typename T>
@@ -163,22 +111,40 @@ namespace noa::cpu::signal::guts {
         }
     }
 
+    template<ConvolutionSeparableDim DIM, typename T, typename U, typename V>
+    auto is_convolve_separable_fft_faster(const Shape4<i64>& shape, const V* filter, i64 filter_size) -> bool {
+        if constexpr (nt::real<T, U, V>) {
+            if (not filter or filter_size <= 1)
+                return false;
+            auto filter_shape = Shape3<i64>{1, 1, 1};
+            filter_shape[to_underlying(DIM) - 1] = filter_size;
+            return is_convolve_fft_faster(shape, filter_shape, ConvolutionSeparableConfig::cost_per_tap);
+        } else {
+            return false;
+        }
+    }
+
     template<ConvolutionSeparableDim DIM, typename T, typename U, typename V>
     void launch_convolve_separable(
         const T* input, const Strides4<i64>& input_strides,
         U* output, const Strides4<i64>& output_strides, const Shape4<i64>& shape,
         const V* filter, i64 filter_size, i64 threads
     ) {
-        using input_accessor_t = AccessorRestrict<const T, 4, i64>;
-        using output_accessor_t = AccessorRestrict<U, 4, i64>;
-        const auto [filter_accessor, filter_buffer] = guts::get_filter(filter, filter_size);
-        const auto dim_size = shape.filter(to_underlying(DIM))[0];
+        if (is_convolve_separable_fft_faster<DIM, T, U>(shape, filter, filter_size)) {
+            auto filter_shape = Shape3<i64>{1, 1, 1};
+            filter_shape[to_underlying(DIM) - 1] = filter_size;
+            return convolve_fft(
+                input, input_strides, output, output_strides, shape,
+                filter, filter_shape, threads);
+        }
 
-        auto kernel = ConvolutionSeparable<DIM, input_accessor_t, output_accessor_t, decltype(filter_accessor)>(
-            input_accessor_t(input, input_strides),
-            output_accessor_t(output, output_strides),
-            filter_accessor, dim_size, filter_size);
-        iwise(shape, kernel, threads);
+        const V* filters[3]{};
+        i64 filter_sizes[3]{};
+        filters[to_underlying(DIM) - 1] = filter;
+        filter_sizes[to_underlying(DIM) - 1] = filter_size;
+        convolve_separable_streaming(
+            input, input_strides, output, output_strides, shape,
+            filters[0], filter_sizes[0], filters[1], filter_sizes[1], filters[2], filter_sizes[2], threads);
     }
 }
 
@@ -191,6 +157,15 @@ namespace noa::cpu::signal {
     ) {
         const auto n_dimensions_to_convolve = sum(filter_shape > 1);
         const auto ndim = filter_shape.ndim();
+        if constexpr (nt::real<T, U, V>) {
+            // Large filters are faster to apply in Fourier space.
+            if (n_dimensions_to_convolve > 1 and guts::is_convolve_fft_faster(shape, filter_shape)) {
+                return guts::convolve_fft(
+                    input, input_strides, output, output_strides, shape,
+                    filter, filter_shape, threads);
+            }
+        }
+
         if (n_dimensions_to_convolve == 1) {
             if (filter_shape[0] > 1) {
                 guts::launch_convolve_separable<guts::ConvolutionSeparableDim::DEPTH>(
@@ -254,6 +229,18 @@ namespace noa::cpu::signal {
         if (filter_width_size <= 0)
             filter_width = nullptr;
 
+        // The filters are applied in one pass, unless some of them are faster to apply in Fourier space.
+        using enum guts::ConvolutionSeparableDim;
+        if (not guts::is_convolve_separable_fft_faster<DEPTH, T, U>(shape, filter_depth, filter_depth_size) and
+            not guts::is_convolve_separable_fft_faster<HEIGHT, T, U>(shape, filter_height, filter_height_size) and
+            not guts::is_convolve_separable_fft_faster<WIDTH, T, U>(shape, filter_width, filter_width_size)) {
+            return guts::convolve_separable_streaming(
+                input, input_strides, output, output_strides, shape,
+                filter_depth, filter_depth_size,
+                filter_height, filter_height_size,
+                filter_width, filter_width_size, threads);
+        }
+
         // Allocate temp buffer if necessary.
         i32 count = 0;
         if (filter_depth)
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <omp.h>
+#include "noa/core/indexing/Offset.hpp"
+#include "noa/core/math/Generic.hpp"
+#include "noa/core/types/Complex.hpp"
+#include "noa/core/types/Shape.hpp"
+#include "noa/cpu/AllocatorHeap.hpp"
+#include "noa/cpu/fft/Plan.hpp"
+
+// FFT convolution with overlap-save tiling.
+// The output is divided into tiles. For each tile, the input is gathered (with the halo of the filter and zero
+// padding at the edges) into a buffer of the size of the transform, multiplied by the spectrum of the filter, and
+// transformed back. Because of the circular convolution, the first filter_size-1 elements of the result are
+// wrapped around and discarded; the remaining elements are the convolved tile. The tiles are sized so that the
+// buffers stay in the L2 cache, and the filter spectrum is computed once and shared by every tile and batch.
+//
+// To match the direct convolution, this computes the (zero-padded) cross-correlation with the filter centered
+// on each output element, i.e. the spectrum is computed from the flipped filter.
+//
+// If a single dimension is convolved, the tiles are segments of the lines along that dimension. The segments of
+// multiple lines are gathered next to each other, so that each task computes a batch of 1d transforms.
+
+namespace noa::cpu::signal::guts {
+    struct ConvolutionFFTConfig {
+        // Maximum size of the transforms along each transformed dimension, for 1d, 2d and 3d tiles.
+        // 2d tiles of 256x256 and 3d tiles of 64x64x64 single-precision buffers (real and complex)
+        // are about 0.5MB and 2MB, respectively.
+        static constexpr i64 max_tile_size[3]{16384, 256, 64};
+
+        // Maximum number of elements of the batch of segments, when a single dimension is convolved.
+        static constexpr i64 max_lines_size = 65536;
+
+        // Cost model, in ns per operation, measured with benchmarks/src/BenchConvolve.cpp.
+        // The direct convolution costs one multiply-add per filter tap, per output element.
+        // The FFT convolution costs two real transforms per tile, plus the complex multiplication, gather
+        // and scatter, which are proportional to the tile size.
+        static constexpr f64 direct_cost_per_tap = 1.4;
+        static constexpr f64 fft_cost_per_element_log2 = 0.3;
+        static constexpr f64 fft_cost_per_element = 3.;
+    };
+
+    /// Returns the DHW shape of the transforms used by the FFT convolution.
+    /// Dimensions that are not convolved (i.e. the filter size is 1) are not transformed.
+    inline auto convolve_fft_tile_shape(const Shape3<i64>& shape, const Shape3<i64>& filter_shape) -> Shape3<i64> {
+        i64 ndim{};
+        for (size_t i{}; i < 3; ++i)
+            ndim += filter_shape[i] > 1;
+        const i64 max_tile_size = ConvolutionFFTConfig::max_tile_size[max(ndim, i64{1}) - 1];
+
+        Shape3<i64> tile_shape{1, 1, 1};
+        for (size_t i{}; i < 3; ++i) {
+            if (filter_shape[i] == 1)
+                continue;
+            // If the padded input fits in one tile, use it. Otherwise, the tile should at least be twice as large
+            // as the filter, otherwise most of the tile is spent on the halo.
+            const i64 padded_size = shape[i] + filter_shape[i] - 1;
+            const i64 min_size = 2 * filter_shape[i];
+            tile_shape[i] = noa::cpu::fft::fast_size(
+                padded_size <= max(max_tile_size, min_size) ? padded_size : max(max_tile_size, min_size));
+        }
+        return tile_shape;
+    }
+
+    /// Estimates, using the cost model, whether the FFT convolution is faster than the direct convolution.
+    /// \param direct_cost_per_tap Cost of the direct convolution, in ns per filter tap, per output element.
+    inline auto is_convolve_fft_faster(
+        const Shape4<i64>& shape, const Shape3<i64>& filter_shape,
+        f64 direct_cost_per_tap = ConvolutionFFTConfig::direct_cost_per_tap
+    ) -> bool {
+        const auto shape_3d = shape.pop_front();
+        const auto tile_shape = convolve_fft_tile_shape(shape_3d, filter_shape);
+
+        i64 n_tiles{1};
+        for (size_t i{}; i < 3; ++i)
+            n_tiles *= divide_up(shape_3d[i], tile_shape[i] - filter_shape[i] + 1);
+
+        const auto n_elements = static_cast<f64>(shape.n_elements());
+        const auto n_elements_per_tile = static_cast<f64>(tile_shape.n_elements());
+        const f64 direct_cost =
+            n_elements * static_cast<f64>(filter_shape.n_elements()) * direct_cost_per_tap;
+        const f64 fft_cost =
+            static_cast<f64>(shape[0] * n_tiles) * n_elements_per_tile *
+            (2 * log2(n_elements_per_tile) * ConvolutionFFTConfig::fft_cost_per_element_log2 +
+             ConvolutionFFTConfig::fft_cost_per_element);
+        return fft_cost < direct_cost;
+    }
+
+    /// FFT convolution along a single dimension, with overlap-save tiling of the lines along that dimension.
+    /// \param dim DHW index of the convolved dimension.
+    template<typename T, typename U, typename V>
+    void convolve_fft_lines(
+        const T* input, const Strides4<i64>& input_strides,
+        U* output, const Strides4<i64>& output_strides, const Shape4<i64>& shape,
+        const V* filter, const Shape3<i64>& filter_shape, size_t dim, i64 n_threads
+    ) {
+        using real_t = std::conditional_t<std::is_same_v<V, f64>, f64, f32>;
+        using complex_t = Complex<real_t>;
+        using plan_t = noa::cpu::fft::Plan<real_t>;
+        constexpr u32 PLAN_FLAGS = noa::cpu::fft::ESTIMATE;
+
+        const auto shape_3d = shape.pop_front();
+        const i64 size = shape_3d[dim];
+        const i64 filter_size = filter_shape[dim];
+        const i64 tile_size = convolve_fft_tile_shape(shape_3d, filter_shape)[dim];
+        const i64 tile_size_rfft = tile_size / 2 + 1;
+        const i64 valid_size = tile_size - filter_size + 1;
+        const i64 halo = filter_size / 2;
+        const i64 n_segments = divide_up(size, valid_size);
+
+        // The lines are indexed along the two other dimensions, in the rightmost order.
+        const size_t dim_0 = dim == 0 ? 1 : 0;
+        const size_t dim_1 = dim == 2 ? 1 : 2;
+        const i64 n_lines = shape_3d[dim_0] * shape_3d[dim_1];
+        const i64 n_lines_per_task = clamp(ConvolutionFFTConfig::max_lines_size / tile_size, i64{1}, n_lines);
+        const i64 n_blocks = divide_up(n_lines, n_lines_per_task);
+        const auto lines_shape = Shape4<i64>{n_lines_per_task, 1, 1, tile_size};
+
+        // Spectrum of the flipped filter, with the normalization of the transforms.
+        auto filter_rfft = AllocatorHeap<complex_t>::allocate(tile_size_rfft);
+        {
+            auto filter_padded = AllocatorHeap<real_t>::allocate(tile_size);
+            std::fill_n(filter_padded.get(), tile_size, real_t{});
+            for (i64 i{}; i < filter_size; ++i)
+                filter_padded[filter_size - 1 - i] = static_cast<real_t>(filter[i]);
+            plan_t(filter_padded.get(), filter_rfft.get(), Shape4<i64>{1, 1, 1, tile_size}, PLAN_FLAGS, 1).execute();
+            const auto scale = 1 / static_cast<real_t>(tile_size);
+            for (i64 i{}; i < tile_size_rfft; ++i)
+                filter_rfft[i] *= scale;
+        }
+
+        const auto convolve_lines = [&](i64 batch, i64 block, i64 segment, real_t* buffer, complex_t* buffer_rfft,
+                                        plan_t& forward, plan_t& backward) {
+            const i64 first_line = block * n_lines_per_task;
+            const i64 n_lines_in_block = min(n_lines_per_task, n_lines - first_line);
+            const i64 output_start = segment * valid_size;
+            const i64 input_start = output_start - halo;
+            const i64 n_valid = min(valid_size, size - output_start);
+
+            // Gather the segments, with the filter halo and zero padding.
+            const T* input_batch = input + input_strides[0] * batch;
+            const i64 input_stride = input_strides[dim + 1];
+            for (i64 line{}; line < n_lines_in_block; ++line) {
+                const i64 index = first_line + line;
+                const T* input_line = input_batch +
+                                      (index / shape_3d[dim_1]) * input_strides[dim_0 + 1] +
+                                      (index % shape_3d[dim_1]) * input_strides[dim_1 + 1];
+                real_t* segment_buffer = buffer + line * tile_size;
+                for (i64 i{}; i < tile_size; ++i) {
+                    const i64 ii = input_start + i;
+                    segment_buffer[i] = ii >= 0 and ii < size ?
+                                        static_cast<real_t>(input_line[ii * input_stride]) : real_t{};
+                }
+            }
+
+            forward.execute();
+            for (i64 line{}; line < n_lines_in_block; ++line)
+                for (i64 i{}; i < tile_size_rfft; ++i)
+                    buffer_rfft[line * tile_size_rfft + i] *= filter_rfft[i];
+            backward.execute();
+
+            // Scatter the valid region of the circular convolutions.
+            U* output_batch = output + output_strides[0] * batch;
+            const i64 output_stride = output_strides[dim + 1];
+            for (i64 line{}; line < n_lines_in_block; ++line) {
+                const i64 index = first_line + line;
+                U* output_line = output_batch +
+                                 (index / shape_3d[dim_1]) * output_strides[dim_0 + 1] +
+                                 (index % shape_3d[dim_1]) * output_strides[dim_1 + 1];
+                const real_t* segment_buffer = buffer + line * tile_size + filter_size - 1;
+                for (i64 i{}; i < n_valid; ++i)
+                    output_line[(output_start + i) * output_stride] = static_cast<U>(segment_buffer[i]);
+            }
+        };
+
+        // Each thread has its own buffers and plans, and convolves entire batches of segments.
+        const i64 n_tasks = shape[0] * n_blocks * n_segments;
+        const i64 actual_n_threads = min(n_threads, n_tasks);
+        #pragma omp parallel num_threads(actual_n_threads) default(none) \
+            shared(n_tasks, n_blocks, n_segments, tile_size, tile_size_rfft, n_lines_per_task, lines_shape, convolve_lines)
+        {
+            // The last block may have fewer lines. The extra lines are transformed but not used,
+            // so initialize them once.
+            auto buffer = AllocatorHeap<real_t>::allocate(n_lines_per_task * tile_size);
+            auto buffer_rfft = AllocatorHeap<complex_t>::allocate(n_lines_per_task * tile_size_rfft);
+            std::fill_n(buffer.get(), n_lines_per_task * tile_size, real_t{});
+            auto forward = plan_t(buffer.get(), buffer_rfft.get(), lines_shape, PLAN_FLAGS, 1);
+            auto backward = plan_t(buffer_rfft.get(), buffer.get(), lines_shape, PLAN_FLAGS, 1);
+
+            #pragma omp for
+            for (i64 task = 0; task < n_tasks; ++task) {
+                const i64 segment = task % n_segments;
+                const i64 block = (task / n_segments) % n_blocks;
+                const i64 batch = task / (n_segments * n_blocks);
+                convolve_lines(batch, block, segment, buffer.get(), buffer_rfft.get(), forward, backward);
+            }
+        }
+    }
+
+    /// FFT convolution, with overlap-save tiling.
+    /// The filter is a C-contiguous DHW array. The transforms are computed in the precision of the filter.
+    template<typename T, typename U, typename V>
+    void convolve_fft(
+        const T* input, const Strides4<i64>& input_strides,
+        U* output, const Strides4<i64>& output_strides, const Shape4<i64>& shape,
+        const V* filter, const Shape3<i64>& filter_shape, i64 n_threads
+    ) {
+        using real_t = std::conditional_t<std::is_same_v<V, f64>, f64, f32>;
+        using complex_t = Complex<real_t>;
+        using plan_t = noa::cpu::fft::Plan<real_t>;
+        constexpr u32 PLAN_FLAGS = noa::cpu::fft::ESTIMATE;
+
+        if (sum(filter_shape > 1) == 1) {
+            const size_t dim = filter_shape[0] > 1 ? 0 : filter_shape[1] > 1 ? 1 : 2;
+            return convolve_fft_lines(
+                input, input_strides, output, output_strides, shape,
+                filter, filter_shape, dim, n_threads);
+        }
+
+        const auto shape_3d = shape.pop_front();
+        const auto tile_shape = convolve_fft_tile_shape(shape_3d, filter_shape);
+        const auto tile_shape_4d = tile_shape.push_front(1);
+        const auto tile_strides = tile_shape.strides();
+        const auto valid_shape = tile_shape - filter_shape + 1;
+        const auto halo = filter_shape / 2;
+        const auto n_tiles_per_dim = Shape3<i64>{
+            divide_up(shape_3d[0], valid_shape[0]),
+            divide_up(shape_3d[1], valid_shape[1]),
+            divide_up(shape_3d[2], valid_shape[2]),
+        };
+        const i64 n_tiles = n_tiles_per_dim.n_elements();
+        const i64 n_elements_per_tile = tile_shape.n_elements();
+        const i64 n_elements_per_tile_rfft = tile_shape.rfft().n_elements();
+
+        // Spectrum of the flipped filter, with the normalization of the transforms.
+        auto filter_rfft = AllocatorHeap<complex_t>::allocate(n_elements_per_tile_rfft);
+        {
+            auto filter_padded = AllocatorHeap<real_t>::allocate(n_elements_per_tile);
+            std::fill_n(filter_padded.get(), n_elements_per_tile, real_t{});
+            for (i64 j{}; j < filter_shape[0]; ++j) {
+                for (i64 k{}; k < filter_shape[1]; ++k) {
+                    for (i64 l{}; l < filter_shape[2]; ++l) {
+                        const i64 flipped = ni::offset_at(
+                            tile_strides, filter_shape[0] - 1 - j, filter_shape[1] - 1 - k, filter_shape[2] - 1 - l);
+                        filter_padded[flipped] = static_cast<real_t>(
+                            filter[(j * filter_shape[1] + k) * filter_shape[2] + l]);
+                    }
+                }
+            }
+            plan_t(filter_padded.get(), filter_rfft.get(), tile_shape_4d, PLAN_FLAGS, n_threads).execute();
+            const auto scale = 1 / static_cast<real_t>(n_elements_per_tile);
+            for (i64 i{}; i < n_elements_per_tile_rfft; ++i)
+                filter_rfft[i] *= scale;
+        }
+
+        const auto convolve_tile = [&](i64 batch, i64 tile, real_t* buffer, complex_t* buffer_rfft,
+                                       plan_t& forward, plan_t& backward) {
+            const auto tile_indices = ni::offset2index(tile, n_tiles_per_dim);
+            const auto output_start = tile_indices * valid_shape.vec;
+
+            // Gather the input, with the filter halo and zero padding.
+            const auto input_start = output_start - halo.vec;
+            const T* input_batch = input + input_strides[0] * batch;
+            for (i64 j{}; j < tile_shape[0]; ++j) {
+                const i64 ij = input_start[0] + j;
+                const bool is_valid_j = ij >= 0 and ij < shape_3d[0];
+                for (i64 k{}; k < tile_shape[1]; ++k) {
+                    const i64 ik = input_start[1] + k;
+                    const bool is_valid_jk = is_valid_j and ik >= 0 and ik < shape_3d[1];
+                    real_t* row = buffer + (j * tile_shape[1] + k) * tile_shape[2];
+                    if (not is_valid_jk) {
+                        std::fill_n(row, tile_shape[2], real_t{});
+                        continue;
+                    }
+                    const T* input_row = input_batch + ij * input_strides[1] + ik * input_strides[2];
+                    for (i64 l{}; l < tile_shape[2]; ++l) {
+                        const i64 il = input_start[2] + l;
+                        row[l] = il >= 0 and il < shape_3d[2] ?
+                                 static_cast<real_t>(input_row[il * input_strides[3]]) : real_t{};
+                    }
+                }
+            }
+
+            forward.execute();
+            for (i64 i{}; i < n_elements_per_tile_rfft; ++i)
+                buffer_rfft[i] *= filter_rfft[i];
+            backward.execute();
+
+            // Scatter the valid region of the circular convolution.
+            const auto offset = filter_shape.vec - 1;
+            U* output_batch = output + output_strides[0] * batch;
+            for (i64 j{}; j < min(valid_shape[0], shape_3d[0] - output_start[0]); ++j) {
+                for (i64 k{}; k < min(valid_shape[1], shape_3d[1] - output_start[1]); ++k) {
+                    const real_t* row = buffer + ((offset[0] + j) * tile_shape[1] + offset[1] + k) * tile_shape[2];
+                    U* output_row = output_batch +
+                                    (output_start[0] + j) * output_strides[1] +
+                                    (output_start[1] + k) * output_strides[2];
+                    for (i64 l{}; l < min(valid_shape[2], shape_3d[2] - output_start[2]); ++l)
+                        output_row[(output_start[2] + l) * output_strides[3]] = static_cast<U>(row[offset[2] + l]);
+                }
+            }
+        };
+
+        // Each thread has its own buffers and plans, and convolves entire tiles.
+        const i64 n_tasks = shape[0] * n_tiles;
+        const i64 actual_n_threads = min(n_threads, n_tasks);
+        #pragma omp parallel num_threads(actual_n_threads) default(none) \
+            shared(n_tasks, n_tiles, n_elements_per_tile, n_elements_per_tile_rfft, tile_shape_4d, convolve_tile)
+        {
+            auto buffer = AllocatorHeap<real_t>::allocate(n_elements_per_tile);
+            auto buffer_rfft = AllocatorHeap<complex_t>::allocate(n_elements_per_tile_rfft);
+            auto forward = plan_t(buffer.get(), buffer_rfft.get(), tile_shape_4d, PLAN_FLAGS, 1);
+            auto backward = plan_t(buffer_rfft.get(), buffer.get(), tile_shape_4d, PLAN_FLAGS, 1);
+
+            #pragma omp for
+            for (i64 task = 0; task < n_tasks; ++task)
+                convolve_tile(task / n_tiles, task % n_tiles, buffer.get(), buffer_rfft.get(), forward, backward);
+        }
+    }
+}
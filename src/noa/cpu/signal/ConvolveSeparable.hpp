@@ -0,0 +1,339 @@
+#pragma once
+
+#include <omp.h>
+#include <algorithm>
+#include <vector>
+#include "noa/core/Config.hpp"
+#include "noa/core/math/Generic.hpp"
+#include "noa/core/types/Shape.hpp"
+#include "noa/cpu/AllocatorHeap.hpp"
+
+// Separable convolution, streaming the rows through ring buffers.
+// The height is divided into strips of rows, and each strip goes through the depth planes in order. For each plane,
+// the rows of the strip (plus the halo of the height filter) are gathered and convolved along the width, one at a
+// time, into a ring buffer of filter_height_size rows. As soon as the ring contains the rows needed by an output
+// row, this row is convolved along the height. The result is saved in a second ring buffer of filter_depth_size
+// planes (restricted to the strip), from which the output plane is convolved along the depth. As such, the input is
+// read once, the output is written once, and the intermediate rows stay in the cache. The height halo of each strip
+// is convolved twice, so strips are made as tall as the cache allows.
+//
+// The inner loops go through adjacent output elements, so that the compiler can vectorize them. Along the width,
+// blocks of adjacent outputs are accumulated in registers. Symmetric filters (e.g. gaussians) are folded: the taps
+// sharing the same weight are added before being multiplied.
+
+namespace noa::cpu::signal::guts {
+    struct ConvolutionSeparableConfig {
+        // Maximum size of the ring buffer of planes (when the depth is convolved).
+        static constexpr i64 max_ring_bytes = 1'048'576;
+        static constexpr i64 min_strip_size = 8;
+        static constexpr i64 max_strip_size = 256;
+
+        // Number of adjacent outputs accumulated in registers when convolving along the width.
+        static constexpr i64 block_size = 16;
+
+        // Cost model of the FFT convolution (see ConvolveFFT.hpp), in ns per filter tap, per output element.
+        // Measured with benchmarks/src/BenchConvolve.cpp, for one dimension.
+        static constexpr f64 cost_per_tap = 0.2;
+    };
+
+    template<typename T>
+    struct SeparableFilter {
+        AllocatorHeap<T>::alloc_unique_type buffer;
+        const T* data;
+        i64 size;
+        i64 halo;
+        bool is_symmetric;
+    };
+
+    /// Converts the filter to the compute type. An empty filter is the identity.
+    template<typename T, typename U>
+    auto make_separable_filter(const U* filter, i64 filter_size) {
+        if (not filter or filter_size <= 0)
+            filter_size = 1;
+        auto buffer = AllocatorHeap<T>::allocate(filter_size);
+        for (i64 i{}; i < filter_size; ++i)
+            buffer[i] = filter ? static_cast<T>(filter[i]) : T{1};
+
+        bool is_symmetric{true};
+        for (i64 i{}; i < filter_size / 2; ++i)
+            is_symmetric = is_symmetric and buffer[i] == buffer[filter_size - 1 - i];
+
+        const T* data = buffer.get();
+        return SeparableFilter<T>{std::move(buffer), data, filter_size, filter_size / 2, is_symmetric};
+    }
+
+    /// Convolves a row along the width: output[l] = sum(filter[t] * padded[l + t]), with l in [0, n).
+    /// The outputs are computed by blocks, so \p output should have at least n rounded up to the block size
+    /// elements, and \p padded, that many elements plus filter.size - 1.
+    template<typename T>
+    void convolve_separable_row(
+        const SeparableFilter<T>& filter,
+        const T* NOA_RESTRICT_ATTRIBUTE padded,
+        T* NOA_RESTRICT_ATTRIBUTE output,
+        i64 n
+    ) {
+        constexpr i64 BLOCK_SIZE = ConvolutionSeparableConfig::block_size;
+        const T* weights = filter.data;
+        const i64 size = filter.size;
+
+        for (i64 l{}; l < n; l += BLOCK_SIZE) {
+            T accumulator[BLOCK_SIZE]{};
+            const T* input = padded + l;
+            if (filter.is_symmetric) {
+                for (i64 t{}; t < size / 2; ++t) {
+                    const T weight = weights[t];
+                    const T* lhs = input + t;
+                    const T* rhs = input + size - 1 - t;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * (lhs[b] + rhs[b]);
+                }
+                if (size % 2) {
+                    const T weight = weights[filter.halo];
+                    const T* center = input + filter.halo;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * center[b];
+                }
+            } else {
+                for (i64 t{}; t < size; ++t) {
+                    const T weight = weights[t];
+                    const T* tap = input + t;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * tap[b];
+                }
+            }
+            for (i64 b{}; b < BLOCK_SIZE; ++b)
+                output[l + b] = accumulator[b];
+        }
+    }
+
+    /// Convolves across rows: output[i] = sum(filter[t] * rows[t][offset + i]), with i in [0, n).
+    /// As with convolve_separable_row, the rows and output should have at least n rounded up to the block size
+    /// elements.
+    template<typename T>
+    void convolve_separable_rows(
+        const SeparableFilter<T>& filter,
+        const T* const* rows, i64 offset,
+        T* NOA_RESTRICT_ATTRIBUTE output,
+        i64 n
+    ) {
+        constexpr i64 BLOCK_SIZE = ConvolutionSeparableConfig::block_size;
+        const T* weights = filter.data;
+        const i64 size = filter.size;
+
+        for (i64 i{}; i < n; i += BLOCK_SIZE) {
+            T accumulator[BLOCK_SIZE]{};
+            const i64 start = offset + i;
+            if (filter.is_symmetric) {
+                for (i64 t{}; t < size / 2; ++t) {
+                    const T weight = weights[t];
+                    const T* NOA_RESTRICT_ATTRIBUTE lhs = rows[t] + start;
+                    const T* NOA_RESTRICT_ATTRIBUTE rhs = rows[size - 1 - t] + start;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * (lhs[b] + rhs[b]);
+                }
+                if (size % 2) {
+                    const T weight = weights[filter.halo];
+                    const T* NOA_RESTRICT_ATTRIBUTE center = rows[filter.halo] + start;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * center[b];
+                }
+            } else {
+                for (i64 t{}; t < size; ++t) {
+                    const T weight = weights[t];
+                    const T* NOA_RESTRICT_ATTRIBUTE tap = rows[t] + start;
+                    for (i64 b{}; b < BLOCK_SIZE; ++b)
+                        accumulator[b] += weight * tap[b];
+                }
+            }
+            for (i64 b{}; b < BLOCK_SIZE; ++b)
+                output[i + b] = accumulator[b];
+        }
+    }
+
+    /// Copies and converts a row. Contiguous rows are vectorized.
+    template<typename T, typename U>
+    void convert_separable_row(
+        const T* NOA_RESTRICT_ATTRIBUTE input, i64 input_stride,
+        U* NOA_RESTRICT_ATTRIBUTE output, i64 output_stride,
+        i64 n
+    ) {
+        if (input_stride == 1 and output_stride == 1) {
+            for (i64 i{}; i < n; ++i)
+                output[i] = static_cast<U>(input[i]);
+        } else {
+            for (i64 i{}; i < n; ++i)
+                output[i * output_stride] = static_cast<U>(input[i * input_stride]);
+        }
+    }
+
+    /// Separable convolution, in a single pass over the input and output.
+    /// Filters that are nullptr (or empty) are ignored. The convolution is computed in the precision of the
+    /// filters (half-precision filters are computed in single-precision).
+    template<typename T, typename U, typename V>
+    void convolve_separable_streaming(
+        const T* input, const Strides4<i64>& input_strides,
+        U* output, const Strides4<i64>& output_strides, const Shape4<i64>& shape,
+        const V* filter_depth, i64 filter_depth_size,
+        const V* filter_height, i64 filter_height_size,
+        const V* filter_width, i64 filter_width_size,
+        i64 n_threads
+    ) {
+        using compute_t = std::conditional_t<std::is_same_v<V, f64>, f64, f32>;
+        using config_t = ConvolutionSeparableConfig;
+
+        const auto fd = make_separable_filter<compute_t>(filter_depth, filter_depth_size);
+        const auto fh = make_separable_filter<compute_t>(filter_height, filter_height_size);
+        const auto fw = make_separable_filter<compute_t>(filter_width, filter_width_size);
+
+        const i64 depth = shape[1];
+        const i64 height = shape[2];
+        const i64 width = shape[3];
+        const bool has_depth = fd.size > 1;
+
+        // The rows are computed by blocks, so the internal buffers are padded to a multiple of the block size.
+        const i64 pitch = divide_up(width, config_t::block_size) * config_t::block_size;
+
+        // If the depth is convolved, the strips go through every plane and the ring of planes should fit in
+        // the cache. Otherwise, planes are independent, and the strips only need to be large enough to amortize
+        // the height halo.
+        const i64 bytes_per_row = pitch * static_cast<i64>(sizeof(compute_t));
+        i64 strip_size{};
+        if (has_depth)
+            strip_size = config_t::max_ring_bytes / (fd.size * bytes_per_row);
+        else
+            strip_size = divide_up(height, max(n_threads, i64{1}));
+        strip_size = min(height, clamp(strip_size, config_t::min_strip_size, config_t::max_strip_size));
+
+        const i64 n_strips = divide_up(height, strip_size);
+        const i64 n_planes_per_task = has_depth ? depth : 1;
+        const i64 n_tasks = shape[0] * (depth / n_planes_per_task) * n_strips;
+        const i64 n_elements_per_slab = strip_size * pitch;
+        const i64 n_elements_padded = pitch + fw.size - 1;
+
+        const auto convolve_strip = [&](
+            i64 task, compute_t* padded, compute_t* rows, compute_t* slabs, const compute_t* zeros,
+            compute_t* line, const compute_t** pointers
+        ) {
+            const i64 strip = task % n_strips;
+            const i64 plane_start = (task / n_strips) % (depth / n_planes_per_task) * n_planes_per_task;
+            const i64 batch = task / n_strips / (depth / n_planes_per_task);
+            const i64 row_start = strip * strip_size;
+            const i64 n_rows = min(strip_size, height - row_start);
+            const T* input_batch = input + input_strides[0] * batch;
+            U* output_batch = output + output_strides[0] * batch;
+
+            // Convolves the strip of plane j along the width and height.
+            // The output row r is passed to the consumer, which should save or use it immediately.
+            const auto convolve_plane = [&](i64 j, auto&& consumer) {
+                for (i64 r{}; r < n_rows + fh.size - 1; ++r) {
+                    compute_t* row = rows + (r % fh.size) * pitch;
+                    const i64 k = row_start - fh.halo + r;
+                    if (k < 0 or k >= height) {
+                        std::fill_n(row, pitch, compute_t{});
+                    } else {
+                        const T* input_row = input_batch + j * input_strides[1] + k * input_strides[2];
+                        convert_separable_row(input_row, input_strides[3], padded + fw.halo, 1, width);
+                        convolve_separable_row(fw, padded, row, width);
+                    }
+
+                    // Once the ring has the rows of the output row, convolve along the height.
+                    const i64 output_row = r - fh.size + 1;
+                    if (output_row >= 0) {
+                        for (i64 t{}; t < fh.size; ++t)
+                            pointers[t] = rows + ((output_row + t) % fh.size) * pitch;
+                        consumer(output_row);
+                    }
+                }
+            };
+
+            if (not has_depth) {
+                const compute_t scale = fd.data[0];
+                U* output_plane = output_batch + plane_start * output_strides[1];
+                convolve_plane(plane_start, [&](i64 r) {
+                    convolve_separable_rows(fh, pointers, 0, line, width);
+                    if (scale != 1) {
+                        for (i64 l{}; l < width; ++l)
+                            line[l] *= scale;
+                    }
+                    U* output_row = output_plane + (row_start + r) * output_strides[2];
+                    convert_separable_row(line, 1, output_row, output_strides[3], width);
+                });
+                return;
+            }
+
+            // The planes are saved in a ring buffer: plane p is at the slab p % fd.size.
+            // To compute the output plane j, the ring should contain the planes [j - halo, j + ahead].
+            const i64 ahead = fd.size - 1 - fd.halo;
+            const auto save_plane = [&](i64 p) {
+                compute_t* slab = slabs + (p % fd.size) * n_elements_per_slab;
+                convolve_plane(p, [&](i64 r) {
+                    convolve_separable_rows(fh, pointers, 0, slab + r * pitch, width);
+                });
+            };
+            for (i64 p{}; p < min(ahead, depth); ++p)
+                save_plane(p);
+
+            for (i64 j{}; j < depth; ++j) {
+                if (j + ahead < depth)
+                    save_plane(j + ahead);
+
+                // Planes outside the volume are zeros.
+                for (i64 t{}; t < fd.size; ++t) {
+                    const i64 p = j - fd.halo + t;
+                    pointers[t] = p >= 0 and p < depth ? slabs + (p % fd.size) * n_elements_per_slab : zeros;
+                }
+                U* output_plane = output_batch + j * output_strides[1];
+                for (i64 r{}; r < n_rows; ++r) {
+                    convolve_separable_rows(fd, pointers, r * pitch, line, width);
+                    U* output_row = output_plane + (row_start + r) * output_strides[2];
+                    convert_separable_row(line, 1, output_row, output_strides[3], width);
+                }
+            }
+        };
+
+        // Each thread has its own buffers, and convolves entire strips.
+        struct Buffers {
+            AllocatorHeap<compute_t>::alloc_unique_type padded;
+            AllocatorHeap<compute_t>::alloc_unique_type rows;
+            AllocatorHeap<compute_t>::alloc_unique_type line;
+            AllocatorHeap<compute_t>::alloc_unique_type slabs;
+            AllocatorHeap<compute_t>::alloc_unique_type zeros;
+            std::vector<const compute_t*> pointers;
+        };
+        const auto allocate_buffers = [&] {
+            Buffers buffers{
+                .padded = AllocatorHeap<compute_t>::allocate(n_elements_padded),
+                .rows = AllocatorHeap<compute_t>::allocate(fh.size * pitch),
+                .line = AllocatorHeap<compute_t>::allocate(pitch),
+                .pointers = std::vector<const compute_t*>(static_cast<size_t>(max(fd.size, fh.size))),
+            };
+            std::fill_n(buffers.padded.get(), n_elements_padded, compute_t{});
+            if (has_depth) {
+                buffers.slabs = AllocatorHeap<compute_t>::allocate(fd.size * n_elements_per_slab);
+                buffers.zeros = AllocatorHeap<compute_t>::allocate(n_elements_per_slab);
+                std::fill_n(buffers.zeros.get(), n_elements_per_slab, compute_t{});
+            }
+            return buffers;
+        };
+        const auto convolve_task = [&](i64 task, Buffers& buffers) {
+            convolve_strip(task, buffers.padded.get(), buffers.rows.get(), buffers.slabs.get(),
+                           buffers.zeros.get(), buffers.line.get(), buffers.pointers.data());
+        };
+
+        const i64 actual_n_threads = min(n_threads, n_tasks);
+        if (actual_n_threads > 1) {
+            #pragma omp parallel num_threads(actual_n_threads) default(none) \
+                shared(n_tasks, allocate_buffers, convolve_task)
+            {
+                auto buffers = allocate_buffers();
+                #pragma omp for
+                for (i64 task = 0; task < n_tasks; ++task)
+                    convolve_task(task, buffers);
+            }
+        } else {
+            auto buffers = allocate_buffers();
+            for (i64 task{}; task < n_tasks; ++task)
+                convolve_task(task, buffers);
+        }
+    }
+}
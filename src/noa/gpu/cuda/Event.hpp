@@ -101,4 +101,9 @@ namespace noa::cuda {
         cudaEvent_t m_event{nullptr};
         Device m_device{};
     };
+
+    inline void Stream::wait(const Event& event) const {
+        const DeviceGuard guard(m_device);
+        check(cudaStreamWaitEvent(get(), event.get(), 0));
+    }
 }
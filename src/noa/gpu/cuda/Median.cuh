@@ -8,25 +8,30 @@
 #include "noa/gpu/cuda/Sort.cuh"
 
 namespace noa::cuda {
+    /// If the input is const, the overwrite parameter is ignored and the input is copied into a buffer.
     template<typename T>
-    T median(
+    auto quantile(
         T* input,
         Strides4<i64> strides,
         Shape4<i64> shape,
+        f64 quantile,
         bool overwrite,
         Stream& stream
-    ) {
+    ) -> std::remove_const_t<T> {
+        using value_t = std::remove_const_t<T>;
         const auto order = ni::order(strides, shape);
         strides = ni::reorder(strides, order);
         shape = ni::reorder(shape, order);
 
         const auto n_elements = shape.n_elements();
-        typename AllocatorDevice<T>::unique_type buffer;
-        T* to_sort{};
-        if (overwrite and ni::are_contiguous(strides, shape)) {
-            to_sort = input;
-        } else {
-            buffer = AllocatorDevice<T>::allocate_async(n_elements, stream);
+        typename AllocatorDevice<value_t>::unique_type buffer;
+        value_t* to_sort{};
+        if constexpr (not std::is_const_v<T>) {
+            if (overwrite and ni::are_contiguous(strides, shape))
+                to_sort = input;
+        }
+        if (not to_sort) {
+            buffer = AllocatorDevice<value_t>::allocate_async(n_elements, stream);
             to_sort = buffer.get();
             copy(input, strides, to_sort, shape.strides(), shape, stream);
         }
@@ -35,14 +40,29 @@ namespace noa::cuda {
         const auto shape_1d = Shape4<i64>{1, 1, 1, n_elements};
         sort(to_sort, shape_1d.strides(), shape_1d, true, -1, stream);
 
-        // Retrieve the median.
-        const bool is_even = noa::is_even(n_elements);
-        T out[2];
-        copy(to_sort + (n_elements - is_even) / 2, out, 1 + is_even, stream);
+        // Retrieve the two closest ranks and interpolate (same as numpy's "linear" method).
+        const f64 position = clamp(quantile, 0., 1.) * static_cast<f64>(n_elements - 1);
+        const auto rank = static_cast<i64>(floor(position));
+        const f64 weight = position - static_cast<f64>(rank);
+        const bool interpolate = weight != 0;
+        value_t out[2];
+        copy(to_sort + rank, out, 1 + interpolate, stream);
         stream.synchronize();
 
-        if (is_even)
-            return (out[0] + out[1]) / T{2};
-        return out[0];
+        if (not interpolate)
+            return out[0];
+        const auto lhs = static_cast<f64>(out[0]);
+        return static_cast<value_t>(lhs + (static_cast<f64>(out[1]) - lhs) * weight);
+    }
+
+    template<typename T>
+    auto median(
+        T* input,
+        Strides4<i64> strides,
+        Shape4<i64> shape,
+        bool overwrite,
+        Stream& stream
+    ) -> std::remove_const_t<T> {
+        return quantile(input, strides, shape, 0.5, overwrite, stream);
     }
 }
@@ -151,6 +151,91 @@ namespace noa::cuda::guts {
         }
     }
 
+    // Sorts the lines of keys and reorders the values accordingly, one line at a time, using cub radix sort.
+    // Lines are copied to contiguous buffers, so the keys and values can have any strides.
+    // If ARGSORT is true, the values are only written to, and are set to the index of the sorted keys.
+    template<bool ARGSORT, typename K, typename V>
+    void sort_pairs_iterative_(
+        const K* keys, const Strides4<i64>& keys_strides, K* keys_output,
+        V* values, const Strides4<i64>& values_strides,
+        const Shape4<i64>& shape, i32 dim, bool ascending, Stream& stream
+    ) {
+        const auto dim_size = safe_cast<i32>(shape[dim]);
+        const auto dim_shape = Shape4<i64>{1, 1, 1, shape[dim]};
+        const auto dim_keys_strides = Strides4<i64>{1, 1, 1, keys_strides[dim]};
+        const auto dim_values_strides = Strides4<i64>{1, 1, 1, values_strides[dim]};
+
+        const auto key_buffer = AllocatorDevice<K>::allocate_async(dim_size, stream);
+        const auto key_buffer_alt = AllocatorDevice<K>::allocate_async(dim_size, stream);
+        const auto value_buffer = AllocatorDevice<V>::allocate_async(dim_size, stream);
+        const auto value_buffer_alt = AllocatorDevice<V>::allocate_async(dim_size, stream);
+        cub::DoubleBuffer<K> cub_keys(key_buffer.get(), key_buffer_alt.get());
+        cub::DoubleBuffer<V> cub_values(value_buffer.get(), value_buffer_alt.get());
+
+        // The indices are the same for every line, so compute them once.
+        using unique_t = typename AllocatorDevice<V>::unique_type;
+        unique_t iota;
+        if constexpr (ARGSORT) {
+            iota = AllocatorDevice<V>::allocate_async(dim_size, stream);
+            auto accessor = AccessorContiguousI32<V, 1>(iota.get());
+            using op_t = ng::IwiseRange<1, decltype(accessor), i32, Arange<V>>;
+            iwise(Shape1<i32>{dim_size}, op_t(accessor, Shape1<i32>{}, Arange<V>{}), stream);
+        }
+
+        size_t temp_storage_bytes{};
+        check(cub_radix_sort_pairs_<K, V>(
+            nullptr, temp_storage_bytes, cub_keys, cub_values, dim_size, ascending, stream));
+        const auto temp_storage = AllocatorDevice<Byte>::allocate_async(
+            static_cast<i64>(temp_storage_bytes), stream);
+
+        Shape3<i64> iter_shape;
+        Strides3<i64> iter_keys_strides;
+        Strides3<i64> iter_values_strides;
+        for (i32 i{}, count{}; i < 4; ++i) {
+            if (i != dim) {
+                iter_shape[count] = shape[i];
+                iter_keys_strides[count] = keys_strides[i];
+                iter_values_strides[count] = values_strides[i];
+                ++count;
+            }
+        }
+
+        for (i64 i = 0; i < iter_shape[0]; ++i) {
+            for (i64 j = 0; j < iter_shape[1]; ++j) {
+                for (i64 k = 0; k < iter_shape[2]; ++k) {
+                    const i64 key_offset = ni::offset_at(iter_keys_strides, i, j, k);
+                    const i64 value_offset = ni::offset_at(iter_values_strides, i, j, k);
+
+                    cub_keys.selector = 0;
+                    cub_values.selector = 0;
+                    copy(keys + key_offset, dim_keys_strides,
+                         key_buffer.get(), dim_shape.strides(),
+                         dim_shape, stream);
+                    if constexpr (ARGSORT) {
+                        copy(iota.get(), value_buffer.get(), dim_size, stream);
+                    } else {
+                        copy(values + value_offset, dim_values_strides,
+                             value_buffer.get(), dim_shape.strides(),
+                             dim_shape, stream);
+                    }
+
+                    check(cub_radix_sort_pairs_<K, V>(
+                        temp_storage.get(), temp_storage_bytes,
+                        cub_keys, cub_values, dim_size, ascending, stream));
+
+                    if (keys_output) {
+                        copy(cub_keys.Current(), dim_shape.strides(),
+                             keys_output + key_offset, dim_keys_strides,
+                             dim_shape, stream);
+                    }
+                    copy(cub_values.Current(), dim_shape.strides(),
+                         values + value_offset, dim_values_strides,
+                         dim_shape, stream);
+                }
+            }
+        }
+    }
+
     // Sort any dimension [0..3] of the input array, in-place.
     // The array can have non-contiguous strides in any dimension.
     // Basically allocates 3 to 4 times the shape...
@@ -261,4 +346,35 @@ namespace noa::cuda {
         else
             guts::sort_batched_(array, strides, shape, dim, ascending, stream);
     }
+
+    template<typename K, typename V>
+    void sort_by_key(
+        K* keys, const Strides4<i64>& keys_strides,
+        V* values, const Strides4<i64>& values_strides,
+        const Shape4<i64>& shape, bool ascending, i32 dim, Stream& stream
+    ) {
+        if (dim == -1)
+            dim = shape[3] > 1 ? 3 : shape[2] > 1 ? 2 : shape[1] > 1 ? 1 : 0;
+        NOA_ASSERT(dim >= 0 and dim <= 3);
+        if (keys_strides[dim] == 0)
+            return;
+
+        guts::sort_pairs_iterative_<false>(
+            keys, keys_strides, keys, values, values_strides, shape, dim, ascending, stream);
+    }
+
+    template<typename T, typename I>
+    void argsort(
+        const T* input, const Strides4<i64>& input_strides,
+        I* indices, const Strides4<i64>& indices_strides,
+        const Shape4<i64>& shape, bool ascending, i32 dim, Stream& stream
+    ) {
+        if (dim == -1)
+            dim = shape[3] > 1 ? 3 : shape[2] > 1 ? 2 : shape[1] > 1 ? 1 : 0;
+        NOA_ASSERT(dim >= 0 and dim <= 3);
+
+        T* keys_output{};
+        guts::sort_pairs_iterative_<true>(
+            input, input_strides, keys_output, indices, indices_strides, shape, dim, ascending, stream);
+    }
 }
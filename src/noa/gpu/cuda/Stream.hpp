@@ -137,6 +137,8 @@ namespace noa::cuda::guts {
 }
 
 namespace noa::cuda {
+    class Event;
+
     struct LaunchConfig {
         dim3 n_blocks;
         dim3 n_threads;
@@ -268,6 +270,10 @@ namespace noa::cuda {
             m_core->resource_registry.clear_after_sync();
         }
 
+        // Makes the work enqueued after this call wait on the event. This call doesn't block the host.
+        // Defined in noa/gpu/cuda/Event.hpp.
+        void wait(const Event& event) const;
+
         [[nodiscard]] cudaStream_t get() const noexcept {
             NOA_ASSERT(m_core);
             return m_core->stream_handle;
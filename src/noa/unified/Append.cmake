@@ -26,6 +26,7 @@ set(NOA_UNIFIED_HEADERS
     unified/Stream.hpp
     unified/Subregion.hpp
     unified/Texture.hpp
+    unified/Trace.hpp
     unified/Traits.hpp
     unified/Utilities.hpp
     unified/View.hpp
@@ -33,6 +34,7 @@ set(NOA_UNIFIED_HEADERS
     # noa::fft
     unified/fft/Factory.hpp
     unified/fft/Remap.hpp
+    unified/fft/Pyramid.hpp
     unified/fft/Resize.hpp
     unified/fft/Transform.hpp
 
@@ -55,6 +57,7 @@ set(NOA_UNIFIED_HEADERS
     unified/geometry/PolarTransform.hpp
     unified/geometry/PolarTransformSpectrum.hpp
     unified/geometry/Project.hpp
+    unified/geometry/ResamplingPlan.hpp
     unified/geometry/RotationalAverage.hpp
     unified/geometry/Symmetry.hpp
     unified/geometry/Transform.hpp
@@ -66,6 +69,7 @@ set(NOA_UNIFIED_SOURCES
     unified/Device.cpp
     unified/Session.cpp
     unified/Stream.cpp
+    unified/Trace.cpp
     )
 
 set(NOA_HEADERS ${NOA_HEADERS} ${NOA_UNIFIED_HEADERS})
@@ -77,6 +77,23 @@ namespace noa::inline types {
         }
 
     private:
+        friend class Stream;
         variant_type m_event;
     };
+
+    inline void Stream::wait(const Event& event) {
+        if (device().is_cpu()) {
+            const auto* cpu_event = std::get_if<Event::cpu_event_t>(&event.m_event);
+            check(cpu_event, "CPU streams can only wait on CPU events");
+            cpu().wait(*cpu_event);
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            const auto* gpu_event = std::get_if<Event::gpu_event_t>(&event.m_event);
+            check(gpu_event, "GPU streams can only wait on GPU events");
+            gpu().wait(*gpu_event);
+            #else
+            panic();
+            #endif
+        }
+    }
 }
@@ -4,6 +4,7 @@
 #include "noa/unified/Traits.hpp"
 #include "noa/unified/Stream.hpp"
 #include "noa/unified/Indexing.hpp"
+#include "noa/unified/Trace.hpp"
 #include "noa/unified/Utilities.hpp"
 
 #include "noa/cpu/Ewise.hpp"
@@ -29,6 +30,44 @@ namespace noa {
 namespace noa::guts {
     template<EwiseOptions, bool, bool, typename Inputs, typename Outputs, typename EwiseOp>
     void ewise(Inputs&&, Outputs&&, EwiseOp&&);
+
+    /// Creates the trace of an ewise operation. Every element of the accessed arrays is counted.
+    template<typename EwiseOp, typename InputAccessors, typename OutputAccessors>
+    auto ewise_trace(
+        const Shape4<i64>& shape,
+        const Device& device,
+        const InputAccessors& input_accessors,
+        const OutputAccessors& output_accessors,
+        i64 n_threads
+    ) -> TraceEvent {
+        i64 n_bytes_read{};
+        i64 n_bytes_written{};
+        std::string dtype;
+        input_accessors.for_each([&]<typename T>(const T&) {
+            if constexpr (nt::accessor_pure<T>) {
+                n_bytes_read += static_cast<i64>(sizeof(nt::value_type_t<T>));
+                if (dtype.empty() and std::tuple_size_v<OutputAccessors> == 0)
+                    dtype = ns::stringify<nt::mutable_value_type_t<T>>();
+            }
+        });
+        output_accessors.for_each([&]<typename T>(const T&) {
+            if constexpr (nt::accessor_pure<T>) {
+                n_bytes_written += static_cast<i64>(sizeof(nt::value_type_t<T>));
+                if (dtype.empty())
+                    dtype = ns::stringify<nt::mutable_value_type_t<T>>();
+            }
+        });
+        const i64 n_elements = shape.n_elements();
+        return {
+            .name = fmt::format("ewise<{}>", trace_type_name<std::decay_t<EwiseOp>>()),
+            .dtype = std::move(dtype),
+            .shape = shape,
+            .n_bytes_read = n_bytes_read * n_elements,
+            .n_bytes_written = n_bytes_written * n_elements,
+            .n_threads = n_threads,
+            .device = device,
+        };
+    }
 }
 
 namespace noa {
@@ -211,8 +250,17 @@ namespace noa::guts {
                     auto& cpu_stream = stream.cpu();
                     auto n_threads = cpu_stream.thread_limit();
                     using config = noa::cpu::EwiseConfig<ZIP_INPUT, ZIP_OUTPUT>;
+                    guts::trace_type trace{};
+                    if constexpr (guts::TRACING) {
+                        trace = guts::make_trace([&] {
+                            return guts::ewise_trace<EwiseOp>(
+                                shape, device, input_accessors, output_accessors,
+                                guts::trace_n_threads(shape.n_elements(), n_threads, config::n_elements_per_thread));
+                        });
+                    }
 
                     if (cpu_stream.is_sync()) {
+                        const auto trace_scope = guts::TraceScope(trace);
                         noa::cpu::ewise<config>(
                             shape, std::forward<EwiseOp>(ewise_op),
                             std::move(input_accessors),
@@ -226,6 +274,7 @@ namespace noa::guts {
                             ih = guts::extract_shared_handle_from_arrays(std::forward<Inputs>(inputs)),
                             oh = guts::extract_shared_handle_from_arrays(std::forward<Outputs>(outputs))
                         ] {
+                            const auto trace_scope = guts::TraceScope(trace);
                             noa::cpu::ewise<config>(shape, std::move(op), std::move(ia), std::move(oa), n_threads);
                         });
                     }
@@ -241,6 +290,13 @@ namespace noa::guts {
                         OPTIONS.gpu_block_size,
                         OPTIONS.gpu_n_elements_per_thread,
                         OPTIONS.gpu_vectorize>;
+                    guts::trace_type trace{};
+                    if constexpr (guts::TRACING) {
+                        trace = guts::make_trace([&] {
+                            return guts::ewise_trace<EwiseOp>(shape, device, input_accessors, output_accessors, 0);
+                        });
+                    }
+                    const auto trace_scope = guts::TraceScope(trace);
                     noa::cuda::ewise<config>(
                         shape, std::forward<EwiseOp>(ewise_op),
                         std::move(input_accessors),
@@ -3,6 +3,7 @@
 #include "noa/core/types/Shape.hpp"
 #include "noa/unified/Device.hpp"
 #include "noa/unified/Stream.hpp"
+#include "noa/unified/Trace.hpp"
 #include "noa/unified/Utilities.hpp"
 
 #include "noa/cpu/Iwise.hpp"
@@ -10,10 +11,40 @@
 #include "noa/gpu/cuda/Iwise.cuh"
 #endif
 
+namespace noa::guts {
+    /// Creates the trace of an iwise operation. The access pattern of the operator is unknown,
+    /// so the varrays attached to the call are reported as read.
+    template<typename Op, typename I, size_t N, typename... Ts>
+    auto iwise_trace(const Shape<I, N>& shape, const Device& device, i64 n_threads, const Ts&... attachments) {
+        i64 n_bytes_read{};
+        auto add_bytes = [&]<typename T>(const T& attachment) {
+            if constexpr (nt::varray<T>)
+                n_bytes_read += attachment.n_elements() * static_cast<i64>(sizeof(nt::value_type_t<T>));
+        };
+        (add_bytes(attachments), ...);
+
+        auto shape_4d = Shape4<i64>::from_value(1);
+        for (size_t i{}; i < N; ++i)
+            shape_4d[4 - N + i] = static_cast<i64>(shape[i]);
+
+        return TraceEvent{
+            .name = fmt::format("iwise<{}>", trace_type_name<std::decay_t<Op>>()),
+            .shape = shape_4d,
+            .n_bytes_read = n_bytes_read,
+            .n_threads = n_threads,
+            .device = device,
+        };
+    }
+}
+
 namespace noa {
     struct IwiseOptions {
         bool generate_cpu{true};
         bool generate_gpu{true};
+
+        /// Minimum number of elements (i.e. calls to the operator) per CPU thread.
+        /// Operators doing more work per call, e.g. looping through a row, should lower this number.
+        i64 cpu_n_elements_per_thread{noa::cpu::IwiseConfig<>::n_elements_per_thread};
     };
 
     /// Index-wise core function; dispatches an index-wise operator across N-dimensional (parallel) for-loops.
@@ -40,24 +71,36 @@ namespace noa {
         Stream& stream = Stream::current(device);
         if constexpr (OPTIONS.generate_cpu) {
             if (device.is_cpu()) {
-                // TODO For now, use the default config, which is meant to trigger the parallel loop
-                //      only for large shapes. We could add a way for the user to change that default?
+                // By default, the parallel loop is only triggered for large shapes.
+                using cpu_config_t = noa::cpu::IwiseConfig<OPTIONS.cpu_n_elements_per_thread>;
                 auto& cpu_stream = stream.cpu();
                 const auto n_threads = cpu_stream.thread_limit();
-                if constexpr (sizeof...(Ts) == 0) {
+                if constexpr (sizeof...(Ts) == 0 and not guts::TRACING) {
                     cpu_stream.enqueue(
-                        noa::cpu::iwise<noa::cpu::IwiseConfig<>, N, I, Op>,
+                        noa::cpu::iwise<cpu_config_t, N, I, Op>,
                         shape, std::forward<Op>(op), n_threads);
                 } else {
+                    guts::trace_type trace{};
+                    if constexpr (guts::TRACING) {
+                        trace = guts::make_trace([&] {
+                            return guts::iwise_trace<Op>(
+                                shape, device, guts::trace_n_threads(
+                                    static_cast<i64>(shape.n_elements()), n_threads,
+                                    cpu_config_t::n_elements_per_thread),
+                                attachments...);
+                        });
+                    }
                     if (cpu_stream.is_sync()) {
-                        noa::cpu::iwise(shape, std::forward<Op>(op), n_threads);
+                        const auto trace_scope = guts::TraceScope(trace);
+                        noa::cpu::iwise<cpu_config_t>(shape, std::forward<Op>(op), n_threads);
                     } else {
                         cpu_stream.enqueue(
-                            [shape, n_threads,
+                            [shape, n_threads, trace,
                                 op_ = std::forward<Op>(op),
                                 h = guts::extract_shared_handle(forward_as_tuple(std::forward<Ts>(attachments)...))
                             ] {
-                                noa::cpu::iwise(shape, std::move(op_), n_threads);
+                                const auto trace_scope = guts::TraceScope(trace);
+                                noa::cpu::iwise<cpu_config_t>(shape, std::move(op_), n_threads);
                             });
                     }
                 }
@@ -69,7 +112,16 @@ namespace noa {
                 #ifdef NOA_ENABLE_CUDA
                 // TODO Add option to set the number of bytes of dynamic shared memory.
                 auto& cuda_stream = Stream::current(device).cuda();
-                noa::cuda::iwise(shape, std::forward<Op>(op), cuda_stream);
+                {
+                    guts::trace_type trace{};
+                    if constexpr (guts::TRACING) {
+                        trace = guts::make_trace([&] {
+                            return guts::iwise_trace<Op>(shape, device, 0, attachments...);
+                        });
+                    }
+                    const auto trace_scope = guts::TraceScope(trace);
+                    noa::cuda::iwise(shape, std::forward<Op>(op), cuda_stream);
+                }
                 cuda_stream.enqueue_attach(std::forward<Ts>(attachments)...);
                 return;
                 #else
@@ -1,34 +1,81 @@
 #pragma once
 
+#include <optional>
 #include <random>
+#include "noa/core/Iwise.hpp"
 #include "noa/core/math/Distribution.hpp"
 #include "noa/unified/Ewise.hpp"
+#include "noa/unified/Iwise.hpp"
 #include "noa/unified/Array.hpp"
 
 namespace noa {
+    struct RandomizeOptions {
+        /// Seed of the random number generator.
+        /// If empty, a seed is drawn from std::random_device.
+        std::optional<u64> seed{};
+
+        /// Whether to use the counter-based generator (Philox4x32-10). In this mode, the value of each element
+        /// only depends on the seed and on the logical (BDHW C-contiguous) index of the element. As such, the
+        /// output is reproducible, regardless of the number of threads, the device or the memory layout.
+        /// Otherwise, each thread seeds its own generator (xoshiro256), which is faster to sample from, but
+        /// the output depends on how the elements are distributed among the threads.
+        bool counter_based{false};
+    };
+
     /// Randomizes an array with uniform random values.
     /// \param[in] distribution A value distribution: Uniform, Normal, LogNormal or Poisson.
     /// \param[out] output      Array to randomize.
+    /// \param options          Generator options.
     template<nt::distribution Distribution, nt::writable_varray_decay Output>
-    void randomize(const Distribution& distribution, Output&& output) {
-        ewise({}, std::forward<Output>(output), Randomizer(distribution, std::random_device{}()));
+    void randomize(const Distribution& distribution, Output&& output, const RandomizeOptions& options = {}) {
+        const u64 seed = options.seed.has_value() ? options.seed.value() : std::random_device{}();
+        if (not options.counter_based)
+            return ewise({}, std::forward<Output>(output), Randomizer(distribution, seed));
+
+        check(not output.is_empty(), "Empty array detected");
+        using value_t = nt::mutable_value_type_t<Output>;
+        using randomizer_t = CounterBasedRandomizer<Distribution, value_t>;
+        const auto randomizer = randomizer_t{distribution, seed};
+        if (output.are_contiguous()) {
+            auto accessor = ng::to_accessor_contiguous_1d(output);
+            using op_t = ng::IwiseRange<1, decltype(accessor), i64, randomizer_t>;
+            iwise(Shape{output.n_elements()}, output.device(),
+                  op_t(accessor, Shape<i64, 1>{}, randomizer),
+                  std::forward<Output>(output));
+        } else {
+            auto accessor = ng::to_accessor(output);
+            using op_t = ng::IwiseRange<4, decltype(accessor), i64, randomizer_t>;
+            iwise(output.shape(), output.device(),
+                  op_t(accessor, output.shape(), randomizer),
+                  std::forward<Output>(output));
+        }
     }
 
     /// Returns an array initialized with random values.
     template<typename T = void, nt::distribution Distribution>
-    [[nodiscard]] auto random(const Distribution& distribution, const Shape4<i64>& shape, ArrayOption option = {}) {
+    [[nodiscard]] auto random(
+        const Distribution& distribution,
+        const Shape4<i64>& shape,
+        ArrayOption option = {},
+        const RandomizeOptions& randomize_options = {}
+    ) {
         using value_t = std::conditional_t<std::is_void_v<T>, nt::value_type_t<Distribution>, T>;
         Array<value_t> out(shape, option);
-        randomize(distribution, out);
+        randomize(distribution, out, randomize_options);
         return out;
     }
 
     /// Returns an array initialized with random values.
     template<typename T = void, nt::distribution Distribution>
-    [[nodiscard]] auto random(const Distribution& distribution, i64 n_elements, ArrayOption option = {}) {
+    [[nodiscard]] auto random(
+        const Distribution& distribution,
+        i64 n_elements,
+        ArrayOption option = {},
+        const RandomizeOptions& randomize_options = {}
+    ) {
         using value_t = std::conditional_t<std::is_void_v<T>, nt::value_type_t<Distribution>, T>;
         Array<value_t> out(n_elements, option);
-        randomize(distribution, out);
+        randomize(distribution, out, randomize_options);
         return out;
     }
 }
@@ -7,6 +7,8 @@
 #include "noa/unified/ReduceAxesEwise.hpp"
 #include "noa/unified/ReduceIwise.hpp"
 #include "noa/unified/ReduceAxesIwise.hpp"
+#include "noa/unified/Iwise.hpp"
+#include "noa/unified/Sort.hpp"
 
 #include "noa/cpu/Median.hpp"
 #ifdef NOA_ENABLE_CUDA
@@ -58,6 +60,87 @@ namespace noa::guts {
         (nt::writable_varray_decay<ArgOffset> or nt::empty<ArgOffset>) and
         (nt::numeric<InputValue, ReducedValue_> or (nt::complex<InputValue> and nt::real<ReducedValue_>)) and
         nt::numeric<ArgValue_> and nt::integer<ArgOffset_, ReducedOffset_>;
+
+    /// Retrieves the quantile of sorted lines.
+    /// The lines are stored contiguously, in the rightmost order of the (contiguous) output.
+    template<typename Input, typename Output>
+    class QuantileOfSortedLines {
+    public:
+        using input_type = Input;
+        using output_type = Output;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+
+    public:
+        constexpr QuantileOfSortedLines(
+            const input_type& lines,
+            const output_type& output,
+            const Shape4<i64>& output_shape,
+            i64 rank, f64 weight
+        ) :
+            m_lines(lines),
+            m_output(output),
+            m_output_contiguous_strides(output_shape.strides()),
+            m_rank(rank),
+            m_weight(weight) {}
+
+        NOA_HD constexpr void operator()(i64 i, i64 j, i64 k, i64 l) const {
+            const i64 line = ni::offset_at(m_output_contiguous_strides, i, j, k, l);
+            const input_value_type lhs = m_lines(line, m_rank);
+            if (m_weight == 0) {
+                m_output(i, j, k, l) = static_cast<output_value_type>(lhs);
+            } else {
+                const auto lhs_f64 = static_cast<f64>(lhs);
+                const auto rhs_f64 = static_cast<f64>(m_lines(line, m_rank + 1));
+                m_output(i, j, k, l) = static_cast<output_value_type>(lhs_f64 + (rhs_f64 - lhs_f64) * m_weight);
+            }
+        }
+
+    private:
+        input_type m_lines;
+        output_type m_output;
+        Strides4<i64> m_output_contiguous_strides;
+        i64 m_rank;
+        f64 m_weight;
+    };
+
+    /// Computes the quantiles along some axes by sorting. The reduced dimensions are moved to the right and
+    /// gathered in a contiguous buffer, so that the elements of each reduction form a line. Then, every line
+    /// is sorted and the quantile is read from the sorted lines.
+    template<typename Input, typename Output>
+    void quantile_axes_by_sorting(const Input& input, const Output& output, f64 quantile) {
+        using value_t = nt::mutable_value_type_t<Input>;
+        const auto& input_shape = input.shape();
+        const auto& output_shape = output.shape();
+
+        Vec4<i64> permutation{};
+        i64 count{};
+        for (i64 i{}; i < 4; ++i)
+            if (output_shape[i] == input_shape[i])
+                permutation[count++] = i;
+        for (i64 i{}; i < 4; ++i)
+            if (output_shape[i] != input_shape[i])
+                permutation[count++] = i;
+
+        const auto n_outputs = output_shape.n_elements();
+        const auto n_reduced = input_shape.n_elements() / n_outputs;
+        Array<value_t> lines(ni::reorder(input_shape, permutation), input.options());
+        input.view().permute(permutation).to(lines);
+        lines = std::move(lines).reshape({1, 1, n_outputs, n_reduced});
+        noa::sort(lines, {.ascending = true, .axis = 3});
+
+        const f64 position = clamp(quantile, 0., 1.) * static_cast<f64>(n_reduced - 1);
+        const auto rank = static_cast<i64>(floor(position));
+        const f64 weight = position - static_cast<f64>(rank);
+
+        using lines_t = AccessorRestrictContiguousI64<const value_t, 2>;
+        auto lines_accessor = lines_t(lines.get(), Strides2<i64>{n_reduced, 1});
+        auto output_accessor = ng::to_accessor(output);
+        using op_t = QuantileOfSortedLines<lines_t, decltype(output_accessor)>;
+        noa::iwise(output_shape, output.device(),
+              op_t(lines_accessor, output_accessor, output_shape, rank, weight),
+              std::move(lines), output);
+    }
 }
 
 namespace noa {
@@ -96,11 +179,13 @@ namespace noa {
     /// \param[in,out] array    Input array.
     /// \param overwrite        Whether the function is allowed to overwrite \p array.
     ///                         If true and if the array is contiguous, the content of \p array is left
-    ///                         in an undefined state. Otherwise, array is unchanged and a temporary
-    ///                         buffer is allocated.
+    ///                         in an undefined state, so \p array should be mutable. Otherwise, array is
+    ///                         unchanged and a temporary buffer is allocated.
     template<nt::readable_varray_of_scalar Input>
     [[nodiscard]] auto median(const Input& array, bool overwrite = false) {
         check(not array.is_empty(), "Empty array detected");
+        check(not overwrite or nt::writable_varray<Input>,
+              "The array cannot be overwritten, since its values are const");
         const Device device = array.device();
         Stream& stream = Stream::current(device);
         if (device.is_cpu()) {
@@ -115,6 +200,37 @@ namespace noa {
         }
     }
 
+    /// Returns the quantile of the input array.
+    /// \param[in,out] array    Input array.
+    /// \param quantile         Quantile to compute, in range [0,1]. Values between two ranks are linearly
+    ///                         interpolated, like numpy's default "linear" method. For integers, the
+    ///                         interpolated value is truncated.
+    /// \param overwrite        Whether the function is allowed to overwrite \p array.
+    ///                         If true and if the array is contiguous, the content of \p array is left
+    ///                         in an undefined state, so \p array should be mutable. Otherwise, array is
+    ///                         unchanged and a temporary buffer is allocated.
+    /// \note On the CPU, integers are selected without being copied or modified, i.e. the overwrite
+    ///       parameter is ignored and a buffer is only allocated if the array is not contiguous.
+    template<nt::readable_varray_of_scalar Input>
+    [[nodiscard]] auto quantile(const Input& array, f64 quantile, bool overwrite = false) {
+        check(not array.is_empty(), "Empty array detected");
+        check(not overwrite or nt::writable_varray<Input>,
+              "The array cannot be overwritten, since its values are const");
+        check(quantile >= 0 and quantile <= 1, "The quantile should be in range [0,1], but got {}", quantile);
+        const Device device = array.device();
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            stream.synchronize();
+            return noa::cpu::quantile(array.get(), array.strides(), array.shape(), quantile, overwrite);
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            return noa::cuda::quantile(array.get(), array.strides(), array.shape(), quantile, overwrite, stream.cuda());
+            #else
+            panic_no_gpu_backend();
+            #endif
+        }
+    }
+
     /// Returns the sum of the input array.
     /// \note For (complex)-floating-point types, the CPU backend uses a Kahan summation (with Neumaier variation).
     template<nt::readable_varray Input>
@@ -360,7 +476,72 @@ namespace noa {
         return output;
     }
 
-    // TODO Add median()
+    /// Reduces an array along some dimensions by taking the quantile.
+    /// \details Dimensions of the output array should match the input shape, or be 1, indicating the dimension
+    ///          should be reduced. Contrary to the other reductions, any combination of dimensions can be reduced,
+    ///          e.g. the quantile over the batch dimension gives the per-pixel quantile of a stack of images.
+    /// \param[in] input    Input array to reduce. It is not modified.
+    /// \param[out] output  Reduced quantiles.
+    /// \param quantile     Quantile to compute, in range [0,1]. Values between two ranks are linearly interpolated,
+    ///                     like numpy's default "linear" method. For integer outputs, the value is truncated.
+    /// \note On the CPU, the reductions are distributed across threads, with each thread using a buffer the size
+    ///       of one reduction. Integers are selected using a histogram of their bits (radix select), which doesn't
+    ///       need the buffer if the reduced dimensions can be accessed as a strided line. On the GPU, the reduced
+    ///       dimensions are copied to a temporary array and sorted.
+    template<nt::readable_varray_decay_of_scalar Input,
+             nt::writable_varray_decay_of_scalar Output>
+    void quantile(Input&& input, Output&& output, f64 quantile) {
+        check(not input.is_empty() and not output.is_empty(), "Empty array detected");
+        check(quantile >= 0 and quantile <= 1, "The quantile should be in range [0,1], but got {}", quantile);
+        for (size_t i{}; i < 4; ++i) {
+            check(output.shape()[i] == 1 or output.shape()[i] == input.shape()[i],
+                  "Dimensions should match the input shape, or be 1, indicating the dimension should be reduced. "
+                  "Got input:shape={}, output:shape={}", input.shape(), output.shape());
+        }
+        check(not ni::are_overlapped(input, output), "The input and output arrays should not overlap");
+
+        const Device device = output.device();
+        check(device == input.device(),
+              "The input and output arrays must be on the same device, but got input:device={} and output:device={}",
+              input.device(), device);
+
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
+            cpu_stream.enqueue([=, i = std::forward<Input>(input), o = std::forward<Output>(output)](){
+                noa::cpu::quantile_axes(
+                    i.get(), i.strides(), i.shape(),
+                    o.get(), o.strides(), o.shape(),
+                    quantile, n_threads);
+            });
+        } else {
+            guts::quantile_axes_by_sorting(input, output, quantile);
+        }
+    }
+
+    /// Reduces an array along some dimensions by taking the quantile.
+    template<nt::readable_varray_decay_of_scalar Input>
+    [[nodiscard]] auto quantile(Input&& input, f64 quantile, ReduceAxes axes) {
+        using value_t = nt::mutable_value_type_t<Input>;
+        Array<value_t> output(guts::axes_to_output_shape(input, axes), input.options());
+        noa::quantile(std::forward<Input>(input), output, quantile);
+        return output;
+    }
+
+    /// Reduces an array along some dimensions by taking the median.
+    /// \details This is equivalent to the 0.5 quantile, see quantile() for more details.
+    template<nt::readable_varray_decay_of_scalar Input,
+             nt::writable_varray_decay_of_scalar Output>
+    void median(Input&& input, Output&& output) {
+        noa::quantile(std::forward<Input>(input), std::forward<Output>(output), 0.5);
+    }
+
+    /// Reduces an array along some dimensions by taking the median.
+    template<nt::readable_varray_decay_of_scalar Input>
+    [[nodiscard]] auto median(Input&& input, ReduceAxes axes) {
+        return noa::quantile(std::forward<Input>(input), 0.5, axes);
+    }
 
     /// Reduces an array along some dimensions by taking the sum.
     /// \details Dimensions of the output array should match the input shape, or be 1, indicating the dimension
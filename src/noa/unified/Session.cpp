@@ -68,7 +68,7 @@ namespace noa::inline types {
 
     void Session::set_fft_cache_limit(i64 count, Device device) {
         if (device.is_cpu())
-            return; // TODO we could have a more flexible caching mechanism for FFTW
+            return noa::cpu::fft::set_cache_limit(clamp_cast<i32>(count));
         #ifdef NOA_ENABLE_CUDA
         auto cuda_device = noa::cuda::Device(device.id(), noa::cuda::Device::DeviceUnchecked{});
         noa::cuda::fft::set_cache_limit(cuda_device, clamp_cast<i32>(count));
@@ -87,4 +87,35 @@ namespace noa::inline types {
         (void) device;
         #endif
     }
+
+    void Session::set_tracing(bool enable) {
+        check(not enable or guts::TRACING,
+              "The tracing is not compiled in. Build the library with NOA_ENABLE_TRACING to enable it");
+        guts::set_tracing(enable);
+    }
+
+    bool Session::is_tracing() noexcept {
+        return guts::is_tracing();
+    }
+
+    void Session::set_trace_limit(i64 n_events) {
+        check(n_events >= 0, "The trace limit should not be negative, but got {}", n_events);
+        guts::set_trace_limit(n_events);
+    }
+
+    auto Session::trace_events() -> std::vector<TraceEvent> {
+        return guts::trace_events();
+    }
+
+    auto Session::trace_counters() -> std::map<std::string, TraceCounter> {
+        return guts::trace_counters();
+    }
+
+    void Session::clear_traces() {
+        guts::clear_traces();
+    }
+
+    void Session::write_trace(const Path& path) {
+        guts::write_chrome_trace(path);
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "noa/unified/Device.hpp"
+#include "noa/unified/Trace.hpp"
 
 namespace noa::inline types {
     /// The session is used to initialize and control the library initialization and static data.
@@ -41,6 +42,13 @@ namespace noa::inline types {
     /// The CUDA backend uses the cuBLAS library for matrix-matrix multiplication. The library caches cuBLAS
     /// handles (one per device). While there's not much point to clear this cache, users can still explicitly
     /// clear it.
+    ///
+    /// \details \b Tracing:
+    /// If the library is built with NOA_ENABLE_TRACING, the element-wise, index-wise and FFT operations can be
+    /// traced. When enabled, each operation records its name, shape, data type, estimated number of bytes read and
+    /// written, number of threads and wall time. The events can be exported to a Chrome-trace JSON file, which can
+    /// be opened by Perfetto (https://ui.perfetto.dev) or chrome://tracing. Counters aggregated per operation name
+    /// can also be queried. Without NOA_ENABLE_TRACING, the tracing is entirely compiled out.
     class Session {
     public:
         /// Sets the maximum number of internal threads used in this session.
@@ -75,6 +83,8 @@ namespace noa::inline types {
         static i64 clear_fft_cache(Device device = Device::current_gpu());
 
         /// Sets the maximum number of plans the FFT cache can hold on a given device.
+        /// On the CPU, this is the number of cached plans per precision (64 by default). The least recently used
+        /// plans are released first.
         static void set_fft_cache_limit(i64 count, Device device = Device::current_gpu());
 
         /// Clears the BLAS cache for a given device.
@@ -83,6 +93,32 @@ namespace noa::inline types {
         ///          streams or the device.
         static void clear_blas_cache(Device device = Device::current_gpu());
 
+        /// Enables or disables the tracing of the operations.
+        /// \note Only the operations created while the tracing is enabled are recorded.
+        /// \throw If enabling the tracing and the library was built without NOA_ENABLE_TRACING.
+        static void set_tracing(bool enable);
+
+        /// Whether the tracing is enabled.
+        static bool is_tracing() noexcept;
+
+        /// Sets the maximum number of events the tracer can hold (100'000 by default).
+        /// Once reached, new events are dropped, but the counters are still updated. Long runs should
+        /// periodically export and clear the traces (see write_trace() and clear_traces()).
+        static void set_trace_limit(i64 n_events);
+
+        /// Returns the recorded events, in the order in which they completed.
+        static auto trace_events() -> std::vector<TraceEvent>;
+
+        /// Returns the counters, per operation name.
+        static auto trace_counters() -> std::map<std::string, TraceCounter>;
+
+        /// Clears the recorded events and counters, and restarts the timeline of the events.
+        /// Operations that started before this call are not recorded.
+        static void clear_traces();
+
+        /// Writes the recorded events in the Chrome-trace JSON format.
+        static void write_trace(const Path& path);
+
     private:
         static i64 m_thread_limit;
     };
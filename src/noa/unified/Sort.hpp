@@ -6,6 +6,8 @@
 #include "noa/gpu/cuda/Sort.cuh"
 #endif
 
+#include "noa/unified/Array.hpp"
+#include "noa/unified/Indexing.hpp"
 #include "noa/unified/Stream.hpp"
 #include "noa/unified/Traits.hpp"
 
@@ -23,9 +25,12 @@ namespace noa {
     /// \tparam T               Any restricted scalar.
     /// \param[in,out] array    Array to sort, in-place.
     /// \param options          Sorting options.
-    /// \note The sort algorithms make temporary copies of the data when sorting along any but the last axis.
-    ///       Consequently, sorting along the last axis is faster and uses less memory than sorting along any
-    ///       other axis.
+    /// \note On the CPU, integers and floating-points are sorted using a radix sort, anything else is sorted
+    ///       using a merge sort. The lines along the sorted axis are sorted in parallel, with only a few lines
+    ///       allocated per thread. If there are fewer lines than threads, each line is sorted in parallel instead.
+    /// \note On the GPU, the sort algorithms make temporary copies of the data when sorting along any but the
+    ///       last axis. Consequently, sorting along the last axis is faster and uses less memory than sorting
+    ///       along any other axis.
     template<nt::writable_varray_decay_of_scalar VArray>
     void sort(VArray&& array, SortOptions options = {}) {
         check(not array.is_empty(), "Empty array detected");
@@ -33,8 +38,9 @@ namespace noa {
         Stream& stream = Stream::current(device);
         if (device.is_cpu()) {
             auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
             cpu_stream.enqueue([=, a = std::forward<VArray>(array)](){
-                noa::cpu::sort(a.get(), a.strides(), a.shape(), options.ascending, options.axis);
+                noa::cpu::sort(a.get(), a.strides(), a.shape(), options.ascending, options.axis, n_threads);
             });
         } else {
             #ifdef NOA_ENABLE_CUDA
@@ -47,5 +53,100 @@ namespace noa {
         }
     }
 
-    // TODO Add sort by keys.
+    /// Sorts the keys and reorders the values accordingly, in-place.
+    /// \tparam K               Any restricted scalar.
+    /// \tparam V               Any type.
+    /// \param[in,out] keys     Keys to sort, in-place.
+    /// \param[in,out] values   Values to reorder, in-place. Should have the same shape as the keys.
+    /// \param options          Sorting options.
+    /// \note The sort is stable, i.e. values with equal keys keep their relative order.
+    /// \note On the GPU, the lines are sorted one at a time.
+    template<nt::writable_varray_decay_of_scalar Keys,
+             nt::writable_varray_decay Values>
+    void sort_by_key(Keys&& keys, Values&& values, SortOptions options = {}) {
+        check(not keys.is_empty() and not values.is_empty(), "Empty array detected");
+        check(all(keys.shape() == values.shape()),
+              "The keys and values should have the same shape, but got keys:shape={} and values:shape={}",
+              keys.shape(), values.shape());
+        check(not ni::are_overlapped(keys, values), "The keys and values should not overlap");
+
+        const Device device = keys.device();
+        check(device == values.device(),
+              "The keys and values should be on the same device, but got keys:device={} and values:device={}",
+              device, values.device());
+
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
+            cpu_stream.enqueue([=, k = std::forward<Keys>(keys), v = std::forward<Values>(values)](){
+                noa::cpu::sort_by_key(
+                    k.get(), k.strides(), v.get(), v.strides(), k.shape(),
+                    options.ascending, options.axis, n_threads);
+            });
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            auto& cuda_stream = stream.cuda();
+            noa::cuda::sort_by_key(
+                keys.get(), keys.strides(), values.get(), values.strides(), keys.shape(),
+                options.ascending, options.axis, cuda_stream);
+            cuda_stream.enqueue_attach(std::forward<Keys>(keys), std::forward<Values>(values));
+            #else
+            panic_no_gpu_backend();
+            #endif
+        }
+    }
+
+    /// Computes the indices that would sort an array along an axis.
+    /// \tparam T               Any restricted scalar.
+    /// \tparam I               Any integer.
+    /// \param[in] input        Array to argsort. It is not modified.
+    /// \param[out] indices     Indices, along the sorted axis, of the sorted elements.
+    ///                         Should have the same shape as the input.
+    /// \param options          Sorting options.
+    /// \note The sort is stable, i.e. equal elements keep their relative order.
+    /// \note On the GPU, the lines are sorted one at a time.
+    template<nt::readable_varray_decay_of_scalar Input,
+             nt::writable_varray_decay_of_integer Indices>
+    void argsort(Input&& input, Indices&& indices, SortOptions options = {}) {
+        check(not input.is_empty() and not indices.is_empty(), "Empty array detected");
+        check(all(input.shape() == indices.shape()),
+              "The input and indices should have the same shape, but got input:shape={} and indices:shape={}",
+              input.shape(), indices.shape());
+
+        const Device device = indices.device();
+        check(device == input.device(),
+              "The input and indices should be on the same device, but got input:device={} and indices:device={}",
+              input.device(), device);
+
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
+            cpu_stream.enqueue([=, i = std::forward<Input>(input), o = std::forward<Indices>(indices)](){
+                noa::cpu::argsort(
+                    i.get(), i.strides(), o.get(), o.strides(), i.shape(),
+                    options.ascending, options.axis, n_threads);
+            });
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            auto& cuda_stream = stream.cuda();
+            noa::cuda::argsort(
+                input.get(), input.strides(), indices.get(), indices.strides(), input.shape(),
+                options.ascending, options.axis, cuda_stream);
+            cuda_stream.enqueue_attach(std::forward<Input>(input), std::forward<Indices>(indices));
+            #else
+            panic_no_gpu_backend();
+            #endif
+        }
+    }
+
+    /// Computes the indices that would sort an array along an axis.
+    /// The returned array of indices is a new C-contiguous array.
+    template<nt::integer I = i64, nt::readable_varray_decay_of_scalar Input>
+    [[nodiscard]] auto argsort(Input&& input, SortOptions options = {}) -> Array<I> {
+        auto indices = Array<I>(input.shape(), input.options());
+        argsort(std::forward<Input>(input), indices, options);
+        return indices;
+    }
 }
@@ -18,6 +18,8 @@ namespace noa::gpu {
 #endif
 
 namespace noa::inline types {
+    class Event;
+
     /// Unified stream, i.e. shared (asynchronous) dispatch queue, and its associated device.
     /// \details
     ///   - Streams are reference counted. While they can be moved and copied around, the actual
@@ -34,6 +36,7 @@ namespace noa::inline types {
     public:
         using cpu_stream = noa::cpu::Stream;
         using gpu_stream = noa::gpu::Stream;
+        using cpu_graph = noa::cpu::Graph;
 
         /// Stream mode.
         /// For CPU devices: DEFAULT/SYNC referes to the current thread. ASYNC launches a new thread which waits
@@ -86,6 +89,15 @@ namespace noa::inline types {
             std::visit([](auto&& stream) { stream.synchronize(); }, m_stream);
         }
 
+        /// Makes the stream wait on an event recorded in this or another stream of the same device type.
+        /// \details The functions enqueued after this call are executed once the event is completed. This call
+        ///          doesn't block the calling thread, so independent stages enqueued to different streams can
+        ///          overlap, with the dependencies resolved by the streams themselves.
+        /// \note For CPU streams, the worker thread of an asynchronous stream sleeps until the event is completed.
+        ///       Synchronous streams execute the functions on the calling thread, which thus waits on the event.
+        /// \note Defined in noa/unified/Event.hpp.
+        void wait(const Event& event);
+
         /// Whether or not the stream is busy.
         /// \note This function may also return error codes from previous, asynchronous launches.
         [[nodiscard]] auto is_busy() -> bool {
@@ -111,6 +123,36 @@ namespace noa::inline types {
             return 1;
         }
 
+    public: // Graph capture
+        /// Starts capturing the enqueued functions into a graph, similar to CUDA graphs.
+        /// \details While capturing, the functions enqueued to the stream are recorded instead of being executed.
+        ///          The arguments are validated, the backend operators are created, and any temporary buffer is
+        ///          allocated during the capture, once. The graph can then be launched any number of times, which
+        ///          only executes the captured operators. The captured operators always read from and write to the
+        ///          arrays used during the capture, so to process new data, copy it into these arrays before
+        ///          launching the graph.
+        /// \note Capture is only supported by CPU streams. Functions that need to synchronize the stream (e.g.
+        ///       reductions returning a value) cannot be captured and throw an exception.
+        void begin_capture() {
+            cpu().begin_capture();
+        }
+
+        /// Stops capturing and returns the captured graph.
+        [[nodiscard]] auto end_capture() -> cpu_graph {
+            return cpu().end_capture();
+        }
+
+        /// Whether the stream is capturing.
+        [[nodiscard]] auto is_capturing() const noexcept -> bool {
+            const auto* stream = std::get_if<cpu_stream>(&m_stream);
+            return stream and stream->is_capturing();
+        }
+
+        /// Enqueues a captured graph.
+        void launch(const cpu_graph& graph) {
+            cpu().launch(graph);
+        }
+
     public: // Access backend stream.
         /// Gets the underlying stream, assuming it is a CPU stream (i.e. device is CPU).
         /// Otherwise, throws an exception.
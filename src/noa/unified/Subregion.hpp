@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
+#include "noa/core/io/ImageFile.hpp"
 #include "noa/unified/Array.hpp"
 #include "noa/unified/Indexing.hpp"
 #include "noa/unified/Iwise.hpp"
@@ -177,6 +181,25 @@ namespace noa::guts {
         origins_type m_order;
     };
 
+    /// Runtime version of ni::index_at, supporting the border modes of extract_subregions.
+    /// Returns -1 if the index is out-of-bounds and the border mode doesn't bring it back within the bounds.
+    constexpr auto subregion_index_at(Border border_mode, i64 index, i64 size) noexcept -> i64 {
+        if (index >= 0 and index < size)
+            return index;
+        switch (border_mode) {
+            case Border::CLAMP: return ni::index_at<Border::CLAMP>(index, size);
+            case Border::MIRROR: return ni::index_at<Border::MIRROR>(index, size);
+            case Border::PERIODIC: return ni::index_at<Border::PERIODIC>(index, size);
+            case Border::REFLECT: return ni::index_at<Border::REFLECT>(index, size);
+            default: return -1;
+        }
+    }
+
+    /// Row of a subregion, and the row of the file it is extracted from.
+    struct SubregionRow {
+        Vec3<i64> file_bdh;
+        Vec3<i64> subregion_bdh;
+    };
 }
 
 namespace noa {
@@ -273,6 +296,183 @@ namespace noa {
         }
     }
 
+    struct ExtractSubregionsFromFileOptions {
+        /// Maximum number of consecutive rows to read and decode at once.
+        /// The band of rows is the only buffer used to read the file, so this bounds the memory usage
+        /// to max_band_rows * width values, regardless of the size of the image(s) in the file.
+        i64 max_band_rows{256};
+
+        /// Whether the decoded values should be clamped to the subregion value type range.
+        bool clamp{true};
+
+        /// Number of threads to read and decode the data.
+        i32 n_threads{1};
+    };
+
+    /// Extracts one or multiple {1|2|3}d subregions at various locations in the image(s) stored in a file.
+    /// \details This is similar to the overload taking an input array, but instead of loading the whole file,
+    ///          the rows of the subregions are sorted by their position in the file, and only the bands of
+    ///          consecutive rows that are needed are read and decoded, one band at a time. This is meant to
+    ///          extract particles from large micrographs, or from stacks of micrographs (using 4d origins),
+    ///          with a bounded memory usage.
+    /// \param[in,out] file     Opened file to extract from.
+    /// \param[out] subregions  Output subregion(s). The file is decoded into the subregion value type.
+    ///                         If the subregions are not CPU-dereferenceable, they are extracted into a temporary
+    ///                         CPU array, which is then copied to the subregions.
+    /// \param[in] origins      Contiguous vector with the (BD)HW indexes of the subregions to extract.
+    ///                         See the overload above for more details.
+    /// \param border_mode      Border mode used for out-of-bound conditions.
+    ///                         Can be Border::{NOTHING|ZERO|VALUE|CLAMP|MIRROR|PERIODIC|REFLECT}.
+    /// \param border_value     Constant value to use for out-of-bound conditions.
+    ///                         Only used if \p border_mode is Border::VALUE.
+    /// \param options          Reading options.
+    template<nt::writable_varray_decay_of_numeric Subregion,
+             nt::readable_varray_decay Origin>
+    requires nt::vec_integer_size<nt::value_type_t<Origin>, 2, 4>
+    void extract_subregions(
+        io::ImageFile& file,
+        Subregion&& subregions,
+        Origin&& origins,
+        Border border_mode = Border::ZERO,
+        nt::value_type_t<Subregion> border_value = {},
+        const ExtractSubregionsFromFileOptions& options = {}
+    ) {
+        using value_t = nt::mutable_value_type_t<Subregion>;
+        using indice_t = nt::mutable_value_type_t<Origin>;
+
+        check(file.is_open(), "The file should be open");
+        check(not subregions.is_empty(), "Empty array detected");
+        check(ni::is_contiguous_vector(origins) and origins.n_elements() == subregions.shape()[0],
+              "The origin should be a contiguous vector of {} elements but got shape={} and strides={}",
+              subregions.shape()[0], origins.shape(), origins.strides());
+        check(options.max_band_rows > 0,
+              "The maximum number of rows per band should be positive, but got {}", options.max_band_rows);
+        switch (border_mode) {
+            case Border::NOTHING:
+            case Border::ZERO:
+            case Border::VALUE:
+            case Border::CLAMP:
+            case Border::MIRROR:
+            case Border::PERIODIC:
+            case Border::REFLECT:
+                break;
+            default:
+                panic("{} not supported", border_mode);
+        }
+
+        // The file is decoded on the CPU, so wait for the subregions and work from the CPU.
+        const auto origins_cpu = origins.to_cpu().eval();
+        const auto origins_1d = origins_cpu.span_1d_contiguous();
+        Array<value_t> buffer;
+        Span<value_t, 4> output;
+        if (subregions.is_dereferenceable()) {
+            subregions.eval();
+            output = subregions.span();
+        } else {
+            buffer = border_mode == Border::NOTHING ? subregions.to_cpu() : Array<value_t>(subregions.shape());
+            output = buffer.eval().span();
+        }
+
+        const auto file_shape = file.shape();
+        const auto subregion_shape = subregions.shape();
+        const value_t cvalue = border_mode == Border::VALUE ? border_value : value_t{};
+
+        // List the rows to extract, with the file row they come from.
+        // Rows that are entirely out-of-bounds are set here.
+        std::vector<ng::SubregionRow> rows;
+        rows.reserve(static_cast<size_t>(subregion_shape.pop_back().n_elements()));
+        for (i64 i{}; i < subregion_shape[0]; ++i) {
+            const auto origin = origins_1d[i].template as<i64>();
+            for (i64 z{}; z < subregion_shape[1]; ++z) {
+                for (i64 y{}; y < subregion_shape[2]; ++y) {
+                    Vec3<i64> file_bdh;
+                    if constexpr (indice_t::SIZE == 4)
+                        file_bdh = {origin[0], z + origin[1], y + origin[2]};
+                    else
+                        file_bdh = {0, z, y + origin[0]};
+
+                    bool is_inbounds{true};
+                    for (size_t j{}; j < 3; ++j) {
+                        file_bdh[j] = ng::subregion_index_at(border_mode, file_bdh[j], file_shape[j]);
+                        is_inbounds = is_inbounds and file_bdh[j] >= 0;
+                    }
+                    if (is_inbounds) {
+                        rows.push_back({file_bdh, {i, z, y}});
+                    } else if (border_mode != Border::NOTHING) {
+                        for (i64 x{}; x < subregion_shape[3]; ++x)
+                            output(i, z, y, x) = cvalue;
+                    }
+                }
+            }
+        }
+
+        // Sort the rows by their position in the file, so that each band is read once.
+        std::ranges::sort(rows, [](const auto& lhs, const auto& rhs) {
+            for (size_t j{}; j < 3; ++j)
+                if (lhs.file_bdh[j] != rhs.file_bdh[j])
+                    return lhs.file_bdh[j] < rhs.file_bdh[j];
+            return false;
+        });
+
+        const i64 width = file_shape[3];
+        const i64 max_band_rows = std::min(options.max_band_rows, file_shape[2]);
+        const auto band = Array<value_t>(Shape4<i64>{1, 1, max_band_rows, width});
+
+        for (size_t i{}; i < rows.size();) {
+            // Group the consecutive rows of the same slice, up to the maximum band size.
+            const auto& first_row = rows[i].file_bdh;
+            size_t end = i + 1;
+            while (end < rows.size() and
+                   rows[end].file_bdh[0] == first_row[0] and
+                   rows[end].file_bdh[1] == first_row[1] and
+                   rows[end].file_bdh[2] <= rows[end - 1].file_bdh[2] + 1 and
+                   rows[end].file_bdh[2] < first_row[2] + max_band_rows)
+                ++end;
+
+            const i64 band_start = first_row[2];
+            const i64 band_end = rows[end - 1].file_bdh[2] + 1;
+            file.read_rows(Span<value_t, 4>(band.get(), Shape4<i64>{1, 1, band_end - band_start, width}),
+                           band_start, {.bd_offset = first_row.pop_back(),
+                                        .clamp = options.clamp,
+                                        .n_threads = options.n_threads});
+
+            for (; i < end; ++i) {
+                const auto& [file_bdh, subregion_bdh] = rows[i];
+                const value_t* input = band.get() + (file_bdh[2] - band_start) * width;
+                const auto [b, z, y] = subregion_bdh;
+                const i64 origin_x = origins_1d[b][indice_t::SIZE - 1];
+                for (i64 x{}; x < subregion_shape[3]; ++x) {
+                    const i64 file_x = ng::subregion_index_at(border_mode, x + origin_x, width);
+                    if (file_x >= 0)
+                        output(b, z, y, x) = input[file_x];
+                    else if (border_mode != Border::NOTHING)
+                        output(b, z, y, x) = cvalue;
+                }
+            }
+        }
+
+        if (not buffer.is_empty())
+            std::move(buffer).to(subregions);
+    }
+
+    /// Extracts one or multiple {1|2|3}d subregions at various locations in the image(s) stored in a file.
+    /// Same as the overload above, but opens the file at \p path.
+    template<nt::writable_varray_decay_of_numeric Subregion,
+             nt::readable_varray_decay Origin>
+    requires nt::vec_integer_size<nt::value_type_t<Origin>, 2, 4>
+    void extract_subregions(
+        const Path& path,
+        Subregion&& subregions,
+        Origin&& origins,
+        Border border_mode = Border::ZERO,
+        nt::value_type_t<Subregion> border_value = {},
+        const ExtractSubregionsFromFileOptions& options = {}
+    ) {
+        auto file = io::ImageFile(path, io::Open{.read = true});
+        extract_subregions(file, std::forward<Subregion>(subregions), std::forward<Origin>(origins),
+                           border_mode, border_value, options);
+    }
+
     /// Inserts into the output array one or multiple {1|2|3}d subregions at various locations.
     /// \param[in] subregions   Subregion(s) to insert into \p output.
     /// \param[out] output      Output array.
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "noa/unified/Trace.hpp"
+
+namespace {
+    using namespace ::noa::types;
+
+    struct Tracer {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        std::map<std::string, TraceCounter> counters;
+        std::chrono::steady_clock::time_point epoch;
+        bool has_epoch{};
+        size_t limit{100'000};
+    };
+
+    std::atomic<bool> g_is_tracing{false};
+
+    auto tracer() -> Tracer& {
+        static Tracer instance;
+        return instance;
+    }
+
+    auto escape_json(std::string_view string) -> std::string {
+        std::string out;
+        out.reserve(string.size());
+        for (char c: string) {
+            if (c == '"' or c == '\\')
+                out += '\\';
+            out += c;
+        }
+        return out;
+    }
+}
+
+namespace noa::guts {
+    auto is_tracing() noexcept -> bool {
+        return g_is_tracing.load(std::memory_order_relaxed);
+    }
+
+    void set_tracing(bool enable) noexcept {
+        if (enable) {
+            // The timeline starts when the tracing is first enabled, or when the traces are cleared.
+            Tracer& instance = tracer();
+            const std::scoped_lock lock(instance.mutex);
+            if (not instance.has_epoch) {
+                instance.epoch = std::chrono::steady_clock::now();
+                instance.has_epoch = true;
+            }
+        }
+        g_is_tracing.store(enable, std::memory_order_relaxed);
+    }
+
+    void set_trace_limit(i64 n_events) noexcept {
+        Tracer& instance = tracer();
+        const std::scoped_lock lock(instance.mutex);
+        instance.limit = static_cast<size_t>(std::max(n_events, i64{0}));
+    }
+
+    void record_trace(
+        TraceEvent&& event,
+        std::chrono::steady_clock::time_point start,
+        std::chrono::steady_clock::time_point end
+    ) {
+        using duration_t = std::chrono::duration<f64, std::micro>;
+        event.thread_id = static_cast<u64>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        event.duration_us = duration_t(end - start).count();
+
+        Tracer& instance = tracer();
+        const std::scoped_lock lock(instance.mutex);
+
+        // Operations that started before the traces were cleared are discarded.
+        if (not instance.has_epoch or start < instance.epoch)
+            return;
+        event.start_us = duration_t(start - instance.epoch).count();
+
+        TraceCounter& counter = instance.counters[event.name];
+        counter.n_calls += 1;
+        counter.total_duration_us += event.duration_us;
+        counter.n_bytes_read += event.n_bytes_read;
+        counter.n_bytes_written += event.n_bytes_written;
+
+        // Past the limit, the events are dropped, but the counters are still updated.
+        if (instance.events.size() < instance.limit)
+            instance.events.push_back(std::move(event));
+    }
+
+    auto trace_events() -> std::vector<TraceEvent> {
+        Tracer& instance = tracer();
+        const std::scoped_lock lock(instance.mutex);
+        return instance.events;
+    }
+
+    auto trace_counters() -> std::map<std::string, TraceCounter> {
+        Tracer& instance = tracer();
+        const std::scoped_lock lock(instance.mutex);
+        return instance.counters;
+    }
+
+    void clear_traces() {
+        Tracer& instance = tracer();
+        const std::scoped_lock lock(instance.mutex);
+        instance.events = {}; // release the memory
+        instance.counters.clear();
+        instance.epoch = std::chrono::steady_clock::now();
+        instance.has_epoch = true;
+    }
+
+    void write_chrome_trace(const Path& path) {
+        // The thread ids are hashes, so map them to small integers for a readable timeline.
+        const std::vector<TraceEvent> events = trace_events();
+        std::map<u64, i64> thread_ids;
+        for (const auto& event: events)
+            thread_ids.emplace(event.thread_id, std::ssize(thread_ids));
+
+        std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        for (size_t i{}; i < events.size(); ++i) {
+            const TraceEvent& event = events[i];
+            json += fmt::format(
+                "{}\n{{\"name\":\"{}\",\"cat\":\"noa\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":0,\"tid\":{},"
+                "\"args\":{{\"shape\":\"{}\",\"dtype\":\"{}\",\"bytes_read\":{},\"bytes_written\":{},"
+                "\"threads\":{},\"device\":\"{}\"}}}}",
+                i == 0 ? "" : ",", escape_json(event.name), event.start_us, event.duration_us,
+                thread_ids.at(event.thread_id), event.shape, escape_json(event.dtype),
+                event.n_bytes_read, event.n_bytes_written, event.n_threads, event.device);
+        }
+        json += "\n]}\n";
+
+        noa::io::mkdir(path.parent_path());
+        std::ofstream file(path, std::ios::out | std::ios::trunc);
+        check(file.is_open(), "Failed to open the trace file {}", path);
+        file << json;
+        check(not file.fail(), "Failed to write the trace file {}", path);
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "noa/core/io/IO.hpp"
+#include "noa/core/types/Shape.hpp"
+#include "noa/core/utils/Strings.hpp"
+#include "noa/unified/Device.hpp"
+
+namespace noa::inline types {
+    /// Operation recorded by the tracer (see Session::set_tracing()).
+    struct TraceEvent {
+        /// Name of the operation, e.g. "ewise<noa::Plus>" or "fft::r2c".
+        std::string name;
+
+        /// Data type of the output, or of the input if there are no outputs.
+        std::string dtype;
+
+        /// BDHW shape of the operation, as launched (e.g. after reordering the dimensions).
+        Shape4<i64> shape;
+
+        /// Estimated number of bytes read and written by the operation. For index-wise operations, the access
+        /// pattern of the operator is unknown, so the arrays attached to the call are all reported as read.
+        i64 n_bytes_read{};
+        i64 n_bytes_written{};
+
+        /// Number of CPU threads used by the operation. Zero for GPU operations.
+        i64 n_threads{};
+
+        /// Device executing the operation.
+        Device device{};
+
+        /// Host thread executing the operation (the worker thread of asynchronous CPU streams).
+        u64 thread_id{};
+
+        /// Start time, in microseconds since the tracing was first enabled or since the traces were last cleared,
+        /// and wall time of the operation.
+        /// For GPU operations, this is the time it took to enqueue the operation.
+        f64 start_us{};
+        f64 duration_us{};
+    };
+
+    /// Aggregated counters of the operations with the same name.
+    struct TraceCounter {
+        i64 n_calls{};
+        f64 total_duration_us{};
+        i64 n_bytes_read{};
+        i64 n_bytes_written{};
+    };
+}
+
+namespace noa::guts {
+    /// Whether the tracing is compiled in (NOA_ENABLE_TRACING). If not, the tracing is entirely compiled out.
+    #ifdef NOA_ENABLE_TRACING
+    inline constexpr bool TRACING = true;
+    #else
+    inline constexpr bool TRACING = false;
+    #endif
+
+    /// Tracer of the library operations. Events are recorded (thread-safe) in one global tracer.
+    auto is_tracing() noexcept -> bool;
+    void set_tracing(bool enable) noexcept;
+    void set_trace_limit(i64 n_events) noexcept;
+    void record_trace(TraceEvent&& event,
+                      std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end);
+    auto trace_events() -> std::vector<TraceEvent>;
+    auto trace_counters() -> std::map<std::string, TraceCounter>;
+    void clear_traces();
+    void write_chrome_trace(const Path& path);
+
+    /// Operation to trace. Empty if the tracing is compiled out or disabled at the time the operation is created.
+    /// This is shared so that it can be captured by the tasks enqueued to the streams.
+    using trace_type = std::conditional_t<TRACING, std::shared_ptr<TraceEvent>, Empty>;
+
+    /// Creates the operation to trace. The event is only created if the tracing is enabled.
+    template<typename F>
+    auto make_trace([[maybe_unused]] F&& make_event) -> trace_type {
+        #ifdef NOA_ENABLE_TRACING
+        if (is_tracing())
+            return std::make_shared<TraceEvent>(make_event());
+        #endif
+        return trace_type{};
+    }
+
+    /// Measures the wall time of the scope and records the operation.
+    class TraceScope {
+    public:
+        explicit TraceScope([[maybe_unused]] const trace_type& trace) noexcept {
+            #ifdef NOA_ENABLE_TRACING
+            if (trace) {
+                m_trace = trace;
+                m_start = std::chrono::steady_clock::now();
+            }
+            #endif
+        }
+
+        ~TraceScope() {
+            #ifdef NOA_ENABLE_TRACING
+            if (m_trace)
+                record_trace(TraceEvent(*m_trace), m_start, std::chrono::steady_clock::now());
+            #endif
+        }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+
+    private:
+        #ifdef NOA_ENABLE_TRACING
+        trace_type m_trace{};
+        std::chrono::steady_clock::time_point m_start{};
+        #endif
+    };
+
+    /// Returns the name of a type, without its template parameters, e.g. "noa::Plus".
+    template<typename T>
+    auto trace_type_name() -> std::string_view {
+        #if defined(_MSC_VER) && !defined(__clang__)
+        // MSVC: "... trace_type_name<struct noa::Plus>(void)".
+        std::string_view name = __FUNCSIG__;
+        const size_t start = name.find("trace_type_name<");
+        if (start == std::string_view::npos)
+            return "unknown";
+        name.remove_prefix(start + 16);
+        for (std::string_view prefix: {"struct ", "class ", "union ", "enum "}) {
+            if (name.starts_with(prefix))
+                name.remove_prefix(prefix.size());
+        }
+        return name.substr(0, name.find_first_of("<>"));
+        #else
+        // GCC: "... trace_type_name() [with T = noa::Plus; ...]", Clang: "... trace_type_name() [T = noa::Plus]".
+        std::string_view name = __PRETTY_FUNCTION__;
+        const size_t start = name.find("T = ");
+        if (start == std::string_view::npos)
+            return "unknown";
+        name.remove_prefix(start + 4);
+        return name.substr(0, name.find_first_of("<;]"));
+        #endif
+    }
+
+    /// Number of threads used by the CPU backend for a given number of elements.
+    inline auto trace_n_threads(i64 n_elements, i64 n_threads, i64 n_elements_per_thread) -> i64 {
+        if (n_elements <= n_elements_per_thread)
+            return 1;
+        return std::clamp(n_elements / n_elements_per_thread, i64{1}, n_threads);
+    }
+}
@@ -44,7 +44,9 @@ namespace noa {
         if (input_device.is_cpu() and output_device.is_cpu()) {
             auto& cpu_stream = Stream::current(input_device).cpu();
             const auto n_threads = cpu_stream.thread_limit();
-            if ((nt::array_decay<Input> or nt::array_decay<Output>) and cpu_stream.is_async()) {
+            // Views are copied immediately, unless the stream is capturing, in which case the copy is recorded.
+            if (cpu_stream.is_capturing() or
+                ((nt::array_decay<Input> or nt::array_decay<Output>) and cpu_stream.is_async())) {
                 cpu_stream.enqueue(
                     [=,
                      input_ = std::forward<Input>(input),
@@ -110,6 +112,8 @@ namespace noa {
     ///       The in-place 0321 permutation requires the axis 3 and 1 to have the same size.
     /// \note On the GPU, the following permutations are optimized: 0123, 0132, 0312, 0321, 0213, 0231.
     ///       Anything else calls copy(), which is slower.
+    /// \note On the CPU, out-of-place permutations moving the innermost dimension are computed by tiles,
+    ///       with every order being supported.
     template<nt::readable_varray_decay Input,
              nt::writable_varray_decay_of_any<nt::mutable_value_type_t<Input>> Output>
     void permute_copy(Input&& input, Output&& output, const Vec4<i64>& permutation) {
@@ -139,7 +143,9 @@ namespace noa {
         if (device.is_cpu()) {
             auto& cpu_stream = stream.cpu();
             const auto n_threads = cpu_stream.thread_limit();
-            if ((nt::array_decay<Input> or nt::array_decay<Output>) and cpu_stream.is_async()) {
+            // Views are copied immediately, unless the stream is capturing, in which case the copy is recorded.
+            if (cpu_stream.is_capturing() or
+                ((nt::array_decay<Input> or nt::array_decay<Output>) and cpu_stream.is_async())) {
                 cpu_stream.enqueue(
                     [=,
                      input_ = std::forward<Input>(input),
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <vector>
+
+#include "noa/unified/Array.hpp"
+#include "noa/unified/Factory.hpp"
+#include "noa/unified/fft/Factory.hpp"
+#include "noa/unified/fft/Resize.hpp"
+#include "noa/unified/fft/Transform.hpp"
+
+namespace noa::fft {
+    struct PyramidOptions {
+        /// Width, in cycle/pix of each level, of the raised-cosine low-pass taper ending at the Nyquist of the level.
+        /// The spectrum of each level is multiplied by 1 at fftfreq=0.5-taper_width, down to 0 at fftfreq=0.5.
+        /// Zero disables the taper.
+        f64 taper_width{0};
+
+        /// Whether the real-space levels should be computed when the pyramid is created.
+        /// Otherwise, a real-space level is computed the first time it is requested.
+        bool compute_real_levels{false};
+
+        /// Options of the transforms. The normalization mode is ignored: the spectra are normalized by the forward
+        /// transform (Norm::FORWARD), so that the real-space levels preserve the intensities of the input.
+        FFTOptions fft_options{};
+    };
+
+    /// Multi-resolution pyramid of (batched) 2d/3d real array(s), i.e. the arrays binned by Fourier cropping.
+    /// \details The input is transformed once. The spectrum of each level is then cropped from the spectrum of the
+    ///          previous (larger) level, or from the spectrum of the input if the taper of the previous level
+    ///          reaches the cropped frequencies. The real-space levels are computed from these spectra, once.
+    ///          The spectra and the real-space levels of every level share one contiguous allocation.
+    /// \note The spectra are non-redundant and non-centered (the "h" layout). The real-space levels are aliasing
+    ///       the padded (in-place) layout, i.e. the rows are padded to the width of the spectra.
+    template<nt::any_of<f32, f64> T>
+    class Pyramid {
+    public:
+        using value_type = T;
+        using complex_type = Complex<T>;
+        using real_array_type = Array<value_type>;
+        using complex_array_type = Array<complex_type>;
+
+    public:
+        Pyramid() = default;
+
+        /// Creates the pyramid.
+        /// \param[in] input        (Batched) 2d or 3d real array(s).
+        /// \param binning_factors  Binning factor of each level, in increasing order, e.g. {1, 2, 4, 8}.
+        ///                         The levels have a logical shape of round(input_shape / factor), with the batch
+        ///                         and the empty dimensions left unchanged.
+        /// \param options          Pyramid options.
+        template<nt::readable_varray_decay_of_almost_any<T> Input>
+        Pyramid(
+            Input&& input,
+            const std::vector<f64>& binning_factors,
+            const PyramidOptions& options = {}
+        ) :
+            m_input_shape(input.shape()),
+            m_binning_factors(binning_factors),
+            m_taper_width(options.taper_width)
+        {
+            check(not input.is_empty(), "Empty array detected");
+            check(not m_binning_factors.empty(), "At least one level should be specified");
+            check(m_taper_width >= 0 and m_taper_width <= 0.5,
+                  "The taper width should be within [0, 0.5], but got {}", m_taper_width);
+            for (size_t i{}; i < m_binning_factors.size(); ++i) {
+                check(m_binning_factors[i] >= 1 and (i == 0 or m_binning_factors[i] > m_binning_factors[i - 1]),
+                      "The binning factors should be greater or equal than 1, and in increasing order, "
+                      "but got factor={} at level={}", m_binning_factors[i], i);
+            }
+            m_fft_options = options.fft_options;
+            m_fft_options.norm = Norm::FORWARD;
+
+            // Compute the layout of the buffer. For each level, the spectrum is followed by the real-space level.
+            i64 n_elements{};
+            for (f64 factor: m_binning_factors) {
+                auto shape = m_input_shape;
+                for (size_t i = 1; i < 4; ++i) {
+                    if (shape[i] > 1) {
+                        const auto size = std::round(static_cast<f64>(shape[i]) / factor);
+                        shape[i] = std::max(i64{1}, static_cast<i64>(size));
+                    }
+                }
+                m_shapes.push_back(shape);
+                m_offsets.push_back(n_elements);
+                n_elements += 2 * shape.rfft().n_elements();
+            }
+            m_buffer = complex_array_type(n_elements, input.options());
+            for (size_t i{}; i < m_shapes.size(); ++i) {
+                const auto shape = m_shapes[i].rfft();
+                const auto offset = m_offsets[i];
+                const auto size = shape.n_elements();
+                m_spectra.push_back(m_buffer.subregion(0, 0, 0, ni::Slice{offset, offset + size}).reshape(shape));
+                m_reals.push_back(alias_to_real(
+                    m_buffer.subregion(0, 0, 0, ni::Slice{offset + size, offset + 2 * size}).reshape(shape),
+                    m_shapes[i]));
+            }
+            m_is_real_computed = std::vector<bool>(m_shapes.size(), false);
+
+            // Forward transform. If the first level is the untapered input, transform directly into it.
+            // Otherwise, the spectrum of the input is only kept until the levels are cropped.
+            const bool is_first_level_input = m_taper_width == 0 and all(m_shapes[0] == m_input_shape);
+            complex_array_type input_spectrum;
+            if (is_first_level_input)
+                r2c(std::forward<Input>(input), m_spectra[0], m_fft_options);
+            else
+                input_spectrum = r2c(std::forward<Input>(input), m_fft_options);
+
+            for (size_t i = is_first_level_input; i < m_shapes.size(); ++i) {
+                // Find the closest larger level with the same frequencies as the input, up to the Nyquist of level i.
+                i64 parent = static_cast<i64>(i) - 1;
+                while (parent >= 0 and not is_untapered_(m_shapes[static_cast<size_t>(parent)], m_shapes[i]))
+                    --parent;
+
+                if (parent >= 0) {
+                    const auto index = static_cast<size_t>(parent);
+                    resize_and_remap(Remap::H2H, m_spectra[index], m_shapes[index],
+                                     m_spectra[i], m_shapes[i], m_taper_width);
+                } else {
+                    resize_and_remap(Remap::H2H, input_spectrum, m_input_shape,
+                                     m_spectra[i], m_shapes[i], m_taper_width);
+                }
+            }
+
+            if (options.compute_real_levels)
+                for (size_t i{}; i < m_shapes.size(); ++i)
+                    (void) real(static_cast<i64>(i));
+        }
+
+    public:
+        [[nodiscard]] auto n_levels() const -> i64 { return std::ssize(m_shapes); }
+        [[nodiscard]] auto input_shape() const -> const Shape4<i64>& { return m_input_shape; }
+        [[nodiscard]] auto device() const -> Device { return m_buffer.device(); }
+        [[nodiscard]] auto is_empty() const -> bool { return m_buffer.is_empty(); }
+        [[nodiscard]] auto taper_width() const -> f64 { return m_taper_width; }
+
+        /// Returns the binning factor of a level, as specified when the pyramid was created.
+        [[nodiscard]] auto binning_factor(i64 level) const -> f64 {
+            return m_binning_factors[to_index_(level)];
+        }
+
+        /// Returns the BDHW logical shape of a level.
+        [[nodiscard]] auto shape(i64 level) const -> const Shape4<i64>& {
+            return m_shapes[to_index_(level)];
+        }
+
+        /// Returns the non-redundant non-centered spectrum of a level.
+        /// \note This is aliasing the memory of the pyramid and should not be modified.
+        [[nodiscard]] auto spectrum(i64 level) const -> const complex_array_type& {
+            return m_spectra[to_index_(level)];
+        }
+
+        /// Returns the real-space level. It is computed the first time the level is requested.
+        /// \note This is aliasing the memory of the pyramid and should not be modified.
+        [[nodiscard]] auto real(i64 level) -> const real_array_type& {
+            const size_t index = to_index_(level);
+            if (not m_is_real_computed[index]) {
+                // The c2r transform doesn't preserve its input, so transform a copy, in-place.
+                const auto& real = m_reals[index];
+                const auto complex = m_buffer.subregion(
+                    0, 0, 0, ni::Slice{m_offsets[index] + m_spectra[index].ssize(),
+                                       m_offsets[index] + 2 * m_spectra[index].ssize()}
+                ).reshape(m_shapes[index].rfft());
+                copy(m_spectra[index], complex);
+                c2r(complex, real, m_fft_options);
+                m_is_real_computed[index] = true;
+            }
+            return m_reals[index];
+        }
+
+        /// Whether the real-space level has been computed.
+        [[nodiscard]] auto is_real_computed(i64 level) const -> bool {
+            return m_is_real_computed[to_index_(level)];
+        }
+
+    private:
+        [[nodiscard]] auto to_index_(i64 level) const -> size_t {
+            check(level >= 0 and level < n_levels(), "Level {} is out of bounds (n_levels={})", level, n_levels());
+            return static_cast<size_t>(level);
+        }
+
+        // Whether the taper of the parent level leaves the frequencies of the child level unchanged.
+        [[nodiscard]] auto is_untapered_(const Shape4<i64>& parent, const Shape4<i64>& child) const -> bool {
+            if (m_taper_width == 0)
+                return true;
+            f64 max_fftfreq_sqd{};
+            for (size_t i = 1; i < 4; ++i) {
+                if (parent[i] > 1) {
+                    const auto fftfreq = static_cast<f64>(child[i] / 2) / static_cast<f64>(parent[i]);
+                    max_fftfreq_sqd += fftfreq * fftfreq;
+                }
+            }
+            return std::sqrt(max_fftfreq_sqd) <= 0.5 - m_taper_width;
+        }
+
+    private:
+        complex_array_type m_buffer;
+        std::vector<complex_array_type> m_spectra;
+        std::vector<real_array_type> m_reals;
+        std::vector<bool> m_is_real_computed;
+        std::vector<Shape4<i64>> m_shapes;
+        std::vector<i64> m_offsets;
+        std::vector<f64> m_binning_factors;
+        Shape4<i64> m_input_shape{};
+        FFTOptions m_fft_options{};
+        f64 m_taper_width{};
+    };
+}
@@ -3,6 +3,9 @@
 #include "noa/core/Config.hpp"
 #include "noa/core/Traits.hpp"
 #include "noa/core/Enums.hpp"
+#include "noa/core/fft/Frequency.hpp"
+#include "noa/core/math/Constant.hpp"
+#include "noa/core/math/Generic.hpp"
 #include "noa/core/types/Shape.hpp"
 #include "noa/core/types/Vec.hpp"
 #include "noa/unified/Resize.hpp"
@@ -100,6 +103,128 @@ namespace noa::fft::guts {
         NOA_NO_UNIQUE_ADDRESS dhw_vec_type m_offset{};
         NOA_NO_UNIQUE_ADDRESS dhw_vec_type m_limit{};
     };
+
+    /// Crops and/or zero-pads, and remaps, in a single pass through the output.
+    /// This is equivalent to resizing in the input layout (as fft::resize) and then remapping to the output layout
+    /// (as fft::remap), with the exception that each dimension can be cropped or padded independently.
+    template<Remap REMAP, bool TAPER,
+             nt::sinteger Index,
+             nt::real Coord,
+             nt::readable_nd<4> Input,
+             nt::writable_nd<4> Output>
+    class FourierResizeRemap {
+    public:
+        using index_type = Index;
+        using coord_type = Coord;
+        using input_type = Input;
+        using output_type = Output;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using input_real_type = nt::value_type_t<input_value_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        using taper_type = std::conditional_t<TAPER, Vec2<coord_type>, Empty>;
+        static_assert(nt::compatible_or_spectrum_types<input_value_type, output_value_type>);
+        static_assert(not TAPER or nt::real_or_complex<input_value_type>);
+
+        static constexpr bool IS_SRC_FULL = REMAP.is_fx2xx();
+        static constexpr bool IS_SRC_CENTERED = REMAP.is_xc2xx();
+        static constexpr bool IS_DST_FULL = REMAP.is_xx2fx();
+        static constexpr bool IS_DST_CENTERED = REMAP.is_xx2xc();
+
+        constexpr FourierResizeRemap(
+            const input_type& input,
+            const output_type& output,
+            const Shape3<index_type>& input_shape,
+            const Shape3<index_type>& output_shape,
+            coord_type taper_width = coord_type{}
+        ) : m_input(input),
+            m_output(output),
+            m_input_shape(input_shape),
+            m_output_shape(output_shape)
+        {
+            if constexpr (TAPER) {
+                m_taper[0] = coord_type{0.5} - taper_width;
+                m_taper[1] = taper_width;
+            }
+        }
+
+        constexpr void operator()(index_type i, index_type oj, index_type ok, index_type ol) const {
+            // Non-centered indices, in the output shape.
+            index_type j = IS_DST_CENTERED ? ifftshift(oj, m_output_shape[0]) : oj;
+            index_type k = IS_DST_CENTERED ? ifftshift(ok, m_output_shape[1]) : ok;
+            index_type l = IS_DST_CENTERED and IS_DST_FULL ? ifftshift(ol, m_output_shape[2]) : ol;
+
+            coord_type weight{1};
+            if constexpr (TAPER) {
+                const auto frequency = Vec3<index_type>{
+                    index2frequency<false>(j, m_output_shape[0]),
+                    index2frequency<false>(k, m_output_shape[1]),
+                    IS_DST_FULL ? index2frequency<false>(l, m_output_shape[2]) : l,
+                };
+                const auto fftfreq = frequency.template as<coord_type>() / m_output_shape.vec.template as<coord_type>();
+                weight = taper_(sqrt(dot(fftfreq, fftfreq)));
+                if (weight <= 0) {
+                    m_output(i, oj, ok, ol) = output_value_type{};
+                    return;
+                }
+            }
+
+            // The redundant half is the conjugate of the symmetric element in the non-redundant half.
+            bool is_conj{};
+            if constexpr (not IS_SRC_FULL and IS_DST_FULL) {
+                if (l >= m_output_shape[2] / 2 + 1) {
+                    j = j != 0 ? m_output_shape[0] - j : j;
+                    k = k != 0 ? m_output_shape[1] - k : k;
+                    l = m_output_shape[2] - l;
+                    is_conj = true;
+                }
+            }
+
+            // Crop or pad, i.e. find the same frequency in the input, if it exists.
+            const index_type fj = index2frequency<false>(j, m_output_shape[0]);
+            const index_type fk = index2frequency<false>(k, m_output_shape[1]);
+            const index_type fl = IS_SRC_FULL ? index2frequency<false>(l, m_output_shape[2]) : l;
+            if (not is_in_input_(fj, m_input_shape[0]) or
+                not is_in_input_(fk, m_input_shape[1]) or
+                (IS_SRC_FULL ? not is_in_input_(fl, m_input_shape[2]) : fl > m_input_shape[2] / 2)) {
+                m_output(i, oj, ok, ol) = output_value_type{};
+                return;
+            }
+            const index_type ij = frequency2index<IS_SRC_CENTERED>(fj, m_input_shape[0]);
+            const index_type ik = frequency2index<IS_SRC_CENTERED>(fk, m_input_shape[1]);
+            const index_type il = IS_SRC_FULL ? frequency2index<IS_SRC_CENTERED>(fl, m_input_shape[2]) : fl;
+
+            auto value = m_input(i, ij, ik, il);
+            if constexpr (nt::complex<input_value_type>) {
+                if (is_conj)
+                    value = conj(value);
+            }
+            if constexpr (TAPER)
+                value *= static_cast<input_real_type>(weight);
+            m_output(i, oj, ok, ol) = cast_or_abs_squared<output_value_type>(value);
+        }
+
+    private:
+        static constexpr bool is_in_input_(index_type frequency, index_type size) noexcept {
+            return -(size / 2) <= frequency and frequency <= (size - 1) / 2;
+        }
+
+        constexpr coord_type taper_(coord_type fftfreq) const noexcept requires TAPER {
+            // Raised-cosine, from 1 at the start of the taper to 0 at the new Nyquist.
+            if (fftfreq <= m_taper[0])
+                return 1;
+            if (fftfreq >= m_taper[0] + m_taper[1])
+                return 0;
+            constexpr coord_type PI = Constant<coord_type>::PI;
+            return (1 + cos(PI * (fftfreq - m_taper[0]) / m_taper[1])) / 2;
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        Shape3<index_type> m_input_shape;
+        Shape3<index_type> m_output_shape;
+        NOA_NO_UNIQUE_ADDRESS taper_type m_taper{};
+    };
 }
 
 namespace noa::fft {
@@ -249,4 +374,113 @@ namespace noa::fft {
         resize<REMAP>(std::forward<Input>(input), input_shape, output, output_shape);
         return output;
     }
+
+    /// Crops or zero-pads FFT(s), and remaps them, in a single pass.
+    /// \param remap           FFT Remap. Any remap supported by fft::remap is supported.
+    /// \param[in] input       FFT to resize and remap.
+    /// \param input_shape     BDHW logical shape of \p input.
+    /// \param[out] output     Resized and remapped FFT.
+    /// \param output_shape    BDHW logical shape of \p output.
+    /// \param taper_width     Width, in cycle/pix, of the raised-cosine taper ending at the new Nyquist.
+    ///                        The output is multiplied by 1 at fftfreq=0.5-taper_width, down to 0 at fftfreq=0.5
+    ///                        (and beyond). Zero disables the taper.
+    ///
+    /// \note This is equivalent to fft::resize in the input layout followed by fft::remap, but each output element
+    ///       is computed once, directly from the input. Contrary to fft::resize, the dimensions can be cropped and
+    ///       padded at the same time, and the padded elements are explicitly set to zero.
+    /// \note The batch dimension cannot be resized.
+    /// \note This function can also perform a cast or compute the power spectrum of the input, depending on the
+    ///       input and output types.
+    template<nt::readable_varray_decay Input, nt::writable_varray_decay Output>
+    requires nt::varray_decay_with_compatible_or_spectrum_types<Input, Output>
+    void resize_and_remap(
+        Remap remap,
+        Input&& input, const Shape4<i64>& input_shape,
+        Output&& output, const Shape4<i64>& output_shape,
+        f64 taper_width = 0
+    ) {
+        using input_value_t = nt::mutable_value_type_t<Input>;
+        using output_value_t = nt::value_type_t<Output>;
+
+        check(not input.is_empty() and not output.is_empty(), "Empty array detected");
+        check(not ni::are_overlapped(input, output), "Input and output arrays should not overlap");
+        check(input.shape()[0] == output.shape()[0] and input_shape[0] == output_shape[0],
+              "The batch dimension cannot be resized");
+        check(vall(Equal{}, input.shape(), (remap.is_fx2xx() ? input_shape : input_shape.rfft())),
+              "Given the {} remap, the input fft is expected to have a physical shape of {}, but got {}",
+              remap, remap.is_fx2xx() ? input_shape : input_shape.rfft(), input.shape());
+        check(vall(Equal{}, output.shape(), (remap.is_xx2fx() ? output_shape : output_shape.rfft())),
+              "Given the {} remap, the output fft is expected to have a physical shape of {}, but got {}",
+              remap, remap.is_xx2fx() ? output_shape : output_shape.rfft(), output.shape());
+        check(taper_width >= 0 and taper_width <= 0.5,
+              "The taper width should be within [0, 0.5], but got {}", taper_width);
+
+        const Device device = output.device();
+        check(device == input.device(),
+              "The input and output arrays must be on the same device, but got input:device={}, output:device={}",
+              input.device(), device);
+
+        using input_accessor_t = AccessorRestrictI64<const input_value_t, 4>;
+        using output_accessor_t = AccessorRestrictI64<output_value_t, 4>;
+        using input_real_t = nt::mutable_value_type_twice_t<Input>;
+        using coord_t = std::conditional_t<std::is_same_v<input_real_t, f64>, f64, f32>;
+        const auto input_accessor = input_accessor_t(input.get(), input.strides());
+        const auto output_accessor = output_accessor_t(output.get(), output.strides());
+        const auto input_shape_3d = input_shape.pop_front();
+        const auto output_shape_3d = output_shape.pop_front();
+        const auto iwise_shape = output.shape();
+
+        const bool has_taper = taper_width > 1e-6;
+        if constexpr (not nt::real_or_complex<input_value_t>)
+            check(not has_taper, "The taper is only supported for real or complex inputs");
+
+        auto launch = [&]<Remap::Enum REMAP>() {
+            if constexpr (nt::real_or_complex<input_value_t>) {
+                if (has_taper) {
+                    auto op = guts::FourierResizeRemap<REMAP, true, i64, coord_t, input_accessor_t, output_accessor_t>(
+                        input_accessor, output_accessor, input_shape_3d, output_shape_3d,
+                        static_cast<coord_t>(taper_width));
+                    return iwise(iwise_shape, device, op, std::forward<Input>(input), std::forward<Output>(output));
+                }
+            }
+            auto op = guts::FourierResizeRemap<REMAP, false, i64, coord_t, input_accessor_t, output_accessor_t>(
+                input_accessor, output_accessor, input_shape_3d, output_shape_3d);
+            iwise(iwise_shape, device, op, std::forward<Input>(input), std::forward<Output>(output));
+        };
+
+        switch (remap) {
+            case Remap::H2H: return launch.template operator()<Remap::H2H>();
+            case Remap::H2HC: return launch.template operator()<Remap::H2HC>();
+            case Remap::H2F: return launch.template operator()<Remap::H2F>();
+            case Remap::H2FC: return launch.template operator()<Remap::H2FC>();
+            case Remap::HC2H: return launch.template operator()<Remap::HC2H>();
+            case Remap::HC2HC: return launch.template operator()<Remap::HC2HC>();
+            case Remap::HC2F: return launch.template operator()<Remap::HC2F>();
+            case Remap::HC2FC: return launch.template operator()<Remap::HC2FC>();
+            case Remap::F2H: return launch.template operator()<Remap::F2H>();
+            case Remap::F2HC: return launch.template operator()<Remap::F2HC>();
+            case Remap::F2F: return launch.template operator()<Remap::F2F>();
+            case Remap::F2FC: return launch.template operator()<Remap::F2FC>();
+            case Remap::FC2H: return launch.template operator()<Remap::FC2H>();
+            case Remap::FC2HC: return launch.template operator()<Remap::FC2HC>();
+            case Remap::FC2F: return launch.template operator()<Remap::FC2F>();
+            case Remap::FC2FC: return launch.template operator()<Remap::FC2FC>();
+        }
+    }
+
+    /// Returns a cropped or zero-padded, and remapped, FFT.
+    /// \see resize_and_remap.
+    template<nt::readable_varray_decay_of_numeric Input>
+    [[nodiscard]] auto resize_and_remap(
+        Remap remap,
+        Input&& input,
+        const Shape4<i64>& input_shape,
+        const Shape4<i64>& output_shape,
+        f64 taper_width = 0
+    ) {
+        using value_t = nt::mutable_value_type_t<Input>;
+        Array<value_t> output(remap.is_xx2fx() ? output_shape : output_shape.rfft(), input.options());
+        resize_and_remap(remap, std::forward<Input>(input), input_shape, output, output_shape, taper_width);
+        return output;
+    }
 }
@@ -3,6 +3,8 @@
 #include "noa/unified/Array.hpp"
 #include "noa/unified/Factory.hpp"
 #include "noa/unified/Ewise.hpp"
+#include "noa/unified/Trace.hpp"
+#include "noa/unified/fft/Resize.hpp"
 
 #include "noa/cpu/fft/Transforms.hpp"
 #ifdef NOA_ENABLE_CUDA
@@ -12,26 +14,103 @@
 namespace noa::fft {
     static constexpr Norm NORM_DEFAULT = Norm::FORWARD;
 
+    /// Planning rigor of the CPU transforms, from the fastest to plan to the (likely) fastest to execute.
+    /// ESTIMATE picks a plan using a simple heuristic. The others measure the execution time of more and more
+    /// algorithms and pick the fastest, which can take seconds for large transforms.
+    enum class Rigor {
+        ESTIMATE,
+        MEASURE,
+        PATIENT,
+        EXHAUSTIVE
+    };
+
     struct FFTOptions {
         /// Normalization mode.
+        /// With Norm::NONE, the normalization can be deferred to the next operation (see normalization_factor).
         Norm norm = NORM_DEFAULT;
 
         /// Whether this transform should be cached.
+        /// On the CPU, only the plans with a planning rigor other than ESTIMATE are cached.
+        /// The caches have a limited capacity, see Session::set_fft_cache_limit and Session::clear_fft_cache.
         bool cache_plan = true;
+
+        /// Planning rigor of the CPU transforms. Plans are measured on scratch buffers, so the arrays are never
+        /// overwritten during planning. This is ignored by the GPU backend.
+        Rigor rigor = Rigor::ESTIMATE;
+
+        /// Whether the CPU plans should be autotuned. The first transform uses a plan created with ESTIMATE,
+        /// while a plan with the planning rigor (at least MEASURE) is measured in the background. Once it is ready,
+        /// the next transforms with the same layout use it. Autotuned plans are always cached.
+        /// This is ignored by the GPU backend.
+        bool autotune = false;
     };
 }
 
+namespace noa::fft {
+    /// Returns the factor applied by the normalization mode to the output of a transform.
+    /// \param shape   BDHW logical shape of the transform.
+    /// \param sign    Sign of the transform. r2c is forward, c2r is backward.
+    /// \param norm    Normalization mode.
+    /// \note Transforms computed with Norm::NONE leave the normalization to the caller. Multiplying by this factor
+    ///       inside the operator consuming (or producing) the spectrum, e.g. with the \c input_scale option of the
+    ///       spectrum filters, saves the extra read and write of the array that the transforms would otherwise do.
+    template<nt::real T = f64>
+    [[nodiscard]] auto normalization_factor(const Shape4<i64>& shape, Sign sign, Norm norm) -> T {
+        if ((sign == Sign::FORWARD and (norm == Norm::FORWARD or norm == Norm::ORTHO)) or
+            (sign == Sign::BACKWARD and (norm == Norm::BACKWARD or norm == Norm::ORTHO))) {
+            const auto count = static_cast<f64>(product(shape.pop_front()));
+            return static_cast<T>(1 / (norm == Norm::ORTHO ? sqrt(count) : count));
+        }
+        return T{1};
+    }
+}
+
 namespace noa::fft::guts {
     template<typename T>
     void normalize(T&& array, const Shape4<i64>& shape, Sign sign, Norm norm) {
         using real_t = nt::mutable_value_type_twice_t<T>;
-        const auto count = static_cast<real_t>(product(shape.pop_front()));
-        const auto scale = norm == Norm::ORTHO ? sqrt(count) : count;
-        if ((sign == Sign::FORWARD and (norm == Norm::FORWARD or norm == Norm::ORTHO)) or
-            (sign == Sign::BACKWARD and (norm == Norm::BACKWARD or norm == Norm::ORTHO))) {
-            ewise({}, std::forward<T>(array), Scale{1 / scale});
+        const auto factor = normalization_factor<real_t>(shape, sign, norm);
+        if (factor != 1)
+            ewise({}, std::forward<T>(array), Scale{factor});
+    }
+
+    /// Creates the trace of a transform. The input and output are read and written once.
+    template<typename Input, typename Output>
+    auto make_trace(
+        const char* name,
+        const Input& input,
+        const Output& output,
+        i64 n_threads
+    ) -> noa::guts::trace_type {
+        if constexpr (noa::guts::TRACING) {
+            return noa::guts::make_trace([&] {
+                using output_t = nt::mutable_value_type_t<Output>;
+                return TraceEvent{
+                    .name = name,
+                    .dtype = ns::stringify<output_t>(),
+                    .shape = input.shape(),
+                    .n_bytes_read = input.n_elements() * static_cast<i64>(sizeof(nt::value_type_t<Input>)),
+                    .n_bytes_written = output.n_elements() * static_cast<i64>(sizeof(output_t)),
+                    .n_threads = n_threads,
+                    .device = output.device(),
+                };
+            });
+        } else {
+            (void) name, (void) input, (void) output, (void) n_threads;
+            return {};
         }
     }
+
+    inline auto to_cpu_options(const FFTOptions& options, u32 algorithm_flags) -> noa::cpu::fft::TuneOptions {
+        u32 flags{};
+        switch (options.rigor) {
+            case Rigor::ESTIMATE: flags = noa::cpu::fft::ESTIMATE; break;
+            case Rigor::MEASURE: flags = noa::cpu::fft::MEASURE; break;
+            case Rigor::PATIENT: flags = noa::cpu::fft::PATIENT; break;
+            case Rigor::EXHAUSTIVE: flags = noa::cpu::fft::EXHAUSTIVE; break;
+        }
+        return {.flags = flags | algorithm_flags, .cache = options.cache_plan, .autotune = options.autotune};
+    }
 }
 
 namespace noa::fft {
@@ -58,16 +137,19 @@ namespace noa::fft {
         if (device.is_cpu()) {
             auto& cpu_stream = stream.cpu();
             const auto n_threads = cpu_stream.thread_limit();
+            const auto cpu_options = guts::to_cpu_options(options, noa::cpu::fft::PRESERVE_INPUT);
+            const auto trace = guts::make_trace("fft::r2c", input, output, n_threads);
             cpu_stream.enqueue([=, real = std::forward<Input>(input)] {
-                constexpr auto flags = noa::cpu::fft::ESTIMATE | noa::cpu::fft::PRESERVE_INPUT;
+                const auto trace_scope = noa::guts::TraceScope(trace);
                 noa::cpu::fft::r2c(
                         real.get(), real.strides(),
                         output.get(), output.strides(),
-                        real.shape(), flags, n_threads);
+                        real.shape(), cpu_options, n_threads);
             });
         } else {
             #ifdef NOA_ENABLE_CUDA
             auto& cuda_stream = stream.cuda();
+            const auto trace_scope = noa::guts::TraceScope(guts::make_trace("fft::r2c", input, output, 0));
             noa::cuda::fft::r2c(
                 input.get(), input.strides(),
                 output.get(), output.strides(),
@@ -116,16 +198,19 @@ namespace noa::fft {
         if (device.is_cpu()) {
             auto& cpu_stream = stream.cpu();
             const auto threads = cpu_stream.thread_limit();
+            const auto cpu_options = guts::to_cpu_options(options, 0);
+            const auto trace = guts::make_trace("fft::c2r", input, output, threads);
             cpu_stream.enqueue([=, complex = std::forward<Input>(input)] {
-                constexpr auto flags = noa::cpu::fft::ESTIMATE;
+                const auto trace_scope = noa::guts::TraceScope(trace);
                 noa::cpu::fft::c2r(
                     complex.get(), complex.strides(),
                     output.get(), output.strides(),
-                    output.shape(), flags, threads);
+                    output.shape(), cpu_options, threads);
             });
         } else {
             #ifdef NOA_ENABLE_CUDA
             auto& cuda_stream = stream.cuda();
+            const auto trace_scope = noa::guts::TraceScope(guts::make_trace("fft::c2r", input, output, 0));
             noa::cuda::fft::c2r(
                 input.get(), input.strides(),
                 output.get(), output.strides(),
@@ -175,16 +260,19 @@ namespace noa::fft {
         if (device.is_cpu()) {
             auto& cpu_stream = stream.cpu();
             const auto threads = cpu_stream.thread_limit();
+            const auto cpu_options = guts::to_cpu_options(options, noa::cpu::fft::PRESERVE_INPUT);
+            const auto trace = guts::make_trace("fft::c2c", input, output, threads);
             cpu_stream.enqueue([=, i = std::forward<Input>(input)] {
-                constexpr auto flags = noa::cpu::fft::ESTIMATE | noa::cpu::fft::PRESERVE_INPUT;
+                const auto trace_scope = noa::guts::TraceScope(trace);
                 noa::cpu::fft::c2c(
                     i.get(), i.strides(),
                     output.get(), output.strides(),
-                    i.shape(), sign, flags, threads);
+                    i.shape(), sign, cpu_options, threads);
             });
         } else {
             #ifdef NOA_ENABLE_CUDA
             auto& cuda_stream = stream.cuda();
+            const auto trace_scope = noa::guts::TraceScope(guts::make_trace("fft::c2c", input, output, 0));
             noa::cuda::fft::c2c(
                 input.get(), input.strides(),
                 output.get(), output.strides(),
@@ -209,4 +297,126 @@ namespace noa::fft {
         c2c(std::forward<Input>(input), output, sign, options);
         return output;
     }
+
+    /// Computes the forward r2c transform of zero-padded array(s), and crops the spectrum.
+    /// This is equivalent to zero-padding the input to the logical shape, computing the r2c transform and cropping
+    /// the spectrum with resize<Remap::H2H>. On the CPU, this is a pruned transform: it is computed one dimension
+    /// at a time, and the rows and planes that are known to be zero, or that are cropped, are skipped.
+    /// \param[in] input    Real array(s). Non-zero region, at the origin, of the zero-padded input.
+    /// \param[out] output  Non-redundant non-centered, aka "h" layout, FFT(s), cropped to the lowest frequencies.
+    ///                     The (D)H dimensions are cropped like resize<Remap::H2H>, and the width keeps the first
+    ///                     output.shape()[3] columns.
+    /// \param shape        BDHW logical shape of the transform, i.e. of the zero-padded input.
+    /// \note On the CPU, the arrays should be in the rightmost order, 1d transforms should be row vectors, and
+    ///       the normalization is folded in the last pass. The plans are cached like the other transforms,
+    ///       but the autotune option is ignored.
+    /// \note On the GPU, the input is zero-padded and the entire spectrum is computed before being cropped.
+    template<nt::varray_decay_of_almost_any<f32, f64> Input,
+             nt::varray_decay_of_any<Complex<nt::mutable_value_type_t<Input>>> Output>
+    void r2c_pruned(Input&& input, Output&& output, const Shape4<i64>& shape, FFTOptions options = {}) {
+        using real_t = nt::mutable_value_type_t<Input>;
+        check(not input.is_empty() and not output.is_empty(), "Empty array detected");
+        check(shape[3] > 1, "The transforms should be along the width, but got shape={}", shape);
+        check(input.shape()[0] == shape[0] and vall(LessEqual{}, input.shape(), shape),
+              "Given the logical shape {}, the input (the non-zero region) should have the same batch and be "
+              "within the logical shape, but got input:shape={}", shape, input.shape());
+        check(output.shape()[0] == shape[0] and vall(LessEqual{}, output.shape(), shape.rfft()),
+              "Given the logical shape {}, the output (the cropped spectrum) should have the same batch and be "
+              "within the rfft shape {}, but got output:shape={}", shape, shape.rfft(), output.shape());
+
+        const Device device = output.device();
+        check(device == input.device(),
+              "The input and output arrays must be on the same device, but got input:device={}, output:device={}",
+              input.device(), device);
+        check(not ni::are_overlapped(input, output), "Input and output arrays should not overlap");
+
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
+            const auto cpu_options = guts::to_cpu_options(options, 0);
+            const auto scale = normalization_factor<real_t>(shape, Sign::FORWARD, options.norm);
+            cpu_stream.enqueue([=, real = std::forward<Input>(input)] {
+                noa::cpu::fft::PrunedPlan<real_t>(
+                    real.get(), real.strides(), real.shape(),
+                    output.get(), output.strides(), output.shape(),
+                    shape, cpu_options, n_threads).execute(scale);
+            });
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            const auto input_shape = input.shape();
+            Array padded = noa::zeros<real_t>(shape, input.options());
+            copy(std::forward<Input>(input), padded.subregion(
+                ni::FullExtent{}, ni::Slice{0, input_shape[1]}, ni::Slice{0, input_shape[2]}, ni::Slice{0, input_shape[3]}));
+            const auto output_shape = output.shape();
+            resize<Remap::H2H>(r2c(std::move(padded), options), shape, std::forward<Output>(output),
+                               {output_shape[0], output_shape[1], output_shape[2], (output_shape[3] - 1) * 2});
+            #else
+            panic_no_gpu_backend();
+            #endif
+        }
+    }
+
+    /// Computes the backward c2r transform of cropped spectrum(s), and only computes a region of the output.
+    /// This is equivalent to zero-padding the spectrum to the logical shape with resize<Remap::H2H>, computing the
+    /// c2r transform and extracting the region at the origin. On the CPU, this is a pruned transform: it is computed
+    /// one dimension at a time, and the rows and planes that are known to be zero, or that are not in the output
+    /// region, are skipped.
+    /// \param[in] input    Non-redundant non-centered, aka "h" layout, FFT(s), cropped to the lowest frequencies.
+    ///                     The (D)H dimensions are padded like resize<Remap::H2H>, and the width is padded with
+    ///                     zeros after the input.shape()[3] columns. On the CPU, the input is preserved.
+    /// \param[out] output  Real array(s). Region, at the origin, of the real-space output.
+    /// \param shape        BDHW logical shape of the transform.
+    /// \note On the CPU, the arrays should be in the rightmost order, 1d transforms should be row vectors, and
+    ///       the normalization is folded in the last pass. The plans are cached like the other transforms,
+    ///       but the autotune option is ignored.
+    /// \note On the GPU, the input is zero-padded and the entire output is computed before being cropped.
+    template<nt::varray_decay_of_almost_any<c32, c64> Input,
+             nt::varray_decay_of_any<nt::mutable_value_type_twice_t<Input>> Output>
+    void c2r_pruned(Input&& input, Output&& output, const Shape4<i64>& shape, FFTOptions options = {}) {
+        using real_t = nt::mutable_value_type_twice_t<Input>;
+        check(not input.is_empty() and not output.is_empty(), "Empty array detected");
+        check(shape[3] > 1, "The transforms should be along the width, but got shape={}", shape);
+        check(input.shape()[0] == shape[0] and vall(LessEqual{}, input.shape(), shape.rfft()),
+              "Given the logical shape {}, the input (the cropped spectrum) should have the same batch and be "
+              "within the rfft shape {}, but got input:shape={}", shape, shape.rfft(), input.shape());
+        check(output.shape()[0] == shape[0] and vall(LessEqual{}, output.shape(), shape),
+              "Given the logical shape {}, the output (the computed region) should have the same batch and be "
+              "within the logical shape, but got output:shape={}", shape, output.shape());
+
+        const Device device = output.device();
+        check(device == input.device(),
+              "The input and output arrays must be on the same device, but got input:device={}, output:device={}",
+              input.device(), device);
+        check(not ni::are_overlapped(input, output), "Input and output arrays should not overlap");
+
+        Stream& stream = Stream::current(device);
+        if (device.is_cpu()) {
+            auto& cpu_stream = stream.cpu();
+            const auto n_threads = cpu_stream.thread_limit();
+            const auto cpu_options = guts::to_cpu_options(options, 0);
+            const auto scale = normalization_factor<real_t>(shape, Sign::BACKWARD, options.norm);
+            cpu_stream.enqueue([=, complex = std::forward<Input>(input)] {
+                noa::cpu::fft::PrunedPlan<real_t>(
+                    complex.get(), complex.strides(), complex.shape(),
+                    output.get(), output.strides(), output.shape(),
+                    shape, cpu_options, n_threads).execute(scale);
+            });
+        } else {
+            #ifdef NOA_ENABLE_CUDA
+            const auto input_shape = input.shape();
+            Array padded = noa::zeros<Complex<real_t>>(shape.rfft(), input.options());
+            resize<Remap::H2H>(std::forward<Input>(input),
+                               {input_shape[0], input_shape[1], input_shape[2], (input_shape[3] - 1) * 2},
+                               padded, shape);
+            const auto output_shape = output.shape();
+            copy(c2r(std::move(padded), shape, options).subregion(
+                     ni::FullExtent{}, ni::Slice{0, output_shape[1]},
+                     ni::Slice{0, output_shape[2]}, ni::Slice{0, output_shape[3]}),
+                 std::forward<Output>(output));
+            #else
+            panic_no_gpu_backend();
+            #endif
+        }
+    }
 }
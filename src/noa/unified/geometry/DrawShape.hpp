@@ -1,8 +1,13 @@
 #pragma once
 
+#include <optional>
+
 #include "noa/core/geometry/Transform.hpp"
 #include "noa/core/geometry/DrawShape.hpp"
+#include "noa/core/types/Pair.hpp"
 #include "noa/core/utils/BatchedParameter.hpp"
+#include "noa/unified/Array.hpp"
+#include "noa/unified/Factory.hpp"
 #include "noa/unified/Iwise.hpp"
 #include "noa/unified/View.hpp"
 
@@ -180,6 +185,103 @@ namespace noa::geometry::guts {
              drawable_transform<std::decay_t<Transform>, Shape::SIZE, DrawValue> or
              (nt::varray_decay<Transform> and drawable_transform<TransformValue, Shape::SIZE, DrawValue>));
 
+    /// Returns the drawing operator of a geometric shape.
+    template<typename Coord, bool IS_SMOOTH, typename Shape>
+    auto to_draw_operator(const Shape& geometric_shape) {
+        constexpr size_t N = Shape::SIZE;
+        auto cvalue = static_cast<Coord>(geometric_shape.cvalue);
+        auto center = geometric_shape.center.template as<Coord>();
+        auto smoothness = static_cast<Coord>(geometric_shape.smoothness);
+        if constexpr (nt::is_same_v<Shape, Ellipse<N>>) {
+            auto radius = geometric_shape.radius.template as<Coord>();
+            using ellipse_t = DrawEllipse<N, Coord, IS_SMOOTH>;
+            return ellipse_t(center, radius, cvalue, geometric_shape.invert, smoothness);
+        } else if constexpr (nt::is_same_v<Shape, Sphere<N>>) {
+            auto radius = static_cast<Coord>(geometric_shape.radius);
+            using sphere_t = DrawSphere<N, Coord, IS_SMOOTH>;
+            return sphere_t(center, radius, cvalue, geometric_shape.invert, smoothness);
+        } else if constexpr (nt::is_same_v<Shape, Rectangle<N>>) {
+            auto radius = geometric_shape.radius.template as<Coord>();
+            using rectangle_t = DrawRectangle<N, Coord, IS_SMOOTH>;
+            return rectangle_t(center, radius, cvalue, geometric_shape.invert, smoothness);
+        } else if constexpr (nt::is_same_v<Shape, Cylinder>) {
+            auto radius_length = Vec2<Coord>::from_values(geometric_shape.radius, geometric_shape.length);
+            using cylinder_t = DrawCylinder<Coord, IS_SMOOTH>;
+            return cylinder_t(center, radius_length, cvalue, geometric_shape.invert, smoothness);
+        } else {
+            static_assert(nt::always_false<>);
+        }
+    }
+
+    /// Computes the (D)HW bounding box [start, end) of the shape (including its smooth edge) drawn onto an array
+    /// of the given (D)HW shape. The box is clamped to the array, and is empty if the shape is outside the array.
+    /// Returns nullopt if the transform is not invertible.
+    template<typename GeometricShape, typename Transform, size_t N = GeometricShape::SIZE>
+    auto draw_shape_bounding_box(
+        const GeometricShape& geometric_shape,
+        const Transform& inverse_transform,
+        const Shape<i64, N>& shape
+    ) -> std::optional<Pair<Vec<i64, N>, Vec<i64, N>>> {
+        // Extent of the shape, along each axis of the shape.
+        const auto smoothness = geometric_shape.smoothness;
+        Vec<f64, N> extent;
+        if constexpr (nt::is_same_v<GeometricShape, Sphere<N>>)
+            extent = Vec<f64, N>::from_value(geometric_shape.radius + smoothness);
+        else if constexpr (nt::is_same_v<GeometricShape, Cylinder>)
+            extent = Vec<f64, N>::from_values(geometric_shape.length, geometric_shape.radius, geometric_shape.radius) + smoothness;
+        else
+            extent = geometric_shape.radius + smoothness;
+
+        // Get the forward transform, i.e. the one going from the shape to the array.
+        const auto center = geometric_shape.center;
+        Mat<f64, N + 1, N + 1> forward = Mat<f64, N + 1, N + 1>::eye(1);
+        if constexpr (nt::mat_of_shape<Transform, N, N> or nt::quaternion<Transform>) {
+            Mat<f64, N, N> rotation;
+            if constexpr (nt::quaternion<Transform>)
+                rotation = inverse_transform.template as<f64>().to_matrix();
+            else
+                rotation = inverse_transform.template as<f64>();
+            if (abs(determinant(rotation)) < 1e-8)
+                return std::nullopt;
+            // x = center + rotation^-1 * p
+            forward = translate(center) * linear2affine(rotation.inverse());
+        } else if constexpr (nt::mat_of_shape<Transform, N, N + 1> or nt::mat_of_shape<Transform, N + 1, N + 1>) {
+            Mat<f64, N + 1, N + 1> affine;
+            if constexpr (nt::mat_of_shape<Transform, N, N + 1>)
+                affine = truncated2affine(inverse_transform.template as<f64>());
+            else
+                affine = inverse_transform.template as<f64>();
+            if (abs(determinant(affine)) < 1e-8)
+                return std::nullopt;
+            // x = affine^-1 * (center + p)
+            forward = affine.inverse() * translate(center);
+        } else {
+            static_assert(nt::empty<Transform>);
+            forward = translate(center);
+        }
+
+        // Transform the corners of the shape's box.
+        auto min = Vec<f64, N>::from_value(std::numeric_limits<f64>::max());
+        auto max = Vec<f64, N>::from_value(std::numeric_limits<f64>::lowest());
+        for (size_t i{}; i < (size_t{1} << N); ++i) {
+            Vec<f64, N> corner;
+            for (size_t j{}; j < N; ++j)
+                corner[j] = (i >> j) & 1 ? extent[j] : -extent[j];
+            const auto coordinates = transform_vector(forward, corner);
+            min = noa::min(min, coordinates);
+            max = noa::max(max, coordinates);
+        }
+        for (size_t i{}; i < N; ++i)
+            if (not is_finite(min[i]) or not is_finite(max[i]))
+                return std::nullopt;
+
+        // Add one element on each side for rounding errors.
+        const auto end_max = shape.vec.template as<f64>();
+        const auto start = clamp(floor(min) - 1, Vec<f64, N>{}, end_max);
+        const auto end = clamp(ceil(max) + 2, start, end_max);
+        return Pair{start.template as<i64>(), end.template as<i64>()};
+    }
+
     template<IwiseOptions OPTIONS,
              typename Index, typename Input, typename Output,
              typename Shape, typename Transform, typename BinaryOp>
@@ -219,35 +321,26 @@ namespace noa::geometry::guts {
         // fall back to double if input is not real or complex.
         using coord_t = drawable_value_type_t<Input, xform_t>;
         auto extract_drawing_operator = [&]<bool is_smooth>() {
-            auto cvalue = static_cast<coord_t>(geometric_shape.cvalue);
-            auto center = geometric_shape.center.template as<coord_t>();
-            auto smoothness = static_cast<coord_t>(geometric_shape.smoothness);
-            if constexpr (nt::is_same_v<Shape, Ellipse<N>>) {
-                auto radius = geometric_shape.radius.template as<coord_t>();
-                using ellipse_t = DrawEllipse<N, coord_t, is_smooth>;
-                return ellipse_t(center, radius, cvalue, geometric_shape.invert, smoothness);
-            } else if constexpr (nt::is_same_v<Shape, Sphere<N>>) {
-                auto radius = static_cast<coord_t>(geometric_shape.radius);
-                using sphere_t = DrawSphere<N, coord_t, is_smooth>;
-                return sphere_t(center, radius, cvalue, geometric_shape.invert, smoothness);
-            } else if constexpr (nt::is_same_v<Shape, Rectangle<N>>) {
-                auto radius = geometric_shape.radius.template as<coord_t>();
-                using rectangle_t = DrawRectangle<N, coord_t, is_smooth>;
-                return rectangle_t(center, radius, cvalue, geometric_shape.invert, smoothness);
-            } else if constexpr (nt::is_same_v<Shape, Cylinder>) {
-                auto radius_length = Vec2<coord_t>::from_values(geometric_shape.radius, geometric_shape.length);
-                using cylinder_t = DrawCylinder<coord_t, is_smooth>;
-                return cylinder_t(center, radius_length, cvalue, geometric_shape.invert, smoothness);
-            } else {
-                static_assert(nt::always_false<>);
-            }
+            return to_draw_operator<coord_t, is_smooth>(geometric_shape);
         };
 
-        // Launch, with or without transformation.
-        auto launch = [&]<typename T>(T draw_op) {
-            // Loop through every element of the output.
-            auto iwise_shape = output.shape().template filter_nd<N>().template as<Index>();
+        // If the shape only covers a small region of the output, only this region is drawn.
+        const auto output_shape_nd = output.shape().template filter_nd<N>().pop_front();
+        std::optional<Pair<Vec<i64, N>, Vec<i64, N>>> bounding_box;
+        if constexpr (not nt::varray<xform_t>) {
+            bounding_box = draw_shape_bounding_box(geometric_shape, inverse_transform, output_shape_nd);
+            if (bounding_box and
+                noa::Shape<i64, N>::from_vec(bounding_box->second - bounding_box->first).n_elements() * 2 >
+                output_shape_nd.n_elements())
+                bounding_box.reset();
+        }
 
+        // Launch, with or without transformation.
+        auto launch = [&]<typename T>(
+            T draw_op,
+            const noa::Shape<Index, N + 1>& iwise_shape,
+            const output_accessor_t& output_accessor
+        ) {
             // Wrap the transform (only called if there is a transform).
             auto extract_transform = [&] {
                 if constexpr (nt::is_mat_of_shape_v<xform_t, N + 1, N + 1>) {
@@ -282,10 +375,44 @@ namespace noa::geometry::guts {
             }
         };
 
+        auto launch_bounded = [&]<typename T>(T draw_op) {
+            // Loop through every element of the output.
+            auto iwise_shape = output.shape().template filter_nd<N>().template as<Index>();
+            if (not bounding_box)
+                return launch(draw_op, iwise_shape, output_accessor);
+
+            using bounded_t = DrawBoundingBox<N, T>;
+            using vec_t = bounded_t::vector_type;
+            const auto outside_value = static_cast<coord_t>(geometric_shape.invert) *
+                                       static_cast<coord_t>(geometric_shape.cvalue);
+            const auto& [start, end] = *bounding_box;
+            if (not input.is_empty()) {
+                // The binary operator is applied to every element, but the shape is only evaluated in the box.
+                return launch(bounded_t(draw_op, vec_t{}, start.template as<coord_t>(),
+                                        end.template as<coord_t>(), outside_value),
+                              iwise_shape, output_accessor);
+            }
+
+            // Fill the output and only draw the box.
+            using output_value_t = nt::value_type_t<Output>;
+            output_value_t fill_value{};
+            fill_value = static_cast<nt::value_type_t<output_value_t>>(outside_value);
+            fill(output, fill_value);
+            if (any(end <= start))
+                return;
+
+            const auto offset = ni::offset_at(output_accessor.strides(), start.template as<Index>().push_front(0));
+            const auto output_box_accessor = output_accessor_t(output_accessor.get() + offset, output_accessor.strides());
+            iwise_shape = noa::Shape<i64, N>::from_vec(end - start).push_front(output.shape()[0]).template as<Index>();
+            return launch(bounded_t(draw_op, start.template as<coord_t>(), start.template as<coord_t>(),
+                                    end.template as<coord_t>(), outside_value),
+                          iwise_shape, output_box_accessor);
+        };
+
         if (geometric_shape.smoothness > 1e-8) {
-            launch(extract_drawing_operator.template operator()<true>());
+            launch_bounded(extract_drawing_operator.template operator()<true>());
         } else {
-            launch(extract_drawing_operator.template operator()<false>());
+            launch_bounded(extract_drawing_operator.template operator()<false>());
         }
     }
 }
@@ -352,4 +479,246 @@ namespace noa::geometry {
             std::forward<Transform>(inverse_transforms),
             binary_op);
     }
+
+    /// Geometric shape compiled into a sparse mask, to efficiently apply the same mask to many arrays.
+    /// \details The shape is evaluated once, and the mask is stored as one [begin, end) span per row, with the values of the mask within these spans. Outside the spans, the mask has a constant
+    ///          value, i.e. 0, or cvalue if the shape is inverted. Applying the mask (see apply_mask) only iterates
+    ///          through the spans, so its cost is proportional to the masked area, regardless of the type of shape or
+    ///          of its smooth edge. The constant region is a plain fill, copy or scaling, or is skipped entirely.
+    template<nt::any_of<f32, f64> Value, size_t N>
+    requires (N == 2 or N == 3)
+    class CompiledMask {
+    public:
+        using value_type = Value;
+        using row_type = Vec<i64, 3>; // begin, end, offset of the first value
+        using rows_type = Array<row_type>;
+        using spans_type = Array<i64>;
+        using values_type = Array<value_type>;
+
+    public:
+        CompiledMask() = default;
+
+        /// Compiles a geometric shape.
+        /// \param shape                BDHW shape of the mask. The batch dimension should be 1.
+        /// \param geometric_shape      Geometric shape to draw.
+        /// \param inverse_transform    Optional inverse (D)HW (affine) matrix or quaternion to apply to the shape.
+        ///                             See draw_shape() for more details. Batched transforms are not supported.
+        /// \param options              Options of the arrays holding the mask.
+        template<typename GeometricShape, typename Transform = Empty>
+        requires (guts::drawable_shape<GeometricShape> and GeometricShape::SIZE == N and
+                  (nt::empty<Transform> or guts::drawable_transform<Transform, N, nt::value_type_t<Transform>>))
+        CompiledMask(
+            const Shape4<i64>& shape,
+            const GeometricShape& geometric_shape,
+            const Transform& inverse_transform = {},
+            const ArrayOption& options = {}
+        ) : m_shape(shape) {
+            check(not shape.is_empty() and shape[0] == 1 and (N == 3 or shape[1] == 1),
+                  "The mask should be a single {}d array, but got shape={}", N, shape);
+            if (geometric_shape.smoothness > 1e-8)
+                compile_(guts::to_draw_operator<value_type, true>(geometric_shape), geometric_shape, inverse_transform, options);
+            else
+                compile_(guts::to_draw_operator<value_type, false>(geometric_shape), geometric_shape, inverse_transform, options);
+        }
+
+    public:
+        [[nodiscard]] auto shape() const -> const Shape4<i64>& { return m_shape; }
+        [[nodiscard]] auto device() const -> Device { return m_rows.device(); }
+        [[nodiscard]] auto is_empty() const -> bool { return m_rows.is_empty(); }
+        [[nodiscard]] auto outside_value() const -> value_type { return m_outside_value; }
+
+        /// Rows of the mask, i.e. the {begin, end, offset} of every (D)H row.
+        [[nodiscard]] auto rows() const -> const rows_type& { return m_rows; }
+
+        /// Indices of the rows with a non-empty span, i.e. d * height + h.
+        /// Empty if the shape is not in the mask.
+        [[nodiscard]] auto spans() const -> const spans_type& { return m_spans; }
+
+        /// Number of elements of the largest span.
+        [[nodiscard]] auto max_span_size() const -> i64 { return m_max_span_size; }
+
+        /// Values of the mask within the spans of the rows. Empty if the shape is not in the mask.
+        [[nodiscard]] auto values() const -> const values_type& { return m_values; }
+
+        /// Number of elements within the spans of the rows.
+        [[nodiscard]] auto n_masked_elements() const -> i64 { return m_values.ssize(); }
+
+    private:
+        template<typename DrawOp, typename GeometricShape, typename Transform>
+        void compile_(
+            const DrawOp& draw_op,
+            const GeometricShape& geometric_shape,
+            const Transform& inverse_transform,
+            const ArrayOption& options
+        ) {
+            const auto shape_nd = m_shape.filter_nd<N>().pop_front();
+            m_outside_value = static_cast<value_type>(geometric_shape.invert) *
+                              static_cast<value_type>(geometric_shape.cvalue);
+
+            // The shape is only evaluated within its bounding box.
+            Vec<i64, N> start{};
+            Vec<i64, N> end = shape_nd.vec;
+            if (const auto box = guts::draw_shape_bounding_box(geometric_shape, inverse_transform, shape_nd)) {
+                start = box->first;
+                end = box->second;
+            }
+
+            auto xform = [&] {
+                if constexpr (nt::empty<Transform>)
+                    return Empty{};
+                else
+                    return inverse_transform.template as<value_type>();
+            }();
+
+            const i64 height = shape_nd[N - 2];
+            const i64 n_rows = N == 3 ? shape_nd[0] * height : height;
+            std::vector<row_type> rows(static_cast<size_t>(n_rows), row_type{});
+            std::vector<i64> spans;
+            std::vector<value_type> values;
+            std::vector<value_type> row_values;
+            const i64 depth_start = N == 3 ? start[0] : 0;
+            const i64 depth_end = N == 3 ? end[0] : 1;
+            for (i64 d = depth_start; d < depth_end; ++d) {
+                for (i64 h = start[N - 2]; h < end[N - 2]; ++h) {
+                    // Evaluate the row and find the region that differs from the outside value.
+                    i64 begin{-1}, last{-1};
+                    row_values.clear();
+                    for (i64 w = start[N - 1]; w < end[N - 1]; ++w) {
+                        Vec<value_type, N> coordinates;
+                        if constexpr (N == 3)
+                            coordinates = Vec<value_type, N>::from_values(d, h, w);
+                        else
+                            coordinates = Vec<value_type, N>::from_values(h, w);
+                        const value_type value = draw_op(coordinates, xform);
+                        row_values.push_back(value);
+                        if (value != m_outside_value) {
+                            if (begin == -1)
+                                begin = w;
+                            last = w;
+                        }
+                    }
+                    if (begin == -1)
+                        continue;
+                    const auto offset = static_cast<i64>(values.size());
+                    rows[static_cast<size_t>(d * height + h)] = {begin, last + 1, offset};
+                    spans.push_back(d * height + h);
+                    m_max_span_size = max(m_max_span_size, last + 1 - begin);
+                    values.insert(values.end(),
+                                  row_values.begin() + (begin - start[N - 1]),
+                                  row_values.begin() + (last + 1 - start[N - 1]));
+                }
+            }
+
+            auto to_array = [&]<typename T>(const std::vector<T>& vector) {
+                if (vector.empty())
+                    return Array<T>{};
+                // Create a new sync stream so that the final copy doesn't sync the default cpu stream of the user.
+                const auto guard = StreamGuard(Device{}, Stream::DEFAULT);
+                auto array = Array<T>(std::ssize(vector));
+                std::copy(vector.begin(), vector.end(), array.get());
+                if (options.device.is_cpu() and options.allocator == Allocator::DEFAULT)
+                    return array;
+                return std::move(array).to(options);
+            };
+            m_rows = to_array(rows);
+            m_spans = to_array(spans);
+            m_values = to_array(values);
+        }
+
+    private:
+        rows_type m_rows;
+        spans_type m_spans;
+        values_type m_values;
+        Shape4<i64> m_shape{};
+        i64 m_max_span_size{};
+        value_type m_outside_value{};
+    };
+
+    /// Applies a compiled mask to array(s), i.e. output = input * mask.
+    /// \param[in] input    2d or 3d array(s) to mask.
+    /// \param[out] output  Masked 2d or 3d array(s). Can be equal to \p input.
+    /// \param[in] mask     Compiled mask, with the same (D)HW shape as the arrays.
+    ///                     The same mask is applied to every batch.
+    /// \note Outside the spans of the mask, the output is filled (if the constant value is 0), copied from the input
+    ///       (if the constant value is 1), or scaled. If the mask is applied in-place and the constant value is 1,
+    ///       e.g. with inverted shapes and cvalue=1, only the spans are accessed.
+    template<typename Input, typename Output, typename Value, size_t N>
+    requires (nt::readable_varray_decay_of_real_or_complex<Input> and
+              nt::writable_varray_decay_of_real_or_complex<Output> and
+              nt::varray_decay_of_almost_same_type<Input, Output>)
+    void apply_mask(Input&& input, Output&& output, const CompiledMask<Value, N>& mask) {
+        check(not input.is_empty() and not output.is_empty() and not mask.is_empty(), "Empty array detected");
+        check(all(input.shape() == output.shape()) and all(output.shape().pop_front() == mask.shape().pop_front()),
+              "The input, output and mask should have the same shape, excluding the batch, "
+              "but got input:shape={}, output:shape={}, mask:shape={}",
+              input.shape(), output.shape(), mask.shape());
+        const Device device = output.device();
+        check(input.device() == device and mask.device() == device,
+              "The input, output and mask must be on the same device, "
+              "but got input:device={}, output:device={}, mask:device={}",
+              input.device(), device, mask.device());
+
+        // Region outside the spans, where the mask is constant.
+        // In-place, the spans are needed by the second pass, so the region is scaled by its own pass instead.
+        const bool is_inplace = input.get() == output.get() and all(input.strides() == output.strides());
+        const auto outside_value = mask.outside_value();
+        using scalar_t = nt::mutable_value_type_twice_t<Input>;
+        if (not is_inplace) {
+            if (outside_value == 0)
+                fill(output, nt::value_type_t<Output>{});
+            else if (outside_value == 1)
+                copy(input, output);
+            else
+                ewise(wrap(input, static_cast<scalar_t>(outside_value)), output, Multiply{});
+        }
+
+        auto launch = [&]<typename Index, IwiseOptions OPTIONS>() {
+            using input_accessor_t = Accessor<nt::const_value_type_t<Input>, N + 1, Index>;
+            using output_accessor_t = Accessor<nt::value_type_t<Output>, N + 1, Index>;
+            using rows_accessor_t = AccessorRestrictContiguous<const Vec<i64, 3>, 1, Index>;
+            using spans_accessor_t = AccessorRestrictContiguous<const i64, 1, Index>;
+            using values_accessor_t = AccessorRestrictContiguous<const Value, 1, Index>;
+            const auto input_accessor = input_accessor_t(
+                input.get(), input.strides().template filter_nd<N>().template as<Index>());
+            const auto output_accessor = output_accessor_t(
+                output.get(), output.strides().template filter_nd<N>().template as<Index>());
+            const auto height = static_cast<Index>(mask.shape()[2]);
+
+            if (is_inplace and outside_value != 1) {
+                using op_t = guts::ApplyCompiledMaskOutside<
+                    N, Index, rows_accessor_t, input_accessor_t, output_accessor_t>;
+                auto op = op_t(input_accessor, output_accessor, rows_accessor_t(mask.rows().get()),
+                               height, static_cast<scalar_t>(outside_value));
+                iwise<OPTIONS>(
+                    output.shape().template filter_nd<N>().template as<Index>(), device, std::move(op),
+                    input, output, mask.rows());
+            }
+            if (mask.spans().is_empty())
+                return;
+
+            // Only the spans are accessed. The grid is padded to the largest span.
+            using op_t = guts::ApplyCompiledMask<
+                N, Index, rows_accessor_t, spans_accessor_t, values_accessor_t, input_accessor_t, output_accessor_t>;
+            auto op = op_t(input_accessor, output_accessor,
+                           rows_accessor_t(mask.rows().get()), spans_accessor_t(mask.spans().get()),
+                           values_accessor_t(mask.values().get()), height);
+            const auto iwise_shape = Shape3<i64>{output.shape()[0], mask.spans().ssize(), mask.max_span_size()};
+            iwise<OPTIONS>(
+                iwise_shape.template as<Index>(), device, std::move(op),
+                std::forward<Input>(input), std::forward<Output>(output),
+                mask.rows(), mask.spans(), mask.values());
+        };
+
+        if (device.is_gpu() and
+            ng::is_accessor_access_safe<i32>(input.strides(), input.shape()) and
+            ng::is_accessor_access_safe<i32>(output.strides(), output.shape()) and
+            mask.n_masked_elements() <= std::numeric_limits<i32>::max()) {
+            #ifdef NOA_ENABLE_CUDA
+            return launch.template operator()<i32, IwiseOptions{.generate_cpu = false}>();
+            #else
+            std::terminate(); // unreachable
+            #endif
+        }
+        launch.template operator()<i64, IwiseOptions{}>();
+    }
 }
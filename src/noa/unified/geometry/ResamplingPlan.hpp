@@ -0,0 +1,645 @@
+#pragma once
+
+#include "noa/core/Enums.hpp"
+#include "noa/core/Interpolation.hpp"
+#include "noa/core/fft/Frequency.hpp"
+#include "noa/core/geometry/Polar.hpp"
+#include "noa/core/geometry/Transform.hpp"
+#include "noa/core/indexing/Offset.hpp"
+#include "noa/unified/Array.hpp"
+#include "noa/unified/Iwise.hpp"
+#include "noa/unified/geometry/PolarTransform.hpp"
+#include "noa/unified/geometry/PolarTransformSpectrum.hpp"
+#include "noa/unified/geometry/Transform.hpp"
+
+namespace noa::geometry::guts {
+    /// Computes the interpolation window of a 2d coordinate, as two separable 1d windows.
+    /// The indices are already resolved according to the border mode. For Border::ZERO and Border::VALUE,
+    /// out-of-bounds elements are given an index of 0 and a weight of 0.
+    /// \param[out] indices Indices of the window, i.e. SIZE row indices, followed by SIZE column indices.
+    /// \param[out] weights Weights of the window, with the same layout as the indices.
+    template<Interp INTERP, Border BORDER, i64 SIZE, typename T>
+    void set_resampling_window(const Vec2<T>& coordinate, const Shape2<i64>& shape, i32* indices, T* weights) {
+        auto set_tap = [&](size_t dim, i64 tap, i64 index, T weight) {
+            const auto offset = static_cast<i64>(dim) * SIZE + tap;
+            if constexpr (BORDER.is_any(Border::ZERO, Border::VALUE)) {
+                if (index < 0 or index >= shape[dim]) {
+                    index = 0;
+                    weight = 0;
+                }
+            } else {
+                index = ni::index_at<BORDER>(index, shape[dim]);
+            }
+            indices[offset] = static_cast<i32>(index);
+            weights[offset] = weight;
+        };
+
+        if constexpr (INTERP.is_almost_any(Interp::NEAREST)) {
+            static_assert(SIZE == 1);
+            const auto rounded = round(coordinate).template as<i64>();
+            for (size_t i{}; i < 2; ++i)
+                set_tap(i, 0, rounded[i], T{1});
+        } else {
+            static_assert(SIZE == INTERP.window_size());
+            constexpr i64 START = -(SIZE - 1) / 2;
+            const auto floored = floor(coordinate);
+            const auto fraction = coordinate - floored;
+            const auto weights_nd = interpolation_weights<INTERP, Vec2<T>>(fraction);
+            for (size_t i{}; i < 2; ++i)
+                for (i64 j{}; j < SIZE; ++j)
+                    set_tap(i, j, static_cast<i64>(floored[i]) + START + j, weights_nd[j][i]);
+        }
+    }
+
+    /// Computes the interpolation window of a 2d frequency, as two separable 1d windows.
+    /// This is equivalent to interpolate_spectrum, i.e. out-of-bounds frequencies are given an index of 0 and a
+    /// weight of 0, and the frequencies are converted to indices according to the layout of the spectrum.
+    /// For rffts, negative frequencies are flipped to their Hermitian counterpart. This is done once for the entire
+    /// window, so it is only supported for windows of size 1 or 2 (see interpolate_spectrum).
+    /// \param shape Logical HW shape of the spectrum.
+    /// \return -1 if the interpolated value should be conjugated, 1 otherwise.
+    template<Interp INTERP, i64 SIZE, bool IS_RFFT, bool IS_CENTERED, typename T>
+    auto set_resampling_spectrum_window(
+        Vec2<T> frequency, const Shape2<i64>& shape, i32* indices, T* weights
+    ) -> T {
+        static_assert(not IS_RFFT or SIZE <= 2);
+        const T conjugate = noa::guts::flip_frequency<IS_RFFT, T>(frequency);
+        const auto bounds = noa::fft::frequency_bounds<IS_RFFT>(shape);
+
+        auto set_tap = [&](size_t dim, i64 tap, i64 index, T weight) {
+            const auto offset = static_cast<i64>(dim) * SIZE + tap;
+            if (index < bounds.first[dim] or index > bounds.second[dim]) {
+                index = 0;
+                weight = 0;
+            } else if (not (IS_RFFT and dim == 1)) { // if width of rfft, frequency == index
+                index = noa::fft::frequency2index<IS_CENTERED>(index, shape[dim]);
+            }
+            indices[offset] = static_cast<i32>(index);
+            weights[offset] = weight;
+        };
+
+        if constexpr (INTERP.is_almost_any(Interp::NEAREST)) {
+            static_assert(SIZE == 1);
+            const auto rounded = round(frequency).template as<i64>();
+            for (size_t i{}; i < 2; ++i)
+                set_tap(i, 0, rounded[i], T{1});
+        } else {
+            static_assert(SIZE == INTERP.window_size());
+            constexpr i64 START = -(SIZE - 1) / 2;
+            const auto floored = floor(frequency);
+            const auto fraction = frequency - floored;
+            const auto weights_nd = interpolation_weights<INTERP, Vec2<T>>(fraction);
+            for (size_t i{}; i < 2; ++i)
+                for (i64 j{}; j < SIZE; ++j)
+                    set_tap(i, j, static_cast<i64>(floored[i]) + START + j, weights_nd[j][i]);
+        }
+        return conjugate;
+    }
+
+    /// 3d iwise operator applying a resampling plan to 2d array(s).
+    /// Each output element is the separable weighted sum of a SIZE*SIZE window of the input.
+    /// If HAS_CONJUGATES, the imaginary part of the sum is multiplied by the (-1 or 1) conjugate of the element.
+    template<i64 SIZE, bool HAS_CVALUE, bool HAS_CONJUGATES,
+             nt::sinteger Index,
+             nt::readable_nd<3> Input,
+             nt::writable_nd<3> Output,
+             nt::readable_nd<1> Indices,
+             nt::readable_nd<1> Weights>
+    class Resample {
+    public:
+        using index_type = Index;
+        using input_type = Input;
+        using output_type = Output;
+        using indices_type = Indices;
+        using weights_type = Weights;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        using weight_type = nt::mutable_value_type_t<weights_type>;
+        using cvalue_type = std::conditional_t<HAS_CVALUE, input_value_type, Empty>;
+        using conjugates_type = std::conditional_t<HAS_CONJUGATES, weights_type, Empty>;
+        static_assert(nt::spectrum_types<input_value_type, output_value_type>);
+        static_assert(not HAS_CONJUGATES or nt::complex<input_value_type>);
+
+    public:
+        constexpr Resample(
+            const input_type& input,
+            const output_type& output,
+            const indices_type& indices,
+            const weights_type& weights,
+            index_type width,
+            index_type plan_batch_stride,
+            cvalue_type cvalue = {},
+            const conjugates_type& conjugates = {}
+        ) :
+            m_input(input),
+            m_output(output),
+            m_indices(indices),
+            m_weights(weights),
+            m_width(width),
+            m_plan_batch_stride(plan_batch_stride),
+            m_cvalue(cvalue),
+            m_conjugates(conjugates) {}
+
+        NOA_HD constexpr void operator()(index_type batch, index_type y, index_type x) const {
+            const index_type element = batch * m_plan_batch_stride + y * m_width + x;
+            const index_type offset = element * 2 * SIZE;
+
+            input_value_type value{};
+            for (index_type j{}; j < SIZE; ++j) {
+                const auto row = static_cast<index_type>(m_indices[offset + j]);
+                input_value_type value_y{};
+                for (index_type i{}; i < SIZE; ++i) {
+                    const auto column = static_cast<index_type>(m_indices[offset + SIZE + i]);
+                    value_y += m_input(batch, row, column) * m_weights[offset + SIZE + i];
+                }
+                value += value_y * m_weights[offset + j];
+            }
+
+            if constexpr (HAS_CVALUE) {
+                // The out-of-bounds elements of the window have a weight of zero.
+                // Since the weights sum to one, the weight of the cvalue is what remains.
+                weight_type sum_y{}, sum_x{};
+                for (index_type i{}; i < SIZE; ++i) {
+                    sum_y += m_weights[offset + i];
+                    sum_x += m_weights[offset + SIZE + i];
+                }
+                value += m_cvalue * (1 - sum_y * sum_x);
+            }
+            if constexpr (HAS_CONJUGATES)
+                value.imag *= m_conjugates[element];
+            m_output(batch, y, x) = cast_or_abs_squared<output_value_type>(value);
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        indices_type m_indices;
+        weights_type m_weights;
+        index_type m_width;
+        index_type m_plan_batch_stride;
+        NOA_NO_UNIQUE_ADDRESS cvalue_type m_cvalue;
+        NOA_NO_UNIQUE_ADDRESS conjugates_type m_conjugates;
+    };
+}
+
+namespace noa::geometry {
+    struct ResamplingPlanOptions {
+        /// Interpolation method. All interpolation modes are supported.
+        /// The fast modes are computed like their accurate counterparts.
+        Interp interp{Interp::LINEAR};
+
+        /// Border method.
+        Border border{Border::ZERO};
+    };
+
+    /// Precomputed 2d resampling.
+    /// \details Geometric transformations (e.g. transform_2d, cartesian2polar or spectrum2polar) compute, for every
+    ///          output element, the input coordinate, the interpolation window and its weights. When the same geometry
+    ///          is applied to many images, this plan computes these windows once, with the border already resolved.
+    ///          Applying it (see resample) is then a gather-multiply-add. The window is stored as two separable 1d
+    ///          windows, i.e. 2*W indices (i32) and 2*W weights per output element, where W is 1 for nearest, 2 for
+    ///          linear, 4 for cubic and 4, 6 or 8 for lanczos.
+    /// \note The plan has one or multiple geometries, one per output batch. If it has a single geometry,
+    ///       it is applied to every output batch.
+    template<nt::any_of<f32, f64> T = f32>
+    class ResamplingPlan {
+    public:
+        using value_type = T;
+        using coord_type = Vec2<T>;
+        using indices_type = Array<i32>;
+        using weights_type = Array<T>;
+        using conjugates_type = Array<T>;
+
+    public:
+        ResamplingPlan() = default;
+
+        /// Creates a plan from the input coordinates of every output element.
+        /// \param input_shape  BDHW shape of the input. The batch is ignored.
+        /// \param output_shape BDHW shape of the output. The batch is the number of geometries.
+        /// \param coordinates  Function returning the HW input coordinate of an output element.
+        ///                     It is called on the CPU as coordinates(batch, y, x) -> Vec2<T>.
+        /// \param options      Interpolation and border options.
+        /// \param array_option Options of the arrays holding the plan.
+        template<typename Coordinates>
+        requires std::convertible_to<std::invoke_result_t<const Coordinates&, i64, i64, i64>, coord_type>
+        ResamplingPlan(
+            const Shape4<i64>& input_shape,
+            const Shape4<i64>& output_shape,
+            const Coordinates& coordinates,
+            const ResamplingPlanOptions& options = {},
+            const ArrayOption& array_option = {}
+        ) :
+            m_input_shape(input_shape),
+            m_output_shape(output_shape),
+            m_interp(options.interp),
+            m_border(options.border)
+        {
+            check_shapes_();
+            check(m_border != Border::NOTHING, "The border mode {} is not supported", m_border);
+
+            auto launch = [&]<Interp INTERP, Border BORDER>() {
+                constexpr i64 SIZE = window_size_<INTERP>();
+                const auto shape = input_shape.filter(2, 3);
+                set_windows_<SIZE>([&](i64 b, i64 y, i64 x, i32* indices, T* weights) {
+                    const coord_type coordinate = coordinates(b, y, x);
+                    guts::set_resampling_window<INTERP, BORDER, SIZE>(coordinate, shape, indices, weights);
+                    return T{1};
+                }, false, array_option);
+            };
+
+            launch_interp_(m_interp, [&]<Interp INTERP>() {
+                switch (m_border) {
+                    case Border::ZERO:     return launch.template operator()<INTERP, Border::ZERO>();
+                    case Border::VALUE:    return launch.template operator()<INTERP, Border::VALUE>();
+                    case Border::CLAMP:    return launch.template operator()<INTERP, Border::CLAMP>();
+                    case Border::PERIODIC: return launch.template operator()<INTERP, Border::PERIODIC>();
+                    case Border::MIRROR:   return launch.template operator()<INTERP, Border::MIRROR>();
+                    case Border::REFLECT:  return launch.template operator()<INTERP, Border::REFLECT>();
+                    case Border::NOTHING:  break;
+                }
+            });
+        }
+
+        /// Creates a plan from the input frequencies of every output element.
+        /// The input is a 2d (r)FFT and the plan computes the same windows as interpolate_spectrum.
+        /// Out-of-bounds frequencies are set to zero, i.e. the border of the plan is Border::ZERO.
+        /// \param remap            Layout of the input spectrum. The output layout is ignored.
+        /// \param spectrum_shape   BDHW logical shape of the input spectrum. The batch is ignored.
+        /// \param output_shape     BDHW shape of the output. The batch is the number of geometries.
+        /// \param frequencies      Function returning the HW unnormalized and centered frequency of an output element.
+        ///                         It is called on the CPU as frequencies(batch, y, x) -> Vec2<T>.
+        /// \param interp           Interpolation method. rffts only support the nearest and linear interpolations,
+        ///                         since mirroring the negative frequencies of larger windows isn't separable.
+        /// \param array_option     Options of the arrays holding the plan.
+        template<typename Frequencies>
+        requires std::convertible_to<std::invoke_result_t<const Frequencies&, i64, i64, i64>, coord_type>
+        ResamplingPlan(
+            Remap remap,
+            const Shape4<i64>& spectrum_shape,
+            const Shape4<i64>& output_shape,
+            const Frequencies& frequencies,
+            Interp interp = Interp::LINEAR,
+            const ArrayOption& array_option = {}
+        ) :
+            m_input_shape(remap.is_hx2xx() ? spectrum_shape.rfft() : spectrum_shape),
+            m_output_shape(output_shape),
+            m_interp(interp),
+            m_border(Border::ZERO)
+        {
+            check_shapes_();
+            check(remap.is_fx2xx() or m_interp.is_almost_any(Interp::NEAREST, Interp::LINEAR),
+                  "rffts only support the nearest and linear interpolations, but got interp={}", m_interp);
+
+            const auto shape = spectrum_shape.filter(2, 3);
+            launch_interp_(m_interp, [&]<Interp INTERP>() {
+                constexpr i64 SIZE = window_size_<INTERP>();
+                auto launch = [&]<bool IS_RFFT, bool IS_CENTERED>() {
+                    set_windows_<SIZE>([&](i64 b, i64 y, i64 x, i32* indices, T* weights) {
+                        const coord_type frequency = frequencies(b, y, x);
+                        return guts::set_resampling_spectrum_window<INTERP, SIZE, IS_RFFT, IS_CENTERED>(
+                            frequency, shape, indices, weights);
+                    }, IS_RFFT, array_option);
+                };
+                if (remap.is_fx2xx()) {
+                    if (remap.is_xc2xx())
+                        return launch.template operator()<false, true>();
+                    return launch.template operator()<false, false>();
+                }
+                if constexpr (SIZE <= 2) {
+                    if (remap.is_xc2xx())
+                        return launch.template operator()<true, true>();
+                    return launch.template operator()<true, false>();
+                }
+            });
+        }
+
+    public:
+        [[nodiscard]] auto input_shape() const -> const Shape4<i64>& { return m_input_shape; }
+        [[nodiscard]] auto output_shape() const -> const Shape4<i64>& { return m_output_shape; }
+        [[nodiscard]] auto interp() const -> Interp { return m_interp; }
+        [[nodiscard]] auto border() const -> Border { return m_border; }
+        [[nodiscard]] auto device() const -> Device { return m_indices.device(); }
+        [[nodiscard]] auto is_empty() const -> bool { return m_indices.is_empty(); }
+
+        /// Size of the 1d interpolation windows.
+        [[nodiscard]] auto window_size() const -> i64 { return m_window_size; }
+
+        /// Indices and weights of the separable windows.
+        /// For each output element, the 2*window_size indices/weights of the rows, followed by the columns.
+        [[nodiscard]] auto indices() const -> const indices_type& { return m_indices; }
+        [[nodiscard]] auto weights() const -> const weights_type& { return m_weights; }
+
+        /// Conjugation of each output element, i.e. -1 if the interpolated value should be conjugated, 1 otherwise.
+        /// This is only used by plans sampling rffts, and is empty otherwise.
+        [[nodiscard]] auto conjugates() const -> const conjugates_type& { return m_conjugates; }
+
+    private:
+        void check_shapes_() const {
+            check(not m_input_shape.is_empty() and not m_output_shape.is_empty(), "Empty shapes detected");
+            check(m_input_shape[1] == 1 and m_output_shape[1] == 1,
+                  "The input and output should be 2d, but got input_shape={}, output_shape={}",
+                  m_input_shape, m_output_shape);
+            check(all(m_input_shape.filter(2, 3) <= std::numeric_limits<i32>::max()),
+                  "The input shape is too large, got input_shape={}", m_input_shape);
+        }
+
+        template<Interp INTERP>
+        static constexpr auto window_size_() -> i64 {
+            return INTERP.is_almost_any(Interp::NEAREST) ? 1 : INTERP.window_size();
+        }
+
+        template<typename Launch>
+        static void launch_interp_(Interp interp, Launch&& launch) {
+            switch (interp) {
+                case Interp::NEAREST:
+                case Interp::NEAREST_FAST:
+                    return launch.template operator()<Interp::NEAREST>();
+                case Interp::LINEAR:
+                case Interp::LINEAR_FAST:
+                    return launch.template operator()<Interp::LINEAR>();
+                case Interp::CUBIC:
+                case Interp::CUBIC_FAST:
+                    return launch.template operator()<Interp::CUBIC>();
+                case Interp::CUBIC_BSPLINE:
+                case Interp::CUBIC_BSPLINE_FAST:
+                    return launch.template operator()<Interp::CUBIC_BSPLINE>();
+                case Interp::LANCZOS4:
+                case Interp::LANCZOS4_FAST:
+                    return launch.template operator()<Interp::LANCZOS4>();
+                case Interp::LANCZOS6:
+                case Interp::LANCZOS6_FAST:
+                    return launch.template operator()<Interp::LANCZOS6>();
+                case Interp::LANCZOS8:
+                case Interp::LANCZOS8_FAST:
+                    return launch.template operator()<Interp::LANCZOS8>();
+            }
+        }
+
+        /// Computes the window of every output element, with set_window(batch, y, x, indices, weights) -> conjugate.
+        template<i64 SIZE, typename SetWindow>
+        void set_windows_(const SetWindow& set_window, bool has_conjugates, const ArrayOption& array_option) {
+            m_window_size = SIZE;
+
+            // Create a new sync stream so that the final copy doesn't sync the default cpu stream of the user.
+            const auto guard = StreamGuard(Device{}, Stream::DEFAULT);
+            const i64 n_elements = m_output_shape.n_elements();
+            auto indices = Array<i32>(n_elements * 2 * SIZE);
+            auto weights = Array<T>(n_elements * 2 * SIZE);
+            auto conjugates = has_conjugates ? Array<T>(n_elements) : Array<T>{};
+            i32* indices_ptr = indices.get();
+            T* weights_ptr = weights.get();
+            T* conjugates_ptr = conjugates.get();
+
+            for (i64 b{}; b < m_output_shape[0]; ++b) {
+                for (i64 y{}; y < m_output_shape[2]; ++y) {
+                    for (i64 x{}; x < m_output_shape[3]; ++x) {
+                        const T conjugate = set_window(b, y, x, indices_ptr, weights_ptr);
+                        if (has_conjugates)
+                            *(conjugates_ptr++) = conjugate;
+                        indices_ptr += 2 * SIZE;
+                        weights_ptr += 2 * SIZE;
+                    }
+                }
+            }
+
+            if (array_option.device.is_cpu() and array_option.allocator == Allocator::DEFAULT) {
+                m_indices = std::move(indices);
+                m_weights = std::move(weights);
+                m_conjugates = std::move(conjugates);
+            } else {
+                m_indices = std::move(indices).to(array_option);
+                m_weights = std::move(weights).to(array_option);
+                if (has_conjugates)
+                    m_conjugates = std::move(conjugates).to(array_option);
+            }
+        }
+
+    private:
+        indices_type m_indices;
+        weights_type m_weights;
+        conjugates_type m_conjugates;
+        Shape4<i64> m_input_shape{};
+        Shape4<i64> m_output_shape{};
+        Interp m_interp{};
+        Border m_border{};
+        i64 m_window_size{};
+    };
+
+    /// Creates the resampling plan equivalent to transform_2d().
+    /// \param input_shape          BDHW shape of the input. The batch is ignored.
+    /// \param output_shape         BDHW shape of the output.
+    /// \param[in] inverse_matrices 2x3 or 3x3 inverse HW affine matrices.
+    ///                             One, or if an array is entered, one per output batch.
+    /// \param options              Interpolation and border options.
+    /// \param array_option         Options of the arrays holding the plan.
+    template<nt::transform_parameter_nd<2> Matrix, typename T = nt::mutable_value_type_twice_t<Matrix>>
+    auto transform_2d_plan(
+        const Shape4<i64>& input_shape,
+        const Shape4<i64>& output_shape,
+        const Matrix& inverse_matrices,
+        const ResamplingPlanOptions& options = {},
+        const ArrayOption& array_option = {}
+    ) -> ResamplingPlan<T> {
+        if constexpr (nt::varray<Matrix>) {
+            check(ni::is_contiguous_vector(inverse_matrices) and
+                  inverse_matrices.n_elements() == output_shape[0],
+                  "The number of matrices, specified as a contiguous vector, should be equal to the batch size "
+                  "of the output, but got matrix:shape={}, matrix:strides={} and output:batch={}",
+                  inverse_matrices.shape(), inverse_matrices.strides(), output_shape[0]);
+            const auto matrices = inverse_matrices.to_cpu().eval();
+            const auto span = matrices.span_1d_contiguous();
+            return ResamplingPlan<T>(
+                input_shape, output_shape,
+                [&](i64 batch, i64 y, i64 x) {
+                    return guts::transform_vector(span[batch], Vec2<T>::from_values(y, x));
+                }, options, array_option);
+        } else {
+            return ResamplingPlan<T>(
+                input_shape, output_shape.set<0>(1),
+                [&](i64, i64 y, i64 x) {
+                    return guts::transform_vector(inverse_matrices, Vec2<T>::from_values(y, x));
+                }, options, array_option);
+        }
+    }
+
+    /// Creates the resampling plan equivalent to cartesian2polar().
+    /// \param cartesian_shape  BDHW shape of the cartesian input. The batch is ignored.
+    /// \param polar_shape      BDHW shape of the polar output. The batch is ignored.
+    /// \param cartesian_center HW transformation center.
+    /// \param options          Transformation options. Out-of-bounds elements are set to zero.
+    /// \param array_option     Options of the arrays holding the plan.
+    template<nt::any_of<f32, f64> T = f32>
+    auto cartesian2polar_plan(
+        const Shape4<i64>& cartesian_shape,
+        const Shape4<i64>& polar_shape,
+        const Vec2<f64>& cartesian_center,
+        PolarTransformOptions options = {},
+        const ArrayOption& array_option = {}
+    ) -> ResamplingPlan<T> {
+        guts::set_polar_window_range_to_default(
+            cartesian_shape, cartesian_center,
+            options.rho_range, options.phi_range);
+
+        // Same as the Cartesian2Polar operator.
+        const auto center = cartesian_center.as<T>();
+        const auto rho_range = options.rho_range.as<T>();
+        const auto phi_range = options.phi_range.as<T>();
+        const T step_angle = Linspace{phi_range[0], phi_range[1], options.phi_endpoint}.for_size(polar_shape[2]).step;
+        const T step_radius = Linspace{rho_range[0], rho_range[1], options.rho_endpoint}.for_size(polar_shape[3]).step;
+
+        return ResamplingPlan<T>(
+            cartesian_shape, polar_shape.set<0>(1),
+            [&](i64, i64 y, i64 x) {
+                const auto polar_coordinate = Vec2<T>::from_values(y, x);
+                const T phi = polar_coordinate[0] * step_angle + phi_range[0];
+                const T rho = polar_coordinate[1] * step_radius + rho_range[0];
+                Vec2<T> cartesian_coordinate = sincos(phi);
+                cartesian_coordinate *= rho;
+                cartesian_coordinate += center;
+                return cartesian_coordinate;
+            }, {.interp = options.interp, .border = Border::ZERO}, array_option);
+    }
+
+    /// Creates the resampling plan equivalent to spectrum2polar().
+    /// \tparam REMAP           Every input layout is supported. The output is the full-centered polar grid.
+    /// \param spectrum_shape   BDHW logical shape of the input spectrum. The batch is ignored.
+    /// \param polar_shape      BDHW shape of the polar output. The batch is ignored.
+    /// \param options          Transformation options. Out-of-bounds elements are set to zero.
+    ///                         rffts only support the nearest and linear interpolations.
+    /// \param array_option     Options of the arrays holding the plan.
+    template<Remap REMAP, nt::any_of<f32, f64> T = f32>
+    requires (REMAP.is_xx2fc())
+    auto spectrum2polar_plan(
+        const Shape4<i64>& spectrum_shape,
+        const Shape4<i64>& polar_shape,
+        PolarTransformSpectrumOptions options = {},
+        const ArrayOption& array_option = {}
+    ) -> ResamplingPlan<T> {
+        guts::set_spectrum2polar_defaults(spectrum_shape, options.rho_range, options.phi_range);
+
+        // Same as the Spectrum2Polar operator.
+        const auto scale = Vec2<T>::from_vec(spectrum_shape.filter(2, 3).vec);
+        const auto rho_range = options.rho_range.as<T>();
+        const auto phi_range = options.phi_range.as<T>();
+        const T step_angle = Linspace{phi_range[0], phi_range[1], options.phi_endpoint}.for_size(polar_shape[2]).step;
+        const T step_fftfreq = Linspace{rho_range[0], rho_range[1], options.rho_endpoint}.for_size(polar_shape[3]).step;
+
+        return ResamplingPlan<T>(
+            REMAP, spectrum_shape, polar_shape.set<0>(1),
+            [&](i64, i64 y, i64 x) {
+                const auto polar_coordinate = Vec2<T>::from_values(y, x);
+                const T phi = polar_coordinate[0] * step_angle + phi_range[0];
+                const T rho = polar_coordinate[1] * step_fftfreq + rho_range[0];
+                return (rho * sincos(phi)) * scale;
+            }, options.interp, array_option);
+    }
+
+    /// Applies a resampling plan to 2d array(s).
+    /// \param[in] input    Input 2d array(s), with the (D)HW shape of the plan input.
+    /// \param[out] output  Output 2d array(s), with the (D)HW shape of the plan output.
+    ///                     If the plan has multiple geometries, there should be one output batch per geometry.
+    ///                     If the input is batched, there should be one input batch per output batch.
+    ///                     Otherwise, the input is broadcast to every output batch.
+    ///                     If real and the input is complex, the power spectrum is computed.
+    /// \param[in] plan     Resampling plan.
+    /// \param cvalue       Constant value to use for out-of-bounds coordinates.
+    ///                     Only used if the border of the plan is Border::VALUE.
+    template<nt::readable_varray_decay_of_real_or_complex Input,
+             nt::writable_varray_decay Output,
+             typename T>
+    requires nt::spectrum_types<nt::mutable_value_type_t<Input>, nt::value_type_t<Output>>
+    void resample(
+        Input&& input,
+        Output&& output,
+        const ResamplingPlan<T>& plan,
+        nt::mutable_value_type_t<Input> cvalue = {}
+    ) {
+        check(not input.is_empty() and not output.is_empty() and not plan.is_empty(), "Empty array detected");
+        check(all(input.shape().pop_front() == plan.input_shape().pop_front()) and
+              all(output.shape().pop_front() == plan.output_shape().pop_front()),
+              "The input and output shapes are not compatible with the plan, "
+              "got input:shape={}, output:shape={}, plan:input_shape={}, plan:output_shape={}",
+              input.shape(), output.shape(), plan.input_shape(), plan.output_shape());
+        check(input.shape()[0] == 1 or input.shape()[0] == output.shape()[0],
+              "The batch size in the input ({}) is not compatible with the batch size in the output ({})",
+              input.shape()[0], output.shape()[0]);
+        check(plan.output_shape()[0] == 1 or plan.output_shape()[0] == output.shape()[0],
+              "The number of geometries in the plan ({}) is not compatible with the batch size in the output ({})",
+              plan.output_shape()[0], output.shape()[0]);
+
+        const Device device = output.device();
+        check(input.device() == device and plan.device() == device,
+              "The input, output and plan must be on the same device, "
+              "but got input:device={}, output:device={}, plan:device={}",
+              input.device(), device, plan.device());
+        check(not ni::are_overlapped(input, output), "The input and output arrays should not overlap");
+
+        auto launch = [&]<typename Index, i64 SIZE, bool HAS_CVALUE, bool HAS_CONJUGATES, IwiseOptions OPTIONS>() {
+            using input_accessor_t = AccessorRestrict<nt::const_value_type_t<Input>, 3, Index>;
+            using output_accessor_t = AccessorRestrict<nt::value_type_t<Output>, 3, Index>;
+            using indices_accessor_t = AccessorRestrictContiguous<const i32, 1, Index>;
+            using weights_accessor_t = AccessorRestrictContiguous<const T, 1, Index>;
+            using op_t = guts::Resample<
+                SIZE, HAS_CVALUE, HAS_CONJUGATES, Index,
+                input_accessor_t, output_accessor_t, indices_accessor_t, weights_accessor_t>;
+
+            auto input_strides = input.strides().filter(0, 2, 3).template as<Index>();
+            if (input.shape()[0] == 1)
+                input_strides[0] = 0;
+            const auto plan_shape = plan.output_shape();
+            const auto plan_batch_stride = plan_shape[0] == 1 ? 0 : plan_shape[2] * plan_shape[3];
+
+            typename op_t::cvalue_type op_cvalue{};
+            if constexpr (HAS_CVALUE)
+                op_cvalue = cvalue;
+            typename op_t::conjugates_type op_conjugates{};
+            if constexpr (HAS_CONJUGATES)
+                op_conjugates = weights_accessor_t(plan.conjugates().get());
+
+            auto op = op_t(
+                input_accessor_t(input.get(), input_strides),
+                output_accessor_t(output.get(), output.strides().filter(0, 2, 3).template as<Index>()),
+                indices_accessor_t(plan.indices().get()),
+                weights_accessor_t(plan.weights().get()),
+                static_cast<Index>(plan_shape[3]),
+                static_cast<Index>(plan_batch_stride),
+                op_cvalue, op_conjugates);
+            iwise<OPTIONS>(
+                output.shape().filter(0, 2, 3).template as<Index>(), device, std::move(op),
+                std::forward<Input>(input), std::forward<Output>(output),
+                plan.indices(), plan.weights(), plan.conjugates());
+        };
+
+        auto launch_size = [&]<typename Index, IwiseOptions OPTIONS>() {
+            auto launch_cvalue = [&]<i64 SIZE>() {
+                if (plan.border() == Border::VALUE)
+                    return launch.template operator()<Index, SIZE, true, false, OPTIONS>();
+                if constexpr (nt::complex<nt::mutable_value_type_t<Input>>) {
+                    if (not plan.conjugates().is_empty())
+                        return launch.template operator()<Index, SIZE, false, true, OPTIONS>();
+                }
+                return launch.template operator()<Index, SIZE, false, false, OPTIONS>();
+            };
+            switch (plan.window_size()) {
+                case 1: return launch_cvalue.template operator()<1>();
+                case 2: return launch_cvalue.template operator()<2>();
+                case 4: return launch_cvalue.template operator()<4>();
+                case 6: return launch_cvalue.template operator()<6>();
+                case 8: return launch_cvalue.template operator()<8>();
+                default: panic("Invalid window size: {}", plan.window_size());
+            }
+        };
+
+        if (device.is_gpu() and
+            ng::is_accessor_access_safe<i32>(input.strides(), input.shape()) and
+            ng::is_accessor_access_safe<i32>(output.strides(), output.shape()) and
+            plan.indices().ssize() <= std::numeric_limits<i32>::max()) {
+            #ifdef NOA_ENABLE_CUDA
+            return launch_size.template operator()<i32, IwiseOptions{.generate_cpu = false}>();
+            #else
+            std::terminate(); // unreachable
+            #endif
+        }
+        launch_size.template operator()<i64, IwiseOptions{}>();
+    }
+}
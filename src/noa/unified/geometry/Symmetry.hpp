@@ -13,8 +13,13 @@ namespace noa::geometry {
     /// \note By convention, the identity matrix is not stored as
     ///       it is implicitly applied by the "symmetrize" functions.
     /// \note Supported symmetries:
-    ///     - CX, with X being a non-zero positive number.
-    /// TODO Add quaternions and more symmetries...
+    ///     - CX, with X being a non-zero positive number. The X-fold axis is along Z.
+    ///     - DX (3d only), with X being a non-zero positive number. CX, with 2-fold axes perpendicular to Z,
+    ///       the first one being along X.
+    ///     - T (3d only): 2-fold axes along X, Y and Z, and 3-fold axes along the diagonals.
+    ///     - O (3d only): 4-fold axes along X, Y and Z.
+    ///     - I (3d only): 2-fold axes along X, Y and Z, and 5-fold axes in the YZ plane.
+    /// TODO Add quaternions...
     template<typename Real, size_t N>
     class Symmetry {
     public:
@@ -58,7 +63,7 @@ namespace noa::geometry {
         [[nodiscard]] auto is_empty() const { return m_buffer.is_empty(); }
 
         [[nodiscard]] auto span() const -> Span<const matrix_type> {
-            return m_buffer.template span<const matrix_type>();
+            return Span<const matrix_type>(m_buffer.get(), m_buffer.ssize());
         }
 
         [[nodiscard]] auto share() const& -> const shared_type& { return m_buffer.share(); }
@@ -80,17 +85,18 @@ namespace noa::geometry {
 
     private:
         void validate_and_set_buffer_(const ArrayOption& options) {
-            check(m_code.type == 'C' and m_code.order > 0, "{} symmetry is not supported", m_code.to_string());
+            const i64 count = guts::symmetry_count<N>(m_code);
+            check(count > 0, "{} symmetry is not supported", m_code.to_string());
 
-            i64 n_matrices = m_code.order - 1; // -1 to remove the identity from the matrices
+            i64 n_matrices = count - 1; // -1 to remove the identity from the matrices
             if (options.device.is_cpu()) {
                 m_buffer = array_type(n_matrices, options);
-                guts::set_cx_symmetry_matrices(m_buffer.span_1d_contiguous());
+                guts::set_symmetry_matrices(m_code, m_buffer.span_1d_contiguous());
             } else {
                 // Create a new sync stream so that the final copy doesn't sync the default cpu stream of the user.
                 const auto guard = StreamGuard(Device{}, Stream::DEFAULT);
                 array_type cpu_matrices(n_matrices);
-                guts::set_cx_symmetry_matrices(cpu_matrices.span_1d_contiguous());
+                guts::set_symmetry_matrices(m_code, cpu_matrices.span_1d_contiguous());
 
                 // Copy to gpu.
                 m_buffer = array_type(n_matrices, options);
@@ -203,6 +209,138 @@ namespace noa::geometry::guts {
         NOA_NO_UNIQUE_ADDRESS batched_post_inverse_affine_type m_post_inverse_affine_matrices;
     };
 
+    /// 3d or 4d iwise operator used to symmetrize 2d or 3d array(s), using the grid-aligned subgroup H of the
+    /// symmetry, i.e. the rotations mapping the sampling grid onto itself (see split_grid_aligned_symmetry).
+    ///  * The partial sums over the coset representatives of H, with the optional pre-transformation, are
+    ///    precomputed (see Symmetrize), and the rotations of H are applied to these sums with exact index maps.
+    ///  * The output is invariant under H, so each orbit of H is computed once, by its first element within
+    ///    the output (the asymmetric unit), which then writes the result to the entire orbit.
+    template<size_t N,
+             nt::integer Index,
+             nt::span_contiguous_nd<1> SymmetryMatrices,
+             nt::interpolator_nd<N> Input,
+             nt::readable_nd<N + 1> Partial,
+             nt::writable_nd<N + 1> Output,
+             nt::batched_parameter PreInvAffine>
+    requires (N == 2 or N == 3)
+    class SymmetrizeAsymmetricUnit {
+    public:
+        using index_type = Index;
+        using symmetry_matrices_type = SymmetryMatrices;
+        using input_type = Input;
+        using partial_type = Partial;
+        using output_type = Output;
+        using batched_pre_inverse_affine_type = PreInvAffine;
+
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using input_real_type = nt::value_type_t<input_value_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        static_assert(nt::same_as<input_value_type, nt::mutable_value_type_t<partial_type>>);
+
+        using symmetry_matrix_type = nt::value_type_t<symmetry_matrices_type>;
+        static_assert(nt::mat_of_shape<symmetry_matrix_type, N, N>);
+        using coord_type = nt::value_type_t<symmetry_matrix_type>;
+        using vec_type = Vec<coord_type, N>;
+        using indices_type = Vec<index_type, N>;
+        using shape_type = Shape<index_type, N>;
+
+    public:
+        constexpr SymmetrizeAsymmetricUnit(
+            const input_type& input,
+            const partial_type& partial,
+            const output_type& output,
+            const shape_type& shape,
+            symmetry_matrices_type grid_aligned_matrices,
+            symmetry_matrices_type coset_matrices,
+            const vec_type& symmetry_center,
+            input_real_type symmetry_scaling,
+            const batched_pre_inverse_affine_type& pre_inverse_affine_matrices
+        ) noexcept :
+            m_input(input), m_partial(partial), m_output(output), m_shape(shape),
+            m_grid_aligned_matrices(grid_aligned_matrices),
+            m_coset_matrices(coset_matrices),
+            m_symmetry_center(symmetry_center),
+            m_symmetry_scaling(symmetry_scaling),
+            m_pre_inverse_affine_matrices(pre_inverse_affine_matrices) {}
+
+        template<nt::same_as<index_type>... I> requires (sizeof...(I) == N)
+        NOA_HD constexpr void operator()(index_type batch, I... indices) const {
+            const auto element = indices_type::from_values(indices...);
+
+            // Only the first element of the orbit is computed.
+            for (const auto& matrix: m_grid_aligned_matrices) {
+                const auto other = orbit_(matrix, element);
+                if (is_inbound_(other) and is_before_(other, element))
+                    return;
+            }
+
+            auto value = partial_(batch, element);
+            for (const auto& matrix: m_grid_aligned_matrices)
+                value += partial_(batch, orbit_(matrix, element));
+            value *= m_symmetry_scaling;
+
+            const auto output_value = static_cast<output_value_type>(value);
+            m_output(element.push_front(batch)) = output_value;
+            for (const auto& matrix: m_grid_aligned_matrices) {
+                const auto other = orbit_(matrix, element);
+                if (is_inbound_(other))
+                    m_output(other.push_front(batch)) = output_value;
+            }
+        }
+
+    private:
+        NOA_HD constexpr auto orbit_(const symmetry_matrix_type& matrix, const indices_type& element) const {
+            const auto coordinates = element.template as<coord_type>() - m_symmetry_center;
+            return (round(matrix * coordinates) + m_symmetry_center).template as<index_type>();
+        }
+
+        NOA_HD constexpr bool is_inbound_(const indices_type& element) const {
+            for (size_t i{}; i < N; ++i)
+                if (element[i] < 0 or element[i] >= m_shape[i])
+                    return false;
+            return true;
+        }
+
+        NOA_HD static constexpr bool is_before_(const indices_type& lhs, const indices_type& rhs) {
+            for (size_t i{}; i < N; ++i)
+                if (lhs[i] != rhs[i])
+                    return lhs[i] < rhs[i];
+            return false;
+        }
+
+        NOA_HD constexpr auto partial_(index_type batch, const indices_type& element) const -> input_value_type {
+            if (is_inbound_(element))
+                return m_partial(element.push_front(batch));
+
+            // The orbit can go outside the partial sums, so compute them from the input.
+            const auto coordinates = element.template as<coord_type>();
+            auto i_coord = coordinates;
+            if constexpr (not nt::empty<nt::value_type_t<batched_pre_inverse_affine_type>>)
+                i_coord = transform_vector(m_pre_inverse_affine_matrices[batch], i_coord);
+            auto value = m_input.interpolate_at(i_coord, batch);
+
+            const auto centered = coordinates - m_symmetry_center;
+            for (const auto& matrix: m_coset_matrices) {
+                i_coord = matrix * centered + m_symmetry_center;
+                if constexpr (not nt::empty<nt::value_type_t<batched_pre_inverse_affine_type>>)
+                    i_coord = transform_vector(m_pre_inverse_affine_matrices[batch], i_coord);
+                value += m_input.interpolate_at(i_coord, batch);
+            }
+            return value;
+        }
+
+    private:
+        input_type m_input;
+        partial_type m_partial;
+        output_type m_output;
+        shape_type m_shape;
+        symmetry_matrices_type m_grid_aligned_matrices;
+        symmetry_matrices_type m_coset_matrices;
+        vec_type m_symmetry_center;
+        input_real_type m_symmetry_scaling;
+        NOA_NO_UNIQUE_ADDRESS batched_pre_inverse_affine_type m_pre_inverse_affine_matrices;
+    };
+
     template<typename T, size_t N>
     concept symmetry_nd = nt::any_of<std::decay_t<T>, Symmetry<f32, N>, Symmetry<f64, N>>;
 
@@ -279,8 +417,98 @@ namespace noa::geometry::guts {
             if (center == std::numeric_limits<f64>::max())
                 center = static_cast<f64>(input_shape_nd[i++] / 2);
 
+        if constexpr (nt::texture_decay<Input>)
+            options.interp = input.interp();
+
+        // Split the symmetry into its grid-aligned subgroup and the coset representatives of that subgroup.
+        using matrix_t = nt::value_type_t<decltype(symmetry_matrices)>;
+        Array<matrix_t> grid_aligned_buffer;
+        Array<matrix_t> coset_buffer;
+        decltype(symmetry_matrices) grid_aligned_matrices{};
+        decltype(symmetry_matrices) coset_matrices{};
+        if (options.asymmetric_unit) {
+            check(nt::empty<std::decay_t<PostMatrix>>,
+                  "The asymmetric unit cannot be used with post-transformations");
+            check(not options.interp.is_almost_any(Interp::CUBIC_BSPLINE),
+                  "The asymmetric unit cannot be used with {}", options.interp);
+            for (auto center: options.symmetry_center)
+                check(center == std::round(center),
+                      "The asymmetric unit requires an integral symmetry center, but got {}",
+                      options.symmetry_center);
+
+            const std::decay_t<Symmetry> cpu_symmetry = symmetry.device().is_cpu() ? symmetry : symmetry.to({});
+            cpu_symmetry.array().eval();
+            const auto [grid_aligned, cosets] = split_grid_aligned_symmetry(cpu_symmetry.span());
+            const auto to_device = [&](const auto& matrices, Array<matrix_t>& buffer, auto& span) {
+                if (matrices.empty())
+                    return;
+                buffer = Array<matrix_t>(std::ssize(matrices));
+                for (i64 i{}; auto& matrix: buffer.span_1d_contiguous())
+                    matrix = matrices[static_cast<size_t>(i++)];
+                if (output.device().is_gpu())
+                    buffer = std::move(buffer).to({.device = output.device(), .allocator = Allocator::DEFAULT});
+                span = buffer.span_1d_contiguous();
+            };
+            to_device(grid_aligned, grid_aligned_buffer, grid_aligned_matrices);
+            to_device(cosets, coset_buffer, coset_matrices);
+        }
+
+        auto launch_asymmetric_unit = [&](const auto& interpolator) {
+            using input_value_t = nt::mutable_value_type_t<Input>;
+            using partial_accessor_t = AccessorRestrict<const input_value_t, N + 1, Index>;
+
+            // Partial sums over the cosets. If there is only the identity, this is the input.
+            Array<input_value_t> partial;
+            partial_accessor_t partial_accessor;
+            if constexpr (nt::varray_decay<Input> and nt::empty<std::decay_t<PreMatrix>>) {
+                if (coset_matrices.is_empty()) {
+                    partial_accessor = partial_accessor_t(
+                        input.get(), input.strides().template filter_nd<N>().template as<Index>());
+                }
+            }
+            if (partial_accessor.is_empty()) {
+                partial = Array<input_value_t>(output.shape(), output.options());
+                partial_accessor = partial_accessor_t(
+                    partial.get(), partial.strides().template filter_nd<N>().template as<Index>());
+                using partial_output_accessor_t = AccessorRestrict<input_value_t, N + 1, Index>;
+                auto batched_empty = ng::to_batched_transform<true>(Empty{});
+                using op_t = guts::Symmetrize<
+                    N, Index, decltype(coset_matrices), std::decay_t<decltype(interpolator)>, partial_output_accessor_t,
+                    decltype(batched_pre_inverse_matrices), decltype(batched_empty)>;
+                iwise<IwiseOptions{
+                    .generate_cpu = not IS_GPU,
+                    .generate_gpu = IS_GPU,
+                }>(output.shape().template filter_nd<N>().template as<Index>(), output.device(),
+                   op_t(interpolator, partial_output_accessor_t(partial.get(), partial_accessor.strides()),
+                        coset_matrices, options.symmetry_center.template as<coord_t>(), real_t{1},
+                        batched_pre_inverse_matrices, batched_empty),
+                   input, partial, coset_buffer, pre_inverse_matrices);
+            }
+
+            using op_t = guts::SymmetrizeAsymmetricUnit<
+                N, Index, decltype(symmetry_matrices), std::decay_t<decltype(interpolator)>,
+                partial_accessor_t, output_accessor_t, decltype(batched_pre_inverse_matrices)>;
+            iwise<IwiseOptions{
+                .generate_cpu = not IS_GPU,
+                .generate_gpu = IS_GPU,
+            }>(output.shape().template filter_nd<N>().template as<Index>(), output.device(),
+               op_t(interpolator, partial_accessor, output_accessor,
+                    output.shape().template filter_nd<N>().pop_front().template as<Index>(),
+                    grid_aligned_matrices, coset_matrices,
+                    options.symmetry_center.template as<coord_t>(), symmetry_scaling,
+                    batched_pre_inverse_matrices),
+               std::forward<Input>(input),
+               std::forward<Output>(output),
+               std::forward<Symmetry>(symmetry),
+               std::forward<PreMatrix>(pre_inverse_matrices),
+               std::move(partial), std::move(grid_aligned_buffer), std::move(coset_buffer));
+        };
+
         auto launch_iwise = [&](auto interp) {
             auto interpolator = ng::to_interpolator<N, interp(), Border::ZERO, Index, coord_t, IS_GPU>(input);
+            if (options.asymmetric_unit)
+                return launch_asymmetric_unit(interpolator);
+
             using op_t = guts::Symmetrize<
                 N, Index, decltype(symmetry_matrices), decltype(interpolator), output_accessor_t,
                 decltype(batched_pre_inverse_matrices), decltype(batched_post_inverse_matrices)>;
@@ -299,8 +527,6 @@ namespace noa::geometry::guts {
                std::forward<PostMatrix>(post_inverse_matrices));
         };
 
-        if constexpr (nt::texture_decay<Input>)
-            options.interp = input.interp();
         switch (options.interp) {
             case Interp::NEAREST:            return launch_iwise(ng::WrapInterp<Interp::NEAREST>{});
             case Interp::NEAREST_FAST:       return launch_iwise(ng::WrapInterp<Interp::NEAREST_FAST>{});
@@ -334,6 +560,17 @@ namespace noa::geometry {
         /// Whether the symmetrized output should be normalized to have the same value range as the input.
         /// If false, output values end up being scaled by the symmetry count.
         bool normalize{true};
+
+        /// Whether to only compute the asymmetric unit of the output and replicate it.
+        /// The rotations of the symmetry that map the sampling grid onto itself (the grid-aligned subgroup,
+        /// e.g. rotations of 90 or 180 degrees around the axes, or 120 degrees around the diagonals) are applied
+        /// with exact index maps, so only the coset representatives of that subgroup are interpolated.
+        /// E.g. O is never interpolated, I needs 5 interpolations per element instead of 60 and D7 needs 7 instead
+        /// of 14. This requires an integral symmetry center, no post-transformation, and is not compatible with
+        /// the cubic B-spline interpolation. The output is the same as with the default evaluation, up to rounding
+        /// errors (with nearest interpolation, coordinates falling exactly between two samples may be rounded
+        /// differently).
+        bool asymmetric_unit{false};
     };
 
     /// Symmetrizes 2d array(s).
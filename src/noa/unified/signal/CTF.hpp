@@ -6,6 +6,7 @@
 #include "noa/core/signal/CTF.hpp"
 #include "noa/core/fft/Frequency.hpp"
 #include "noa/unified/Array.hpp"
+#include "noa/unified/Factory.hpp"
 #include "noa/unified/Iwise.hpp"
 
 namespace noa::signal::guts {
@@ -56,13 +57,15 @@ namespace noa::signal::guts {
             const ctf_parameter_type& ctf,
             bool ctf_abs,
             bool ctf_squared,
-            const Linspace<coord_type>& fftfreq_range
+            const Linspace<coord_type>& fftfreq_range,
+            coord_type input_scale = 1
         ) :
             m_ctf(ctf),
             m_output(output),
             m_shape(shape.template pop_back<IS_RFFT>()),
             m_input(input),
             m_fftfreq_start(fftfreq_range.start),
+            m_input_scale(input_scale),
             m_ctf_abs(ctf_abs),
             m_ctf_squared(ctf_squared)
         {
@@ -109,7 +112,7 @@ namespace noa::signal::guts {
             if constexpr (HAS_INPUT) {
                 const auto input_indices = noa::fft::remap_indices<REMAP, true>(Vec{output_indices...}, m_shape);
                 m_output(batch, output_indices...) = cast_or_abs_squared<output_value_type>(
-                    m_input(input_indices.push_front(batch)) * static_cast<input_real_type>(ctf));
+                    m_input(input_indices.push_front(batch)) * static_cast<input_real_type>(ctf * m_input_scale));
             } else {
                 m_output(batch, output_indices...) = static_cast<output_value_type>(ctf);
             }
@@ -122,11 +125,198 @@ namespace noa::signal::guts {
         NOA_NO_UNIQUE_ADDRESS input_type m_input{};
         coord_nd_type m_fftfreq_step;
         coord_type m_fftfreq_start;
+        coord_type m_input_scale;
         bool m_ctf_abs;
         bool m_ctf_squared;
     };
 }
 
+namespace noa::signal::guts {
+    /// Per-batch coefficients of the CTF phase, as a polynomial of the per-pixel terms of the CTFBatched tables:
+    /// phase = s^2 * (defocus + astigmatism_cos * cos(2phi) + astigmatism_sin * sin(2phi)) + cs * s^4 - offset,
+    /// with s the spatial frequency in 1/A.
+    template<nt::any_of<f32, f64> T>
+    struct CTFPolynomial {
+        T defocus;
+        T astigmatism_cos;
+        T astigmatism_sin;
+        T cs;
+        T offset;
+        T bfactor_forth;
+        T scale;
+    };
+
+    template<typename Coord, typename CTF>
+    constexpr auto ctf_polynomial(const CTF& ctf) -> CTFPolynomial<Coord> {
+        // This is the phase of CTF::value_at() expanded, in double precision.
+        const auto wavelength = static_cast<f64>(ctf.wavelength());
+        const auto amplitude = static_cast<f64>(ctf.amplitude());
+        const auto k1 = Constant<f64>::PI * wavelength;
+        const auto k2 = Constant<f64>::PI * 0.5 * static_cast<f64>(ctf.cs()) * 1e7 * wavelength * wavelength * wavelength;
+        const auto k3 = atan(amplitude / sqrt(1 - amplitude * amplitude));
+
+        f64 defocus, astigmatism{}, angle{};
+        if constexpr (nt::ctf_isotropic<CTF>) {
+            defocus = -static_cast<f64>(ctf.defocus()) * 1e4;
+        } else {
+            defocus = -static_cast<f64>(ctf.defocus().value) * 1e4;
+            astigmatism = -static_cast<f64>(ctf.defocus().astigmatism) * 1e4;
+            angle = static_cast<f64>(ctf.defocus().angle);
+        }
+        return {
+            .defocus = static_cast<Coord>(k1 * defocus),
+            .astigmatism_cos = static_cast<Coord>(k1 * astigmatism * cos(2 * angle)),
+            .astigmatism_sin = static_cast<Coord>(k1 * astigmatism * sin(2 * angle)),
+            .cs = static_cast<Coord>(k2),
+            .offset = static_cast<Coord>(static_cast<f64>(ctf.phase_shift()) + k3),
+            .bfactor_forth = static_cast<Coord>(ctf.bfactor() / 4),
+            .scale = static_cast<Coord>(ctf.scale()),
+        };
+    }
+
+    /// Index-wise operator, to compute the per-pixel terms of the CTF of a 2d rfft: s^2, cos(2phi), sin(2phi)
+    /// and the B-factor envelope, with s the spatial frequency in 1/A and phi its angle.
+    template<bool IS_CENTERED, nt::any_of<f32, f64> Coord, nt::sinteger Index>
+    class CTFTables {
+    public:
+        using index_type = Index;
+        using coord_type = Coord;
+        using coord2_type = Vec2<coord_type>;
+        using table_type = Vec4<coord_type>;
+        using output_type = AccessorContiguous<table_type, 2, index_type>;
+
+    public:
+        constexpr CTFTables(
+            const output_type& output,
+            const Shape2<index_type>& shape,
+            const coord2_type& pixel_size,
+            coord_type bfactor_forth
+        ) :
+            m_output(output),
+            m_norm(1 / (coord2_type::from_vec(shape.vec) * pixel_size)),
+            m_height(shape.pop_back()),
+            m_bfactor_forth(bfactor_forth) {}
+
+        NOA_HD void operator()(index_type y, index_type x) const {
+            const auto frequency = noa::fft::index2frequency<IS_CENTERED, true>(Vec{y, x}, m_height);
+            const auto s = coord2_type::from_vec(frequency) * m_norm;
+            const auto s2 = dot(s, s);
+            const auto phi = noa::geometry::cartesian2phi<false>(s);
+            m_output(y, x) = {
+                s2, cos(2 * phi), sin(2 * phi),
+                m_bfactor_forth != 0 ? exp(m_bfactor_forth * s2) : coord_type{1},
+            };
+        }
+
+    private:
+        output_type m_output;
+        coord2_type m_norm;
+        Shape1<index_type> m_height;
+        coord_type m_bfactor_forth;
+    };
+
+    /// Index-wise operator, to apply per-batch CTFs to 2d rffts.
+    /// \details The CTFs are evaluated from the per-pixel CTFTables and the per-batch CTFPolynomial, which leaves
+    ///          a polynomial and a sine per element (and the exponential of the B-factor if it varies between batches).
+    ///          Each call computes one pixel of every batch in [batch_start, batch_end), so that the sum of the
+    ///          squared CTFs can be accumulated without atomics.
+    template<Remap REMAP,
+             nt::any_of<f32, f64> Coord,
+             nt::sinteger Index,
+             nt::readable_nd_optional<3> Input,
+             nt::writable_nd_optional<3> Output,
+             nt::writable_nd_optional<2> Weights>
+    class CTFBatched {
+    public:
+        static_assert(REMAP.is_any(Remap::H2H, Remap::HC2HC, Remap::HC2H, Remap::H2HC));
+
+        using index_type = Index;
+        using coord_type = Coord;
+        using input_type = Input;
+        using output_type = Output;
+        using weights_type = Weights;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        using weights_value_type = nt::value_type_t<weights_type>;
+        using table_type = AccessorRestrictContiguous<const Vec4<coord_type>, 2, index_type>;
+        using polynomial_type = AccessorRestrictContiguous<const CTFPolynomial<coord_type>, 1, index_type>;
+
+    public:
+        constexpr CTFBatched(
+            const input_type& input,
+            const output_type& output,
+            const weights_type& weights,
+            const table_type& table,
+            const polynomial_type& polynomials,
+            index_type height,
+            index_type batch_start,
+            index_type batch_end,
+            bool is_envelope_shared,
+            bool ctf_abs,
+            coord_type input_scale
+        ) :
+            m_input(input),
+            m_output(output),
+            m_weights(weights),
+            m_table(table),
+            m_polynomials(polynomials),
+            m_height(Shape1<index_type>{height}),
+            m_batch_start(batch_start),
+            m_batch_end(batch_end),
+            m_input_scale(input_scale),
+            m_is_envelope_shared(is_envelope_shared),
+            m_ctf_abs(ctf_abs) {}
+
+        NOA_HD void operator()(index_type y, index_type x) const {
+            const auto terms = m_table(y, x);
+            const auto s2 = terms[0];
+            const auto s4 = s2 * s2;
+            const auto input_indices = noa::fft::remap_indices<REMAP, true>(Vec{y, x}, m_height);
+
+            coord_type ctf_squared_sum{};
+            for (index_type batch = m_batch_start; batch < m_batch_end; ++batch) {
+                const auto& polynomial = m_polynomials[batch];
+                const auto defocus =
+                    polynomial.defocus +
+                    polynomial.astigmatism_cos * terms[1] +
+                    polynomial.astigmatism_sin * terms[2];
+                const auto phase = s2 * defocus + polynomial.cs * s4 - polynomial.offset;
+                auto ctf = -sin(phase) * polynomial.scale;
+                ctf *= m_is_envelope_shared ? terms[3] : exp(polynomial.bfactor_forth * s2);
+                if (m_ctf_abs)
+                    ctf = abs(ctf);
+
+                if (m_output) {
+                    auto& output = m_output(batch, y, x);
+                    if (m_input) {
+                        using real_t = nt::value_type_t<input_value_type>;
+                        const auto value = m_input(input_indices.push_front(batch));
+                        output = static_cast<output_value_type>(value * static_cast<real_t>(ctf * m_input_scale));
+                    } else {
+                        output = static_cast<output_value_type>(ctf);
+                    }
+                }
+                ctf_squared_sum += ctf * ctf;
+            }
+            if (m_weights)
+                m_weights(y, x) += static_cast<weights_value_type>(ctf_squared_sum);
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        weights_type m_weights;
+        table_type m_table;
+        polynomial_type m_polynomials;
+        Shape1<index_type> m_height;
+        index_type m_batch_start;
+        index_type m_batch_end;
+        coord_type m_input_scale;
+        bool m_is_envelope_shared;
+        bool m_ctf_abs;
+    };
+}
+
 namespace noa::signal::guts {
     template<typename T, typename U = nt::value_type_t<T>, typename V = std::decay_t<T>>
     concept varray_decay_or_ctf_isotropic = (nt::ctf_isotropic<V> or (nt::varray<V> and nt::ctf_isotropic<U>));
@@ -204,6 +394,10 @@ namespace noa::signal {
 
         /// Whether the square of the ctf should be computed.
         bool ctf_squared{};
+
+        /// Factor multiplying the input, e.g. the normalization factor of the transform that computed the input
+        /// spectrum (see noa::fft::normalization_factor). Ignored if the input is empty.
+        f64 input_scale{1};
     };
 
     /// Computes isotropic CTF(s) over entire FFT or rFFT spectrum or over a specific frequency range (see options).
@@ -343,7 +537,8 @@ namespace noa::signal {
                     output_accessor_t(output.get(), output.strides().filter(0, index)),
                     shape.filter(index), guts::extract_ctf(ctf),
                     options.ctf_abs, options.ctf_squared,
-                    options.fftfreq_range.as<coord_t>()
+                    options.fftfreq_range.as<coord_t>(),
+                    static_cast<coord_t>(options.input_scale)
                 );
                 return iwise(
                     iwise_shape, device, op,
@@ -368,7 +563,8 @@ namespace noa::signal {
                     output_accessor_t(output.get(), output_strides.filter(0, 2, 3)),
                     shape.filter(2, 3), guts::extract_ctf(ctf),
                     options.ctf_abs, options.ctf_squared,
-                    options.fftfreq_range.as<coord_t>()
+                    options.fftfreq_range.as<coord_t>(),
+                    static_cast<coord_t>(options.input_scale)
                 );
                 auto iwise_shape = shape.filter(0, 2, 3);
                 if constexpr (REMAP.is_xx2hx())
@@ -398,7 +594,8 @@ namespace noa::signal {
                     output_accessor_t(output.get(), output_strides),
                     shape.pop_front(), guts::extract_ctf(ctf),
                     options.ctf_abs, options.ctf_squared,
-                    options.fftfreq_range.as<coord_t>()
+                    options.fftfreq_range.as<coord_t>(),
+                    static_cast<coord_t>(options.input_scale)
                 );
                 auto iwise_shape = shape;
                 if constexpr (REMAP.is_xx2hx())
@@ -504,7 +701,8 @@ namespace noa::signal {
             output_accessor_t(output.get(), output_strides.filter(0, 2, 3)),
             shape.filter(2, 3), guts::extract_ctf(ctf),
             options.ctf_abs, options.ctf_squared,
-            options.fftfreq_range.as<coord_t>()
+            options.fftfreq_range.as<coord_t>(),
+            static_cast<coord_t>(options.input_scale)
         );
 
         auto iwise_shape = shape.filter(0, 2, 3);
@@ -515,4 +713,156 @@ namespace noa::signal {
               std::forward<Output>(output),
               std::forward<CTF>(ctf));
     }
+
+    struct CTFBatchedOptions {
+        /// Whether the absolute of the ctf should be used, e.g. for phase-flipping.
+        bool ctf_abs{};
+
+        /// Factor multiplying the input, e.g. the normalization factor of the transform that computed the input
+        /// spectrum (see noa::fft::normalization_factor). Ignored if the input is empty.
+        f64 input_scale{1};
+    };
+
+    /// Applies per-batch CTFs to a stack of 2d rffts, e.g. per-particle CTFs.
+    /// \details The per-pixel terms (s^2, cos(2phi), sin(2phi) and the B-factor envelope) are computed once for the
+    ///          entire stack, and each CTF is then a polynomial of these terms. The multiplication with the input
+    ///          and the sum of the squared CTFs (e.g. for Wiener filtering) are done in the same pass.
+    /// \tparam REMAP               Remapping operation. Should be H2H, HC2H, H2HC or HC2HC.
+    /// \param[in] input            Stack of 2d rffts to multiply with the CTFs.
+    ///                             If empty, the CTFs are directly written to the output.
+    /// \param[out] output          Stack of CTF-multiplied 2d rffts, or the CTFs if the input is empty.
+    ///                             If no remapping is done, it can be equal to the input. Can be empty.
+    /// \param[in,out] ctf_squared  Single 2d rfft, to which the sum of the squared CTFs is added. Can be empty.
+    /// \param shape                Logical BDHW shape of the stack.
+    /// \param[in] ctf              Isotropic or anisotropic CTF(s). A contiguous vector of CTFs can be passed,
+    ///                             with one CTF per batch. If a single value is passed, it is applied to every batch.
+    ///                             The CTFs should all have the same pixel size.
+    /// \param options              CTF options.
+    /// \note The CTFs are read on the CPU before enqueueing the operator.
+    template<Remap REMAP,
+             nt::writable_varray_decay_of_any<f32, f64, c32, c64> Output,
+             nt::writable_varray_decay_of_any<f32, f64> Weights = View<nt::value_type_twice_t<Output>>,
+             typename CTF,
+             nt::readable_varray_decay Input = View<nt::const_value_type_t<Output>>>
+    requires ((guts::varray_decay_or_ctf_isotropic<CTF> or guts::varray_decay_or_ctf_anisotropic<CTF>) and
+              nt::varray_decay_of_almost_same_type<Input, Output> and
+              REMAP.is_any(Remap::H2H, Remap::HC2HC, Remap::HC2H, Remap::H2HC))
+    void ctf_batched_2d(
+        Input&& input,
+        Output&& output,
+        Weights&& ctf_squared,
+        const Shape4<i64>& shape,
+        CTF&& ctf,
+        const CTFBatchedOptions& options = {}
+    ) {
+        check(shape.ndim() == 2, "Only (batched) 2d arrays are supported, but got shape={}", shape);
+        check(not output.is_empty() or not ctf_squared.is_empty(), "Empty array detected");
+        const Device device = output.is_empty() ? ctf_squared.device() : output.device();
+
+        const auto shape_2d = shape.filter(2, 3);
+        if (not output.is_empty()) {
+            check(vall(Equal{}, output.shape(), shape.rfft()),
+                  "The output shape doesn't match the expected shape. Got output:shape={} and expected:shape={}",
+                  output.shape(), shape.rfft());
+        }
+        if (not ctf_squared.is_empty()) {
+            check(vall(Equal{}, ctf_squared.shape(), shape.rfft().set<0>(1)),
+                  "The ctf_squared shape doesn't match the expected shape. Got ctf_squared:shape={} and expected:shape={}",
+                  ctf_squared.shape(), shape.rfft().set<0>(1));
+            check(ctf_squared.device() == device,
+                  "The ctf_squared and output arrays must be on the same device, "
+                  "but got ctf_squared:device={} and output:device={}",
+                  ctf_squared.device(), device);
+        }
+        Strides4<i64> input_strides;
+        if (not input.is_empty()) {
+            check(not output.is_empty(), "An output is required to multiply the input with the CTFs");
+            check(input.device() == device,
+                  "The input and output arrays must be on the same device, but got input:device={} and output:device={}",
+                  input.device(), device);
+            check(not REMAP.has_layout_change() or not ni::are_overlapped(input, output),
+                  "This function cannot execute an in-place multiplication and a remapping");
+            input_strides = input.strides();
+            check(ni::broadcast(input.shape(), input_strides, output.shape()),
+                  "Cannot broadcast an array of shape {} into an array of shape {}",
+                  input.shape(), output.shape());
+        }
+
+        // Compute the polynomial coefficients of every CTF.
+        using coord_t = nt::mutable_value_type_twice_t<CTF>;
+        using polynomial_t = guts::CTFPolynomial<coord_t>;
+        auto polynomials = noa::empty<polynomial_t>(shape[0]);
+        Vec2<coord_t> pixel_size;
+        bool is_envelope_shared{true};
+        {
+            const auto polynomials_1d = polynomials.span_1d_contiguous();
+            const auto set_polynomials = [&](auto get_ctf) {
+                for (i64 i{}; i < shape[0]; ++i) {
+                    const auto& ctf_i = get_ctf(i);
+                    polynomials_1d[i] = guts::ctf_polynomial<coord_t>(ctf_i);
+
+                    Vec2<coord_t> pixel_size_i;
+                    if constexpr (nt::ctf_isotropic<std::decay_t<decltype(ctf_i)>>)
+                        pixel_size_i = Vec2<coord_t>::filled_with(ctf_i.pixel_size());
+                    else
+                        pixel_size_i = ctf_i.pixel_size();
+                    if (i == 0)
+                        pixel_size = pixel_size_i;
+                    check(vall(Equal{}, pixel_size, pixel_size_i),
+                          "The CTFs should have the same pixel size, but got {} and {}", pixel_size, pixel_size_i);
+                    is_envelope_shared = is_envelope_shared and
+                                         polynomials_1d[i].bfactor_forth == polynomials_1d[0].bfactor_forth;
+                }
+            };
+            if constexpr (nt::varray_decay<CTF>) {
+                check(ni::is_contiguous_vector(ctf) and ctf.n_elements() == shape[0],
+                      "The CTFs should be specified as a contiguous vector with {} elements, "
+                      "but got ctf:shape={} and ctf:strides={}",
+                      shape[0], ctf.shape(), ctf.strides());
+                const auto ctf_cpu = ctf.to_cpu().eval();
+                const auto ctf_1d = ctf_cpu.span_1d_contiguous();
+                set_polynomials([&](i64 i) { return ctf_1d[i]; });
+            } else {
+                set_polynomials([&](i64) { return ctf; });
+            }
+        }
+        const coord_t shared_bfactor_forth = is_envelope_shared ? polynomials.first().bfactor_forth : 0;
+        if (device.is_gpu())
+            polynomials = std::move(polynomials).to({.device = device});
+
+        // Compute the per-pixel terms, shared by every batch.
+        using table_accessor_t = AccessorContiguous<Vec4<coord_t>, 2, i64>;
+        const auto table = noa::empty<Vec4<coord_t>>(shape.rfft().set<0>(1), {.device = device});
+        const auto table_accessor = table_accessor_t(table.get(), table.strides().filter(2));
+        const auto table_op = guts::CTFTables<REMAP.is_xx2xc(), coord_t, i64>(
+            table_accessor, shape_2d, pixel_size, shared_bfactor_forth);
+        iwise(shape_2d.rfft(), device, table_op, table);
+
+        // Apply the CTFs. Each call loops through a chunk of batches, so that the input and output
+        // rows touched by successive pixels stay in cache.
+        using input_accessor_t = Accessor<nt::const_value_type_t<Input>, 3, i64>;
+        using output_accessor_t = Accessor<nt::value_type_t<Output>, 3, i64>;
+        using weights_accessor_t = Accessor<nt::value_type_t<Weights>, 2, i64>;
+        using op_t = guts::CTFBatched<REMAP, coord_t, i64, input_accessor_t, output_accessor_t, weights_accessor_t>;
+        const auto input_accessor = input_accessor_t(input.get(), input_strides.filter(0, 2, 3));
+        const auto output_accessor = output_accessor_t(output.get(), output.strides().filter(0, 2, 3));
+        const auto weights_accessor = weights_accessor_t(ctf_squared.get(), ctf_squared.strides().filter(2, 3));
+        const auto table_restrict = typename op_t::table_type(table.get(), table.strides().filter(2));
+        const auto polynomials_accessor = typename op_t::polynomial_type(polynomials.get());
+
+        // On the CPU, each pixel computes up to 32 CTFs, so the parallel loop is triggered for much smaller
+        // shapes than the default, which would run the usual particle sizes (e.g. 256x129) on a single thread.
+        constexpr i64 N_BATCHES_PER_CALL_CPU = 32;
+        constexpr auto ITERATION_OPTIONS = IwiseOptions{
+            .cpu_n_elements_per_thread = (1 << 16) / N_BATCHES_PER_CALL_CPU
+        };
+        const i64 n_batches_per_call = device.is_cpu() ? N_BATCHES_PER_CALL_CPU : shape[0];
+        for (i64 batch_start{}; batch_start < shape[0]; batch_start += n_batches_per_call) {
+            const auto op = op_t(
+                input_accessor, output_accessor, weights_accessor, table_restrict, polynomials_accessor,
+                shape[2], batch_start, min(batch_start + n_batches_per_call, shape[0]),
+                is_envelope_shared, options.ctf_abs, static_cast<coord_t>(options.input_scale));
+            iwise<ITERATION_OPTIONS>(shape_2d.rfft(), device, op, input, output, ctf_squared, table, polynomials);
+        }
+    }
 }
@@ -14,6 +14,9 @@ namespace noa::signal {
     /// \param[in] filter   1d, 2d or 3d C-contiguous filter. The same filter is applied to every output batch.
     ///                     Dimensions should have an odd number of elements. Dimensions don't have to have the same size.
     /// \note The precision of the convolution is the floating-point precision of the \p filter value type.
+    /// \note On the CPU, large filters are applied in Fourier space, using an overlap-save tiling of the output,
+    ///       if a cost model estimates it to be faster than the direct convolution. The filter spectrum is computed
+    ///       once and shared by every tile and batch.
     template<nt::readable_varray_decay_of_real Input,
              nt::writable_varray_decay_of_real Output,
              nt::readable_varray_decay_of_real Filter>
@@ -81,11 +84,14 @@ namespace noa::signal {
     /// \param[in] filter_width     1d filter with an odd number of elements applied along the width dimension.
     /// \param[out] buffer          Temporary array. If only one dimension is filtered, this is ignored. Otherwise,
     ///                             it should be an array of the same shape as \p output, or be an empty array,
-    ///                             in which case a temporary array will be allocated internally.
+    ///                             in which case a temporary array will be allocated internally if needed.
     ///
     /// \note The precision of the convolution is the floating-point precision of the filters value type.
     /// \note Filters can be empty. In these cases, the convolution in the corresponding dimension is not applied
     ///       and it goes directly to the next filter, if any. Filters can be equal to each other.
+    /// \note On the CPU, the filters are applied in a single pass, streaming strips of rows through small
+    ///       buffers, and the temporary array is not used. Large filters may be applied in Fourier space instead,
+    ///       as in convolve().
     template<nt::readable_varray_decay_of_real Input,
              nt::writable_varray_decay_of_real Output,
              nt::readable_varray_decay_of_real FilterDepth = View<nt::const_value_type_t<Input>>,
@@ -58,6 +58,8 @@ namespace noa::signal::guts {
 
     template<Correlation MODE>
     struct CrossCorrelationMap {
+        f64 scale{1}; // normalization of the inverse transform
+
         template<typename R>
         constexpr void operator()(const Complex<R>& l, const Complex<R>& r, Complex<R>& o) {
             constexpr auto EPSILON = static_cast<R>(1e-13);
@@ -83,6 +85,7 @@ namespace noa::signal::guts {
             } else {
                 static_assert(nt::always_false<>);
             }
+            o *= static_cast<R>(scale);
         }
     };
 
@@ -463,25 +466,28 @@ namespace noa::signal {
             tmp = buffer.view();
         }
 
+        // The normalization of the c2r transform is folded into the multiplication.
+        const auto scale = noa::fft::normalization_factor(output.shape(), noa::fft::Sign::BACKWARD, options.ifft_norm);
+
         // TODO Add normalization with auto-correlation?
         //      IMO it's always simpler to normalize the real inputs,
         //      so not sure how useful this would be.
         switch (options.mode) {
             case Correlation::CONVENTIONAL:
                 ewise(wrap(std::forward<Lhs>(lhs), rhs), tmp,
-                      guts::CrossCorrelationMap<Correlation::CONVENTIONAL>{});
+                      guts::CrossCorrelationMap<Correlation::CONVENTIONAL>{scale});
                 break;
             case Correlation::PHASE:
                 ewise(wrap(std::forward<Lhs>(lhs), rhs), tmp,
-                      guts::CrossCorrelationMap<Correlation::PHASE>{});
+                      guts::CrossCorrelationMap<Correlation::PHASE>{scale});
                 break;
             case Correlation::DOUBLE_PHASE:
                 ewise(wrap(std::forward<Lhs>(lhs), rhs), tmp,
-                      guts::CrossCorrelationMap<Correlation::DOUBLE_PHASE>{});
+                      guts::CrossCorrelationMap<Correlation::DOUBLE_PHASE>{scale});
                 break;
             case Correlation::MUTUAL:
                 ewise(wrap(std::forward<Lhs>(lhs), rhs), tmp,
-                      guts::CrossCorrelationMap<Correlation::MUTUAL>{});
+                      guts::CrossCorrelationMap<Correlation::MUTUAL>{scale});
                 break;
         }
 
@@ -497,10 +503,10 @@ namespace noa::signal {
 
         if (buffer.is_empty())
             noa::fft::c2r(std::forward<Rhs>(rhs), std::forward<Output>(output),
-                          {.norm = options.ifft_norm, .cache_plan = options.ifft_cache_plan});
+                          {.norm = noa::fft::Norm::NONE, .cache_plan = options.ifft_cache_plan});
         else {
             noa::fft::c2r(std::forward<Buffer>(buffer), std::forward<Output>(output),
-                          {.norm = options.ifft_norm, .cache_plan = options.ifft_cache_plan});
+                          {.norm = noa::fft::Norm::NONE, .cache_plan = options.ifft_cache_plan});
         }
     }
 
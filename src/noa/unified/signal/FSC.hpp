@@ -5,7 +5,11 @@
 #include "noa/core/fft/Frequency.hpp"
 #include "noa/unified/Array.hpp"
 #include "noa/unified/Ewise.hpp"
+#include "noa/unified/Factory.hpp"
 #include "noa/unified/Iwise.hpp"
+#include "noa/unified/fft/Factory.hpp"
+#include "noa/unified/fft/Transform.hpp"
+#include "noa/unified/geometry/DrawShape.hpp"
 
 namespace noa::signal {
     constexpr auto n_shells(const Shape4<i64>& shape) -> i64 {
@@ -21,6 +25,12 @@ namespace noa::signal {
         }
         return 1;
     }
+
+    /// Returns the BDHW shape of the local resolution map, i.e. the number of windows along each dimension,
+    /// given the BDHW shape of the half maps and the step (in voxels) between the window centers.
+    constexpr auto local_resolution_shape(const Shape4<i64>& shape, i64 step) -> Shape4<i64> {
+        return {shape[0], divide_up(shape[1], step), divide_up(shape[2], step), divide_up(shape[3], step)};
+    }
 }
 
 
@@ -216,17 +226,15 @@ namespace noa::signal::guts {
             const auto denominator_lhs = abs_squared(lhs);
             const auto denominator_rhs = abs_squared(rhs);
 
-            const auto normalized_direction = coord3_type::from_values(z, y, x) / radius;
+            // The frequency is inside the cone if abs(cos(angle)) >= cos(cone_aperture), where the angle is between
+            // the frequency and the cone direction. To skip the arccos and the normalization of the frequency,
+            // check abs(dot(fftfreq, direction)) >= cos(cone_aperture) * norm(fftfreq) instead.
+            // Note that the DC is inside every cone.
+            const auto min_cos_times_norm = m_cos_cone_aperture * sqrt(radius_sqd);
             for (index_type cone{}; cone < m_cone_count; ++cone) {
-                // angular_difference = acos(dot(a,b))
-                // We could compute the angular difference between the current frequency and the cone direction.
-                // However, we only want to know if the frequency is inside or outside the cone, so skip the arccos
-                // and check abs(cos(angle)) > cos(cone_aperture).
-
                 // TODO In CUDA, try constant memory for the directions, or the less appropriate shared memory.
                 const auto normalized_direction_cone = m_normalized_cone_directions[cone].template as<coord_type>();
-                const auto cos_angle_difference = dot(normalized_direction, normalized_direction_cone);
-                if (abs(cos_angle_difference) > m_cos_cone_aperture)
+                if (abs(dot(fftfreq, normalized_direction_cone)) < min_cos_times_norm)
                     continue;
 
                 // Atomic save.
@@ -300,7 +308,7 @@ namespace noa::signal::guts {
             n_cones = cone_directions.ssize();
         }
 
-        const auto expected_shape = Shape4<i64>{shape[0], 1, n_cones, n_shells(lhs.shape())};
+        const auto expected_shape = Shape4<i64>{shape[0], 1, n_cones, n_shells(shape)};
         check(vall(Equal{}, fsc.shape(), expected_shape) and fsc.are_contiguous(),
               "The FSC does not have the correct shape. Given the input shape {}, and the number of cones ({}),"
               "the expected shape is {}, but got {}",
@@ -313,7 +321,7 @@ namespace noa::signal::fft {
     /// \tparam REMAP   Whether the input rffts are centered. Should be H2H or HC2HC.
     /// \param[in] lhs  Left-hand side.
     /// \param[in] rhs  Right-hand side. Should have the same shape as \p lhs.
-    /// \param[out] fsc The output FSC. Should be a (batched) vector of size n_shells(lhs.shape()).
+    /// \param[out] fsc The output FSC. Should be a (batched) vector of size n_shells(shape).
     /// \param shape    Logical shape of \p lhs and \p rhs.
     template<Remap REMAP,
              nt::readable_varray_decay_of_complex Lhs,
@@ -333,17 +341,18 @@ namespace noa::signal::fft {
         using input_accessor_t = AccessorRestrictI64<complex_t, 4>;
         using output_accessor_t = AccessorRestrictContiguousI32<real_t, 2>;
 
-        const auto options = lhs.options().set_allocator(Allocator::DEFAULT_ASYNC);
-        const auto denominator = Array<real_t>(fsc.shape().template set<1>(2), options);
+        const auto options = ArrayOption{fsc.device(), Allocator::DEFAULT_ASYNC};
+        const auto denominator = noa::zeros<real_t>(fsc.shape().template set<1>(2), options);
         auto denominator_lhs = denominator.subregion(ni::FullExtent{}, 0);
         auto denominator_rhs = denominator.subregion(ni::FullExtent{}, 1);
 
-        const auto reduction_op = FSCIsotropic<REMAP, real_t, i64, input_accessor_t, output_accessor_t>(
+        const auto reduction_op = guts::FSCIsotropic<REMAP, real_t, i64, input_accessor_t, output_accessor_t>(
                 input_accessor_t(lhs.get(), lhs.strides()),
                 input_accessor_t(rhs.get(), rhs.strides()), shape.pop_front(),
                 output_accessor_t(fsc.get(), fsc.strides().filter(0, 3).template as_safe<i32>()),
                 output_accessor_t(denominator_lhs.get(), denominator_lhs.strides().filter(0, 3).template as_safe<i32>()),
                 output_accessor_t(denominator_rhs.get(), denominator_rhs.strides().filter(0, 3).template as_safe<i32>()));
+        noa::fill(fsc, real_t{});
         iwise(shape.rfft(), fsc.device(), reduction_op, std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
         ewise(wrap(std::move(denominator_lhs), std::move(denominator_rhs)),
               std::forward<Output>(fsc),
@@ -355,7 +364,7 @@ namespace noa::signal::fft {
     /// \param[in] lhs  Left-hand side.
     /// \param[in] rhs  Right-hand side. Should have the same shape as \p lhs.
     /// \param shape    Logical shape of \p lhs and \p rhs.
-    /// \return A (batched) row vector with the FSC. The number of shells is n_shells(lhs.shape()).
+    /// \return A (batched) row vector with the FSC. The number of shells is n_shells(shape).
     template<Remap REMAP,
              nt::readable_varray_decay_of_complex Lhs,
              nt::readable_varray_decay_of_complex Rhs>
@@ -365,8 +374,8 @@ namespace noa::signal::fft {
         Rhs&& rhs,
         const Shape4<i64>& shape
     ) {
-        using value_t = nt::mutable_value_type_t<Lhs>;
-        auto fsc = Array<value_t>({shape[0], 1, 1, n_shells(rhs.shape())}, rhs.options());
+        using value_t = nt::mutable_value_type_twice_t<Lhs>;
+        auto fsc = Array<value_t>({shape[0], 1, 1, n_shells(shape)}, rhs.options());
         fsc_isotropic<REMAP>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs), fsc, shape);
         return fsc;
     }
@@ -377,7 +386,7 @@ namespace noa::signal::fft {
     /// \param[in] rhs              Right-hand side. Should have the same shape as \p lhs.
     /// \param[out] fsc             The output FSC. A row-major table of shape (n_batches, 1, n_cones, n_shells).
     ///                             Each row contains the shell values. There's one row per cone.
-    ///                             Each column is a shell, with the number of shells set to n_shells(lhs.shape()).
+    ///                             Each column is a shell, with the number of shells set to n_shells(shape).
     ///                             There's one table per input batch.
     /// \param shape                Logical shape of \p lhs and \p rhs.
     /// \param[in] cone_directions  DHW normalized direction(s) of the cone(s).
@@ -400,18 +409,18 @@ namespace noa::signal::fft {
     ) {
         guts::check_fsc_parameters(lhs, rhs, fsc, shape, cone_directions);
 
-        using coord_t = nt::mutable_value_type_t<Cones>;
+        using coord_t = nt::mutable_value_type_twice_t<Cones>;
         using real_t = nt::value_type_t<Output>;
         using input_accessor_t = AccessorRestrictI64<nt::const_value_type_t<Lhs>, 4>;
         using output_accessor_t = AccessorRestrictContiguousI32<real_t, 3>;
         using direction_accessor_t = AccessorRestrictContiguousI32<nt::const_value_type_t<Cones>, 1>;
 
-        const auto options = lhs.options().set_allocator(Allocator::DEFAULT_ASYNC);
-        const auto denominator = Array<real_t>(fsc.shape().template set<1>(2), options);
+        const auto options = ArrayOption{fsc.device(), Allocator::DEFAULT_ASYNC};
+        const auto denominator = noa::zeros<real_t>(fsc.shape().template set<1>(2), options);
         auto denominator_lhs = denominator.subregion(ni::FullExtent{}, 0);
         auto denominator_rhs = denominator.subregion(ni::FullExtent{}, 1);
 
-        auto reduction_op = FSCAnisotropic<REMAP, coord_t, i64, input_accessor_t, output_accessor_t, direction_accessor_t>(
+        auto reduction_op = guts::FSCAnisotropic<REMAP, coord_t, i64, input_accessor_t, output_accessor_t, direction_accessor_t>(
             input_accessor_t(lhs.get(), lhs.strides()),
             input_accessor_t(rhs.get(), rhs.strides()), shape.pop_front(),
             output_accessor_t(fsc.get(), fsc.strides().filter(0, 2, 3).template as_safe<i32>()),
@@ -420,6 +429,7 @@ namespace noa::signal::fft {
             direction_accessor_t(cone_directions.get()),
             cone_directions.ssize(),
             static_cast<coord_t>(cone_aperture));
+        noa::fill(fsc, real_t{});
         iwise(shape.rfft(), fsc.device(), reduction_op,
               std::forward<Lhs>(lhs),
               std::forward<Rhs>(rhs),
@@ -438,7 +448,7 @@ namespace noa::signal::fft {
     /// \param cone_aperture        Cone aperture, in radians.
     /// \return A row-major (batched) table with the FSC, of shape (n_batches, 1, n_cones, n_shells).
     ///         Each row contains the shell values. There's one row per cone.
-    ///         Each column is a shell, with the number of shells set to n_shells(lhs.shape()).
+    ///         Each column is a shell, with the number of shells set to n_shells(shape).
     ///         There's one table per input batch.
     template<Remap REMAP,
              nt::readable_varray_decay_of_complex Lhs,
@@ -454,10 +464,473 @@ namespace noa::signal::fft {
         Cones&& cone_directions,
         f32 cone_aperture
     ) {
-        using value_t = nt::mutable_value_type_t<Lhs>;
-        auto fsc = Array<value_t>({shape[0], 1, cone_directions.ssize(), n_shells(lhs.shape())}, rhs.options());
+        using value_t = nt::mutable_value_type_twice_t<Lhs>;
+        auto fsc = Array<value_t>({shape[0], 1, cone_directions.ssize(), n_shells(shape)}, rhs.options());
         fsc_anisotropic<REMAP>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs), fsc, shape,
                                std::forward<Cones>(cone_directions), cone_aperture);
         return fsc;
     }
 }
+
+namespace noa::signal::guts {
+    /// 3d iwise operator computing, for each frequency of a (non-centered) rfft, the lower shell and the lerp
+    /// weight of the upper shell, as computed by FSCIsotropic. Frequencies past Nyquist have a shell of -1.
+    /// The table is shared by all the windows of the local FSC.
+    template<nt::sinteger Index, nt::writable_nd<3> Output>
+    class LocalFSCShellTable {
+    public:
+        using index_type = Index;
+        using shape3_type = Shape3<index_type>;
+        using output_type = Output;
+        using output_value_type = nt::value_type_t<output_type>;
+        using coord_type = nt::value_type_t<output_value_type>;
+        using coord3_type = Vec3<coord_type>;
+        static_assert(nt::vec_real_size<output_value_type, 2>);
+
+    public:
+        LocalFSCShellTable(const output_type& table, const shape3_type& shape) :
+            m_table(table),
+            m_shape(shape.pop_back()),
+            m_norm(coord_type{1} / coord3_type::from_vec(shape.vec)),
+            m_scale(static_cast<coord_type>(min(shape))) {}
+
+        NOA_HD void operator()(index_type z, index_type y, index_type x) const {
+            const auto frequency = noa::fft::index2frequency<false, true>(Vec{z, y, x}, m_shape);
+            const auto fftfreq = coord3_type::from_vec(frequency) * m_norm;
+            const auto radius_sqd = dot(fftfreq, fftfreq);
+            if (radius_sqd > coord_type{0.25}) {
+                m_table(z, y, x) = {-1, 0};
+                return;
+            }
+            const auto radius = sqrt(radius_sqd) * m_scale;
+            const auto shell_low = floor(radius);
+            m_table(z, y, x) = {shell_low, radius - shell_low};
+        }
+
+    private:
+        output_type m_table;
+        Shape2<index_type> m_shape;
+        coord3_type m_norm;
+        coord_type m_scale;
+    };
+
+    /// 3d iwise operator extracting the windows of the local FSC, for both half maps.
+    /// * The windows are centered on the grid of the resolution map, i.e. the window of the resolution map
+    ///   element (b,z,y,x) is centered on the voxel (b,z,y,x)*step of the half maps.
+    /// * Each call computes a row of a window, for a batch of (consecutive) windows starting at window_offset.
+    /// * The windows are multiplied by the (soft) mask. Out-of-bound voxels are set to zero.
+    template<nt::sinteger Index,
+             nt::readable_nd<4> Input,
+             nt::readable_nd<3> Mask,
+             nt::writable_nd<4> Output>
+    class LocalFSCWindows {
+    public:
+        using index_type = Index;
+        using shape3_type = Shape3<index_type>;
+        using shape4_type = Shape4<index_type>;
+        using input_type = Input;
+        using mask_type = Mask;
+        using output_type = Output;
+        using output_value_type = nt::value_type_t<output_type>;
+        static_assert(nt::real<nt::mutable_value_type_t<input_type>,
+                               nt::mutable_value_type_t<mask_type>,
+                               output_value_type>);
+
+    public:
+        LocalFSCWindows(
+            const input_type& lhs,
+            const input_type& rhs,
+            const shape3_type& input_shape,
+            const mask_type& mask,
+            const output_type& lhs_windows,
+            const output_type& rhs_windows,
+            const shape4_type& grid_shape,
+            index_type step,
+            index_type window_size
+        ) : m_lhs(lhs), m_rhs(rhs), m_mask(mask),
+            m_lhs_windows(lhs_windows),
+            m_rhs_windows(rhs_windows),
+            m_input_shape(input_shape),
+            m_grid_shape(grid_shape),
+            m_step(step),
+            m_window_size(window_size) {}
+
+        void set_window_offset(index_type window_offset) noexcept {
+            m_window_offset = window_offset;
+        }
+
+        NOA_HD void operator()(index_type window, index_type z, index_type y) const {
+            const auto grid_indices = ni::offset2index(m_window_offset + window, m_grid_shape);
+            const auto batch = grid_indices[0];
+            const auto center = m_window_size / 2;
+            const auto iz = grid_indices[1] * m_step + z - center;
+            const auto iy = grid_indices[2] * m_step + y - center;
+            const auto ix_start = grid_indices[3] * m_step - center;
+
+            // Only the x range within the half maps is read.
+            index_type x_start{}, x_end{};
+            if (ni::is_inbounds(m_input_shape.pop_back(), Vec{iz, iy})) {
+                x_start = clamp(-ix_start, index_type{}, m_window_size);
+                x_end = clamp(m_input_shape[2] - ix_start, index_type{}, m_window_size);
+            }
+            for (index_type x{}; x < x_start; ++x) {
+                m_lhs_windows(window, z, y, x) = 0;
+                m_rhs_windows(window, z, y, x) = 0;
+            }
+            for (index_type x = x_start; x < x_end; ++x) {
+                const auto mask = static_cast<output_value_type>(m_mask(z, y, x));
+                const auto ix = ix_start + x;
+                m_lhs_windows(window, z, y, x) = static_cast<output_value_type>(m_lhs(batch, iz, iy, ix)) * mask;
+                m_rhs_windows(window, z, y, x) = static_cast<output_value_type>(m_rhs(batch, iz, iy, ix)) * mask;
+            }
+            for (index_type x = max(x_start, x_end); x < m_window_size; ++x) {
+                m_lhs_windows(window, z, y, x) = 0;
+                m_rhs_windows(window, z, y, x) = 0;
+            }
+        }
+
+    private:
+        input_type m_lhs;
+        input_type m_rhs;
+        mask_type m_mask;
+        output_type m_lhs_windows;
+        output_type m_rhs_windows;
+        shape3_type m_input_shape;
+        shape4_type m_grid_shape;
+        index_type m_step;
+        index_type m_window_size;
+        index_type m_window_offset{};
+    };
+
+    /// 1d iwise operator computing the isotropic FSC of a batch of windows.
+    /// This is the same reduction as FSCIsotropic, but each call computes the FSC of an entire window, so the
+    /// shells are accumulated without atomics and the shells of each frequency are read from the shared table.
+    /// This is used on the CPU, where there are enough windows to keep the threads busy.
+    template<nt::sinteger Index,
+             nt::readable_nd<4> Input,
+             nt::readable_nd<3> Table,
+             nt::writable_nd<2> Output>
+    class LocalFSCShells {
+    public:
+        using index_type = Index;
+        using shape3_type = Shape3<index_type>;
+        using input_type = Input;
+        using table_type = Table;
+        using output_type = Output;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        static_assert(nt::complex<input_value_type> and nt::real<output_value_type>);
+
+    public:
+        LocalFSCShells(
+            const input_type& lhs,
+            const input_type& rhs,
+            const table_type& shells,
+            const shape3_type& rfft_shape,
+            index_type n_shells,
+            const output_type& fsc,
+            const output_type& denominator_lhs,
+            const output_type& denominator_rhs
+        ) : m_lhs(lhs), m_rhs(rhs), m_shells(shells),
+            m_fsc(fsc),
+            m_denominator_lhs(denominator_lhs),
+            m_denominator_rhs(denominator_rhs),
+            m_rfft_shape(rfft_shape),
+            m_max_shell_index(n_shells - 1) {}
+
+        void operator()(index_type window) const {
+            for (index_type i{}; i <= m_max_shell_index; ++i) {
+                m_fsc(window, i) = 0;
+                m_denominator_lhs(window, i) = 0;
+                m_denominator_rhs(window, i) = 0;
+            }
+
+            for (index_type z{}; z < m_rfft_shape[0]; ++z) {
+                for (index_type y{}; y < m_rfft_shape[1]; ++y) {
+                    for (index_type x{}; x < m_rfft_shape[2]; ++x) {
+                        const auto [shell, fraction_high] = m_shells(z, y, x);
+                        if (shell < 0)
+                            continue;
+
+                        const auto shell_low = static_cast<index_type>(shell);
+                        const auto shell_high = min(m_max_shell_index, shell_low + 1);
+                        const auto fraction_low = 1 - fraction_high;
+
+                        const auto lhs = m_lhs(window, z, y, x);
+                        const auto rhs = m_rhs(window, z, y, x);
+                        const auto numerator = static_cast<output_value_type>(dot(lhs, rhs));
+                        const auto denominator_lhs = static_cast<output_value_type>(abs_squared(lhs));
+                        const auto denominator_rhs = static_cast<output_value_type>(abs_squared(rhs));
+
+                        m_fsc(window, shell_low) += numerator * fraction_low;
+                        m_fsc(window, shell_high) += numerator * fraction_high;
+                        m_denominator_lhs(window, shell_low) += denominator_lhs * fraction_low;
+                        m_denominator_lhs(window, shell_high) += denominator_lhs * fraction_high;
+                        m_denominator_rhs(window, shell_low) += denominator_rhs * fraction_low;
+                        m_denominator_rhs(window, shell_high) += denominator_rhs * fraction_high;
+                    }
+                }
+            }
+
+            for (index_type i{}; i <= m_max_shell_index; ++i)
+                FSCNormalization{}(m_denominator_lhs(window, i), m_denominator_rhs(window, i), m_fsc(window, i));
+        }
+
+    private:
+        input_type m_lhs;
+        input_type m_rhs;
+        table_type m_shells;
+        output_type m_fsc;
+        output_type m_denominator_lhs;
+        output_type m_denominator_rhs;
+        shape3_type m_rfft_shape;
+        index_type m_max_shell_index;
+    };
+
+    /// 1d iwise operator computing the local resolution from the FSC curves of a batch of windows.
+    /// The resolution is where the FSC first drops below the threshold, with a lerp between the two shells
+    /// around the crossing. If the FSC never drops below the threshold, the resolution is set to Nyquist.
+    template<nt::sinteger Index,
+             nt::readable_nd<2> FSC,
+             nt::writable_nd<4> Output>
+    class LocalFSCResolution {
+    public:
+        using index_type = Index;
+        using shape4_type = Shape4<index_type>;
+        using fsc_type = FSC;
+        using output_type = Output;
+        using fsc_value_type = nt::mutable_value_type_t<fsc_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        static_assert(nt::real<fsc_value_type, output_value_type>);
+
+    public:
+        LocalFSCResolution(
+            const fsc_type& fsc,
+            const output_type& resolution,
+            const shape4_type& grid_shape,
+            index_type n_shells,
+            f64 window_size,
+            f64 spacing,
+            f64 threshold
+        ) : m_fsc(fsc),
+            m_resolution(resolution),
+            m_grid_shape(grid_shape),
+            m_n_shells(n_shells),
+            m_window_size_in_angstrom(static_cast<fsc_value_type>(window_size * spacing)),
+            m_threshold(static_cast<fsc_value_type>(threshold)) {}
+
+        void set_window_offset(index_type window_offset) noexcept {
+            m_window_offset = window_offset;
+        }
+
+        NOA_HD void operator()(index_type window) const {
+            auto shell = static_cast<fsc_value_type>(m_n_shells - 1);
+            for (index_type i = 1; i < m_n_shells; ++i) {
+                const auto current = m_fsc(window, i);
+                if (current < m_threshold) {
+                    const auto previous = m_fsc(window, i - 1);
+                    const auto fraction = (previous - m_threshold) / max(previous - current, fsc_value_type{1e-6});
+                    shell = max(fsc_value_type{1}, static_cast<fsc_value_type>(i - 1) + clamp(fraction, 0, 1));
+                    break;
+                }
+            }
+            const auto grid_indices = ni::offset2index(m_window_offset + window, m_grid_shape);
+            m_resolution(grid_indices) = static_cast<output_value_type>(m_window_size_in_angstrom / shell);
+        }
+
+    private:
+        fsc_type m_fsc;
+        output_type m_resolution;
+        shape4_type m_grid_shape;
+        index_type m_window_offset{};
+        index_type m_n_shells;
+        fsc_value_type m_window_size_in_angstrom;
+        fsc_value_type m_threshold;
+    };
+}
+
+namespace noa::signal {
+    struct LocalResolutionOptions {
+        /// Size, in voxels, of the cubic windows in which the FSC is computed.
+        i64 window_size;
+
+        /// Step, in voxels, between the window centers. The resolution map has a shape of
+        /// local_resolution_shape(shape, step), i.e. one resolution value every step voxels.
+        i64 step;
+
+        /// Size, in voxels, of the raised-cosine edge of the spherical mask applied to the windows.
+        /// The mask, including its edge, has a diameter of window_size.
+        f64 mask_edge_size{5};
+
+        /// FSC threshold defining the resolution.
+        f64 fsc_threshold{0.143};
+
+        /// Pixel size, in Angstrom per voxel. The resolution map is in Angstrom, or in voxels if 1.
+        f64 spacing{1};
+
+        /// Number of windows processed at once. This sets the size of the temporary buffers, which hold
+        /// two padded windows per batch, and can be lowered to keep the memory footprint bounded.
+        i64 n_windows_per_batch{128};
+
+        /// Planning rigor of the CPU transforms of the windows. The plans are cached and reused for every
+        /// batch of windows, so the planning time is amortized.
+        noa::fft::Rigor fft_rigor{noa::fft::Rigor::MEASURE};
+    };
+
+    /// Computes the local resolution map from two (independent) half maps.
+    /// \details The FSC between the half maps is computed within a soft-masked window around every step-th
+    ///          voxel and the resolution is where the FSC first drops below the threshold. Windows are extracted,
+    ///          Fourier transformed and correlated in batches of n_windows_per_batch windows, reusing the same
+    ///          buffers and FFT plans. On the CPU, each thread reduces the shells of entire windows, using a
+    ///          frequency-to-shell table shared by every window. On the GPU, the shells of the batch of windows
+    ///          are reduced with fft::fsc_isotropic.
+    /// \param[in] lhs          Left-hand side 3d half map(s).
+    /// \param[in] rhs          Right-hand side 3d half map(s). Should have the same shape as \p lhs.
+    /// \param[out] resolution  Local resolution map(s), of shape local_resolution_shape(lhs.shape(), step).
+    ///                         The voxel (b,z,y,x) of the map is the resolution at the voxel (b,z,y,x)*step
+    ///                         of the half maps.
+    /// \param options          Local resolution options.
+    template<nt::readable_varray_decay_of_real Lhs,
+             nt::readable_varray_decay_of_real Rhs,
+             nt::writable_varray_decay_of_real Output>
+    requires nt::varray_decay_of_almost_same_type<Lhs, Rhs>
+    void local_resolution(
+        Lhs&& lhs,
+        Rhs&& rhs,
+        Output&& resolution,
+        const LocalResolutionOptions& options
+    ) {
+        check(not lhs.is_empty() and not rhs.is_empty() and not resolution.is_empty(), "Empty array detected");
+        check(vall(Equal{}, lhs.shape(), rhs.shape()),
+              "The two input arrays should have the same shape. Got lhs:{} and rhs:{}",
+              lhs.shape(), rhs.shape());
+        check(lhs.shape().ndim() == 3, "The half maps should be 3d arrays, but got shape={}", lhs.shape());
+        check(options.window_size >= 2 and options.step >= 1 and options.n_windows_per_batch >= 1,
+              "Invalid options: window_size={} (should be >= 2), step={} (should be >= 1), "
+              "n_windows_per_batch={} (should be >= 1)",
+              options.window_size, options.step, options.n_windows_per_batch);
+        check(options.mask_edge_size >= 0 and options.mask_edge_size <= static_cast<f64>(options.window_size / 2),
+              "The mask edge size should be within [0, window_size/2], but got mask_edge_size={}",
+              options.mask_edge_size);
+
+        const auto grid_shape = local_resolution_shape(lhs.shape(), options.step);
+        check(vall(Equal{}, resolution.shape(), grid_shape),
+              "Given the half maps of shape {} and the step {}, the resolution map should have a shape of {}, "
+              "but got {}", lhs.shape(), options.step, grid_shape, resolution.shape());
+
+        const Device device = resolution.device();
+        check(device == lhs.device() and device == rhs.device(),
+              "The input and output arrays must be on the same device, but got lhs:{}, rhs:{}, resolution:{}",
+              lhs.device(), rhs.device(), device);
+
+        using real_t = nt::mutable_value_type_t<Lhs>;
+        using input_accessor_t = AccessorRestrictI64<nt::const_value_type_t<Lhs>, 4>;
+        using mask_accessor_t = AccessorRestrictI64<const real_t, 3>;
+        using windows_accessor_t = AccessorRestrictI64<real_t, 4>;
+        using fsc_accessor_t = AccessorRestrictI64<const real_t, 2>;
+        using output_accessor_t = AccessorI64<nt::value_type_t<Output>, 4>;
+
+        // Temporary buffers, reused for every batch of windows.
+        const i64 n_windows = grid_shape.n_elements();
+        const i64 n_windows_per_batch = std::min(n_windows, options.n_windows_per_batch);
+        const i64 window_size = options.window_size;
+        const auto windows_shape = Shape4<i64>{n_windows_per_batch, window_size, window_size, window_size};
+        const auto buffer_options = ArrayOption{device, Allocator::DEFAULT_ASYNC};
+        auto [lhs_windows, lhs_windows_rfft] = noa::fft::empty<real_t>(windows_shape, buffer_options);
+        auto [rhs_windows, rhs_windows_rfft] = noa::fft::empty<real_t>(windows_shape, buffer_options);
+        auto fsc = Array<real_t>({n_windows_per_batch, 1, 1, n_shells(windows_shape)}, buffer_options);
+
+        // The mask, and on the CPU the shells of the rfft frequencies, are shared by every window.
+        const auto window_shape = windows_shape.set<0>(1);
+        const auto window_center = static_cast<f64>(window_size / 2);
+        auto mask = Array<real_t>(window_shape, buffer_options);
+        noa::geometry::draw_shape({}, mask, noa::geometry::Sphere{
+            .center = Vec3<f64>::from_value(window_center),
+            .radius = window_center - options.mask_edge_size,
+            .smoothness = options.mask_edge_size,
+        });
+
+        Array<Vec2<real_t>> shells;
+        Array<real_t> denominators;
+        if (device.is_cpu()) {
+            using table_accessor_t = AccessorRestrictI64<Vec2<real_t>, 3>;
+            shells = Array<Vec2<real_t>>(window_shape.rfft(), buffer_options);
+            denominators = Array<real_t>(fsc.shape().template set<1>(2), buffer_options);
+            iwise(shells.shape().pop_front(), device,
+                  guts::LocalFSCShellTable<i64, table_accessor_t>(
+                      table_accessor_t(shells.get(), shells.strides().pop_front()),
+                      window_shape.pop_front()),
+                  shells);
+        }
+
+        auto extract_op = guts::LocalFSCWindows<i64, input_accessor_t, mask_accessor_t, windows_accessor_t>(
+            input_accessor_t(lhs.get(), lhs.strides()),
+            input_accessor_t(rhs.get(), rhs.strides()),
+            lhs.shape().pop_front(),
+            mask_accessor_t(mask.get(), mask.strides().pop_front()),
+            windows_accessor_t(lhs_windows.get(), lhs_windows.strides()),
+            windows_accessor_t(rhs_windows.get(), rhs_windows.strides()),
+            grid_shape, options.step, window_size);
+        auto resolution_op = guts::LocalFSCResolution<i64, fsc_accessor_t, output_accessor_t>(
+            fsc_accessor_t(fsc.get(), fsc.strides().filter(0, 3)),
+            output_accessor_t(resolution.get(), resolution.strides()),
+            grid_shape, fsc.shape()[3], static_cast<f64>(window_size),
+            options.spacing, options.fsc_threshold);
+
+        const auto fft_options = noa::fft::FFTOptions{
+            .norm = noa::fft::Norm::NONE, // the FSC is normalized
+            .cache_plan = true,
+            .rigor = options.fft_rigor,
+        };
+
+        for (i64 window_offset{}; window_offset < n_windows; window_offset += n_windows_per_batch) {
+            const i64 n_batches = std::min(n_windows_per_batch, n_windows - window_offset);
+            const auto batches = ni::Slice{0, n_batches};
+            const auto batch_shape = windows_shape.set<0>(n_batches);
+
+            extract_op.set_window_offset(window_offset);
+            iwise(batch_shape.pop_back(), device, extract_op, lhs, rhs, mask, lhs_windows, rhs_windows);
+
+            // The buffers are passed as arrays (not views), so they are kept alive by asynchronous streams.
+            auto lhs_rfft = lhs_windows_rfft.subregion(batches);
+            auto rhs_rfft = rhs_windows_rfft.subregion(batches);
+            noa::fft::r2c(lhs_windows.subregion(batches), lhs_rfft, fft_options);
+            noa::fft::r2c(rhs_windows.subregion(batches), rhs_rfft, fft_options);
+            if (device.is_cpu()) {
+                using rfft_accessor_t = AccessorRestrictI64<const Complex<real_t>, 4>;
+                using table_accessor_t = AccessorRestrictI64<const Vec2<real_t>, 3>;
+                using shells_accessor_t = AccessorRestrictI64<real_t, 2>;
+                const auto shells_op = guts::LocalFSCShells<i64, rfft_accessor_t, table_accessor_t, shells_accessor_t>(
+                    rfft_accessor_t(lhs_rfft.get(), lhs_rfft.strides()),
+                    rfft_accessor_t(rhs_rfft.get(), rhs_rfft.strides()),
+                    table_accessor_t(shells.get(), shells.strides().pop_front()),
+                    window_shape.rfft().pop_front(), fsc.shape()[3],
+                    shells_accessor_t(fsc.get(), fsc.strides().filter(0, 3)),
+                    shells_accessor_t(denominators.get(), denominators.strides().filter(0, 3)),
+                    shells_accessor_t(denominators.get() + denominators.strides()[1],
+                                      denominators.strides().filter(0, 3)));
+                iwise<IwiseOptions{.generate_gpu = false, .cpu_n_elements_per_thread = 1}>(
+                    Shape{n_batches}, device, shells_op,
+                    std::move(lhs_rfft), std::move(rhs_rfft), shells, fsc, denominators);
+            } else {
+                noa::signal::fft::fsc_isotropic<Remap::H2H>(
+                    std::move(lhs_rfft), std::move(rhs_rfft), fsc.subregion(batches), batch_shape);
+            }
+
+            resolution_op.set_window_offset(window_offset);
+            iwise(Shape{n_batches}, device, resolution_op, fsc, resolution);
+        }
+    }
+
+    /// Computes the local resolution map from two (independent) half maps.
+    /// \return The resolution map(s), of shape local_resolution_shape(lhs.shape(), options.step).
+    template<nt::readable_varray_decay_of_real Lhs,
+             nt::readable_varray_decay_of_real Rhs>
+    requires nt::varray_decay_of_almost_same_type<Lhs, Rhs>
+    auto local_resolution(Lhs&& lhs, Rhs&& rhs, const LocalResolutionOptions& options) {
+        using value_t = nt::mutable_value_type_t<Lhs>;
+        auto resolution = Array<value_t>(local_resolution_shape(lhs.shape(), options.step), lhs.options());
+        local_resolution(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs), resolution, options);
+        return resolution;
+    }
+}
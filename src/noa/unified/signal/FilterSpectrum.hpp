@@ -63,11 +63,13 @@ namespace noa::signal::guts {
             const shape_nd_type& shape,
             const filter_type& filter,
             coord2_type fftfreq_range,
-            bool fftfreq_endpoint
+            bool fftfreq_endpoint,
+            real_type input_scale = 1
         ) :
             m_input(input),
             m_output(output),
             m_fftfreq_start(fftfreq_range[0]),
+            m_input_scale(input_scale),
             m_shape(shape.template pop_back<REMAP.is_hx2hx()>()),
             m_filter(std::move(filter))
         {
@@ -99,7 +101,7 @@ namespace noa::signal::guts {
             if (m_input) {
                 output = cast_or_abs_squared<output_value_type>(
                     static_cast<input_result_type>(m_input(batch, indices...)) *
-                    static_cast<filter_result_type>(filter));
+                    (static_cast<filter_result_type>(filter) * m_input_scale));
             } else {
                 output = cast_or_abs_squared<output_value_type>(filter);
             }
@@ -110,6 +112,7 @@ namespace noa::signal::guts {
         output_type m_output;
         coord_nd_type m_fftfreq_step;
         coord_type m_fftfreq_start;
+        real_type m_input_scale;
         shape_type m_shape;
         filter_type m_filter;
     };
@@ -153,6 +156,10 @@ namespace noa::signal {
 
         /// Whether the frequency_range's end should be included in the range.
         bool fftfreq_endpoint{true};
+
+        /// Factor multiplying the input, e.g. the normalization factor of the transform that computed the input
+        /// spectrum (see noa::fft::normalization_factor). Ignored if the input is empty.
+        f64 input_scale{1};
     };
 
     /// Filters a nd spectrum(s).
@@ -193,7 +200,8 @@ namespace noa::signal {
         using op_t = guts::FilterSpectrum<
             N, REMAP, i64, coord_t, decltype(input_accessor), decltype(output_accessor), std::decay_t<Filter>>;
         auto op = op_t(input_accessor, output_accessor, shape.filter_nd<N>().pop_front(), filter,
-                       options.fftfreq_range.as<coord_t>(), options.fftfreq_endpoint);
+                       options.fftfreq_range.as<coord_t>(), options.fftfreq_endpoint,
+                       static_cast<typename op_t::real_type>(options.input_scale));
 
         iwise(output.shape().template filter_nd<N>(), output.device(), op,
               std::forward<Input>(input), std::forward<Output>(output));
@@ -131,15 +131,141 @@ namespace noa::signal::guts {
         coord_type m_cutoff_fftfreq_sqd;
     };
 
+    /// 2d or 3d iwise operator to phase shift the rows of 2d or 3d array(s).
+    /// Instead of computing the phase shift of every element, the phase shift is computed at the start of the row
+    /// and is then updated along the row by multiplying it with the (constant) phase shift of one frequency step.
+    /// The recurrence is re-anchored every ANCHOR_STRIDE elements, and wherever the frequencies are not
+    /// consecutive (e.g. the wrap-around of non-centered full FFTs), which bounds the accumulated error.
+    /// If the input is broadcast across batches (its batch stride is zero), every row of the input is shifted
+    /// by a chunk of n_shifts_per_call consecutive shifts in the same call, so that the input is read fewer times.
+    template<Remap REMAP, size_t N,
+             nt::sinteger Index,
+             nt::batched_parameter Shift,
+             nt::readable_nd_optional<N + 1> Input,
+             nt::writable_nd<N + 1> Output>
+    requires (N == 2 or N == 3)
+    class PhaseShiftRecurrence {
+    public:
+        static constexpr bool IS_SRC_CENTERED = REMAP.is_xc2xx();
+        static constexpr bool IS_RFFT = REMAP.is_hx2hx();
+        static_assert(REMAP.is_hx2hx() or REMAP.is_fx2fx());
+
+        using index_type = Index;
+        using shape_nd_type = Shape<index_type, N>;
+        using shape_type = Shape<index_type, N - IS_RFFT>;
+
+        using shift_parameter_type = Shift;
+        using vec_nd_type = nt::value_type_t<shift_parameter_type>;
+        using coord_type = nt::value_type_t<vec_nd_type>;
+        static_assert(nt::vec_real_size<vec_nd_type, N>);
+
+        using input_type = Input;
+        using output_type = Output;
+        using input_value_type = nt::mutable_value_type_t<input_type>;
+        using input_real_type = nt::value_type_t<input_value_type>;
+        using output_value_type = nt::value_type_t<output_type>;
+        static_assert(nt::complex<output_value_type, input_value_type>);
+
+        static constexpr index_type ANCHOR_STRIDE = 32;
+
+    public:
+        constexpr PhaseShiftRecurrence(
+            const input_type& input,
+            const output_type& output,
+            const shape_nd_type& shape,
+            const shift_parameter_type& shift,
+            coord_type cutoff,
+            index_type n_batches = 1,
+            index_type n_shifts_per_call = 1
+        ) :
+            m_input(input), m_output(output),
+            m_norm(coord_type{1} / vec_nd_type::from_vec(shape.vec)),
+            m_shape(shape.template pop_back<IS_RFFT>()),
+            m_shift(shift),
+            m_cutoff_fftfreq_sqd(cutoff * cutoff),
+            m_width(IS_RFFT ? shape[N - 1] / 2 + 1 : shape[N - 1]),
+            m_n_batches(n_batches),
+            m_n_shifts_per_call(n_shifts_per_call) {}
+
+        template<nt::same_as<index_type>... I> requires (sizeof...(I) == N - 1)
+        constexpr void operator()(index_type batch, I... row) const {
+            const index_type start = batch * m_n_shifts_per_call;
+            const index_type end = min(start + m_n_shifts_per_call, m_n_batches);
+            for (index_type i = start; i < end; ++i)
+                shift_row_(batch, i, row...);
+        }
+
+    private:
+        template<typename... I>
+        constexpr void shift_row_(index_type input_batch, index_type output_batch, I... row) const {
+            const auto& shift = m_shift[output_batch];
+
+            // The frequencies and output indices of the row are the same for every element of the row.
+            const auto row_frequency = noa::fft::index2frequency<IS_SRC_CENTERED, IS_RFFT>(Vec{row..., index_type{}}, m_shape);
+            const auto row_output_indices = noa::fft::remap_indices<REMAP>(Vec{row..., index_type{}}, m_shape);
+
+            // Phase shift of one frequency step along the width.
+            input_value_type step;
+            const auto step_factor = static_cast<input_real_type>(
+                -2 * Constant<coord_type>::PI * shift[N - 1] * m_norm[N - 1]);
+            sincos(step_factor, &step.imag, &step.real);
+
+            input_value_type phase_shift;
+            index_type anchor{};
+            index_type previous_frequency{};
+            for (index_type x{}; x < m_width; ++x) {
+                auto frequency = row_frequency;
+                auto output_indices = row_output_indices;
+                if constexpr (IS_RFFT) {
+                    frequency[N - 1] = x; // if width of rfft, frequency == index
+                    output_indices[N - 1] = x;
+                } else {
+                    frequency[N - 1] = noa::fft::index2frequency<IS_SRC_CENTERED>(x, m_width);
+                    output_indices[N - 1] = noa::fft::remap_index<REMAP>(x, m_width);
+                }
+                const auto fftfreq = vec_nd_type::from_vec(frequency) * m_norm;
+
+                if (x == 0 or x - anchor >= ANCHOR_STRIDE or frequency[N - 1] != previous_frequency + 1) {
+                    phase_shift = noa::fft::phase_shift<input_value_type>(shift, fftfreq);
+                    anchor = x;
+                } else {
+                    phase_shift *= step;
+                }
+                previous_frequency = frequency[N - 1];
+
+                const auto phase_shift_or_one =
+                    dot(fftfreq, fftfreq) <= m_cutoff_fftfreq_sqd ? phase_shift : input_value_type{1, 0};
+
+                auto& output = m_output(output_indices.push_front(output_batch));
+                if (m_input)
+                    output = static_cast<output_value_type>(m_input(input_batch, row..., x) * phase_shift_or_one);
+                else
+                    output = static_cast<output_value_type>(phase_shift_or_one);
+            }
+        }
+
+    private:
+        input_type m_input;
+        output_type m_output;
+        vec_nd_type m_norm;
+        shape_type m_shape;
+        shift_parameter_type m_shift;
+        coord_type m_cutoff_fftfreq_sqd;
+        index_type m_width;
+        index_type m_n_batches;
+        index_type m_n_shifts_per_call;
+    };
+
     template<Remap REMAP, typename Input, typename Output, typename Shift>
     void check_phase_shift_parameters(
         const Input& input, const Output& output,
         const Shape4<i64>& shape, const Shift& shifts
     ) {
         check(not output.is_empty(), "Empty array detected");
-        check(vall(Equal{}, output.shape(), shape.rfft()),
-              "Given the logical shape {}, the expected non-redundant shape should be {}, but got {}",
-              shape, shape.rfft(), output.shape());
+        const auto expected_shape = REMAP.is_hx2hx() ? shape.rfft() : shape;
+        check(vall(Equal{}, output.shape(), expected_shape),
+              "Given the logical shape {} and remap {}, the expected output shape should be {}, but got {}",
+              shape, REMAP, expected_shape, output.shape());
 
         if (not input.is_empty()) {
             check(output.device() == input.device(),
@@ -174,6 +300,60 @@ namespace noa::signal::guts {
         }
     }
 
+    template<Remap REMAP, size_t N, typename Shift,
+             typename InputAccessor, typename OutputAccessor, typename Input, typename Output, typename... Ts>
+    void launch_phase_shift(
+        const Shape<i64, N + 1>& iwise_shape,
+        const InputAccessor& input_accessor,
+        const OutputAccessor& output_accessor,
+        const Shape<i64, N>& shape,
+        const Shift& shift,
+        nt::value_type_twice_t<Shift> cutoff,
+        Input&& input, Output&& output, Ts&&... attachments
+    ) {
+        const Device device = output.device();
+        if (device.is_cpu()) {
+            // The CPU computes the phase shifts with a recurrence along the rows, so one call per row.
+            // If the input is broadcast, each input row is shifted by a chunk of shifts in the same call.
+            // The shifts are chunked, as opposed to all processed in the same call, so that the number
+            // of threads still scales with the number of shifts.
+            constexpr i64 N_SHIFTS_PER_CALL = 8;
+            constexpr i64 N_ELEMENTS_PER_THREAD = 256;
+
+            const i64 n_batches = iwise_shape[0];
+            const bool is_broadcast =
+                not input.is_empty() and n_batches > 1 and input.get() != output.get() and
+                (input.shape()[0] == 1 or input.strides()[0] == 0);
+
+            using op_t = PhaseShiftRecurrence<REMAP, N, i64, Shift, InputAccessor, OutputAccessor>;
+            if (is_broadcast) {
+                constexpr auto OPTIONS = IwiseOptions{
+                    .generate_gpu = false,
+                    .cpu_n_elements_per_thread = N_ELEMENTS_PER_THREAD / N_SHIFTS_PER_CALL,
+                };
+                auto op = op_t(input_accessor, output_accessor, shape, shift, cutoff, n_batches, N_SHIFTS_PER_CALL);
+                iwise<OPTIONS>(
+                    iwise_shape.pop_back().template set<0>(divide_up(n_batches, N_SHIFTS_PER_CALL)), device, op,
+                    std::forward<Input>(input), std::forward<Output>(output), std::forward<Ts>(attachments)...);
+            } else {
+                constexpr auto OPTIONS = IwiseOptions{
+                    .generate_gpu = false,
+                    .cpu_n_elements_per_thread = N_ELEMENTS_PER_THREAD,
+                };
+                auto op = op_t(input_accessor, output_accessor, shape, shift, cutoff, n_batches);
+                iwise<OPTIONS>(
+                    iwise_shape.pop_back(), device, op,
+                    std::forward<Input>(input), std::forward<Output>(output), std::forward<Ts>(attachments)...);
+            }
+        } else {
+            using op_t = PhaseShift<REMAP, N, i64, Shift, InputAccessor, OutputAccessor>;
+            auto op = op_t(input_accessor, output_accessor, shape, shift, cutoff);
+            iwise<IwiseOptions{.generate_cpu = false}>(
+                iwise_shape, device, op,
+                std::forward<Input>(input), std::forward<Output>(output), std::forward<Ts>(attachments)...);
+        }
+    }
+
     template<typename T>
     auto extract_shift(const T& shift) {
         if constexpr (nt::vec<T>) {
@@ -186,10 +366,10 @@ namespace noa::signal::guts {
 }
 
 namespace noa::signal {
-    /// Phase-shifts 2d rfft(s).
-    /// \tparam REMAP           Remap operation. Should be H2H, H2HC, HC2HC or HC2H.
-    /// \param[in] input        2d rfft to phase-shift. If empty, the phase-shifts are saved in \p output.
-    /// \param[out] output      Phase-shifted 2d rfft.
+    /// Phase-shifts 2d (r)fft(s).
+    /// \tparam REMAP           Remap operation. Should be H2H, H2HC, HC2HC, HC2H, F2F, F2FC, FC2FC or FC2F.
+    /// \param[in] input        2d (r)fft to phase-shift. If empty, the phase-shifts are saved in \p output.
+    /// \param[out] output      Phase-shifted 2d (r)fft.
     /// \param shape            BDHW logical shape.
     /// \param[in] shifts       HW 2d phase-shift to apply.
     ///                         A single value or a contiguous vector with one shift per batch.
@@ -197,6 +377,9 @@ namespace noa::signal {
     ///                         Values are usually from 0 (DC) to 0.5 (Nyquist).
     ///                         Frequencies higher than this value are not phase-shifted.
     /// \note \p input and \p output can be equal as long as the layout is unchanged.
+    /// \note On the CPU, the phase-shifts are computed incrementally along the rows, which saves most of the
+    ///       trigonometric evaluations. Translational searches should pass a single input with one shift per
+    ///       output batch, in which case each input row is read once and shifted by every shift.
     template<Remap REMAP,
              nt::writable_varray_decay_of_complex Output,
              nt::readable_varray_decay_of_complex Input = View<nt::const_value_type_t<Output>>,
@@ -238,20 +421,16 @@ namespace noa::signal {
         }
 
         using shift_t = decltype(guts::extract_shift(shifts));
-        using op_t = guts::PhaseShift<REMAP, 2, i64, shift_t, input_accessor_t, output_accessor_t>;
-        auto op = op_t(input_accessor, output_accessor,
-                       shape.filter(2, 3), guts::extract_shift(shifts),
-                       static_cast<coord_t>(fftfreq_cutoff));
-        iwise(iwise_shape, output.device(), op,
-              std::forward<Input>(input),
-              std::forward<Output>(output),
-              std::forward<Shift>(shifts));
+        guts::launch_phase_shift<REMAP, 2, shift_t>(
+            iwise_shape, input_accessor, output_accessor, shape.filter(2, 3),
+            guts::extract_shift(shifts), static_cast<coord_t>(fftfreq_cutoff),
+            std::forward<Input>(input), std::forward<Output>(output), std::forward<Shift>(shifts));
     }
 
-    /// Phase-shifts 3d rfft(s).
-    /// \tparam REMAP           Remap operation. Should be H2H, H2HC, HC2HC or HC2H.
-    /// \param[in] input        3d rfft to phase-shift. If empty, the phase-shifts are saved in \p output.
-    /// \param[out] output      Phase-shifted 3d rfft.
+    /// Phase-shifts 3d (r)fft(s).
+    /// \tparam REMAP           Remap operation. Should be H2H, H2HC, HC2HC, HC2H, F2F, F2FC, FC2FC or FC2F.
+    /// \param[in] input        3d (r)fft to phase-shift. If empty, the phase-shifts are saved in \p output.
+    /// \param[out] output      Phase-shifted 3d (r)fft.
     /// \param shape            BDHW logical shape.
     /// \param[in] shifts       HW 3d phase-shift to apply.
     ///                         A single value or a contiguous vector with one shift per batch.
@@ -259,6 +438,9 @@ namespace noa::signal {
     ///                         Values are usually from 0 (DC) to 0.5 (Nyquist).
     ///                         Frequencies higher than this value are not phase-shifted.
     /// \note \p input and \p output can be equal as long as the layout is unchanged.
+    /// \note On the CPU, the phase-shifts are computed incrementally along the rows, which saves most of the
+    ///       trigonometric evaluations. Translational searches should pass a single input with one shift per
+    ///       output batch, in which case each input row is read once and shifted by every shift.
     template<Remap REMAP,
              nt::writable_varray_decay_of_complex Output,
              nt::readable_varray_decay_of_complex Input = View<nt::const_value_type_t<Output>>,
@@ -300,13 +482,9 @@ namespace noa::signal {
         }
 
         using shift_t = decltype(guts::extract_shift(shifts));
-        using op_t = guts::PhaseShift<REMAP, 3, i64, shift_t, input_accessor_t, output_accessor_t>;
-        auto op = op_t(input_accessor, output_accessor,
-                       shape.filter(1, 2, 3), guts::extract_shift(shifts),
-                       static_cast<coord_t>(fftfreq_cutoff));
-        iwise(iwise_shape, output.device(), op,
-              std::forward<Input>(input),
-              std::forward<Output>(output),
-              std::forward<Shift>(shifts));
+        guts::launch_phase_shift<REMAP, 3, shift_t>(
+            iwise_shape, input_accessor, output_accessor, shape.filter(1, 2, 3),
+            guts::extract_shift(shifts), static_cast<coord_t>(fftfreq_cutoff),
+            std::forward<Input>(input), std::forward<Output>(output), std::forward<Shift>(shifts));
     }
 }
@@ -1,5 +1,7 @@
 #include <noa/core/types/Half.hpp>
 #include <noa/core/math/Comparison.hpp>
+
+#include <bit>
 #include <catch2/catch.hpp>
 
 
@@ -49,3 +51,58 @@ TEST_CASE("core::Half", "[noa][core]") {
     f16 hc(2.5);
     REQUIRE(fmt::format("{:.2}", hc) == "2.5");
 }
+
+TEST_CASE("core::Half, scalar conversions", "[noa][core]") {
+    using namespace ::noa::types;
+
+    // With NOA_ENABLE_F16C, the f16<->f32 conversions use the hardware instructions.
+    // Either way, they should match the software conversions.
+    for (u32 i{}; i < 65536; ++i) {
+        const auto half = f16::from_bits(static_cast<u16>(i));
+        const auto expected = half_float::half_cast<f32>(half.native());
+        if (std::isnan(expected))
+            REQUIRE(std::isnan(static_cast<f32>(half)));
+        else
+            REQUIRE(static_cast<f32>(half) == expected);
+    }
+
+    // Rounding to nearest even, denormals and overflows.
+    for (i32 i{}; i < 20001; ++i) {
+        const auto x = static_cast<f32>(i - 10000);
+        for (f32 value: {x * 7.37f, x * 1.3e-8f, x / 3.f, x * 0.125f + 0.0625f}) {
+            const auto expected = half_float::half_cast<half_float::half>(value);
+            REQUIRE(std::bit_cast<u16>(f16(value)) == std::bit_cast<u16>(expected));
+        }
+    }
+}
+
+TEST_CASE("core::half2float, float2half", "[noa][core]") {
+    using namespace ::noa::types;
+
+    // Every f16 value, with an odd number of elements to exercise the remaining elements.
+    std::vector<f16> halves(65535);
+    for (size_t i{}; i < halves.size(); ++i)
+        halves[i] = f16::from_bits(static_cast<u16>(i));
+    std::vector<f32> floats(halves.size());
+    noa::half2float(halves.data(), floats.data(), std::ssize(halves));
+    for (size_t i{}; i < halves.size(); ++i) {
+        const auto expected = static_cast<f32>(halves[i]);
+        if (std::isnan(expected))
+            REQUIRE(std::isnan(floats[i]));
+        else
+            REQUIRE(floats[i] == expected);
+    }
+
+    // Rounding, denormals and overflows.
+    std::vector<f32> values(1001);
+    for (size_t i{}; i < values.size(); ++i) {
+        const auto x = static_cast<f32>(i) - 500.f;
+        values[i] = i % 3 == 0 ? x * 143.37f : i % 3 == 1 ? x * 1.3e-7f : x / 7.f;
+    }
+    values[0] = std::numeric_limits<f32>::infinity();
+    values[1] = -std::numeric_limits<f32>::infinity();
+    std::vector<f16> results(values.size());
+    noa::float2half(values.data(), results.data(), std::ssize(values));
+    for (size_t i{}; i < values.size(); ++i)
+        REQUIRE(results[i] == static_cast<f16>(values[i]));
+}
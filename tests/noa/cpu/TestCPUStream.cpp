@@ -1,3 +1,4 @@
+#include <noa/cpu/Event.hpp>
 #include <noa/cpu/Stream.hpp>
 #include <catch2/catch.hpp>
 
@@ -125,4 +126,127 @@ TEST_CASE("cpu::Stream", "[noa][cpu]") {
         async_stream.synchronize();
         REQUIRE((t1.count[0] == 0 and t1.count[1] == 3));
     }
+
+    SECTION("graph capture") {
+        for (auto mode: {Stream::SYNC, Stream::ASYNC}) {
+            Stream stream(mode, 1);
+            int count{};
+            std::vector<int> values;
+            flag = 0;
+
+            stream.begin_capture();
+            REQUIRE(stream.is_capturing());
+            REQUIRE(stream.is_async());
+            stream.enqueue([&count](int v) { count += v; }, 2);
+            stream.enqueue([&values](std::vector<int>&& v) { values = std::move(v); }, std::vector{1, 2, 3});
+            stream.enqueue(task3, std::ref(flag), 7);
+            REQUIRE_THROWS(stream.synchronize());
+            REQUIRE_THROWS(stream.begin_capture());
+            const auto graph = stream.end_capture();
+            REQUIRE_FALSE(stream.is_capturing());
+            REQUIRE(stream.is_sync() == (mode == Stream::SYNC));
+            REQUIRE(graph.n_tasks() == 3);
+            REQUIRE((count == 0 and values.empty() and flag == 0));
+
+            for (int i{}; i < 3; ++i) {
+                values.clear();
+                flag = 0;
+                stream.launch(graph);
+                stream.synchronize();
+                REQUIRE(count == 2 * (i + 1));
+                REQUIRE(values == std::vector{1, 2, 3}); // the arguments are not moved from
+                REQUIRE(flag == 7);
+            }
+
+            // Graphs can be captured in graphs.
+            stream.begin_capture();
+            stream.launch(graph);
+            stream.launch(graph);
+            const auto nested_graph = stream.end_capture();
+            REQUIRE(nested_graph.n_tasks() == 2);
+            count = 0;
+            stream.launch(nested_graph);
+            stream.synchronize();
+            REQUIRE(count == 4);
+        }
+    }
+
+    SECTION("wait on event") {
+        using noa::cpu::Event;
+        Stream producer(Stream::ASYNC, 1);
+        Stream consumer(Stream::ASYNC, 1);
+
+        Event event;
+        event.synchronize(); // not recorded, nothing to wait for
+        consumer.wait(event);
+
+        int value{};
+        producer.enqueue(task5);
+        event.record(producer);
+        REQUIRE_FALSE(event.is_busy());
+
+        const auto start = std::chrono::steady_clock::now();
+        consumer.wait(event);
+        consumer.enqueue([&value, &flag] { value = flag; });
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        REQUIRE(elapsed < std::chrono::milliseconds(100)); // the host isn't blocked
+
+        consumer.synchronize();
+        REQUIRE(value == 5);
+        REQUIRE(event.is_busy());
+
+        // The event is completed even if the producer failed.
+        producer.enqueue(task4);
+        event.record(producer);
+        consumer.wait(event);
+        consumer.enqueue([&value] { value = 6; });
+        consumer.synchronize();
+        REQUIRE(value == 6);
+        REQUIRE_THROWS_AS(producer.synchronize(), std::exception);
+
+        // Synchronous streams wait on the current thread.
+        Stream sync_stream(Stream::SYNC, 1);
+        producer.enqueue(task5);
+        event.record(producer);
+        flag = 0;
+        sync_stream.wait(event);
+        REQUIRE(flag == 5);
+
+        // The last record completes before the previous one, which shouldn't move the event backward.
+        Stream slow(Stream::ASYNC, 1);
+        slow.enqueue(task5);
+        event.record(slow);
+        event.record(consumer);
+        event.synchronize();
+        slow.synchronize();
+        REQUIRE(event.is_busy());
+        event.synchronize();
+
+        // Records captured in a graph are only made when the graph is launched.
+        Stream capturing(Stream::ASYNC, 1);
+        capturing.begin_capture();
+        capturing.enqueue(task5);
+        event.record(capturing);
+        const auto graph = capturing.end_capture();
+        REQUIRE(event.is_busy());
+        event.synchronize(); // doesn't wait for the graph
+
+        flag = 0;
+        for (int i{}; i < 2; ++i) {
+            capturing.launch(graph);
+            capturing.synchronize();
+            REQUIRE(event.is_busy());
+            REQUIRE(flag == 5);
+        }
+
+        // A record made before the graph is launched completes after the graph's record.
+        slow.enqueue(task5);
+        event.record(slow);
+        capturing.launch(graph);
+        capturing.synchronize();
+        REQUIRE(event.is_busy());
+        slow.synchronize();
+        REQUIRE(event.is_busy());
+        event.synchronize();
+    }
 }
@@ -15,6 +15,7 @@ set(TEST_UNIFIED_SOURCES
     noa/unified/TestUnifiedRandom.cpp
     noa/unified/TestUnifiedImageFile.cpp
     noa/unified/TestUnifiedSort.cpp
+    noa/unified/TestUnifiedTrace.cpp
 
     noa/unified/math/TestUnifiedBlas.cpp
     noa/unified/math/TestUnifiedComplex.cpp
@@ -27,6 +28,7 @@ set(TEST_UNIFIED_SOURCES
     noa/unified/memory/TestUnifiedSubregion.cpp
 
     noa/unified/fft/TestUnifiedFFT.cpp
+    noa/unified/fft/TestUnifiedPyramid.cpp
     noa/unified/fft/TestUnifiedRemap.cpp
     noa/unified/fft/TestUnifiedResize.cpp
 
@@ -35,6 +37,7 @@ set(TEST_UNIFIED_SOURCES
     noa/unified/signal/fft/TestUnifiedBandpass.cpp
     noa/unified/signal/fft/TestUnifiedPhaseShift.cpp
     noa/unified/signal/fft/TestUnifiedStandardize.cpp
+    noa/unified/signal/fft/TestUnifiedFSC.cpp
     noa/unified/signal/TestUnifiedMedian.cpp
     noa/unified/signal/TestUnifiedConvolve.cpp
 
@@ -65,3 +65,81 @@ TEST_CASE("core::random_generator(), random_value()") {
         REQUIRE((value >= -10. and value <= 10.));
     }
 }
+
+TEST_CASE("core::CounterBasedRandomBitsGenerator") {
+    // Known-answer tests of Philox4x32-10, from the Random123 library.
+    u32 output[4];
+    noa::CounterBasedRandomBitsGenerator::philox({0, 0}, {0, 0, 0, 0}, output);
+    REQUIRE((output[0] == 0x6627e8d5 and output[1] == 0xe169c58d and
+             output[2] == 0xbc57ac4c and output[3] == 0x9b00dbd8));
+
+    noa::CounterBasedRandomBitsGenerator::philox(
+        {0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, output);
+    REQUIRE((output[0] == 0x408f276d and output[1] == 0x41c83b0e and
+             output[2] == 0xa20bc7c6 and output[3] == 0x6d5451fd));
+
+    noa::CounterBasedRandomBitsGenerator::philox(
+        {0xa4093822, 0x299f31d0}, {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, output);
+    REQUIRE((output[0] == 0xd16cfe09 and output[1] == 0x94fdcceb and
+             output[2] == 0x5001e420 and output[3] == 0x24126ea1));
+}
+
+TEMPLATE_TEST_CASE("unified::randomize(), counter-based", "[noa][unified]", f32, f64, c32) {
+    using real_t = noa::traits::value_type_t<TestType>;
+    const auto shape = Shape4<i64>{2, 40, 128, 130};
+    const auto options = noa::RandomizeOptions{.seed = 1234, .counter_based = true};
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    // Reference: single-threaded, on the CPU.
+    Array<TestType> expected;
+    {
+        auto stream = StreamGuard(Device{}, Stream::DEFAULT);
+        stream.set_thread_limit(1);
+        expected = noa::random<TestType>(noa::Normal<real_t>{5, 2}, shape, {}, options);
+    }
+
+    for (auto& device: devices) {
+        INFO(device);
+        auto stream = StreamGuard(device, Stream::DEFAULT);
+        stream.set_thread_limit(4);
+        const auto array_options = ArrayOption(device, "managed");
+
+        // Same values, regardless of the number of threads, the device and the layout.
+        const auto contiguous = noa::random<TestType>(noa::Normal<real_t>{5, 2}, shape, array_options, options);
+        REQUIRE(test::allclose_abs(contiguous, expected, 1e-5));
+
+        auto padded_shape = shape;
+        padded_shape[3] += 10;
+        const auto padded = Array<TestType>(padded_shape, array_options)
+            .subregion(noa::indexing::Ellipsis{}, noa::indexing::Slice{0, shape[3]});
+        noa::randomize(noa::Normal<real_t>{5, 2}, padded, options);
+        REQUIRE(test::allclose_abs(padded, expected, 1e-5));
+
+        // Different seeds give different values.
+        const auto other = noa::random<TestType>(
+            noa::Normal<real_t>{5, 2}, shape, array_options, {.seed = 1235, .counter_based = true});
+        REQUIRE_FALSE(test::allclose_abs(other, expected, 1e-5));
+    }
+
+    // Statistics.
+    if constexpr (noa::traits::real<TestType>) {
+        const auto uniform = noa::random(noa::Uniform<TestType>{-10, 10}, shape, {}, options);
+        REQUIRE(noa::min(uniform) >= TestType{-10});
+        REQUIRE(noa::max(uniform) <= TestType{10});
+        REQUIRE_THAT(noa::mean(uniform), Catch::WithinAbs(0, 0.05));
+
+        REQUIRE_THAT(noa::mean(expected), Catch::WithinAbs(5, 0.01));
+        REQUIRE_THAT(noa::stddev(expected), Catch::WithinAbs(2, 0.01));
+
+        for (f64 mean: {4., 50.}) {
+            INFO("mean=" << mean);
+            const auto poisson = noa::random<TestType>(noa::Poisson<i32>{mean}, shape, {}, options);
+            REQUIRE(noa::min(poisson) >= 0);
+            REQUIRE_THAT(noa::mean(poisson), Catch::WithinRel(mean, 0.005));
+            REQUIRE_THAT(noa::variance(poisson), Catch::WithinRel(mean, 0.01));
+        }
+    }
+}
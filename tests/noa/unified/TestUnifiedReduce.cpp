@@ -2,6 +2,7 @@
 #include <noa/unified/Reduce.hpp>
 #include <noa/unified/Factory.hpp>
 #include <noa/unified/IO.hpp>
+#include <noa/unified/Random.hpp>
 #include <catch2/catch.hpp>
 
 #include "Utils.hpp"
@@ -202,3 +203,37 @@ TEMPLATE_TEST_CASE("unified::reduce - cpu vs gpu", "[noa][unified]", i64, f32, f
     REQUIRE(test::allclose_abs_safe(&cpu_sum, &gpu_sum, 1, eps));
     REQUIRE(test::allclose_abs_safe(&cpu_mean, &gpu_mean, 1, eps));
 }
+
+TEMPLATE_TEST_CASE("unified::reduce - quantile/median of const arrays", "[noa][unified]", i32, f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto shape = test::random_shape_batched(3);
+    INFO(shape);
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto array = noa::random<TestType>(noa::Uniform<TestType>{-50, 50}, shape, options);
+        const auto original = array.copy();
+        const View<const TestType> contiguous = array.view();
+        const View<const TestType> strided = array.view().subregion(
+            noa::indexing::FullExtent{}, noa::indexing::FullExtent{}, noa::indexing::FullExtent{},
+            noa::indexing::Slice{0, shape[3], 2});
+
+        for (const auto& input: {contiguous, strided}) {
+            // The const arrays are copied, and then compared with a mutable copy that is overwritten.
+            const auto median = noa::median(input);
+            const auto quantile = noa::quantile(input, 0.3);
+            REQUIRE(median == noa::median(input.copy(), true));
+            REQUIRE(quantile == noa::quantile(input.copy(), 0.3, true));
+            REQUIRE(test::allclose_abs(array, original, 0));
+
+            REQUIRE_THROWS((void) noa::median(input, true));
+            REQUIRE_THROWS((void) noa::quantile(input, 0.3, true));
+        }
+    }
+}
@@ -272,3 +272,90 @@ TEST_CASE("unified::reduce - argmax/argmin()", "[noa][unified]") {
         }
     }
 }
+
+namespace {
+    // Reference: gather the elements of each reduction, sort them and interpolate (numpy's "linear" method).
+    template<typename T>
+    auto quantile_reference(const View<const T>& input, const Shape4<i64>& output_shape, f64 quantile) -> Array<T> {
+        Array<T> output(output_shape);
+        const auto& input_shape = input.shape();
+        std::vector<T> values;
+        for (i64 i{}; i < output_shape[0]; ++i) {
+            for (i64 j{}; j < output_shape[1]; ++j) {
+                for (i64 k{}; k < output_shape[2]; ++k) {
+                    for (i64 l{}; l < output_shape[3]; ++l) {
+                        values.clear();
+                        for (i64 m{}; m < (output_shape[0] == 1 ? input_shape[0] : 1); ++m)
+                            for (i64 n{}; n < (output_shape[1] == 1 ? input_shape[1] : 1); ++n)
+                                for (i64 o{}; o < (output_shape[2] == 1 ? input_shape[2] : 1); ++o)
+                                    for (i64 p{}; p < (output_shape[3] == 1 ? input_shape[3] : 1); ++p)
+                                        values.push_back(input(i + m, j + n, k + o, l + p));
+                        std::sort(values.begin(), values.end());
+
+                        const f64 position = quantile * static_cast<f64>(values.size() - 1);
+                        const auto rank = static_cast<size_t>(std::floor(position));
+                        const f64 weight = position - static_cast<f64>(rank);
+                        const auto lhs = static_cast<f64>(values[rank]);
+                        const auto rhs = static_cast<f64>(values[std::min(rank + 1, values.size() - 1)]);
+                        output(i, j, k, l) = weight == 0 ? values[rank] : static_cast<T>(lhs + (rhs - lhs) * weight);
+                    }
+                }
+            }
+        }
+        return output;
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::reduce - quantile/median along axes", "[noa][unified]", i16, i32, u64, f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto pad = GENERATE(true, false);
+    const auto n_threads = GENERATE(1, 4);
+    const auto shape = Shape4<i64>{5, 8, 20, 30};
+    const auto padded_shape = pad ? shape + Shape4<i64>{0, 0, 0, 5} : shape;
+    INFO("pad=" << pad << ", n_threads=" << n_threads);
+
+    Array<TestType> buffer(padded_shape);
+    // A small range for the integers, to have duplicates.
+    test::Randomizer<TestType> randomizer(noa::traits::uinteger<TestType> ? 0 : -50, 50);
+    test::randomize(buffer.get(), buffer.n_elements(), randomizer);
+    const auto input = buffer.subregion(noa::indexing::Ellipsis{}, noa::indexing::Slice{0, shape[3]});
+
+    const std::array axes_to_reduce{
+        ReduceAxes{.batch=true},
+        ReduceAxes{.width=true},
+        ReduceAxes{.depth=true, .height=true, .width=true},
+        ReduceAxes{.batch=true, .height=true},
+        ReduceAxes{.batch=true, .depth=true, .height=true, .width=true},
+    };
+
+    for (auto& device: devices) {
+        auto stream = StreamGuard(device, Stream::DEFAULT);
+        stream.set_thread_limit(n_threads);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        const auto input_device = device.is_cpu() ? input : input.to(options);
+
+        for (const auto& axes: axes_to_reduce) {
+            const auto output_shape = noa::guts::axes_to_output_shape(input, axes);
+            INFO("device=" << device << ", output_shape=" << output_shape);
+
+            for (f64 quantile: {0., 0.1, 0.5, 0.95, 1.}) {
+                INFO("quantile=" << quantile);
+                const auto expected = quantile_reference<TestType>(input.view(), output_shape, quantile);
+                const auto result = noa::quantile(input_device, quantile, axes);
+                REQUIRE(test::allclose_abs(expected, result, 1e-7));
+            }
+
+            const auto expected = quantile_reference<TestType>(input.view(), output_shape, 0.5);
+            const auto result = noa::like(expected.to(options));
+            noa::median(input_device, result);
+            REQUIRE(test::allclose_abs(expected, result, 1e-7));
+        }
+
+        // Reducing everything is equivalent to the array quantile.
+        const auto expected = quantile_reference<TestType>(input.view(), {1, 1, 1, 1}, 0.95);
+        REQUIRE_THAT(noa::quantile(input_device, 0.95), Catch::WithinAbs(static_cast<f64>(expected.first()), 1e-7));
+    }
+}
@@ -1,7 +1,10 @@
 #include <noa/unified/Array.hpp>
 #include <noa/unified/Sort.hpp>
 #include <noa/unified/IO.hpp>
+#include <noa/unified/Factory.hpp>
+#include <noa/unified/Random.hpp>
 #include <catch2/catch.hpp>
+#include <numeric>
 
 #include "Utils.hpp"
 #include "Assets.h"
@@ -41,3 +44,121 @@ TEST_CASE("unified::sort", "[assets][noa][unified]") {
         }
     }
 }
+
+namespace {
+    // Reference: sort each line along the axis using std::stable_sort.
+    template<typename T>
+    auto sort_reference(const Array<T>& input, i32 axis, bool ascending) -> Pair<Array<T>, Array<i64>> {
+        const auto shape = input.shape();
+        auto sorted = input.to_cpu().copy();
+        auto indices = Array<i64>(shape);
+        const auto sorted_span = sorted.span();
+        const auto indices_span = indices.span();
+
+        auto lines_shape = shape;
+        lines_shape[axis] = 1;
+        std::vector<i64> order(static_cast<size_t>(shape[axis]));
+        std::vector<T> line(static_cast<size_t>(shape[axis]));
+        for (i64 i{}; i < lines_shape[0]; ++i) {
+            for (i64 j{}; j < lines_shape[1]; ++j) {
+                for (i64 k{}; k < lines_shape[2]; ++k) {
+                    for (i64 l{}; l < lines_shape[3]; ++l) {
+                        auto index = Vec4<i64>{i, j, k, l};
+                        for (i64 m{}; m < shape[axis]; ++m) {
+                            index[axis] = m;
+                            line[static_cast<size_t>(m)] = sorted_span(index);
+                        }
+                        std::iota(order.begin(), order.end(), i64{});
+                        std::stable_sort(order.begin(), order.end(), [&](i64 a, i64 b) {
+                            const auto& lhs = line[static_cast<size_t>(a)];
+                            const auto& rhs = line[static_cast<size_t>(b)];
+                            return ascending ? lhs < rhs : rhs < lhs;
+                        });
+                        for (i64 m{}; m < shape[axis]; ++m) {
+                            index[axis] = m;
+                            sorted_span(index) = line[static_cast<size_t>(order[static_cast<size_t>(m)])];
+                            indices_span(index) = order[static_cast<size_t>(m)];
+                        }
+                    }
+                }
+            }
+        }
+        return {sorted, indices};
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::sort, argsort, sort_by_key", "[noa][unified]", i16, u32, i64, f16, f32, f64) {
+    const auto axis = GENERATE(0, 1, 2, 3);
+    const auto ascending = GENERATE(true, false);
+    const auto n_threads = GENERATE(1, 4);
+    INFO("axis=" << axis << ", ascending=" << ascending << ", n_threads=" << n_threads);
+
+    // The first shape has few but large lines, the second has many lines in the radix and comparison sort range.
+    auto input_shape = GENERATE(Shape4<i64>{1, 1, 2, 70'000}, Shape4<i64>{3, 40, 7, 700}, Shape4<i64>{3, 40, 7, 12});
+    std::swap(input_shape[axis], input_shape[3]);
+    INFO(input_shape);
+
+    auto stream = StreamGuard(Device{}, Stream::DEFAULT);
+    stream.set_thread_limit(n_threads);
+
+    // Use a small range to have many duplicates, which checks for stability.
+    // Negative values are also checked since they are transformed differently by the radix sort.
+    constexpr auto min = noa::traits::uinteger<TestType> ? 0 : -50;
+    // f16 isn't supported by the random distributions, so generate in f32 and cast.
+    using random_t = std::conditional_t<std::is_same_v<TestType, f16>, f32, TestType>;
+    const auto random = noa::random<random_t>(noa::Uniform<random_t>(min, min + 100), input_shape);
+    Array<TestType> input(input_shape);
+    noa::cast(random, input);
+    const auto [expected_sorted, expected_indices] = sort_reference(input, axis, ascending);
+
+    const auto sorted = input.copy();
+    noa::sort(sorted, {ascending, axis});
+    REQUIRE(test::allclose_abs(expected_sorted, sorted, 1e-7));
+
+    const auto indices = noa::argsort(input, {ascending, axis});
+    REQUIRE(test::allclose_abs(expected_indices, indices, 1e-7));
+
+    const auto keys = input.copy();
+    const auto values = noa::arange<f64>(input_shape);
+    noa::sort_by_key(keys, values, {ascending, axis});
+    REQUIRE(test::allclose_abs(expected_sorted, keys, 1e-7));
+
+    // The values are the original offsets, so they should match the offset of the sorted indices.
+    const auto indices_span = indices.span();
+    const auto values_span = values.span();
+    const auto strides = input_shape.strides();
+    bool is_valid{true};
+    for (i64 i{}; i < input_shape[0]; ++i) {
+        for (i64 j{}; j < input_shape[1]; ++j) {
+            for (i64 k{}; k < input_shape[2]; ++k) {
+                for (i64 l{}; l < input_shape[3]; ++l) {
+                    auto index = Vec4<i64>{i, j, k, l};
+                    index[axis] = indices_span(i, j, k, l);
+                    if (values_span(i, j, k, l) != static_cast<f64>(noa::indexing::offset_at(strides, index)))
+                        is_valid = false;
+                }
+            }
+        }
+    }
+    REQUIRE(is_valid);
+}
+
+TEST_CASE("unified::sort_by_key, strided", "[noa][unified]") {
+    auto stream = StreamGuard(Device{}, Stream::DEFAULT);
+    stream.set_thread_limit(2);
+
+    // Sort along the depth, with the keys and values being non-contiguous views.
+    const auto shape = Shape4<i64>{2, 600, 3, 5};
+    Array<f32> buffer = noa::random<f32>(noa::Uniform<f32>(-10, 10), Shape4<i64>{2, 600, 3, 10});
+    View<f32> keys = buffer.view().subregion(noa::indexing::Ellipsis{}, noa::indexing::Slice{0, 5});
+    Array<i64> values_buffer = noa::empty<i64>(shape.flip());
+    View<i64> values = values_buffer.view().permute({3, 2, 1, 0});
+    REQUIRE(noa::all(values.shape() == shape));
+
+    const auto [expected_sorted, expected_indices] = sort_reference(keys.to_cpu(), 1, true);
+    noa::argsort(keys, values, {.axis=1});
+    REQUIRE(test::allclose_abs(expected_indices, values, 1e-7));
+
+    noa::sort_by_key(keys, values, {.axis=1});
+    REQUIRE(test::allclose_abs(expected_sorted, keys, 1e-7));
+}
@@ -1,6 +1,11 @@
+#include <noa/unified/Event.hpp>
 #include <noa/unified/Stream.hpp>
+#include <noa/unified/Ewise.hpp>
+#include <noa/unified/Factory.hpp>
 #include <catch2/catch.hpp>
 
+#include "Utils.hpp"
+
 
 TEST_CASE("unified::Stream", "[noa][unified]") {
     using namespace ::noa::types;
@@ -75,3 +80,90 @@ TEST_CASE("unified::Stream", "[noa][unified]") {
         Session::set_thread_limit(old_limit);
     }
 }
+
+TEST_CASE("unified::Stream, graph capture", "[noa][unified]") {
+    using namespace ::noa::types;
+    const auto mode = GENERATE(Stream::DEFAULT, Stream::ASYNC);
+    auto stream = StreamGuard(Device{}, mode);
+
+    const auto shape = Shape4<i64>{2, 1, 64, 64};
+    const auto input = noa::empty<f32>(shape);
+    const auto output = noa::like(input);
+
+    // Capture output = (input + 1) * input, using a temporary buffer allocated during the capture.
+    stream.begin_capture();
+    {
+        const auto tmp = noa::like(input);
+        noa::ewise(noa::wrap(input, 1.f), tmp, noa::Plus{});
+        noa::ewise(noa::wrap(tmp, input), output, noa::Multiply{});
+    }
+    const auto graph = stream.end_capture();
+    REQUIRE(graph.n_tasks() == 2);
+
+    const auto expected = noa::like(input);
+    for (f32 value: {1.f, 2.f, 3.f}) {
+        noa::fill(input, value);
+        noa::fill(output, 0.f);
+        stream.launch(graph);
+        noa::fill(expected, (value + 1) * value);
+        stream.synchronize();
+        REQUIRE(test::allclose_abs(output, expected, 1e-6));
+    }
+}
+
+TEST_CASE("unified::Stream, graph capture with views", "[noa][unified]") {
+    using namespace ::noa::types;
+    const auto mode = GENERATE(Stream::DEFAULT, Stream::ASYNC);
+    auto stream = StreamGuard(Device{}, mode);
+
+    const auto shape = Shape4<i64>{1, 1, 32, 64};
+    const auto input = noa::empty<f32>(shape);
+    const auto tmp = noa::like(input);
+    const auto output = noa::empty<f32>(shape.filter(0, 1, 3, 2));
+
+    // Capture output = permute(input + 1), with View-to-View copies.
+    stream.begin_capture();
+    noa::copy(input.view(), tmp.view());
+    noa::ewise(noa::wrap(tmp.view(), 1.f), tmp.view(), noa::Plus{});
+    noa::permute_copy(tmp.view(), output.view(), {0, 1, 3, 2});
+    const auto graph = stream.end_capture();
+    REQUIRE(graph.n_tasks() == 3);
+
+    const auto expected = noa::like(output);
+    for (f32 value: {1.f, 2.f, 3.f}) {
+        noa::fill(input, value);
+        noa::fill(tmp, 0.f);
+        noa::fill(output, 0.f);
+        stream.launch(graph);
+        noa::fill(expected, value + 1);
+        stream.synchronize();
+        REQUIRE(test::allclose_abs(output, expected, 1e-6));
+    }
+}
+
+TEST_CASE("unified::Stream, wait on event", "[noa][unified]") {
+    using namespace ::noa::types;
+    auto producer = Stream(Device{}, Stream::ASYNC);
+    auto consumer = Stream(Device{}, Stream::ASYNC);
+
+    const auto shape = Shape4<i64>{1, 1, 256, 256};
+    const auto input = noa::empty<f32>(shape);
+    const auto output = noa::like(input);
+    const auto expected = noa::fill(shape, 4.f);
+
+    for (f32 value: {1.f, 2.f, 3.f}) {
+        Event event;
+        {
+            const auto guard = StreamGuard(producer);
+            noa::fill(input, value);
+            event.record(producer);
+        }
+        {
+            const auto guard = StreamGuard(consumer);
+            consumer.wait(event);
+            noa::ewise(noa::wrap(input, 4.f - value), output, noa::Plus{});
+        }
+        consumer.synchronize();
+        REQUIRE(test::allclose_abs(output, expected, 1e-6));
+    }
+}
@@ -0,0 +1,96 @@
+#include <fstream>
+#include <sstream>
+
+#include <noa/unified/Session.hpp>
+#include <noa/unified/Ewise.hpp>
+#include <noa/unified/Factory.hpp>
+#include <noa/unified/fft/Transform.hpp>
+#include <catch2/catch.hpp>
+
+#include "Utils.hpp"
+
+using namespace ::noa::types;
+namespace fs = std::filesystem;
+
+// The tracing is compiled out by default. Configure with -DNOA_ENABLE_TRACING=ON to test the traces.
+TEST_CASE("unified::Session, tracing", "[noa][unified]") {
+    if constexpr (not noa::guts::TRACING) {
+        REQUIRE_FALSE(noa::Session::is_tracing());
+        REQUIRE_THROWS(noa::Session::set_tracing(true));
+        REQUIRE_NOTHROW(noa::Session::set_tracing(false));
+        return;
+    }
+
+    const auto shape = Shape4<i64>{2, 1, 64, 64};
+    for (auto mode: {Stream::DEFAULT, Stream::ASYNC}) {
+        noa::Session::clear_traces();
+        noa::Session::set_tracing(true);
+        REQUIRE(noa::Session::is_tracing());
+
+        const auto device = Device{};
+        auto guard = StreamGuard(device, mode);
+        const auto lhs = noa::fill(shape, f32{1});
+        const auto rhs = noa::fill(shape, f32{2});
+        const auto out = noa::like(lhs);
+        noa::ewise(noa::wrap(lhs, rhs), out, noa::Plus{});
+        const auto rfft = noa::fft::r2c(out);
+        guard.synchronize();
+        noa::Session::set_tracing(false);
+
+        // Operations launched while the tracing is disabled are not recorded.
+        noa::ewise(noa::wrap(lhs, rhs), out, noa::Plus{});
+        guard.synchronize();
+
+        const std::vector<TraceEvent> events = noa::Session::trace_events();
+        for (const auto& event: events)
+            REQUIRE(event.start_us >= 0);
+        const auto plus = std::ranges::find(events, "ewise<noa::Plus>", &TraceEvent::name);
+        REQUIRE(plus != events.end());
+        REQUIRE(plus->dtype == "f32");
+        REQUIRE(plus->shape.n_elements() == shape.n_elements());
+        REQUIRE(plus->n_bytes_read == shape.n_elements() * 8);
+        REQUIRE(plus->n_bytes_written == shape.n_elements() * 4);
+        REQUIRE(plus->n_threads == 1);
+        REQUIRE(plus->device == device);
+        REQUIRE(plus->duration_us >= 0);
+
+        const auto r2c = std::ranges::find(events, "fft::r2c", &TraceEvent::name);
+        REQUIRE(r2c != events.end());
+        REQUIRE(r2c->dtype == "c32");
+        REQUIRE(r2c->n_bytes_written == rfft.n_elements() * 8);
+
+        const auto counters = noa::Session::trace_counters();
+        REQUIRE(counters.at("ewise<noa::Plus>").n_calls == 1);
+        REQUIRE(counters.at("fft::r2c").n_calls == 1);
+        REQUIRE(counters.at("ewise<noa::Fill>").n_calls == 2);
+    }
+
+    const auto directory = fs::current_path() / "test_trace";
+    const auto filename = directory / "trace.json";
+    noa::Session::write_trace(filename);
+    std::ifstream file(filename);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string json = buffer.str();
+    REQUIRE(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    REQUIRE(json.find("\"name\":\"ewise<noa::Plus>\"") != std::string::npos);
+    REQUIRE(json.find("\"ph\":\"X\"") != std::string::npos);
+    fs::remove_all(directory);
+
+    // Past the limit, the events are dropped but the counters are still updated.
+    noa::Session::clear_traces();
+    noa::Session::set_trace_limit(1);
+    noa::Session::set_tracing(true);
+    {
+        const auto array = noa::fill(shape, f32{1});
+        noa::ewise(noa::wrap(array, array), array, noa::Plus{});
+        array.eval();
+    }
+    noa::Session::set_tracing(false);
+    REQUIRE(noa::Session::trace_events().size() == 1);
+    REQUIRE(noa::Session::trace_counters().at("ewise<noa::Plus>").n_calls == 1);
+    REQUIRE(noa::Session::trace_counters().at("ewise<noa::Fill>").n_calls == 1);
+    noa::Session::set_trace_limit(100'000);
+
+    noa::Session::clear_traces();
+}
@@ -3,7 +3,9 @@
 #include <noa/unified/Random.hpp>
 #include <noa/unified/Factory.hpp>
 #include <noa/unified/IO.hpp>
+#include <noa/unified/Session.hpp>
 #include <catch2/catch.hpp>
+#include <thread>
 #include "Utils.hpp"
 
 using namespace ::noa::types;
@@ -170,3 +172,209 @@ TEMPLATE_TEST_CASE("unified::fft::c2c()", "[noa][unified]", f32, f64) {
         }
     }
 }
+
+TEMPLATE_TEST_CASE("unified::fft, planning rigor and autotuning", "[noa][unified]", f32, f64) {
+    const i64 ndim = GENERATE(1, 2, 3);
+    const bool inplace = GENERATE(true, false);
+    INFO("ndim: " << ndim);
+    INFO("inplace: " << inplace);
+
+    const f64 abs_epsilon = std::is_same_v<TestType, f32> ? 1e-4 : 1e-9;
+    const auto shape = noa::fft::next_fast_shape(test::random_shape_batched(ndim));
+    auto guard = StreamGuard(Device{}, Stream::DEFAULT);
+    guard.set_thread_limit(GENERATE(1, 2));
+
+    const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape);
+    const auto expected_rfft = noa::fft::r2c(input);
+    const auto expected_fft = noa::fft::c2c(expected_rfft, noa::fft::Sign::FORWARD);
+
+    for (auto options: {
+        noa::fft::FFTOptions{.rigor = noa::fft::Rigor::MEASURE},
+        noa::fft::FFTOptions{.cache_plan = false, .rigor = noa::fft::Rigor::MEASURE},
+        noa::fft::FFTOptions{.autotune = true},
+    }) {
+        INFO("autotune: " << options.autotune << ", cache: " << options.cache_plan);
+
+        // The first calls may use the estimated plans while the measured plans are created in the background.
+        for (i64 i{}; i < 3; ++i) {
+            Array<TestType> real;
+            Array<Complex<TestType>> rfft;
+            if (inplace) {
+                auto [buffer_real, buffer_rfft] = noa::fft::empty<TestType>(shape);
+                real = std::move(buffer_real);
+                rfft = std::move(buffer_rfft);
+            } else {
+                real = noa::empty<TestType>(shape);
+                rfft = noa::empty<Complex<TestType>>(shape.rfft());
+            }
+            input.to(real);
+
+            noa::fft::r2c(real, rfft, options);
+            REQUIRE(test::allclose_abs_safe(expected_rfft, rfft, abs_epsilon));
+            if (not inplace)
+                REQUIRE(test::allclose_abs_safe(input, real, 0));
+
+            const auto fft = noa::fft::c2c(rfft, noa::fft::Sign::FORWARD, options);
+            REQUIRE(test::allclose_abs_safe(expected_fft, fft, abs_epsilon * 10));
+
+            noa::fft::c2r(rfft, real, options);
+            REQUIRE(test::allclose_abs_safe(input, real, abs_epsilon));
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::fft, cached plans of odd and even sizes", "[noa][unified]", f32, f64) {
+    // In-place, the even and odd sizes have the same rfft shape and the same strides,
+    // so the cached plans should be distinguished by the logical shape.
+    const i64 ndim = GENERATE(1, 2, 3);
+    const i64 n_threads = GENERATE(1, 4); // 4: batch-level parallelism
+    const i64 cache_limit = GENERATE(1, 64);
+    INFO("ndim: " << ndim << ", n_threads: " << n_threads << ", cache_limit: " << cache_limit);
+
+    const f64 abs_epsilon = std::is_same_v<TestType, f32> ? 1e-4 : 1e-9;
+    auto guard = StreamGuard(Device{}, Stream::DEFAULT);
+    Session::set_fft_cache_limit(cache_limit, Device{});
+
+    const auto options = noa::fft::FFTOptions{.rigor = noa::fft::Rigor::MEASURE};
+    for (i64 i{}; i < 2; ++i) {
+        for (i64 size: {24, 25}) {
+            auto shape = Shape4<i64>{4, 1, 1, size};
+            if (ndim >= 2)
+                shape[2] = size;
+            if (ndim == 3)
+                shape[1] = size;
+            INFO("shape: " << shape);
+
+            guard.set_thread_limit(1);
+            const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape);
+            const auto expected_rfft = noa::fft::r2c(input);
+
+            guard.set_thread_limit(n_threads);
+            auto [real, rfft] = noa::fft::empty<TestType>(shape);
+            input.to(real);
+            noa::fft::r2c(real, rfft, options);
+            REQUIRE(test::allclose_abs_safe(expected_rfft, rfft, abs_epsilon));
+
+            noa::fft::c2r(rfft, real, options);
+            REQUIRE(test::allclose_abs_safe(input, real, abs_epsilon));
+        }
+    }
+    Session::set_fft_cache_limit(64, Device{});
+}
+
+TEMPLATE_TEST_CASE("unified::fft, batch-level parallelism", "[noa][unified]", f32, f64) {
+    // Odd sizes, so that the slices of the batch don't all have the same alignment.
+    const auto shape = GENERATE(Shape4<i64>{17, 1, 35, 33}, Shape4<i64>{6, 1, 1, 63}, Shape4<i64>{5, 12, 13, 14});
+    const bool inplace = GENERATE(true, false);
+    const auto rigor = GENERATE(noa::fft::Rigor::ESTIMATE, noa::fft::Rigor::MEASURE);
+    INFO("shape: " << shape << ", inplace: " << inplace);
+
+    const f64 abs_epsilon = std::is_same_v<TestType, f32> ? 1e-4 : 1e-9;
+    auto guard = StreamGuard(Device{}, Stream::DEFAULT);
+    guard.set_thread_limit(1);
+    const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape);
+    const auto expected_rfft = noa::fft::r2c(input);
+    const auto expected_fft = noa::fft::c2c(expected_rfft, noa::fft::Sign::FORWARD);
+
+    guard.set_thread_limit(4);
+    Array<TestType> real;
+    Array<Complex<TestType>> rfft;
+    if (inplace) {
+        auto [buffer_real, buffer_rfft] = noa::fft::empty<TestType>(shape);
+        real = std::move(buffer_real);
+        rfft = std::move(buffer_rfft);
+    } else {
+        real = noa::empty<TestType>(shape);
+        rfft = noa::empty<Complex<TestType>>(shape.rfft());
+    }
+    input.to(real);
+
+    const auto options = noa::fft::FFTOptions{.rigor = rigor};
+    noa::fft::r2c(real, rfft, options);
+    REQUIRE(test::allclose_abs_safe(expected_rfft, rfft, abs_epsilon));
+
+    const auto fft = noa::fft::c2c(rfft, noa::fft::Sign::FORWARD, options);
+    REQUIRE(test::allclose_abs_safe(expected_fft, fft, abs_epsilon * 10));
+
+    noa::fft::c2r(rfft, real, options);
+    REQUIRE(test::allclose_abs_safe(input, real, abs_epsilon));
+}
+
+TEMPLATE_TEST_CASE("unified::fft::r2c_pruned/c2r_pruned()", "[noa][unified]", f32, f64) {
+    const i64 ndim = GENERATE(1, 2, 3);
+    const auto norm = GENERATE(noa::fft::Norm::FORWARD, noa::fft::Norm::ORTHO, noa::fft::Norm::BACKWARD);
+    const auto rigor = GENERATE(noa::fft::Rigor::ESTIMATE, noa::fft::Rigor::MEASURE); // MEASURE is cached
+    const auto fft_options = noa::fft::FFTOptions{.norm = norm, .rigor = rigor};
+    INFO("ndim: " << ndim);
+
+    const f64 abs_epsilon = std::is_same_v<TestType, f32> ? 5e-4 : 1e-9;
+    test::Randomizer<i64> randomizer(1, 20);
+    const auto shape = test::random_shape_batched(ndim);
+    auto input_shape = shape;
+    auto output_shape = shape.rfft();
+    for (size_t i = 4 - static_cast<size_t>(ndim); i < 4; ++i) {
+        input_shape[i] = std::max(i64{1}, shape[i] - randomizer.get());
+        output_shape[i] = std::max(i64{1}, output_shape[i] - randomizer.get());
+    }
+    INFO("shape: " << shape << ", input_shape: " << input_shape << ", output_shape: " << output_shape);
+    const auto output_logical_shape = Shape4<i64>{
+        output_shape[0], output_shape[1], output_shape[2], (output_shape[3] - 1) * 2};
+
+    // The errors grow with the magnitude of the (unnormalized) sums.
+    const auto epsilon = [&](noa::fft::Sign sign) {
+        const auto n_elements = static_cast<f64>(shape.pop_front().n_elements());
+        const auto magnitude = noa::fft::normalization_factor(shape, sign, norm) * std::sqrt(n_elements);
+        return abs_epsilon * std::max(1., magnitude);
+    };
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (const auto& device: devices) {
+        INFO(device);
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+
+        { // r2c: pad, transform and crop.
+            const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, input_shape, options);
+            const auto padded = noa::zeros<TestType>(shape, options);
+            input.to(padded.subregion(
+                noa::indexing::FullExtent{},
+                noa::indexing::Slice{0, input_shape[1]},
+                noa::indexing::Slice{0, input_shape[2]},
+                noa::indexing::Slice{0, input_shape[3]}));
+            const auto expected = noa::empty<Complex<TestType>>(output_shape, options);
+            noa::fft::resize<noa::Remap::H2H>(
+                noa::fft::r2c(padded, {.norm = norm}), shape, expected, output_logical_shape);
+
+            // The second transform reuses the cached plans, if any.
+            for (i32 i{}; i < 2; ++i) {
+                const auto result = noa::empty<Complex<TestType>>(output_shape, options);
+                noa::fft::r2c_pruned(input, result, shape, fft_options);
+                REQUIRE(test::allclose_abs_safe(expected, result, epsilon(noa::fft::Sign::FORWARD)));
+            }
+        }
+
+        { // c2r: pad, transform and crop.
+            const auto input = noa::random<Complex<TestType>>(noa::Uniform<TestType>{-5, 5}, output_shape, options);
+            const auto padded = noa::zeros<Complex<TestType>>(shape.rfft(), options);
+            noa::fft::resize<noa::Remap::H2H>(input, output_logical_shape, padded, shape);
+            const auto expected = noa::fft::c2r(padded, shape, {.norm = norm}).subregion(
+                noa::indexing::FullExtent{},
+                noa::indexing::Slice{0, input_shape[1]},
+                noa::indexing::Slice{0, input_shape[2]},
+                noa::indexing::Slice{0, input_shape[3]});
+
+            const auto input_copy = input.copy();
+            for (i32 i{}; i < 2; ++i) {
+                const auto result = noa::empty<TestType>(input_shape, options);
+                noa::fft::c2r_pruned(input, result, shape, fft_options);
+                REQUIRE(test::allclose_abs_safe(expected, result, epsilon(noa::fft::Sign::BACKWARD)));
+                REQUIRE(test::allclose_abs_safe(input_copy, input, 0));
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#include <noa/unified/fft/Pyramid.hpp>
+#include <noa/unified/fft/Resize.hpp>
+#include <noa/unified/fft/Transform.hpp>
+#include <noa/unified/Random.hpp>
+#include <noa/unified/Factory.hpp>
+
+#include <catch2/catch.hpp>
+#include "Utils.hpp"
+
+using namespace ::noa::types;
+
+TEMPLATE_TEST_CASE("unified::fft::Pyramid", "[noa][unified]", f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto shape = GENERATE(Shape4<i64>{2, 1, 128, 120}, Shape4<i64>{1, 64, 60, 66});
+    const auto taper_width = GENERATE(0., 0.1, 0.25);
+    const std::vector<f64> factors{1, 2, 3.5, 8};
+    INFO("shape=" << shape << ", taper_width=" << taper_width);
+
+    for (auto& device: devices) {
+        INFO(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape, options);
+
+        auto pyramid = noa::fft::Pyramid<TestType>(input, factors, {.taper_width = taper_width});
+        REQUIRE(pyramid.n_levels() == 4);
+        REQUIRE(pyramid.device() == device);
+
+        const auto input_spectrum = noa::fft::r2c(input);
+        for (i64 i{}; i < pyramid.n_levels(); ++i) {
+            INFO("level=" << i);
+            const auto& level_shape = pyramid.shape(i);
+            for (size_t j = 1; j < 4; ++j) {
+                const auto expected_size = static_cast<i64>(std::round(static_cast<f64>(shape[j]) / factors[i]));
+                REQUIRE(level_shape[j] == (shape[j] == 1 ? 1 : expected_size));
+            }
+
+            // Each level is the spectrum of the input cropped to the level.
+            const auto expected_spectrum = noa::fft::resize_and_remap(
+                noa::Remap::H2H, input_spectrum, shape, level_shape, taper_width);
+            REQUIRE(test::allclose_abs_safe(pyramid.spectrum(i), expected_spectrum, 1e-5));
+
+            REQUIRE_FALSE(pyramid.is_real_computed(i));
+            const auto expected_real = noa::fft::c2r(expected_spectrum.copy(), level_shape);
+            const auto real = pyramid.real(i);
+            REQUIRE(test::allclose_abs_safe(real, expected_real, 1e-5));
+            REQUIRE(pyramid.is_real_computed(i));
+
+            // The spectrum is preserved and the real-space level isn't recomputed.
+            // To check the latter, the level is overwritten and shouldn't be reset by the second call.
+            REQUIRE(test::allclose_abs_safe(pyramid.spectrum(i), expected_spectrum, 1e-5));
+            noa::fill(real, TestType{-1});
+            REQUIRE(pyramid.real(i).get() == real.get());
+            REQUIRE(test::allclose_abs_safe(pyramid.real(i), noa::fill(level_shape, TestType{-1}, options), 1e-5));
+        }
+    }
+}
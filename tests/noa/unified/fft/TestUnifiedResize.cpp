@@ -1,5 +1,6 @@
 #include <noa/unified/fft/Resize.hpp>
 #include <noa/unified/fft/Remap.hpp>
+#include <noa/unified/signal/Bandpass.hpp>
 #include <noa/unified/Random.hpp>
 #include <noa/unified/Factory.hpp>
 #include <noa/unified/IO.hpp>
@@ -91,3 +92,63 @@ TEMPLATE_TEST_CASE("unified::fft::resize and remap", "[noa][unified]", f32, f64,
         REQUIRE(test::allclose_abs_safe(a0, a4, 5e-6));
     }
 }
+
+namespace {
+    template<typename T>
+    auto resize_then_remap(Remap remap, const Array<T>& input, const Shape4<i64>& input_shape, const Shape4<i64>& output_shape) {
+        Array<T> resized;
+        switch (remap.erase_output()) {
+            case Remap::H2H: resized = noa::fft::resize<"h2h">(input, input_shape, output_shape); break;
+            case Remap::HC2HC: resized = noa::fft::resize<"hc2hc">(input, input_shape, output_shape); break;
+            case Remap::F2F: resized = noa::fft::resize<"f2f">(input, input_shape, output_shape); break;
+            case Remap::FC2FC: resized = noa::fft::resize<"fc2fc">(input, input_shape, output_shape); break;
+            default: noa::panic("unreachable");
+        }
+        return noa::fft::remap(remap, resized, output_shape);
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::fft::resize_and_remap()", "[noa][unified]", f32, c32, c64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const bool pad = GENERATE(true, false);
+    const auto input_shape = test::random_shape_batched(GENERATE(2, 3));
+    auto output_shape = input_shape;
+    test::Randomizer<i64> randomizer(0, 20);
+    for (size_t i = 1; i < 4; ++i) {
+        if (input_shape[i] > 1)
+            output_shape[i] = pad ? input_shape[i] + randomizer.get() : std::max(input_shape[i] - randomizer.get(), i64{2});
+    }
+    INFO("input_shape=" << input_shape << ", output_shape=" << output_shape);
+
+    const std::array<Remap, 16> remaps{
+        Remap::H2H, Remap::H2HC, Remap::H2F, Remap::H2FC,
+        Remap::HC2H, Remap::HC2HC, Remap::HC2F, Remap::HC2FC,
+        Remap::F2H, Remap::F2HC, Remap::F2F, Remap::F2FC,
+        Remap::FC2H, Remap::FC2HC, Remap::FC2F, Remap::FC2FC,
+    };
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        for (auto remap: remaps) {
+            INFO(remap);
+            const auto input = noa::random(
+                noa::Uniform<TestType>{-50, 50}, remap.is_fx2xx() ? input_shape : input_shape.rfft(), options);
+            const auto expected = resize_then_remap(remap, input, input_shape, output_shape);
+            const auto output = noa::fft::resize_and_remap(remap, input, input_shape, output_shape);
+            REQUIRE(test::allclose_abs(expected, output, 1e-6));
+        }
+
+        // The taper is a lowpass ending at the new Nyquist.
+        const auto input = noa::random(noa::Uniform<TestType>{-50, 50}, input_shape.rfft(), options);
+        const auto expected = noa::fft::resize_and_remap(Remap::H2HC, input, input_shape, output_shape);
+        noa::signal::lowpass<"hc2hc">(expected, expected, output_shape, {.cutoff = 0.4, .width = 0.1});
+        const auto output = noa::fft::resize_and_remap(Remap::H2HC, input, input_shape, output_shape, 0.1);
+        REQUIRE(test::allclose_abs_safe(expected, output, 1e-4));
+    }
+}
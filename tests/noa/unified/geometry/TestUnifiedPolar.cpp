@@ -1,5 +1,6 @@
 #include <noa/unified/geometry/PolarTransform.hpp>
 #include <noa/unified/geometry/DrawShape.hpp>
+#include <noa/unified/geometry/ResamplingPlan.hpp>
 #include <noa/unified/Factory.hpp>
 #include <noa/unified/IO.hpp>
 
@@ -81,3 +82,36 @@ TEST_CASE("unified::geometry::cartesian2polar", "[noa][unified]") {
 }
 
 // TODO Random polar -> cartesian -> polar (preserve scaling)
+
+TEST_CASE("unified::geometry::cartesian2polar, resampling plan", "[noa][unified]") {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto interp = GENERATE(noa::Interp::NEAREST, noa::Interp::LINEAR, noa::Interp::CUBIC, noa::Interp::LANCZOS6);
+    INFO(interp);
+
+    const auto cartesian_shape = Shape4<i64>{2, 1, 128, 120};
+    const auto polar_shape = Shape4<i64>{2, 1, 256, 64};
+    const auto center = Vec2<f64>{64, 60};
+    const auto polar_options = noa::geometry::PolarTransformOptions{
+        .rho_range = {2, 58},
+        .phi_range = {0, noa::Constant<f64>::PI},
+        .interp = interp
+    };
+
+    for (const auto& device: devices) {
+        INFO(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        const auto input = noa::empty<f32>(cartesian_shape, options);
+        noa::geometry::draw_shape({}, input, noa::geometry::Sphere{.center=center, .radius=20., .smoothness=30.});
+
+        const auto expected = noa::empty<f32>(polar_shape, options);
+        const auto output = noa::like(expected);
+        noa::geometry::cartesian2polar(input, expected, center, polar_options);
+
+        const auto plan = noa::geometry::cartesian2polar_plan(cartesian_shape, polar_shape, center, polar_options, options);
+        noa::geometry::resample(input, output, plan);
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-5));
+    }
+}
@@ -778,3 +778,109 @@ TEST_CASE("unified::geometry::shapes, 3d batched", "[noa][unified]") {
         }
     }
 }
+
+TEST_CASE("unified::geometry::shapes, bounding box", "[noa][unified]") {
+    // Transforms given as a varray are never restricted to the bounding box of the shape.
+    constexpr auto shape = Shape4<i64>{2, 64, 70, 66};
+    const auto center = GENERATE(Vec{20., 35., 40.}, Vec{2., 68., 30.}, Vec{-20., 35., 40.});
+    const auto invert = GENERATE(false, true);
+    INFO("center=" << center << ", invert=" << invert);
+
+    const auto rotation = noa::geometry::euler2matrix(noa::deg2rad(Vec{20., 35., -10.}), {.axes="zyz"});
+    const auto inv_affine = (
+        noa::geometry::translate(center + Vec{1.5, -2., 3.}) *
+        noa::geometry::linear2affine(rotation) *
+        noa::geometry::translate(-center)
+    ).as<f32>();
+
+    std::vector devices{Device("cpu")};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto device: devices) {
+        INFO(device);
+        const auto option = ArrayOption(device, Allocator::MANAGED);
+        const auto input = noa::random(noa::Uniform{-5.f, 5.f}, shape, option);
+        const auto expected = noa::like(input);
+        const auto output = noa::like(input);
+        const auto matrices = noa::empty<Mat44<f32>>(shape[0], option);
+        noa::fill(matrices, inv_affine);
+
+        const auto check = [&](const auto& geometric_shape) {
+            noa::geometry::draw_shape({}, expected, geometric_shape, matrices);
+            noa::geometry::draw_shape({}, output, geometric_shape, inv_affine);
+            REQUIRE(test::allclose_abs_safe(expected, output, 1e-5));
+
+            noa::geometry::draw_shape(input, expected, geometric_shape, matrices);
+            noa::geometry::draw_shape(input, output, geometric_shape, inv_affine);
+            REQUIRE(test::allclose_abs_safe(expected, output, 1e-5));
+        };
+        check(noa::geometry::Sphere{.center=center, .radius=8., .smoothness=4., .cvalue=2., .invert=invert});
+        check(noa::geometry::Ellipse{.center=center, .radius=Vec{4., 10., 7.}, .smoothness=3., .invert=invert});
+        check(noa::geometry::Rectangle{.center=center, .radius=Vec{4., 10., 7.}, .smoothness=0., .invert=invert});
+        check(noa::geometry::Cylinder{.center=center, .radius=6., .length=9., .smoothness=5., .invert=invert});
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::geometry::CompiledMask", "[noa][unified]", f32, c32, f64) {
+    const auto shape = GENERATE(Shape4<i64>{3, 1, 128, 120}, Shape4<i64>{3, 40, 48, 44});
+    const auto invert = GENERATE(false, true);
+    const bool is_2d = shape[1] == 1;
+    const auto mask_shape = Shape4<i64>{1, shape[1], shape[2], shape[3]};
+    INFO("shape=" << shape << ", invert=" << invert);
+
+    std::vector devices{Device("cpu")};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto device: devices) {
+        INFO(device);
+        const auto option = ArrayOption(device, Allocator::MANAGED);
+        const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape, option);
+        const auto expected = noa::like(input);
+        const auto output = noa::like(input);
+
+        const auto check = [&](const auto& mask, const auto& geometric_shape, const auto& inverse_transform) {
+            REQUIRE(mask.n_masked_elements() <= shape.pop_front().n_elements());
+            noa::geometry::draw_shape(input, expected, geometric_shape, inverse_transform);
+            noa::geometry::apply_mask(input, output, mask);
+            REQUIRE(test::allclose_abs_safe(expected, output, 1e-5));
+
+            noa::copy(input, output);
+            noa::geometry::apply_mask(output, output, mask);
+            REQUIRE(test::allclose_abs_safe(expected, output, 1e-5));
+        };
+
+        if (is_2d) {
+            const auto sphere = noa::geometry::Sphere{
+                .center=Vec{60., 50.}, .radius=20., .smoothness=10., .cvalue=1., .invert=invert};
+            const auto rectangle = noa::geometry::Rectangle{
+                .center=Vec{100., 110.}, .radius=Vec{30., 20.}, .smoothness=5., .invert=invert};
+            const auto inv_rotation = noa::geometry::rotate(noa::deg2rad(-30.)).as<f32>();
+            check(noa::geometry::CompiledMask<f32, 2>(mask_shape, sphere, {}, option), sphere, Empty{});
+            check(noa::geometry::CompiledMask<f32, 2>(mask_shape, rectangle, inv_rotation, option),
+                  rectangle, inv_rotation);
+
+            // The constant value outside the spans is neither 0 nor 1 if inverted.
+            const auto scaled_sphere = noa::geometry::Sphere{
+                .center=Vec{60., 50.}, .radius=20., .smoothness=10., .cvalue=0.5, .invert=invert};
+            check(noa::geometry::CompiledMask<f32, 2>(mask_shape, scaled_sphere, {}, option), scaled_sphere, Empty{});
+
+            // The shape is entirely outside the array, so there are no spans.
+            const auto outside_sphere = noa::geometry::Sphere{
+                .center=Vec{-100., -100.}, .radius=20., .smoothness=5., .cvalue=1., .invert=invert};
+            const auto outside_mask = noa::geometry::CompiledMask<f32, 2>(mask_shape, outside_sphere, {}, option);
+            REQUIRE(outside_mask.spans().is_empty());
+            check(outside_mask, outside_sphere, Empty{});
+        } else {
+            const auto sphere = noa::geometry::Sphere{
+                .center=Vec{20., 24., 22.}, .radius=10., .smoothness=6., .cvalue=1., .invert=invert};
+            const auto cylinder = noa::geometry::Cylinder{
+                .center=Vec{20., 24., 22.}, .radius=8., .length=12., .smoothness=3., .invert=invert};
+            const auto inv_rotation = noa::geometry::euler2matrix(noa::deg2rad(Vec{20., 35., -10.})).transpose();
+            check(noa::geometry::CompiledMask<f64, 3>(mask_shape, sphere, {}, option), sphere, Empty{});
+            check(noa::geometry::CompiledMask<f64, 3>(mask_shape, cylinder, inv_rotation, option),
+                  cylinder, inv_rotation);
+        }
+    }
+}
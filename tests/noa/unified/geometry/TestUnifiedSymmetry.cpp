@@ -5,6 +5,7 @@
 #include <noa/unified/geometry/Transform.hpp>
 #include <noa/unified/IO.hpp>
 #include <noa/unified/Factory.hpp>
+#include <noa/unified/Random.hpp>
 
 #include <catch2/catch.hpp>
 #include "Assets.h"
@@ -204,3 +205,75 @@ TEST_CASE("unified::geometry::transform_3d, symmetry", "[noa][unified][assets]")
     }
     REQUIRE(count == expected_count);
 }
+
+TEST_CASE("unified::geometry::Symmetry, point groups", "[noa][unified]") {
+    const auto [code, expected_count] = GENERATE(table<const char*, i64>({
+        {"C2", 2}, {"C7", 7}, {"D2", 4}, {"D7", 14}, {"T", 12}, {"O", 24}, {"I", 60}
+    }));
+    INFO(code);
+
+    const auto symmetry = ng::Symmetry<f64, 3>(code);
+    const auto matrices = symmetry.span();
+    REQUIRE(matrices.ssize() + 1 == expected_count);
+
+    // The matrices, with the identity, should be distinct rotations and form a group.
+    std::vector<Mat33<f64>> group{Mat33<f64>::eye(1)};
+    for (const auto& matrix: matrices)
+        group.push_back(matrix);
+    const auto find = [&](const Mat33<f64>& matrix) {
+        i64 n{};
+        for (const auto& element: group)
+            n += noa::allclose(element, matrix, 1e-6);
+        return n;
+    };
+    for (const auto& lhs: group) {
+        REQUIRE_THAT(noa::determinant(lhs), Catch::WithinAbs(1, 1e-6));
+        REQUIRE(find(lhs) == 1);
+        for (const auto& rhs: group)
+            REQUIRE(find(lhs * rhs) == 1);
+    }
+}
+
+TEST_CASE("unified::geometry::symmetrize_3d, asymmetric unit", "[noa][unified]") {
+    const auto code = GENERATE("C4", "D7", "T", "O", "I");
+    const auto interp = GENERATE(Interp::LINEAR, Interp::CUBIC, Interp::LANCZOS4);
+    INFO(code << ", " << interp);
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto shape = Shape4<i64>{2, 38, 36, 40};
+    const auto center = Vec{19., 18., 20.};
+    const auto inverse_pre_matrices = noa::empty<Mat34<f32>>(2);
+    inverse_pre_matrices(0, 0, 0, 0) = ng::affine2truncated(ng::translate(Vec{0.4, -1.2, 2.7}).as<f32>());
+    inverse_pre_matrices(0, 0, 0, 1) = ng::affine2truncated((
+        ng::translate(center) *
+        ng::linear2affine(ng::euler2matrix(noa::deg2rad(Vec{12., -34., 56.}), {.axes="zyz"})) *
+        ng::translate(-center)
+    ).as<f32>());
+
+    for (auto& device: devices) {
+        const auto stream = noa::StreamGuard(device);
+        const auto options = noa::ArrayOption(device, noa::Allocator::MANAGED);
+        INFO(device);
+
+        const auto symmetry = ng::Symmetry<f32, 3>(code, options);
+        const auto input = noa::random(noa::Uniform<f32>{-1, 1}, shape, options);
+        const auto expected = noa::like(input);
+        const auto output = noa::like(input);
+        const auto pre_matrices = inverse_pre_matrices.to(options);
+
+        // Without pre-transformations, the partial sums can be skipped for the subgroups.
+        ng::symmetrize_3d(input, expected, symmetry, {.symmetry_center=center, .interp=interp});
+        ng::symmetrize_3d(input, output, symmetry, {.symmetry_center=center, .interp=interp, .asymmetric_unit=true});
+        REQUIRE(test::allclose_abs_safe(expected, output, 5e-5));
+
+        ng::symmetrize_3d(input, expected, symmetry, {.symmetry_center=center, .interp=interp}, pre_matrices);
+        ng::symmetrize_3d(
+            input, output, symmetry,
+            {.symmetry_center=center, .interp=interp, .asymmetric_unit=true},
+            pre_matrices);
+        REQUIRE(test::allclose_abs_safe(expected, output, 5e-5));
+    }
+}
@@ -1,6 +1,7 @@
 #include <noa/core/geometry/Euler.hpp>
 #include <noa/unified/geometry/CubicBSplinePrefilter.hpp>
 #include <noa/unified/geometry/Transform.hpp>
+#include <noa/unified/geometry/ResamplingPlan.hpp>
 #include <noa/unified/IO.hpp>
 #include <noa/unified/Factory.hpp>
 #include <noa/unified/Random.hpp>
@@ -278,3 +279,72 @@ TEMPLATE_TEST_CASE("unified::geometry::transform_2d(), texture interpolation", "
         REQUIRE(results);
     }
 }
+
+TEMPLATE_TEST_CASE("unified::geometry::transform_2d(), resampling plan", "[noa]", f32, c32) {
+    const Interp interp = GENERATE(
+        Interp::NEAREST,
+        Interp::LINEAR,
+        Interp::CUBIC,
+        Interp::CUBIC_BSPLINE,
+        Interp::LANCZOS4,
+        Interp::LANCZOS6,
+        Interp::LANCZOS8
+    );
+    const Border border = GENERATE(
+        Border::ZERO,
+        Border::VALUE,
+        Border::CLAMP,
+        Border::MIRROR,
+        Border::PERIODIC,
+        Border::REFLECT
+    );
+    INFO(interp);
+    INFO(border);
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto value = test::Randomizer<TestType>(-3., 3.).get();
+    const auto input_shape = Shape4<i64>{1, 1, 64, 58};
+    const auto output_shape = Shape4<i64>{3, 1, 60, 70};
+    const auto center = input_shape.filter(2, 3).vec.as<f64>() / 2;
+
+    auto matrices = noa::empty<Mat23<f64>>(output_shape[0]);
+    for (i64 i{}; auto& matrix: matrices.span_1d_contiguous()) {
+        const auto rotation = noa::deg2rad(static_cast<f64>(i++) * 37. + 15.);
+        matrix = noa::geometry::affine2truncated(
+            noa::geometry::translate(center + 3.5) *
+            noa::geometry::linear2affine(noa::geometry::rotate(-rotation)) *
+            noa::geometry::translate(-center));
+    }
+
+    for (auto& device: devices) {
+        INFO(device);
+        const auto options = ArrayOption{.device=device, .allocator="managed"};
+        const auto input = noa::random(noa::Uniform<TestType>{-2, 2}, input_shape.set<0>(3), options);
+        const auto expected = noa::empty<TestType>(output_shape, options);
+        const auto output = noa::like(expected);
+
+        // One geometry per batch.
+        const auto plan = noa::geometry::transform_2d_plan(
+            input_shape, output_shape, matrices, {interp, border}, options);
+        REQUIRE(plan.window_size() == (interp == Interp::NEAREST ? 1 : interp.window_size()));
+
+        noa::geometry::transform_2d(input, expected, matrices.to(options), {interp, border, value});
+        noa::geometry::resample(input, output, plan, value);
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-5));
+
+        // Same geometry for every batch.
+        const auto plan_single = noa::geometry::transform_2d_plan(
+            input_shape, output_shape, matrices(0, 0, 0, 0), {interp, border}, options);
+        noa::geometry::transform_2d(input, expected, matrices(0, 0, 0, 0), {interp, border, value});
+        noa::geometry::resample(input, output, plan_single, value);
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-5));
+
+        // Broadcast the input.
+        noa::geometry::transform_2d(input.subregion(0), expected, matrices.to(options), {interp, border, value});
+        noa::geometry::resample(input.subregion(0), output, plan, value);
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-5));
+    }
+}
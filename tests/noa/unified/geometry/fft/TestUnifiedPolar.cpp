@@ -5,7 +5,9 @@
 #include <noa/unified/fft/Remap.hpp>
 #include <noa/unified/geometry/DrawShape.hpp>
 #include <noa/unified/geometry/PolarTransformSpectrum.hpp>
+#include <noa/unified/geometry/ResamplingPlan.hpp>
 #include <noa/unified/geometry/RotationalAverage.hpp>
+#include <noa/unified/Random.hpp>
 #include <noa/unified/Reduce.hpp>
 #include <noa/unified/signal/CTF.hpp>
 
@@ -104,6 +106,60 @@ TEST_CASE("unified::geometry::fft::rotational_average", "[noa][unified]") {
     }
 }
 
+TEST_CASE("unified::geometry::fft::spectrum2polar, resampling plan", "[noa][unified]") {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const i64 size = GENERATE(64, 65);
+    const auto interp = GENERATE(noa::Interp::NEAREST, noa::Interp::LINEAR, noa::Interp::CUBIC);
+    INFO("size=" << size << ", interp=" << interp);
+
+    const auto shape = Shape4<i64>{2, 1, size, size + 6};
+    const auto polar_shape = Shape4<i64>{2, 1, 128, 40};
+    const auto polar_options = noa::geometry::PolarTransformSpectrumOptions{
+        .rho_range = {0.05, 0.45},
+        .phi_range = {-noa::Constant<f64>::PI, noa::Constant<f64>::PI},
+        .interp = interp,
+    };
+
+    auto run = [&]<noa::Remap REMAP>(const ArrayOption& options) {
+        INFO(REMAP);
+        const auto input_shape = REMAP.is_hx2xx() ? shape.rfft() : shape;
+        const auto input = noa::random(noa::Uniform<c32>{-1, 1}, input_shape, options);
+
+        if (REMAP.is_hx2xx() and interp == noa::Interp::CUBIC) {
+            REQUIRE_THROWS_AS(noa::geometry::spectrum2polar_plan<REMAP>(
+                shape, polar_shape, polar_options, options), noa::Exception);
+            return;
+        }
+        const auto plan = noa::geometry::spectrum2polar_plan<REMAP>(shape, polar_shape, polar_options, options);
+        REQUIRE(plan.conjugates().is_empty() == REMAP.is_fx2xx());
+
+        // Complex and power spectrum.
+        const auto expected = noa::empty<c32>(polar_shape, options);
+        const auto output = noa::like(expected);
+        noa::geometry::spectrum2polar<REMAP>(input, shape, expected, polar_options);
+        noa::geometry::resample(input, output, plan);
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-5));
+
+        const auto expected_power = noa::empty<f32>(polar_shape, options);
+        const auto output_power = noa::like(expected_power);
+        noa::geometry::spectrum2polar<REMAP>(input, shape, expected_power, polar_options);
+        noa::geometry::resample(input, output_power, plan);
+        REQUIRE(test::allclose_abs_safe(output_power, expected_power, 5e-5));
+    };
+
+    for (const auto& device: devices) {
+        INFO(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        run.template operator()<noa::Remap::HC2FC>(options);
+        run.template operator()<noa::Remap::H2FC>(options);
+        run.template operator()<noa::Remap::FC2FC>(options);
+        run.template operator()<noa::Remap::F2FC>(options);
+    }
+}
+
 TEST_CASE("unified::geometry::fft::rotational_average_anisotropic, vs isotropic", "[noa][unified]") {
     // Test that with an isotropic ctf it gives the same results as the classic rotational average.
 
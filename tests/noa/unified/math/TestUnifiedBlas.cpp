@@ -134,3 +134,53 @@ TEMPLATE_TEST_CASE("unified::matmul()", "[noa][unified]", f32, f64, c32, c64) {
         REQUIRE(test::allclose_abs_safe(output, expected, std::is_same_v<real_t, f64> ? 1e-7 : 5e-3));
     }
 }
+
+TEMPLATE_TEST_CASE("unified::matmul(), batched small matrices", "[noa][unified]", f32, f64, c32, c64) {
+    using real_t = noa::traits::value_type_t<TestType>;
+
+    const i64 batches = test::Randomizer<i64>(2, 64).get();
+    const auto [m, n, k] = GENERATE(as<Vec3<i64>>{},
+        Vec3<i64>{2, 2, 2}, Vec3<i64>{3, 3, 3}, Vec3<i64>{4, 4, 4}, Vec3<i64>{4, 1, 4},
+        Vec3<i64>{8, 8, 8}, Vec3<i64>{5, 3, 7}, Vec3<i64>{32, 32, 32}, Vec3<i64>{100, 64, 128});
+    const auto [lhs_transpose, rhs_transpose] = GENERATE(as<Vec2<bool>>{},
+        Vec2<bool>{false, false}, Vec2<bool>{true, false}, Vec2<bool>{false, true}, Vec2<bool>{true, true});
+    const auto beta = static_cast<TestType>(GENERATE(0, 2));
+    INFO("batches=" << batches << ", mnk=" << m << "," << n << "," << k);
+    INFO("transpose=" << lhs_transpose << "," << rhs_transpose << ", beta=" << beta);
+
+    const auto lhs_shape = Shape4<i64>{batches, 1, m, k};
+    const auto rhs_shape = Shape4<i64>{batches, 1, k, n};
+    const auto out_shape = Shape4<i64>{batches, 1, m, n};
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any(Device::GPU))
+        devices.emplace_back("gpu");
+
+    for (auto& device: devices) {
+        auto stream = StreamGuard(device, Stream::DEFAULT);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        // The transposed matrices are passed as transposed copies, so that the expected result is unchanged.
+        auto lhs = noa::random(noa::Uniform<TestType>{-5, 5}, lhs_shape, options);
+        auto rhs = noa::random(noa::Uniform<TestType>{-5, 5}, rhs_shape, options);
+        const auto lhs_input = lhs_transpose ? lhs.permute({0, 1, 3, 2}).copy() : lhs;
+        const auto rhs_input = rhs_transpose ? rhs.permute({0, 1, 3, 2}).copy() : rhs;
+        const auto output = noa::random(noa::Uniform<TestType>{-5, 5}, out_shape, options);
+
+        // Compute expected:
+        const auto expected = output.to({.device = "cpu", .allocator = Allocator::MANAGED});
+        noa::ewise({}, expected, noa::Scale{beta});
+        stream.synchronize();
+        naive_matmul_(lhs, rhs, expected);
+
+        // Compute output:
+        noa::matmul(lhs_input, rhs_input, output, {
+            .beta = beta,
+            .lhs_transpose = lhs_transpose,
+            .rhs_transpose = rhs_transpose,
+        });
+
+        REQUIRE(test::allclose_abs_safe(output, expected, std::is_same_v<real_t, f64> ? 1e-7 : 5e-3));
+    }
+}
@@ -39,3 +39,53 @@ TEMPLATE_TEST_CASE("unified::cast", "[noa][unified]", i32, f32, f64) {
         REQUIRE(test::allclose_abs(data0, data1));
     }
 }
+
+TEST_CASE("unified::cast, f16", "[noa][unified]") {
+    const bool pad = GENERATE(false, true);
+    const auto subregion_shape = test::random_shape_batched(3);
+    auto shape = subregion_shape;
+    if (pad)
+        shape[3] += 12;
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any(Device::GPU))
+        devices.emplace_back("gpu");
+
+    for (const auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, "unified");
+
+        using namespace noa::indexing;
+        const auto input = noa::random(noa::Uniform<f32>{-70000, 70000}, shape, options)
+            .subregion(Ellipsis{}, Slice{0, subregion_shape[3]});
+        const auto halves = noa::like<f16>(input);
+        const auto floats = noa::like<f32>(input);
+
+        for (bool clamp: {false, true}) {
+            INFO("clamp=" << clamp);
+            noa::cast(input, halves, clamp);
+            noa::cast(halves, floats, clamp);
+
+            const auto input_cpu = input.to_cpu();
+            const auto halves_cpu = halves.to_cpu();
+            const auto floats_cpu = floats.to_cpu().eval();
+            const auto input_span = input_cpu.span();
+            const auto halves_span = halves_cpu.span();
+            const auto floats_span = floats_cpu.span();
+            bool is_ok{true};
+            for (i64 i{}; i < input_span.shape()[0]; ++i) {
+                for (i64 j{}; j < input_span.shape()[1]; ++j) {
+                    for (i64 k{}; k < input_span.shape()[2]; ++k) {
+                        for (i64 l{}; l < input_span.shape()[3]; ++l) {
+                            const f32 value = input_span(i, j, k, l);
+                            const f16 expected = clamp ? noa::clamp_cast<f16>(value) : static_cast<f16>(value);
+                            is_ok = is_ok and halves_span(i, j, k, l) == expected and
+                                    floats_span(i, j, k, l) == static_cast<f32>(expected);
+                        }
+                    }
+                }
+            }
+            REQUIRE(is_ok);
+        }
+    }
+}
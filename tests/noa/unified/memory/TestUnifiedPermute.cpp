@@ -134,3 +134,40 @@ TEST_CASE("unified::permute, broadcast", "[noa][unified]") {
         }
     }
 }
+
+TEMPLATE_TEST_CASE("unified::permute, all orders", "[noa][unified]", i32, f16, f32, f64, c32, c64) {
+    std::vector<Vec4<i64>> permutations;
+    Vec4<i64> permutation{0, 1, 2, 3};
+    do {
+        permutations.push_back(permutation);
+    } while (std::next_permutation(permutation.begin(), permutation.end()));
+    REQUIRE(permutations.size() == 24);
+
+    // Not multiple of the tile and block sizes.
+    const auto shape = Shape4<i64>{3, 35, 70, 133};
+    const bool pad = GENERATE(false, true);
+    INFO("pad=" << pad);
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        auto padded_shape = shape;
+        if (pad)
+            padded_shape[3] += 7;
+        Array<TestType> data = noa::random<TestType>(noa::Uniform{-5, 5}, padded_shape, options);
+        data = data.subregion(noa::indexing::Ellipsis{}, noa::indexing::Slice{0, shape[3]});
+
+        for (const auto& p: permutations) {
+            INFO(p);
+            const auto expected = noa::permute(data, p);
+            const auto result = noa::permute_copy(data, p);
+            REQUIRE(test::allclose_abs(expected, result, 1e-8));
+        }
+    }
+}
@@ -8,6 +8,7 @@
 #include "Utils.hpp"
 
 using namespace ::noa::types;
+namespace fs = std::filesystem;
 
 TEST_CASE("unified::extract_subregions()", "[asset][noa][unified]") {
     constexpr bool COMPUTE_ASSETS = false;
@@ -137,3 +138,60 @@ TEMPLATE_TEST_CASE("unified::atlas_layout(), insert_subregions()", "[noa][unifie
         REQUIRE(test::allclose_abs(subregions, o_subregions, 1e-8));
     }
 }
+
+TEST_CASE("unified::extract_subregions(), from file", "[noa][unified]") {
+    const auto directory = fs::current_path() / "test_extract_subregions";
+    const auto filename = directory / "micrographs.mrc";
+
+    // Two micrographs, with particles close to the edges.
+    const auto shape = Shape4<i64>{2, 1, 150, 121};
+    const auto micrographs = noa::random(noa::Uniform<f32>{-5, 5}, shape);
+    noa::write(micrographs, filename);
+
+    const auto origins = noa::empty<Vec4<i64>>(6);
+    const auto origins_1d = origins.span_1d_contiguous();
+    origins_1d[0] = {0, 0, 0, 0};
+    origins_1d[1] = {0, 0, 40, 30};
+    origins_1d[2] = {1, 0, -20, 100};
+    origins_1d[3] = {1, 0, 130, -15};
+    origins_1d[4] = {0, 0, 45, 35}; // overlaps with origins_1d[1]
+    origins_1d[5] = {1, 0, 200, 200}; // entirely out-of-bounds
+
+    const auto origins_2d = noa::empty<Vec2<i32>>(6);
+    for (i64 i{}; auto& origin: origins_2d.span_1d_contiguous())
+        origin = origins_1d[i++].filter(2, 3).as<i32>();
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto border_mode = GENERATE(
+        noa::Border::NOTHING, noa::Border::ZERO, noa::Border::VALUE,
+        noa::Border::CLAMP, noa::Border::MIRROR, noa::Border::PERIODIC, noa::Border::REFLECT);
+    const auto max_band_rows = GENERATE(i64{7}, i64{256});
+    INFO(border_mode);
+    INFO(max_band_rows);
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto subregion_shape = Shape4<i64>{6, 1, 32, 40};
+        const auto expected = noa::fill(subregion_shape, 4.f, options);
+        const auto result = noa::fill(subregion_shape, 4.f, options);
+        noa::extract_subregions(micrographs.to(options), expected, origins.to(options), border_mode, 2.f);
+        noa::extract_subregions(filename, result, origins.to(options), border_mode, 2.f,
+                                {.max_band_rows = max_band_rows});
+        REQUIRE(test::allclose_abs_safe(expected, result, 1e-7));
+
+        // The 2d origins extract from the first micrograph.
+        auto file = noa::io::ImageFile(filename, {.read = true});
+        noa::extract_subregions(micrographs.subregion(0).to(options), expected, origins_2d.to(options), border_mode, 2.f);
+        noa::extract_subregions(file, result, origins_2d.to(options), border_mode, 2.f,
+                                {.max_band_rows = max_band_rows});
+        REQUIRE(test::allclose_abs_safe(expected, result, 1e-7));
+    }
+
+    fs::remove_all(directory);
+}
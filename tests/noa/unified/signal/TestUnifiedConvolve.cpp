@@ -92,3 +92,158 @@ TEST_CASE("unified::signal::convolve_separable()", "[asset][noa][unified]") {
         }
     }
 }
+
+namespace {
+    using namespace noa::types;
+
+    // Direct (zero-padded) convolution, as computed by noa.
+    template<typename T>
+    void convolve_reference(const View<const T>& input, const View<T>& output, const View<const T>& filter) {
+        const auto shape = output.shape();
+        const auto filter_shape = filter.shape().pop_front();
+        const auto halo = filter_shape / 2;
+        for (i64 i{}; i < shape[0]; ++i) {
+            for (i64 j{}; j < shape[1]; ++j) {
+                for (i64 k{}; k < shape[2]; ++k) {
+                    for (i64 l{}; l < shape[3]; ++l) {
+                        f64 sum{};
+                        for (i64 fj{}; fj < filter_shape[0]; ++fj) {
+                            for (i64 fk{}; fk < filter_shape[1]; ++fk) {
+                                for (i64 fl{}; fl < filter_shape[2]; ++fl) {
+                                    const i64 ij = j - halo[0] + fj;
+                                    const i64 ik = k - halo[1] + fk;
+                                    const i64 il = l - halo[2] + fl;
+                                    if (ij < 0 or ij >= shape[1] or ik < 0 or ik >= shape[2] or il < 0 or il >= shape[3])
+                                        continue;
+                                    sum += static_cast<f64>(input(input.shape()[0] == 1 ? 0 : i, ij, ik, il)) *
+                                           static_cast<f64>(filter(0, fj, fk, fl));
+                                }
+                            }
+                        }
+                        output(i, j, k, l) = static_cast<T>(sum);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::signal::convolve(), large filters", "[noa][unified]", f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    // Large filters are convolved in Fourier space on the CPU. The shapes are large enough to have multiple tiles.
+    // The input batch is broadcast to check that the filter spectrum is shared between batches.
+    const auto [input_shape, output_shape, filter_shape] = GENERATE(table<Shape4<i64>, Shape4<i64>, Shape4<i64>>({
+        {{1, 1, 600, 520}, {2, 1, 600, 520}, {1, 1, 31, 21}},
+        {{2, 1, 150, 130}, {2, 1, 150, 130}, {1, 1, 45, 45}},
+        {{1, 70, 80, 90}, {1, 70, 80, 90}, {1, 9, 9, 9}},
+        {{1, 3, 64, 3000}, {1, 3, 64, 3000}, {1, 1, 1, 201}},
+        {{1, 1000, 12, 10}, {1, 1000, 12, 10}, {1, 201, 1, 1}},
+        {{2, 3, 1000, 7}, {2, 3, 1000, 7}, {1, 1, 201, 1}},
+    }));
+    INFO("output_shape=" << output_shape << ", filter_shape=" << filter_shape);
+
+    const auto input = noa::random<TestType>(noa::Uniform<TestType>{-1, 1}, input_shape);
+    const auto filter = noa::random<TestType>(noa::Uniform<TestType>{-1, 1}, filter_shape);
+    const auto expected = noa::empty<TestType>(output_shape);
+    convolve_reference<TestType>(input.view(), expected.view(), filter.view());
+
+    const f64 epsilon = std::is_same_v<TestType, f32> ? 5e-4 : 1e-9;
+    for (auto& device: devices) {
+        INFO(device);
+        const auto stream = StreamGuard(device, Stream::DEFAULT);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        const auto input_device = input.to(options);
+        const auto filter_device = filter.to(options);
+        const auto output = noa::empty<TestType>(output_shape, options);
+
+        noa::signal::convolve(input_device, output, filter_device);
+        REQUIRE(test::allclose_abs_safe(expected, output, epsilon));
+
+        if (sum(filter_shape.pop_front() > 1) == 1) {
+            const auto filter_1d = filter_device.reshape({1, 1, 1, filter_shape.n_elements()});
+            noa::fill(output, TestType{});
+            if (filter_shape[1] > 1)
+                noa::signal::convolve_separable(input_device, output, filter_1d, {}, {});
+            else if (filter_shape[2] > 1)
+                noa::signal::convolve_separable(input_device, output, {}, filter_1d, {});
+            else
+                noa::signal::convolve_separable(input_device, output, {}, {}, filter_1d);
+            REQUIRE(test::allclose_abs_safe(expected, output, epsilon));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::signal::convolve_separable(), streaming", "[noa][unified]", f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    // The filters are compared against the equivalent (outer product) filter. Symmetric filters are folded, so
+    // test both symmetric and non-symmetric filters. The volumes are tall enough to have multiple strips,
+    // and the input is permuted to check the strided accesses.
+    const auto [shape, filter_sizes, symmetric] = GENERATE(table<Shape4<i64>, Vec3<i64>, bool>({
+        {{2, 1, 300, 257}, {0, 7, 9}, true},
+        {{1, 1, 300, 257}, {0, 7, 5}, false},
+        {{2, 40, 50, 33}, {5, 3, 7}, true},
+        {{1, 37, 45, 60}, {3, 5, 1}, false},
+        {{1, 20, 30, 40}, {3, 0, 0}, true},
+        {{2, 5, 600, 31}, {0, 11, 0}, false},
+    }));
+    const i64 n_threads = GENERATE(1, 3);
+    INFO("shape=" << shape << ", filter_sizes=" << filter_sizes << ", symmetric=" << symmetric);
+
+    Array<TestType> filters[3];
+    for (size_t i{}; i < 3; ++i) {
+        if (filter_sizes[i] == 0)
+            continue;
+        filters[i] = noa::random<TestType>(noa::Uniform<TestType>{-1, 1}, {1, 1, 1, filter_sizes[i]});
+        if (symmetric) {
+            const auto span = filters[i].span_1d();
+            for (i64 j{}; j < filter_sizes[i] / 2; ++j)
+                span[filter_sizes[i] - 1 - j] = span[j];
+        }
+    }
+
+    const auto filter_shape = Shape4<i64>{1, noa::max(filter_sizes[0], i64{1}), noa::max(filter_sizes[1], i64{1}),
+                                          noa::max(filter_sizes[2], i64{1})};
+    const auto filter = noa::empty<TestType>(filter_shape);
+    for (i64 j{}; j < filter_shape[1]; ++j) {
+        for (i64 k{}; k < filter_shape[2]; ++k) {
+            for (i64 l{}; l < filter_shape[3]; ++l) {
+                TestType value{1};
+                if (not filters[0].is_empty())
+                    value *= filters[0](0, 0, 0, j);
+                if (not filters[1].is_empty())
+                    value *= filters[1](0, 0, 0, k);
+                if (not filters[2].is_empty())
+                    value *= filters[2](0, 0, 0, l);
+                filter(0, j, k, l) = value;
+            }
+        }
+    }
+
+    const auto input = noa::random<TestType>(noa::Uniform<TestType>{-1, 1}, shape.flip()).permute({3, 2, 1, 0});
+    const auto expected = noa::empty<TestType>(shape);
+    convolve_reference<TestType>(input.view(), expected.view(), filter.view());
+
+    const f64 epsilon = std::is_same_v<TestType, f32> ? 5e-5 : 1e-12;
+    for (auto& device: devices) {
+        INFO(device);
+        auto stream = StreamGuard(device, Stream::DEFAULT);
+        stream.set_thread_limit(n_threads);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        const auto input_device = input.to(options);
+        const auto output = noa::empty<TestType>(shape, options);
+
+        Array<TestType> filters_device[3];
+        for (size_t i{}; i < 3; ++i)
+            if (not filters[i].is_empty())
+                filters_device[i] = filters[i].to(options);
+
+        noa::signal::convolve_separable(input_device, output, filters_device[0], filters_device[1], filters_device[2]);
+        REQUIRE(test::allclose_abs_safe(expected, output, epsilon));
+    }
+}
@@ -2,6 +2,7 @@
 #include <noa/unified/Random.hpp>
 #include <noa/unified/IO.hpp>
 #include <noa/unified/fft/Remap.hpp>
+#include <noa/unified/fft/Transform.hpp>
 #include <noa/unified/signal/Bandpass.hpp>
 #include <noa/unified/Ewise.hpp>
 
@@ -320,3 +321,43 @@ TEMPLATE_TEST_CASE("unified::signal::bandpass(), cpu vs gpu", "[noa][unified]",
     noa::signal::bandpass<"h2h">({}, gpu_output, shape, {0.1, 0.1, 0.45, 0.05});
     REQUIRE(test::allclose_abs(cpu_output, gpu_output.to_cpu(), 5e-6));
 }
+
+TEMPLATE_TEST_CASE("unified::signal::bandpass(), deferred normalization", "[noa][unified]", f32, f64) {
+    const auto shape = test::random_shape_batched(3);
+    constexpr auto bandpass = noa::signal::Bandpass{
+        .highpass_cutoff=0.1,
+        .highpass_width=0.1,
+        .lowpass_cutoff=0.4,
+        .lowpass_width=0.1,
+    };
+    const auto norm = GENERATE(noa::fft::Norm::FORWARD, noa::fft::Norm::ORTHO, noa::fft::Norm::BACKWARD);
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device, Stream::DEFAULT);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto input = noa::random(noa::Uniform<TestType>{-5, 5}, shape, options);
+
+        // Normalize during the transforms.
+        const auto expected = noa::like(input);
+        const auto rfft = noa::fft::r2c(input, {.norm = norm});
+        noa::signal::bandpass<Remap::H2H>(rfft, rfft, shape, bandpass);
+        noa::fft::c2r(rfft, expected, {.norm = norm});
+
+        // Normalize within the bandpass.
+        const auto result = noa::like(input);
+        noa::fft::r2c(input, rfft, {.norm = noa::fft::Norm::NONE});
+        const auto scale =
+            noa::fft::normalization_factor(shape, noa::fft::Sign::FORWARD, norm) *
+            noa::fft::normalization_factor(shape, noa::fft::Sign::BACKWARD, norm);
+        noa::signal::bandpass<Remap::H2H>(rfft, rfft, shape, bandpass, {.input_scale = scale});
+        noa::fft::c2r(rfft, result, {.norm = noa::fft::Norm::NONE});
+
+        REQUIRE(test::allclose_abs_safe(expected, result, std::is_same_v<TestType, f32> ? 1e-4 : 1e-10));
+    }
+}
@@ -4,6 +4,7 @@
 #include <noa/unified/fft/Remap.hpp>
 #include <noa/unified/IO.hpp>
 #include <noa/unified/Ewise.hpp>
+#include <noa/unified/Reduce.hpp>
 
 #include <catch2/catch.hpp>
 
@@ -327,3 +328,69 @@ TEST_CASE("unified::signal::ctf_anisotropic, default range, vs isotropic", "[noa
         }
     }
 }
+
+TEMPLATE_TEST_CASE("unified::signal::ctf_batched_2d", "[noa][unified]", f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    using CTFAnisotropic64 = noa::signal::CTFAnisotropic<f64>;
+    const auto shape = test::random_shape_batched(2, {.batch_range = {1, 70}});
+    const bool is_bfactor_shared = GENERATE(true, false);
+    INFO(shape);
+    INFO(is_bfactor_shared);
+
+    auto ctfs = noa::empty<CTFAnisotropic64>(shape[0]);
+    auto randomizer = test::Randomizer<f64>(0, 1);
+    for (auto& ctf: ctfs.span_1d_contiguous()) {
+        ctf = CTFAnisotropic64::Parameters{
+            .pixel_size = {2.1, 2.1},
+            .defocus = {1 + 2 * randomizer.get(), randomizer.get() * 0.3, randomizer.get() * 3},
+            .voltage = 300.,
+            .amplitude = 0.07,
+            .cs = 2.7,
+            .phase_shift = randomizer.get() * 0.5,
+            .bfactor = is_bfactor_shared ? -20. : -50 * randomizer.get(),
+            .scale = 1.,
+        }.to_ctf();
+    }
+
+    for (auto device: devices) {
+        INFO(device);
+        auto stream = StreamGuard(device);
+        stream.set_thread_limit(4); // the CPU path is parallelized over the pixels
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        if (ctfs.device() != device)
+            ctfs = ctfs.to(options);
+
+        using complex_t = Complex<TestType>;
+        const auto input = noa::random<complex_t>(noa::Uniform<TestType>{-5, 5}, shape.rfft(), options);
+        const auto output = noa::like(input);
+        const auto ctf_squared = noa::zeros<TestType>(shape.rfft().set<0>(1), options);
+        noa::signal::ctf_batched_2d<Remap::HC2H>(input, output, ctf_squared, shape, ctfs, {.input_scale = 2});
+
+        // Compare with the CTFs computed one element at a time.
+        const auto expected = noa::like(input);
+        noa::signal::ctf_anisotropic<Remap::HC2H>(input, expected, shape, ctfs, {.input_scale = 2});
+        REQUIRE(test::allclose_abs_safe(output, expected, 5e-4));
+
+        const auto expected_ctf_squared = noa::like<TestType>(input);
+        const auto expected_ctf_squared_sum = noa::like(ctf_squared);
+        noa::signal::ctf_anisotropic<Remap::H2H>(expected_ctf_squared, shape, ctfs, {.ctf_squared = true});
+        noa::sum(expected_ctf_squared, expected_ctf_squared_sum);
+        REQUIRE(test::allclose_abs_safe(ctf_squared, expected_ctf_squared_sum, 5e-4));
+
+        // The squared CTFs are added to the existing values.
+        noa::signal::ctf_batched_2d<Remap::H2H>({}, View<complex_t>{}, ctf_squared, shape, ctfs);
+        noa::ewise({}, expected_ctf_squared_sum, noa::Scale{TestType{2}});
+        REQUIRE(test::allclose_abs_safe(ctf_squared, expected_ctf_squared_sum, 1e-3));
+
+        // A single isotropic CTF, applied to every batch.
+        const auto ctf_isotropic = noa::signal::CTFIsotropic<f64>(2.1, 2.5, 300, 0.07, 2.7, 0, -10, 1);
+        const auto output_ctf = noa::like<TestType>(input);
+        const auto expected_ctf = noa::like<TestType>(input);
+        noa::signal::ctf_batched_2d<Remap::H2HC>({}, output_ctf, View<TestType>{}, shape, ctf_isotropic);
+        noa::signal::ctf_isotropic<Remap::H2HC>(expected_ctf, shape, ctf_isotropic);
+        REQUIRE(test::allclose_abs_safe(output_ctf, expected_ctf, 5e-5));
+    }
+}
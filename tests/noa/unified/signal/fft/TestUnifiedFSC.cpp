@@ -0,0 +1,148 @@
+#include <noa/unified/Factory.hpp>
+#include <noa/unified/Random.hpp>
+#include <noa/unified/signal/FSC.hpp>
+
+#include <catch2/catch.hpp>
+#include "Utils.hpp"
+
+using namespace noa::types;
+namespace ns = noa::signal;
+namespace ni = noa::indexing;
+
+TEST_CASE("unified::signal::fft::fsc_isotropic, identical inputs", "[noa][unified]") {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto shape = Shape4<i64>{2, 32, 40, 36};
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto lhs = noa::random<c32>(noa::Uniform<f32>{-1, 1}, shape.rfft(), options);
+        const auto rhs = lhs.copy();
+        const auto fsc = ns::fft::fsc_isotropic<noa::Remap::H2H>(lhs, rhs, shape);
+        REQUIRE(noa::vall(noa::Equal{}, fsc.shape(), Shape4<i64>{2, 1, 1, ns::n_shells(shape)}));
+        REQUIRE(ns::n_shells(shape) == 17);
+        REQUIRE(test::allclose_abs(fsc, noa::fill(fsc.shape(), 1.f, options), 1e-5));
+    }
+}
+
+TEST_CASE("unified::signal::fft::fsc_anisotropic", "[noa][unified]") {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    const auto shape = Shape4<i64>{2, 32, 32, 32};
+    const auto n_shells = ns::n_shells(shape);
+    const auto cone_aperture = noa::deg2rad(30.f);
+
+    // Flip the sign of the frequencies that are more than 45deg away from the z-axis.
+    // As such, the FSC is 1 in the cone along z, and -1 in the cone along x (except for the DC).
+    const auto lhs = noa::random<c32>(noa::Uniform<f32>{-1, 1}, shape.rfft());
+    const auto rhs = lhs.copy();
+    const auto span = rhs.span();
+    for (i64 i{}; i < shape[0]; ++i) {
+        for (i64 j{}; j < shape[1]; ++j) {
+            for (i64 k{}; k < shape[2]; ++k) {
+                for (i64 l{}; l < shape[3] / 2 + 1; ++l) {
+                    const auto frequency = Vec{
+                        j < (shape[1] + 1) / 2 ? j : j - shape[1],
+                        k < (shape[2] + 1) / 2 ? k : k - shape[2],
+                        l,
+                    }.as<f64>();
+                    if (std::abs(frequency[0]) < std::sqrt(0.5) * noa::norm(frequency))
+                        span(i, j, k, l) *= -1;
+                }
+            }
+        }
+    }
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto cones = Array<Vec3<f32>>::from_values(Vec3<f32>{1, 0, 0}, Vec3<f32>{0, 0, 1}).to(options);
+        const auto lhs_device = lhs.to(options);
+        const auto rhs_device = rhs.to(options);
+
+        // Identical inputs.
+        const auto fsc = ns::fft::fsc_anisotropic<noa::Remap::H2H>(lhs_device, lhs_device.copy(), shape, cones, cone_aperture);
+        REQUIRE(noa::vall(noa::Equal{}, fsc.shape(), Shape4<i64>{2, 1, 2, n_shells}));
+        REQUIRE(test::allclose_abs(fsc, noa::fill(fsc.shape(), 1.f, options), 1e-5));
+
+        ns::fft::fsc_anisotropic<noa::Remap::H2H>(lhs_device, rhs_device, fsc, shape, cones, cone_aperture);
+        const auto fsc_z = fsc.subregion(ni::FullExtent{}, 0, 0);
+        const auto fsc_x = fsc.subregion(ni::FullExtent{}, 0, 1, ni::Slice{1});
+        REQUIRE(test::allclose_abs(fsc_z, noa::fill(fsc_z.shape(), 1.f, options), 1e-5));
+        REQUIRE(test::allclose_abs(fsc_x, noa::fill(fsc_x.shape(), -1.f, options), 1e-5));
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::signal::local_resolution", "[noa][unified]", f32, f64) {
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    // The left part of the half maps is identical, so the local resolution is at Nyquist,
+    // and the right part is independent noise, so the local resolution is much lower.
+    const auto shape = Shape4<i64>{1, 48, 40, 64};
+    const auto step = i64{8};
+    const auto window_size = i64{16};
+    const auto spacing = 2.;
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto distribution = noa::Uniform<TestType>{-1, 1};
+        const auto lhs = noa::random(distribution, shape, options, {.seed = 42, .counter_based = true});
+        const auto rhs = noa::random(distribution, shape, options, {.seed = 43, .counter_based = true});
+        lhs.subregion(ni::Ellipsis{}, ni::Slice{0, 32}).to(rhs.subregion(ni::Ellipsis{}, ni::Slice{0, 32}));
+
+        const auto grid_shape = ns::local_resolution_shape(shape, step);
+        REQUIRE(noa::vall(noa::Equal{}, grid_shape, Shape4<i64>{1, 6, 5, 8}));
+
+        const auto resolution = ns::local_resolution(lhs, rhs, {
+            .window_size = window_size,
+            .step = step,
+            .spacing = spacing,
+            .n_windows_per_batch = 7, // uneven last batch
+        });
+        REQUIRE(noa::vall(noa::Equal{}, resolution.shape(), grid_shape));
+        resolution.eval();
+
+        const auto span = resolution.span();
+        const auto nyquist = static_cast<TestType>(2 * spacing);
+        TestType noise_sum{};
+        i64 noise_count{};
+        for (i64 z{}; z < grid_shape[1]; ++z) {
+            for (i64 y{}; y < grid_shape[2]; ++y) {
+                for (i64 x{}; x < grid_shape[3]; ++x) {
+                    INFO("z=" << z << ", y=" << y << ", x=" << x);
+                    const auto center = x * step;
+                    if (center + window_size / 2 <= 32) // window within the identical part
+                        REQUIRE_THAT(span(0, z, y, x), Catch::WithinAbs(nyquist, 1e-4));
+                    else if (center - window_size / 2 >= 32) { // window within the noise
+                        noise_sum += span(0, z, y, x);
+                        ++noise_count;
+                    }
+                }
+            }
+        }
+        // The FSC of small windows is noisy, so only check the average.
+        REQUIRE(noise_sum / static_cast<TestType>(noise_count) > 3 * nyquist);
+
+        // The batching shouldn't affect the result.
+        const auto resolution_one_batch = ns::local_resolution(lhs, rhs, {
+            .window_size = window_size,
+            .step = step,
+            .spacing = spacing,
+            .n_windows_per_batch = grid_shape.n_elements(),
+        });
+        REQUIRE(test::allclose_abs(resolution, resolution_one_batch, 1e-5));
+    }
+}
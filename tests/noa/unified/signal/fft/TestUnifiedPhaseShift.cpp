@@ -313,3 +313,123 @@ TEMPLATE_TEST_CASE("unified::signal::phase_shift{2|3}d(), cpu vs gpu", "[noa][un
     }
     REQUIRE(test::allclose_abs(cpu_output, gpu_output.to_cpu(), 8e-5));
 }
+
+TEMPLATE_TEST_CASE("unified::signal::phase_shift{2|3}d(), accuracy", "[noa][unified]", c32, c64) {
+    using real_t = noa::traits::value_type_t<TestType>;
+    const i64 ndim = GENERATE(2, 3);
+    const Remap remap = GENERATE(
+        Remap::H2H, Remap::H2HC, Remap::HC2H, Remap::HC2HC,
+        Remap::F2F, Remap::F2FC, Remap::FC2F, Remap::FC2FC);
+    const auto shape = test::random_shape_batched(ndim, {.batch_range = {1, 3}});
+    const auto shift = Vec{31.5, -15.2, -121.1};
+    INFO(shape);
+    INFO(remap);
+
+    // Compute the expected phase-shifts, one element at a time, in the non-centered layout.
+    const bool is_rfft = remap.is_hx2hx();
+    const auto output_shape = is_rfft ? shape.rfft() : shape;
+    const auto input = noa::random<TestType>(noa::Uniform<f32>{-1, 2}, output_shape);
+    const auto expected = noa::empty<TestType>(output_shape);
+    const auto input_span = input.span();
+    const auto expected_span = expected.span();
+    for (i64 i{}; i < output_shape[0]; ++i) {
+        for (i64 j{}; j < output_shape[1]; ++j) {
+            for (i64 k{}; k < output_shape[2]; ++k) {
+                for (i64 l{}; l < output_shape[3]; ++l) {
+                    const auto frequency = Vec{
+                        j < (shape[1] + 1) / 2 ? j : j - shape[1],
+                        k < (shape[2] + 1) / 2 ? k : k - shape[2],
+                        is_rfft or l < (shape[3] + 1) / 2 ? l : l - shape[3],
+                    };
+                    const auto fftfreq = frequency.as<f64>() / shape.pop_front().vec.as<f64>();
+                    const auto factor = -2 * noa::Constant<f64>::PI * dot(shift, fftfreq);
+                    const auto phase_shift = static_cast<TestType>(c64{std::cos(factor), std::sin(factor)});
+                    expected_span(i, j, k, l) = input_span(i, j, k, l) * phase_shift;
+                }
+            }
+        }
+    }
+
+    // Move the input and expected output to the layouts of the remap.
+    const auto to_centered = is_rfft ? Remap::H2HC : Remap::F2FC;
+    if (remap.is_xc2xx())
+        noa::fft::remap(to_centered, input.copy(), input, shape);
+    if (remap.is_xx2xc())
+        noa::fft::remap(to_centered, expected.copy(), expected, shape);
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto& device: devices) {
+        const auto stream = StreamGuard(device, Stream::DEFAULT);
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        const auto device_input = input.to(options);
+        const auto output = noa::empty<TestType>(output_shape, options);
+        const auto phase_shift = [&]<Remap REMAP>() {
+            if (ndim == 2)
+                noa::signal::phase_shift_2d<REMAP>(device_input, output, shape, shift.pop_front().as<real_t>());
+            else
+                noa::signal::phase_shift_3d<REMAP>(device_input, output, shape, shift.as<real_t>());
+        };
+        switch (remap) {
+            case Remap::H2H: phase_shift.template operator()<Remap::H2H>(); break;
+            case Remap::H2HC: phase_shift.template operator()<Remap::H2HC>(); break;
+            case Remap::HC2H: phase_shift.template operator()<Remap::HC2H>(); break;
+            case Remap::HC2HC: phase_shift.template operator()<Remap::HC2HC>(); break;
+            case Remap::F2F: phase_shift.template operator()<Remap::F2F>(); break;
+            case Remap::F2FC: phase_shift.template operator()<Remap::F2FC>(); break;
+            case Remap::FC2F: phase_shift.template operator()<Remap::FC2F>(); break;
+            case Remap::FC2FC: phase_shift.template operator()<Remap::FC2FC>(); break;
+            default: FAIL();
+        }
+        REQUIRE(test::allclose_abs(output, expected, std::is_same_v<real_t, f64> ? 1e-10 : 5e-4));
+    }
+}
+
+TEMPLATE_TEST_CASE("unified::signal::phase_shift{2|3}d(), multiple shifts", "[noa][unified]", c32, c64) {
+    using real_t = noa::traits::value_type_t<TestType>;
+    const i64 ndim = GENERATE(2, 3);
+    const auto shape = test::random_shape(ndim);
+    const i64 n_shifts = test::Randomizer<i64>(2, 40).get();
+    const auto output_shape = shape.rfft().set<0>(n_shifts);
+    INFO(shape);
+
+    auto shifts_2d = noa::empty<Vec2<real_t>>(n_shifts);
+    auto shifts_3d = noa::empty<Vec3<real_t>>(n_shifts);
+    auto randomizer = test::Randomizer<real_t>(-30, 30);
+    for (i64 i{}; i < n_shifts; ++i) {
+        shifts_3d.span_1d()[i] = {randomizer.get(), randomizer.get(), randomizer.get()};
+        shifts_2d.span_1d()[i] = shifts_3d.span_1d()[i].pop_front();
+    }
+
+    std::vector<Device> devices{"cpu"};
+    if (Device::is_any_gpu())
+        devices.emplace_back("gpu");
+
+    for (auto& device: devices) {
+        auto stream = StreamGuard(device, Stream::DEFAULT);
+        if (device.is_cpu())
+            stream.set_thread_limit(4); // the shifts are split in chunks, which are distributed across threads
+        const auto options = ArrayOption(device, Allocator::MANAGED);
+        INFO(device);
+
+        // One input, shifted by every shift.
+        const auto input = noa::random<TestType>(noa::Uniform<f32>{-1, 2}, shape.rfft(), options);
+        const auto output0 = noa::empty<TestType>(output_shape, options);
+        const auto output1 = noa::empty<TestType>(output_shape, options);
+        for (i64 i{}; i < n_shifts; ++i) {
+            if (ndim == 2)
+                noa::signal::phase_shift_2d<"h2hc">(input, output0.subregion(i), shape, shifts_2d.span_1d()[i]);
+            else
+                noa::signal::phase_shift_3d<"h2hc">(input, output0.subregion(i), shape, shifts_3d.span_1d()[i]);
+        }
+        if (ndim == 2)
+            noa::signal::phase_shift_2d<"h2hc">(input, output1, shape.set<0>(n_shifts), shifts_2d.to({device}));
+        else
+            noa::signal::phase_shift_3d<"h2hc">(input, output1, shape.set<0>(n_shifts), shifts_3d.to({device}));
+        REQUIRE(test::allclose_abs(output0, output1, 1e-6f));
+    }
+}